@@ -180,6 +180,8 @@ typedef struct tag_HYMIRROR_LF_INFO{
     unsigned int uiDataStatus;
     unsigned int uiPairStatus;
     unsigned int uiSecResAccess;
+    unsigned int uiModel;               // only filled by the listing of all pairs
+    string strGroupID;
 } HYMIRROR_LF_INFO_STRU;
 
 typedef struct tag_VSTORE_PAIR_INFO{
@@ -468,10 +470,10 @@ public:
     const TLV_LOGIN_INFO_STRU GetLoginInfo(){return m_stLoginInfo;};
 
     virtual int CMD_showarrayinfo(list<REMOTE_ARRAY_STRU>& rlstRemoteArrayInfo){return RETURN_OK;}
-    virtual int CMD_showarraystretched(list<REMOTE_ARRAY_STRU>& rlstRemoteArrayStrecthed){return RETURN_OK;}
-    virtual int CMD_showarrayclonefs()
+    virtual int CMD_showarraystretched(list<REMOTE_ARRAY_STRU>& rlstRemoteArrayStrecthed, bool &rbStretch){return RETURN_OK;}
+    virtual int CMD_showarrayclonefs(bool &rbNfs)
     {
-        g_bnfs = false;
+        rbNfs = false;
         return RETURN_OK;
     }
     virtual int CMD_showlun(list<LUN_INFO_STRU>& rlstLunInfo) {return RETURN_OK;}
@@ -490,6 +492,7 @@ public:
     virtual int CMD_showconsistgrinfo(IN OUT GROUP_INFO_STRU &rstGroupInfo) {return RETURN_OK;}
     virtual int CMD_showconsistgrinfo(OUT list<GROUP_INFO_STRU> &rlstGroupInfo) {return RETURN_OK;}
     virtual int CMD_showconsistgrhminfo(IN OUT GROUP_INFO_STRU &rstGroupInfo) {return RETURN_OK;}
+    virtual int CMD_showconsistgrhminfo(OUT list<GROUP_INFO_STRU> &rlstGroupInfo) {return RETURN_OK;}
     virtual int CMD_syncconsistgr(IN string strGroupID) {return RETURN_OK;}
     virtual int CMD_syncvstorepair(IN const string& strGroupID) {return RETURN_OK; }
     virtual int CMD_syncconsistgrhm(IN string strGroupID) {return RETURN_OK;}
@@ -535,6 +538,8 @@ public:
     virtual int CMD_showhymirrorlun(IN OUT HYMIRROR_LF_INFO_STRU &rstHyMirrorLUNInfo){return RETURN_OK;}
     virtual int CMD_showhymirrorlun_all(IN string &rstrMirrorID, OUT list<HYMIRROR_LF_INFO_STRU> &rlstHyMirrorLUNInfo){return RETURN_OK;}
     virtual int CMD_showhypermetrolun_all(IN string &hypermetroid, OUT list<HYPERMETRO_LF_INFO_STRU> &rlstHMLUNInfo) {return RETURN_OK;}
+    virtual int CMD_showhymirrorlun_all(OUT map<string, list<HYMIRROR_LF_INFO_STRU> > &rmapHyMirrorLUNInfo) {return RETURN_OK;}
+    virtual int CMD_showhypermetrolun_all(OUT map<string, list<HYPERMETRO_LF_INFO_STRU> > &rmapHMLUNInfo) {return RETURN_OK;}
     virtual int CMD_showhymirrorfs_all(IN string &rstrMirrorID, OUT list<HYMIRROR_LF_INFO_STRU> &rlstHyMirrorFSInfo) {return RETURN_OK;}
     virtual int CMD_showhymirrorbyfs(IN string &strID, OUT list<HYMIRROR_LF_INFO_STRU> &rlstHyMirrorFSInfo,IN bool bismirrorID) {return RETURN_OK;}
     virtual int CMD_showFShyimginfo(IN OUT HYIMAGE_INFO_STRU &rstHyImageInfo) {return RETURN_OK;}
@@ -568,12 +573,14 @@ public:
     virtual int CMD_showctrinfo(OUT list<CONTROLLER_INFO_STRU> &rlstControllerInfo,OUT string &strErrorMsg) {return RETURN_OK;}
     virtual int CMD_showHostByHostGroup(const string &strHostGroupID, list<CMDHOSTINFO_STRU> &lstHosts){return RETURN_OK;}
     virtual int CMD_showhostlink(IN string strHostID,IN unsigned int nFlag,OUT list<HOST_LINK_INFO> &rlstHostLinkInfo){return RETURN_OK;}
+    virtual int CMD_showhostlink_all(IN unsigned int nFlag,OUT list<HOST_LINK_INFO> &rlstHostLinkInfo){return RETURN_OK;}
 
     virtual int CMD_showarraymodelinfo(IN OUT HYPER_STORAGE_STRU &rstStorageInfo){return RETURN_OK;}
     virtual string CMD_getctrip(){return "";};
 
     virtual int CMD_showLunGroupByLUN(const string &strLunID, list<string> &strLunGroupID, int objType) {return RETURN_OK;}
     virtual int CMD_showInitiatorInfo(const string &initiatorID, const string& type, INITIATOR_INFO& initiatorInfo) {return RETURN_OK;}
+    virtual int CMD_showInitiatorInfo_all(const string& type, list<INITIATOR_INFO>& lstInitiatorInfo) {return RETURN_OK;}
     virtual int CMD_removeHostFromHostGroup(const string& hostID, const string& groupID) {return RETURN_OK;}
     virtual int CMD_createHost(const string& hostName, CMDHOSTINFO_STRU& hostInfo) {return RETURN_OK;}
     virtual int CMD_addLun2LunGroup(const string &strLunID, const string &strLunGroupID, int objType) {return RETURN_OK;}
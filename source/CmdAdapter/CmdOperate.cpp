@@ -13,6 +13,7 @@
 // under the License.
 
 #include "CmdOperate.h"
+#include <algorithm>
 
 CCmdOperate::CCmdOperate(void)
 {
@@ -68,6 +69,32 @@ int CCmdOperate::SetStorageInfo(HYPER_STORAGE_STRU &rstHyperStor)
     return RETURN_ERR;
 }
 
+/*------------------------------------------------------------
+Function Name: TakeSession()
+Description  : Take over the adapter and its logged in sessions of another object,
+               which gets the adapter of this object in return.
+Data Accessed: None.
+Data Updated : None.
+Input        : rOther.
+Output       : None.
+Return       : None.
+Call         :
+Called by    :
+Created By   :
+Modification :
+Others       :
+-------------------------------------------------------------*/
+void CCmdOperate::TakeSession(CCmdOperate &rOther)
+{
+    CCmdAdapter *objAdapter = m_objAdapter;
+
+    m_objAdapter = rOther.m_objAdapter;
+    rOther.m_objAdapter = objAdapter;
+
+    m_strSN.swap(rOther.m_strSN);
+    std::swap(m_iCommType, rOther.m_iCommType);
+}
+
 int CCmdOperate::CheckByType(IN int &riCommType)
 {
     int iRtn = RETURN_OK;
@@ -128,19 +155,31 @@ int CCmdOperate::CMD_showarrayinfo(list<REMOTE_ARRAY_STRU>& rlstRemoteArrayInfo)
     return RETURN_ERR;
 }
 
+/* the check leaves its outcome in g_bstretch */
 int CCmdOperate::CMD_showarraystretched(list<REMOTE_ARRAY_STRU>& rlstRemoteArrayStretched)
+{
+    return CMD_showarraystretched(rlstRemoteArrayStretched, g_bstretch);
+}
+
+int CCmdOperate::CMD_showarraystretched(list<REMOTE_ARRAY_STRU>& rlstRemoteArrayStretched, bool &rbStretch)
 {
     if (NULL != m_objAdapter){
-        return m_objAdapter->CMD_showarraystretched(rlstRemoteArrayStretched);
+        return m_objAdapter->CMD_showarraystretched(rlstRemoteArrayStretched, rbStretch);
     }
 
     return RETURN_ERR;
 }
 
+/* the check leaves its outcome in g_bnfs */
 int CCmdOperate::CMD_showarrayclonefs()
+{
+    return CMD_showarrayclonefs(g_bnfs);
+}
+
+int CCmdOperate::CMD_showarrayclonefs(bool &rbNfs)
 {
     if(NULL != m_objAdapter){
-        return m_objAdapter->CMD_showarrayclonefs();
+        return m_objAdapter->CMD_showarrayclonefs(rbNfs);
     }
     return RETURN_ERR;
 }
@@ -247,6 +286,15 @@ int CCmdOperate::CMD_showconsistgrinfo(OUT list<GROUP_INFO_STRU> &rlstGroupInfo)
     return m_objAdapter->CMD_showconsistgrinfo(rlstGroupInfo);
 }
 
+int CCmdOperate::CMD_showconsistgrhminfo(OUT list<GROUP_INFO_STRU> &rlstGroupInfo)
+{
+    if (NULL == m_objAdapter){
+        return RETURN_ERR;
+    }
+
+    return m_objAdapter->CMD_showconsistgrhminfo(rlstGroupInfo);
+}
+
 int CCmdOperate::CMD_syncconsistgr(IN string strGroupID)
 {
     if (NULL == m_objAdapter){
@@ -713,6 +761,24 @@ int CCmdOperate::CMD_showhypermetrolun_all(IN string &hypermetroid, OUT list<HYP
     return m_objAdapter->CMD_showhypermetrolun_all(hypermetroid, rlstHMLUNInfo);
 }
 
+int CCmdOperate::CMD_showhymirrorlun_all(OUT map<string, list<HYMIRROR_LF_INFO_STRU> > &rmapHyMirrorLUNInfo)
+{
+    if (NULL == m_objAdapter){
+        return RETURN_ERR;
+    }
+
+    return m_objAdapter->CMD_showhymirrorlun_all(rmapHyMirrorLUNInfo);
+}
+
+int CCmdOperate::CMD_showhypermetrolun_all(OUT map<string, list<HYPERMETRO_LF_INFO_STRU> > &rmapHMLUNInfo)
+{
+    if (NULL == m_objAdapter){
+        return RETURN_ERR;
+    }
+
+    return m_objAdapter->CMD_showhypermetrolun_all(rmapHMLUNInfo);
+}
+
 int CCmdOperate::CMD_showhymirrorfs_all(IN string &rstrMirrorID, OUT list<HYMIRROR_LF_INFO_STRU> &rlstHyMirrorFSInfo)
 {
     if (NULL == m_objAdapter){
@@ -1111,6 +1177,28 @@ int CCmdOperate:: CMD_showhostlink(IN string initatorWwn,IN unsigned int nFalg,l
     return m_objAdapter->CMD_showhostlink(initatorWwn,nFalg,rlstHostLinkInfo);
 }
 
+/*------------------------------------------------------------
+Function Name: CMD_showhostlink_all()
+Description  : Query all host links of one initiator type.
+Data Accessed: None.
+Data Updated : None.
+Input        : nFalg.
+Output       : rlstHostLinkInfo.
+Return       : Success or failure.
+Call         :
+Called by    :
+Created By   :
+Modification :
+Others       :
+-------------------------------------------------------------*/
+int CCmdOperate:: CMD_showhostlink_all(IN unsigned int nFalg,list<HOST_LINK_INFO> &rlstHostLinkInfo)
+{
+    if (NULL == m_objAdapter){
+        return RETURN_ERR;
+    }
+    return m_objAdapter->CMD_showhostlink_all(nFalg,rlstHostLinkInfo);
+}
+
 int CCmdOperate::CMD_showvstorepair_info(IN const string &pairid, OUT VSTORE_PAIR_INFO_STRU &vstorePair)
 {
     if (NULL == m_objAdapter){
@@ -1297,6 +1385,14 @@ int CCmdOperate::CMD_showInitiatorInfo(const string &initiatorID, const string&
     return m_objAdapter->CMD_showInitiatorInfo(initiatorID, type, initiatorInfo);
 }
 
+int CCmdOperate::CMD_showInitiatorInfo_all(const string& type, list<INITIATOR_INFO>& lstInitiatorInfo)
+{
+    if (NULL == m_objAdapter){
+        return RETURN_ERR;
+    }
+    return m_objAdapter->CMD_showInitiatorInfo_all(type, lstInitiatorInfo);
+}
+
 int CCmdOperate::CMD_removeHostFromHostGroup(const string& hostID, const string& groupID)
 {
     if (NULL == m_objAdapter){
@@ -31,6 +31,7 @@ public:
     int SetSN(const string& sn);
     const string GetSN();
     int SetStorageInfo(HYPER_STORAGE_STRU &rstHyperStor);
+    void TakeSession(CCmdOperate &rOther);
     int CMD_maplun2host(const string& hostname, const list<string>& luns);
     int CMD_maplun2hostGroup(const string& hostname, const list<string>& luns);
     int CMD_unmaplun2host(const string& hostname, const list<string>& luns);
@@ -39,6 +40,7 @@ public:
     int CheckArraySN(string &rstrArraySN);
     int CMD_showarrayinfo(list<REMOTE_ARRAY_STRU>& rlstRemoteArrayInfo); 
     int CMD_showarraystretched(list<REMOTE_ARRAY_STRU>& rlstRemoteArrayStretched);
+    int CMD_showarraystretched(list<REMOTE_ARRAY_STRU>& rlstRemoteArrayStretched, bool &rbStretch);
     int CMD_showlun(list<LUN_INFO_STRU>& rlstLunInfo);
     int CMD_showlun(LUN_INFO_STRU& rstLunInfo);
     int CMD_showfs(FS_INFO_STRU& rstFSInfo);
@@ -51,6 +53,7 @@ public:
     int CMD_showconsistgrinfo(IN OUT GROUP_INFO_STRU &rstGroupInfo);
     int CMD_showconsistgrinfo(OUT list<GROUP_INFO_STRU> &rlstGroupInfo);
     int CMD_showconsistgrhminfo(IN OUT GROUP_INFO_STRU &rstGroupInfo);
+    int CMD_showconsistgrhminfo(OUT list<GROUP_INFO_STRU> &rlstGroupInfo);
     int CMD_syncconsistgr(IN string strGroupID);
     int CMD_syncconsistgrhm(IN string strGroupID);
     int CMD_swapconsistgr(IN string strGroupID);
@@ -100,6 +103,8 @@ public:
     int CMD_showhymirrorlun(IN OUT HYMIRROR_LF_INFO_STRU &rstHyMirrorLUNInfo);
     int CMD_showhymirrorlun_all(IN string &rstrMirrorID, OUT list<HYMIRROR_LF_INFO_STRU> &rlstHyMirrorLUNInfo);
     int CMD_showhypermetrolun_all(IN string &hypermetroid, OUT list<HYPERMETRO_LF_INFO_STRU> &rlstHMLUNInfo);
+    int CMD_showhymirrorlun_all(OUT map<string, list<HYMIRROR_LF_INFO_STRU> > &rmapHyMirrorLUNInfo);
+    int CMD_showhypermetrolun_all(OUT map<string, list<HYPERMETRO_LF_INFO_STRU> > &rmapHMLUNInfo);
     int CMD_showhymirrorfs_all(IN string &rstrMirrorID, OUT list<HYMIRROR_LF_INFO_STRU> &rlstHyMirrorFSInfo);
     int CMD_showhymirrorbyfs(IN string &strID, OUT list<HYMIRROR_LF_INFO_STRU> &rlstHyMirrorFSInfo,IN bool bismirrorID = false);
     int CMD_delhyimg(IN string &rstrSnapshotID);
@@ -122,10 +127,13 @@ public:
     int CMD_showtlvsysinfo(IN OUT HYPER_STORAGE_STRU &rstSysInfo,OUT string &strErrorMsg);
     int CMD_showhostByhostGroup(const string &strHostGroupID, list<CMDHOSTINFO_STRU> &lstHosts);
     int CMD_showhostlink(IN string initatorWwn, IN unsigned int nFalg,list<HOST_LINK_INFO> &rlstHostLinkInfo);
+    int CMD_showhostlink_all(IN unsigned int nFalg,list<HOST_LINK_INFO> &rlstHostLinkInfo);
     int CMD_showarrayclonefs();
+    int CMD_showarrayclonefs(bool &rbNfs);
     int CMD_showvstorepair_info(IN const string &pairid, OUT VSTORE_PAIR_INFO_STRU &vstorePair);
     int CMD_showLunGroupByLUN(const string &strLunID, list<string> &strLunGroupID, int objType);
     int CMD_showInitiatorInfo(const string &initiatorID, const string& type, INITIATOR_INFO& initiatorInfo);
+    int CMD_showInitiatorInfo_all(const string& type, list<INITIATOR_INFO>& lstInitiatorInfo);
     int CMD_removeHostFromHostGroup(const string& hostID, const string& groupID);
     int CMD_createHost(const string& hostName, CMDHOSTINFO_STRU& hostInfo);
     int CMD_CreateLunGroup(const string &lunGroupName, string &lunGroupID);
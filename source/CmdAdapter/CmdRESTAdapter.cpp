@@ -252,9 +252,13 @@ int CRESTCmd::CMD_showarrayinfo(list<REMOTE_ARRAY_STRU>& rlstRemoteArrayInfo)
                 strarraytype = restPkg[i][REMOTEDEVICE_TAG_ARRAYTYPE].asString();
             }
             if (strarraytype != "1"){
+                COMMLOG(OS_LOG_INFO, "skip remote device [%s], its array type is [%s].",
+                    restPkg[i][COMMON_TAG_ID].asString().c_str(), strarraytype.c_str());
                 continue;
             }
             if (restPkg[i][REMOTEDEVICE_TAG_SN].asString().empty()){
+                COMMLOG(OS_LOG_WARN, "skip remote device [%s], its SN is unknown.",
+                    restPkg[i][COMMON_TAG_ID].asString().c_str());
                 continue;
             }
 
@@ -276,8 +280,9 @@ Function Name: CMD_showarraystretched()
 Description  : Query whether the remote device supports dual-active
 Data Accessed: None.
 Data Updated : None.
-Input        : 
+Input        : rbStretch:whether config.txt supports stretched.
 Output       : rlstRemoteArrayInfo:Remote device information.
+               rbStretch:whether stretched is supported.
 Return       : Success or failure.
 Call         :
 Called by    :
@@ -285,7 +290,7 @@ Called by    :
 Modification :
 Others       :
 -------------------------------------------------------------*/
-int CRESTCmd::CMD_showarraystretched(list<REMOTE_ARRAY_STRU>& rlstRemoteArrayStrecthed)
+int CRESTCmd::CMD_showarraystretched(list<REMOTE_ARRAY_STRU>& rlstRemoteArrayStrecthed, bool &rbStretch)
 {
     int iRet = RETURN_OK;
     CRestPackage restPkg;
@@ -323,22 +328,22 @@ int CRESTCmd::CMD_showarraystretched(list<REMOTE_ARRAY_STRU>& rlstRemoteArrayStr
                 if (0 == (strStretched[j][COMMON_TAG_LICENSE_FEATUREID].compare(HYPERMETROPAIR_TAG_LICENSE_INDEX))){
                     if ((0 == strStretched[j][COMMON_TAG_LICENSE_OPENSTATUS].compare(HYPERMETROPAIR_TAG_LICENSE_OPENSTATUS))
                         && (strStretched[j][COMMON_TAG_LICENSE_STATE].compare(HYPERMETROPAIR_TAG_LICENSE_STATE) != 0)){
-                        if (g_bstretch == true){
+                        if (rbStretch == true){
                             stArrayInfo.strStretched = HM_SUPPORT_STRETCHED;
-                            g_bstretch = true;
+                            rbStretch = true;
                             COMMLOG(OS_LOG_INFO, "Check array (ip [%s]) license, is support stretched, "
                                 "and config.txt is also support stretched.", iter->c_str());
                         }
                         else{
                             stArrayInfo.strStretched = HM_SUPPORT_NOT_STRETCHED;
-                            g_bstretch = false;
+                            rbStretch = false;
                             COMMLOG(OS_LOG_WARN, "Check array (ip [%s]) license, is support stretched, "
                                 "but config.txt is not support stretched. so not support stretched", iter->c_str());
                         }
                         break;
                     }
                     else{
-                        if (g_bstretch == true){
+                        if (rbStretch == true){
                             COMMLOG(OS_LOG_WARN, "Check array (ip [%s]) license, is not support stretched, "
                                 "config.txt is support stretched. so not support stretched.", iter->c_str());
                         }
@@ -347,20 +352,20 @@ int CRESTCmd::CMD_showarraystretched(list<REMOTE_ARRAY_STRU>& rlstRemoteArrayStr
                                 "and config.txt is also not support stretched.", iter->c_str());
                         }
                         stArrayInfo.strStretched = HM_SUPPORT_NOT_STRETCHED;
-                        g_bstretch = false;
+                        rbStretch = false;
                         break;
                     }
                 }
             }
             if (j == strStretched.size()){
                 stArrayInfo.strStretched = HM_SUPPORT_NOT_STRETCHED;
-                if (g_bstretch == true){
-                    g_bstretch = false;
+                if (rbStretch == true){
+                    rbStretch = false;
                     COMMLOG(OS_LOG_WARN, "Check array (ip [%s]) license, is not support stretched, "
                         "config.txt is support stretched. so not support stretched.", iter->c_str());
                 }
                 else{
-                    g_bstretch = false;
+                    rbStretch = false;
                     COMMLOG(OS_LOG_WARN, "Check array (ip [%s]) license, is not support stretched, "
                         "and config.txt is also not support stretched.", iter->c_str());
                 }
@@ -2667,6 +2672,404 @@ int CRESTCmd::CMD_showhypermetrolun_all(IN string &hypermetroid, OUT list<HYPERM
     return RETURN_OK;
 }
 
+/*------------------------------------------------------------
+Function Name: CMD_showhymirrorlun_all()
+Description  : Query the member LUN information of all remote replications
+               with one paged listing, keyed by the replication pair id.
+               The pair state and model, the consistency group and the
+               arrays of both members are filled, the system is queried
+               once for the whole listing. The name of the local resource
+               is not queried.
+Data Accessed: None.
+Data Updated : None.
+Input        : None.
+Output       : rmapHyMirrorLUNInfo:
+Return       : Success or Failure.
+Call         :
+Called by    :
+Called by    :
+Modification :
+Others       :
+-------------------------------------------------------------*/
+int CRESTCmd::CMD_showhymirrorlun_all(OUT map<string, list<HYMIRROR_LF_INFO_STRU> > &rmapHyMirrorLUNInfo)
+{
+    int iRet = RETURN_OK;
+    CRestPackage restPkg;
+    ostringstream tmposs;
+    SYSTEM_INFO_STRU rstSysInfo;
+
+    iRet = CMD_showsys(rstSysInfo);
+    if (iRet != RETURN_OK){
+        COMMLOG(OS_LOG_ERROR, "CMD_showsys fail [%d].", iRet);
+        return RETURN_ERR;
+    }
+
+    TLV_LOGIN_INFO_STRU rstLogInInfo = GetLoginInfo();
+    for (list<string>::const_iterator iter = rstLogInInfo.lstArrayIP.begin(); 
+        iter != rstLogInInfo.lstArrayIP.end(); ++iter){
+        int rangeIndex = 0;
+        string strDeviceIP = *iter;
+        bool flag = true;
+        CRESTConn *restConn = getConn(strDeviceIP, rstLogInInfo.strArrayUser, rstLogInInfo.strArrayPwd);
+        rmapHyMirrorLUNInfo.clear();
+
+        while(true){
+            tmposs.str("");
+            tmposs << RESTURL_REPLICATIONPAIR << "?range=[" << rangeIndex << "-" << (rangeIndex + RECOMMEND_RANGE_COUNT) << "]";
+
+            iRet = restConn->doRequest(tmposs.str(), REST_REQUEST_MODE_GET, "", restPkg);
+            if (iRet != RETURN_OK){
+                COMMLOG(OS_LOG_ERROR, "ip [%s] url [%s] the iRet is (%d).", iter->c_str(), tmposs.str().c_str(), iRet);
+                flag = false;
+                break;
+            }
+
+            if (restPkg.errorCode() != RETURN_OK){
+                iRet = restPkg.errorCode();
+                COMMLOG(OS_LOG_ERROR, "ip [%s] url [%s] the iRet is (%d), description %s.", 
+                    iter->c_str(), tmposs.str().c_str(), iRet, restPkg.description().c_str());
+                return restPkg.errorCode();
+            }
+
+            size_t i = 0;
+            for (; i < restPkg.count(); ++i){
+                HYMIRROR_LF_INFO_STRU stHyMirrorLUNInfoLocal, stHyMirrorLUNInfoRemote;
+                string strMirrorID = restPkg[i][COMMON_TAG_ID].asString();
+                unsigned int resType = jsonValue2Type<unsigned int>(restPkg[i][REPLICATIONPAIR_TAG_LOCALRESTYPE]);
+                bool isPrimary = (restPkg[i][REPLICATIONPAIR_TAG_ISPRIMARY].asString().compare("true") == 0);
+
+                unsigned int uiSyncType = jsonValue2Type<unsigned int>(restPkg[i][REPLICATIONPAIR_TAG_SYNCHRONIZETYPE]);
+                if (0xFFFFFFFF == uiSyncType){
+                    uiSyncType = 0;
+                }
+
+                int iProgress = jsonValue2Type<int>(restPkg[i][REPLICATIONPAIR_TAG_REPLICATIONPROGRESS]);
+
+                unsigned int uiDataStatusRemote = jsonValue2Type<unsigned int>(restPkg[i][REPLICATIONPAIR_TAG_SECRESDATASTATUS]);
+                if (0xFFFFFFFF == uiDataStatusRemote){
+                    uiDataStatusRemote = 0;
+                }
+
+                unsigned int uiDataStatusLocal = jsonValue2Type<unsigned int>(restPkg[i][REPLICATIONPAIR_TAG_PRIRESDATASTATUS]);
+                if (0xFFFFFFFF == uiDataStatusLocal){
+                    uiDataStatusLocal = 0;
+                }
+
+                unsigned int uiPairStatus = jsonValue2Type<unsigned int>(restPkg[i][COMMON_TAG_RUNNINGSTATUS]);
+                if (0xFFFFFFFF == uiPairStatus){
+                    uiPairStatus = 0;
+                }
+
+                if (uiPairStatus == RUNNING_STATUS_NORMAL && iProgress == -1){
+                    iProgress = 100;
+                }
+
+                unsigned int uiModel = jsonValue2Type<unsigned int>(restPkg[i][REPLICATIONPAIR_TAG_REPLICATIONMODEL]);
+                UpdateModel(uiModel);
+
+                unsigned long long ullStartTime = jsonValue2Type<unsigned long long>(restPkg[i][REPLICATIONPAIR_TAG_STARTTIME]);
+
+                stHyMirrorLUNInfoLocal.strMirrorID = strMirrorID;
+                stHyMirrorLUNInfoLocal.uiSyncType = uiSyncType;
+                stHyMirrorLUNInfoLocal.iProgress = iProgress;
+                stHyMirrorLUNInfoLocal.uiDataStatus = uiDataStatusLocal;
+                ConvertMirrorSlaveLUNStatus(stHyMirrorLUNInfoLocal.uiDataStatus);
+                TimeChg(ullStartTime,stHyMirrorLUNInfoLocal.strSyncStartTime);
+                stHyMirrorLUNInfoLocal.uiPairStatus = uiPairStatus;
+                ConvertMirrorPairStatus(stHyMirrorLUNInfoLocal.uiPairStatus);
+                stHyMirrorLUNInfoLocal.uilocalResType = resType;
+                stHyMirrorLUNInfoLocal.uiModel = uiModel;
+                stHyMirrorLUNInfoLocal.strID = restPkg[i][REPLICATIONPAIR_TAG_LOCALRESID].asString();
+                stHyMirrorLUNInfoLocal.strArrayWWN = rstSysInfo.strDeviceSerialNumber;
+                stHyMirrorLUNInfoLocal.strArrayName = rstSysInfo.strName;
+
+                stHyMirrorLUNInfoRemote.strMirrorID = strMirrorID;
+                stHyMirrorLUNInfoRemote.uiSyncType = uiSyncType;
+                stHyMirrorLUNInfoRemote.iProgress = iProgress;
+                stHyMirrorLUNInfoRemote.uiDataStatus = uiDataStatusRemote;
+                ConvertMirrorSlaveLUNStatus(stHyMirrorLUNInfoRemote.uiDataStatus);
+                TimeChg(ullStartTime,stHyMirrorLUNInfoRemote.strSyncStartTime);
+                stHyMirrorLUNInfoRemote.uiPairStatus = uiPairStatus;
+                ConvertMirrorPairStatus(stHyMirrorLUNInfoRemote.uiPairStatus);
+                stHyMirrorLUNInfoRemote.uilocalResType = resType;
+                stHyMirrorLUNInfoRemote.uiModel = uiModel;
+                stHyMirrorLUNInfoRemote.strID = restPkg[i][REPLICATIONPAIR_TAG_REMOTERESID].asString();
+                stHyMirrorLUNInfoRemote.strArrayWWN = restPkg[i][REPLICATIONPAIR_TAG_REMOTEDEVICESN].asString();
+                stHyMirrorLUNInfoRemote.strArrayName = restPkg[i][REPLICATIONPAIR_TAG_REMOTEDEVICENAME].asString();
+
+                stHyMirrorLUNInfoRemote.uiSecResAccess = jsonValue2Type<unsigned int>(restPkg[i][REPLICATIONPAIR_TAG_SECRESACCESS]);
+                stHyMirrorLUNInfoLocal.uiSecResAccess = jsonValue2Type<unsigned int>(restPkg[i][REPLICATIONPAIR_TAG_SECRESACCESS]);
+
+                if (restPkg[i][REPLICATIONPAIR_TAG_ISINCG].asString().compare("true") == 0 &&
+                    restPkg[i][REPLICATIONPAIR_TAG_CGID].asString().compare(STR_INVALID_CGID) != 0){
+                    stHyMirrorLUNInfoLocal.strGroupID = restPkg[i][REPLICATIONPAIR_TAG_CGID].asString();
+                    stHyMirrorLUNInfoRemote.strGroupID = stHyMirrorLUNInfoLocal.strGroupID;
+                }
+
+                if (isPrimary){
+                    stHyMirrorLUNInfoLocal.uiRelationType = LUN_RELATION_MASTER;
+                    stHyMirrorLUNInfoRemote.uiRelationType = LUN_RELATION_SLAVE;    
+                }
+                else{
+                    stHyMirrorLUNInfoLocal.uiRelationType = LUN_RELATION_SLAVE;
+                    stHyMirrorLUNInfoRemote.uiRelationType = LUN_RELATION_MASTER;
+                }
+
+                list<HYMIRROR_LF_INFO_STRU> &rlstHyMirrorLUNInfo = rmapHyMirrorLUNInfo[strMirrorID];
+                rlstHyMirrorLUNInfo.clear();
+                rlstHyMirrorLUNInfo.push_back(stHyMirrorLUNInfoLocal);
+                rlstHyMirrorLUNInfo.push_back(stHyMirrorLUNInfoRemote);
+            }
+
+            if (RECOMMEND_RANGE_COUNT == i){
+                rangeIndex += RECOMMEND_RANGE_COUNT;
+            }
+            else{
+                break;
+            }
+        }
+
+        if (flag)
+            return RETURN_OK;
+        else
+            continue;
+    }
+
+    return RETURN_ERR;
+}
+
+/*------------------------------------------------------------
+Function Name: CMD_showhypermetrolun_all()
+Description  : Query the member LUN information of all hypermetro pairs
+               with one paged listing, keyed by the hypermetro pair id.
+               The members are filled as by the query of a single pair;
+               the system, each hypermetro domain and the hypermetro
+               consistency groups are queried once for the whole listing.
+               A pair whose consistency group can not be queried is left
+               out, so that the caller falls back to the single query.
+Data Accessed: None.
+Data Updated : None.
+Input        : None.
+Output       : rmapHMLUNInfo:
+Return       : Success or Failure.
+Call         :
+Called by    :
+Called by    :
+Modification :
+Others       :
+-------------------------------------------------------------*/
+int CRESTCmd::CMD_showhypermetrolun_all(OUT map<string, list<HYPERMETRO_LF_INFO_STRU> > &rmapHMLUNInfo)
+{
+    int iRet = RETURN_OK;
+    CRestPackage restPkg;
+    ostringstream tmposs;
+    SYSTEM_INFO_STRU rstSysInfo;
+    map<string, HYPERMETRODOMAIN_LF_INFO_STRU> mapDomainInfo;
+    map<string, GROUP_INFO_STRU> mapGroupInfo;
+    bool bGroupListed = false;
+
+    iRet = CMD_showsys(rstSysInfo);
+    if (iRet != RETURN_OK){
+        COMMLOG(OS_LOG_ERROR, "CMD_showsys fail [%d].", iRet);
+        return RETURN_ERR;
+    }
+
+    TLV_LOGIN_INFO_STRU rstLogInInfo = GetLoginInfo();
+    for (list<string>::const_iterator iter = rstLogInInfo.lstArrayIP.begin(); 
+        iter != rstLogInInfo.lstArrayIP.end(); ++iter){
+        int rangeIndex = 0;
+        string strDeviceIP = *iter;
+        bool flag = true;
+        CRESTConn *restConn = getConn(strDeviceIP, rstLogInInfo.strArrayUser, rstLogInInfo.strArrayPwd);
+        rmapHMLUNInfo.clear();
+
+        while(true){
+            tmposs.str("");
+            tmposs << RESTURL_HYPERMETROPAIR << "?range=[" << rangeIndex << "-" << (rangeIndex + RECOMMEND_RANGE_COUNT) << "]";
+
+            iRet = restConn->doRequest(tmposs.str(), REST_REQUEST_MODE_GET, "", restPkg);
+            if (iRet != RETURN_OK){
+                COMMLOG(OS_LOG_ERROR, "ip [%s] url [%s] the iRet is (%d).", iter->c_str(), tmposs.str().c_str(), iRet);
+                flag = false;
+                break;
+            }
+
+            if (restPkg.errorCode() != RETURN_OK){
+                iRet = restPkg.errorCode();
+                COMMLOG(OS_LOG_ERROR, "ip [%s] url [%s] the iRet is (%d), description %s.", 
+                    iter->c_str(), tmposs.str().c_str(), iRet, restPkg.description().c_str());
+                return restPkg.errorCode();
+            }
+
+            size_t i = 0;
+            for (; i < restPkg.count(); ++i){
+                HYPERMETRO_LF_INFO_STRU stHMLUNInfoLocal, stHMLUNInfoRemote;
+                string hypermetroid = restPkg[i][COMMON_TAG_ID].asString();
+                bool isPrimary = (restPkg[i][HYPERMETROPAIR_TAG_ISPRIMARY].asString().compare("true") == 0);
+
+                int iProgress = jsonValue2Type<int>(restPkg[i][HYPERMETROPAIR_TAG_REPLICATIONPROGRESS]);
+
+                unsigned int uiDataStatusRemote = jsonValue2Type<unsigned int>(restPkg[i][HYPERMETROPAIR_TAG_REMOTEDATASTATE]);
+                if (0xFFFFFFFF == uiDataStatusRemote){
+                    uiDataStatusRemote = 0;
+                }
+
+                unsigned int uiDataStatusLocal = jsonValue2Type<unsigned int>(restPkg[i][HYPERMETROPAIR_TAG_LOCALDATASTATE]);
+                if (0xFFFFFFFF == uiDataStatusLocal){
+                    uiDataStatusLocal = 0;
+                }
+
+                unsigned int uiPairStatus = jsonValue2Type<unsigned int>(restPkg[i][COMMON_TAG_RUNNINGSTATUS]);
+                if (0xFFFFFFFF == uiPairStatus){
+                    uiPairStatus = 0;
+                }
+
+                if (uiPairStatus == RUNNING_STATUS_NORMAL && iProgress == -1){
+                    iProgress = 100;
+                }
+
+                unsigned int uiHealthStatus = jsonValue2Type<unsigned int>(restPkg[i][COMMON_TAG_HEALTHSTATUS]);
+                if (0xFFFFFFFF == uiHealthStatus){
+                    uiHealthStatus = 0;
+                }
+
+                unsigned long long ullStartTime = jsonValue2Type<unsigned long long>(restPkg[i][HYPERMETROPAIR_TAG_STARTTIME]);
+
+                stHMLUNInfoLocal.strHMpairID = hypermetroid;
+                stHMLUNInfoLocal.iProgress = iProgress;
+                stHMLUNInfoLocal.uiDataStatus = uiDataStatusLocal;
+                ConvertHMSlaveLUNStatus(stHMLUNInfoLocal.uiDataStatus);
+                TimeChg(ullStartTime,stHMLUNInfoLocal.strSyncStartTime);
+                stHMLUNInfoLocal.uiPairStatus = uiPairStatus;
+                ConvertHMPairStatus(stHMLUNInfoLocal.uiPairStatus);
+                stHMLUNInfoLocal.uiHealthStatus = uiHealthStatus;
+                stHMLUNInfoLocal.strID = restPkg[i][HYPERMETROPAIR_TAG_LOCALOBJID].asString();
+                stHMLUNInfoLocal.strName = restPkg[i][HYPERMETROPAIR_TAG_LOCALOBJNAME].asString();
+                stHMLUNInfoLocal.strArrayWWN = rstSysInfo.strDeviceSerialNumber;
+                stHMLUNInfoLocal.strArrayName = rstSysInfo.strName;
+                stHMLUNInfoLocal.strDomainID = restPkg[i][HYPERMETROPAIR_TAG_DOMAINID].asString();
+                stHMLUNInfoLocal.strIsinCg = restPkg[i][HYPERMETROPAIR_TAG_ISINCG].asString();
+                stHMLUNInfoLocal.uiLocalAccess = jsonValue2Type<unsigned int>(restPkg[i][HYPERMETROPAIR_TAG_LOCALHOSTACCESSSTATE]);
+                stHMLUNInfoLocal.strstretched = g_bstretch ? "true" : "false";
+
+                stHMLUNInfoRemote.strHMpairID = hypermetroid;
+                stHMLUNInfoRemote.iProgress = iProgress;
+                stHMLUNInfoRemote.uiDataStatus = uiDataStatusRemote;
+                ConvertHMSlaveLUNStatus(stHMLUNInfoRemote.uiDataStatus);
+                TimeChg(ullStartTime,stHMLUNInfoRemote.strSyncStartTime);
+                stHMLUNInfoRemote.uiPairStatus = uiPairStatus;
+                ConvertHMPairStatus(stHMLUNInfoRemote.uiPairStatus);
+                stHMLUNInfoRemote.uiHealthStatus = uiHealthStatus;
+                stHMLUNInfoRemote.strID = restPkg[i][HYPERMETROPAIR_TAG_REMOTEOBJID].asString();
+                stHMLUNInfoRemote.strName = restPkg[i][HYPERMETROPAIR_TAG_REMOTEOBJNAME].asString();
+                stHMLUNInfoRemote.strDomainID = restPkg[i][HYPERMETROPAIR_TAG_DOMAINID].asString();
+                stHMLUNInfoRemote.strIsinCg = restPkg[i][HYPERMETROPAIR_TAG_ISINCG].asString();
+                stHMLUNInfoRemote.strstretched = stHMLUNInfoLocal.strstretched;
+
+                if (mapDomainInfo.end() == mapDomainInfo.find(stHMLUNInfoLocal.strDomainID)){
+                    HYPERMETRODOMAIN_LF_INFO_STRU stHMDomainInfo;
+                    (void)CMD_showhyperMetroDomain_all(stHMLUNInfoLocal.strDomainID, stHMDomainInfo);
+                    mapDomainInfo[stHMLUNInfoLocal.strDomainID] = stHMDomainInfo;
+                }
+                HYPERMETRODOMAIN_LF_INFO_STRU &rstHMDomainInfo = mapDomainInfo[stHMLUNInfoLocal.strDomainID];
+                stHMLUNInfoLocal.strCptype = rstHMDomainInfo.strCptype;
+                stHMLUNInfoRemote.strArrayWWN = rstHMDomainInfo.strRemoteArraySN;
+                stHMLUNInfoRemote.strArrayName = rstHMDomainInfo.strRemoteArrayName;
+                stHMLUNInfoRemote.strCptype = rstHMDomainInfo.strCptype;
+
+                if (stHMLUNInfoLocal.strIsinCg.compare("true") == 0){
+                    string strCGID = restPkg[i][HYPERMETROPAIR_TAG_CGID].asString();
+
+                    if (!bGroupListed){
+                        list<GROUP_INFO_STRU> lstGroupInfo;
+                        if (RETURN_OK == CMD_showconsistgrhminfo(lstGroupInfo)){
+                            for (list<GROUP_INFO_STRU>::iterator itGroup = lstGroupInfo.begin(); itGroup != lstGroupInfo.end(); ++itGroup){
+                                mapGroupInfo[itGroup->strID] = *itGroup;
+                            }
+                        }
+                        bGroupListed = true;
+                    }
+
+                    if (mapGroupInfo.end() == mapGroupInfo.find(strCGID)){
+                        GROUP_INFO_STRU stGroupInfo;
+                        stGroupInfo.strID = strCGID;
+                        if (RETURN_OK != CMD_showconsistgrhminfo(stGroupInfo)){
+                            COMMLOG(OS_LOG_WARN, "CMD_showconsistgrhminfo of %s failed, pair %s is not listed.",
+                                strCGID.c_str(), hypermetroid.c_str());
+                            continue;
+                        }
+                        mapGroupInfo[strCGID] = stGroupInfo;
+                    }
+
+                    GROUP_INFO_STRU &rstGroupInfo = mapGroupInfo[strCGID];
+                    isPrimary = (rstGroupInfo.uiIsPrimary != HM_GROUP_RELATION_SLAVE);
+
+                    if (isPrimary){
+                        stHMLUNInfoLocal.uiRelationType = LUN_RELATION_MASTER;
+                        stHMLUNInfoRemote.uiRelationType = LUN_RELATION_SLAVE;    
+                    }
+                    else{
+                        stHMLUNInfoLocal.uiRelationType = LUN_RELATION_SLAVE;
+                        stHMLUNInfoRemote.uiRelationType = LUN_RELATION_MASTER;
+                    }
+                    stHMLUNInfoRemote.uiSecResAccess = rstGroupInfo.uiSecResAccess;
+                    stHMLUNInfoLocal.uiSecResAccess = rstGroupInfo.uiSecResAccess;
+                }
+                else{
+                    unsigned int uiLocalAccessState = jsonValue2Type<unsigned int>(restPkg[i][HYPERMETROPAIR_TAG_LOCALHOSTACCESSSTATE]);
+                    unsigned int uiRemoteAccessState = jsonValue2Type<unsigned int>(restPkg[i][HYPERMETROPAIR_TAG_REMOTEHOSTACCESSSTATE]);
+
+                    if (isPrimary){
+                        stHMLUNInfoLocal.uiRelationType = LUN_RELATION_MASTER;
+                        stHMLUNInfoRemote.uiRelationType = LUN_RELATION_SLAVE;    
+                        stHMLUNInfoRemote.uiSecResAccess = uiRemoteAccessState;
+                        stHMLUNInfoLocal.uiSecResAccess = uiRemoteAccessState;
+                    }
+                    else{
+                        stHMLUNInfoLocal.uiRelationType = LUN_RELATION_SLAVE;
+                        stHMLUNInfoRemote.uiRelationType = LUN_RELATION_MASTER;
+                        stHMLUNInfoRemote.uiSecResAccess = uiLocalAccessState;
+                        stHMLUNInfoLocal.uiSecResAccess = uiLocalAccessState;
+                    }
+                    if ("false" == stHMLUNInfoLocal.strCptype && HM_STATUS_FAULT == stHMLUNInfoLocal.uiHealthStatus){
+                        if (RESOURCE_ACCESS_READ_WRITE == uiLocalAccessState && RESOURCE_ACCESS_NODATA == uiRemoteAccessState){
+                            stHMLUNInfoLocal.uiRelationType = LUN_RELATION_MASTER;
+                            stHMLUNInfoRemote.uiRelationType = LUN_RELATION_SLAVE;     
+                            stHMLUNInfoLocal.uiSecResAccess = RESOURCE_ACCESS_NODATA;
+                            stHMLUNInfoRemote.uiSecResAccess = RESOURCE_ACCESS_NODATA;
+                        }
+                        if (RESOURCE_ACCESS_NOACCESS == uiLocalAccessState && RESOURCE_ACCESS_NODATA == uiRemoteAccessState){
+                            stHMLUNInfoLocal.uiRelationType = LUN_RELATION_SLAVE;
+                            stHMLUNInfoRemote.uiRelationType = LUN_RELATION_MASTER;
+                            stHMLUNInfoLocal.uiSecResAccess = RESOURCE_ACCESS_READ_WRITE;
+                            stHMLUNInfoRemote.uiSecResAccess = RESOURCE_ACCESS_READ_WRITE;
+                        }
+                    }
+                }
+
+                list<HYPERMETRO_LF_INFO_STRU> &rlstHMLUNInfo = rmapHMLUNInfo[hypermetroid];
+                rlstHMLUNInfo.clear();
+                rlstHMLUNInfo.push_back(stHMLUNInfoLocal);
+                rlstHMLUNInfo.push_back(stHMLUNInfoRemote);
+            }
+
+            if (RECOMMEND_RANGE_COUNT == i){
+                rangeIndex += RECOMMEND_RANGE_COUNT;
+            }
+            else{
+                break;
+            }
+        }
+
+        if (flag)
+            return RETURN_OK;
+        else
+            continue;
+    }
+
+    return RETURN_ERR;
+}
+
 /*------------------------------------------------------------
 Function Name: CMD_showhyperMetroDomain_all()
 Description  : Query the information of the hypermetro member LUN.
@@ -3994,46 +4397,195 @@ int CRESTCmd::CMD_showconsistgrinfo(OUT list<GROUP_INFO_STRU> &rlstGroupInfo)
 {
     int iRet = RETURN_OK;
     CRestPackage restPkg;
+    ostringstream tmposs;
  
     TLV_LOGIN_INFO_STRU rstLogInInfo = GetLoginInfo();
 
     for (list<string>::const_iterator iter = rstLogInInfo.lstArrayIP.begin(); 
         iter != rstLogInInfo.lstArrayIP.end(); ++iter){
+        int rangeIndex = 0;
         string strDeviceIP = *iter;
+        bool flag = true;
         CRESTConn *restConn = getConn(strDeviceIP, rstLogInInfo.strArrayUser, rstLogInInfo.strArrayPwd);
+        rlstGroupInfo.clear();
 
-        iRet = restConn->doRequest(RESTURL_CONSISTENTGROUP, REST_REQUEST_MODE_GET, "", restPkg);
-        if (iRet != RETURN_OK){
-            COMMLOG(OS_LOG_ERROR, "ip [%s] url [%s] the iRet is (%d).", iter->c_str(), RESTURL_CONSISTENTGROUP, iRet);
-            continue;
-        }
+        while(true){
+            tmposs.str("");
+            tmposs << RESTURL_CONSISTENTGROUP << "?range=[" << rangeIndex << "-" << (rangeIndex + RECOMMEND_RANGE_COUNT) << "]";
 
-        if (restPkg.errorCode() != RETURN_OK){
-            iRet = restPkg.errorCode();
-            COMMLOG(OS_LOG_ERROR, "ip [%s] url [%s] the iRet is (%d), description %s.", 
-                iter->c_str(), RESTURL_CONSISTENTGROUP, iRet, restPkg.description().c_str());
-            return restPkg.errorCode();
+            iRet = restConn->doRequest(tmposs.str(), REST_REQUEST_MODE_GET, "", restPkg);
+            if (iRet != RETURN_OK){
+                COMMLOG(OS_LOG_ERROR, "ip [%s] url [%s] the iRet is (%d).", iter->c_str(), tmposs.str().c_str(), iRet);
+                flag = false;
+                break;
+            }
+
+            if (restPkg.errorCode() != RETURN_OK){
+                iRet = restPkg.errorCode();
+                COMMLOG(OS_LOG_ERROR, "ip [%s] url [%s] the iRet is (%d), description %s.", 
+                    iter->c_str(), tmposs.str().c_str(), iRet, restPkg.description().c_str());
+                return restPkg.errorCode();
+            }
+
+            size_t i = 0;
+            for (; i < restPkg.count(); ++i){
+                GROUP_INFO_STRU stGroupInfo;
+
+                stGroupInfo.strID = restPkg[i][COMMON_TAG_ID].asString();
+                stGroupInfo.strName = restPkg[i][COMMON_TAG_NAME].asString();
+                stGroupInfo.uiStatus = jsonValue2Type<unsigned int>(restPkg[i][COMMON_TAG_HEALTHSTATUS]);
+                stGroupInfo.uiState = jsonValue2Type<unsigned int>(restPkg[i][COMMON_TAG_RUNNINGSTATUS]);
+                UpdateGroupStatus(stGroupInfo.uiState);
+
+                stGroupInfo.uiModel = jsonValue2Type<unsigned int>(restPkg[i][CONSISTENTGROUP_TAG_REPLICATIONMODEL]);
+                UpdateModel(stGroupInfo.uiModel);
+
+                bool isPrimary = (restPkg[i][CONSISTENTGROUP_TAG_ISPRIMARY].asString().compare("true") == 0);
+                if (isPrimary){
+                    stGroupInfo.uiIsPrimary = MIRROR_LUN_RELATION_MASTER;
+                }
+                else{
+                    stGroupInfo.uiIsPrimary = MIRROR_LUN_RELATION_SLAVE;
+                }
+
+                stGroupInfo.uiSecResAccess = jsonValue2Type<unsigned int>(restPkg[i][CONSISTENTGROUP_TAG_SECRESACCESS]);
+
+                rlstGroupInfo.push_back(stGroupInfo);
+            }
+
+            if (RECOMMEND_RANGE_COUNT == i){
+                rangeIndex += RECOMMEND_RANGE_COUNT;
+            }
+            else{
+                break;
+            }
         }
 
+        if (flag)
+            return RETURN_OK;
+        else
+            continue;
+    }
+
+    return RETURN_ERR;
+}
+
+/*------------------------------------------------------------
+Function Name: CMD_showconsistgrhminfo()
+Description  : Query all hypermetro consistency groups with one paged
+               listing. The groups are filled as by the query of a single
+               group, the hypermetro domain is queried once per domain.
+Data Accessed: None.
+Data Updated : None.
+Input        : 
+Output       : rlstGroupInfo
+Return       : Success or Failure.
+Call         :
+Called by    :
+Called by    :
+Modification :
+Others       :
+-------------------------------------------------------------*/
+int CRESTCmd::CMD_showconsistgrhminfo(OUT list<GROUP_INFO_STRU> &rlstGroupInfo)
+{
+    int iRet = RETURN_OK;
+    CRestPackage restPkg;
+    ostringstream tmposs;
+    map<string, string> mapDomainCptype;
+ 
+    TLV_LOGIN_INFO_STRU rstLogInInfo = GetLoginInfo();
+
+    for (list<string>::const_iterator iter = rstLogInInfo.lstArrayIP.begin(); 
+        iter != rstLogInInfo.lstArrayIP.end(); ++iter){
+        int rangeIndex = 0;
+        string strDeviceIP = *iter;
+        bool flag = true;
+        CRESTConn *restConn = getConn(strDeviceIP, rstLogInInfo.strArrayUser, rstLogInInfo.strArrayPwd);
         rlstGroupInfo.clear();
-        for (size_t i = 0; i < restPkg.count(); ++i){
-            GROUP_INFO_STRU stGroupInfo;
 
-            stGroupInfo.strID = restPkg[i][COMMON_TAG_ID].asString();
-            stGroupInfo.strName = restPkg[i][COMMON_TAG_NAME].asString();
-            stGroupInfo.uiStatus = jsonValue2Type<unsigned int>(restPkg[i][COMMON_TAG_HEALTHSTATUS]);
-            stGroupInfo.uiState = jsonValue2Type<unsigned int>(restPkg[i][COMMON_TAG_RUNNINGSTATUS]);
-            UpdateGroupStatus(stGroupInfo.uiState);
+        while(true){
+            tmposs.str("");
+            tmposs << RESTURL_HYPERMETRO_CONSISTENTGROUP << "?range=[" << rangeIndex << "-" << (rangeIndex + RECOMMEND_RANGE_COUNT) << "]";
+
+            iRet = restConn->doRequest(tmposs.str(), REST_REQUEST_MODE_GET, "", restPkg);
+            if (iRet != RETURN_OK){
+                COMMLOG(OS_LOG_ERROR, "ip [%s] url [%s] the iRet is (%d).", iter->c_str(), tmposs.str().c_str(), iRet);
+                flag = false;
+                break;
+            }
+
+            if (restPkg.errorCode() != RETURN_OK){
+                iRet = restPkg.errorCode();
+                COMMLOG(OS_LOG_ERROR, "ip [%s] url [%s] the iRet is (%d), description %s.", 
+                    iter->c_str(), tmposs.str().c_str(), iRet, restPkg.description().c_str());
+                return restPkg.errorCode();
+            }
+
+            size_t i = 0;
+            for (; i < restPkg.count(); ++i){
+                GROUP_INFO_STRU stGroupInfo;
+
+                stGroupInfo.strID = restPkg[i][COMMON_TAG_ID].asString();
+                stGroupInfo.strName = restPkg[i][COMMON_TAG_NAME].asString();
+                stGroupInfo.uiStatus = jsonValue2Type<unsigned int>(restPkg[i][COMMON_TAG_HEALTHSTATUS]);
+                stGroupInfo.uiState = jsonValue2Type<unsigned int>(restPkg[i][COMMON_TAG_RUNNINGSTATUS]);
+                stGroupInfo.hmdomain = restPkg[i][HYPERMETROPAIR_TAG_DOMAINID].asString();
+                stGroupInfo.uiModel = jsonValue2Type<unsigned int>(restPkg[i][HYPERMETRO_CONSISTENTGROUP_TAG_MODEL]);
+                stGroupInfo.uiSyncDirection = jsonValue2Type<unsigned int>(restPkg[i][HYPERMETRO_CONSISTENTGROUP_TAG_SYNCDIRECTION]);
+                stGroupInfo.uiSecResAccess = RESOURCE_ACCESS_NOACCESS;
+
+                if (HM_SLAVE_PAIR_STATUS_CHAR_NORMAL == stGroupInfo.uiState){
+                    stGroupInfo.uiSecResAccess = RESOURCE_ACCESS_READ_WRITE;
+                }
+
+                UpdateModel(stGroupInfo.uiModel);
 
-            stGroupInfo.uiModel = jsonValue2Type<unsigned int>(restPkg[i][CONSISTENTGROUP_TAG_REPLICATIONMODEL]);
-            UpdateModel(stGroupInfo.uiModel);
+                bool priorityStationType = (restPkg[i][CONSISTENTGROUP_TAG_PRIORITYSTATIONTYPE].asString().compare("1") == 0);
+                if (priorityStationType){
+                    stGroupInfo.uiIsPrimary = HM_GROUP_RELATION_SLAVE;
+                }
+                else{
+                    stGroupInfo.uiIsPrimary = HM_GROUP_RELATION_MASTER;
+                }
 
-            stGroupInfo.uiIsPrimary = jsonValue2Type<unsigned int>(restPkg[i][CONSISTENTGROUP_TAG_ISPRIMARY]);  //trueΪ1falseΪ0
-            stGroupInfo.uiSecResAccess = jsonValue2Type<unsigned int>(restPkg[i][CONSISTENTGROUP_TAG_SECRESACCESS]);
+                if (mapDomainCptype.end() == mapDomainCptype.find(stGroupInfo.hmdomain)){
+                    HYPERMETRODOMAIN_LF_INFO_STRU stHMDomainInfoLocal;
+                    if (RETURN_OK == CMD_showhyperMetroDomain_all(stGroupInfo.hmdomain, stHMDomainInfoLocal)){
+                        mapDomainCptype[stGroupInfo.hmdomain] = stHMDomainInfoLocal.strCptype;
+                    }
+                    else{
+                        mapDomainCptype[stGroupInfo.hmdomain] = "";
+                    }
+                }
+                stGroupInfo.strCptype = mapDomainCptype[stGroupInfo.hmdomain];
+
+                if ("false" == stGroupInfo.strCptype && HM_STATUS_FAULT == stGroupInfo.uiStatus){
+                    if (HM_CONSISGROUP_DATA_FROM_LOCAL_TO_REMOTE == stGroupInfo.uiSyncDirection){
+                        stGroupInfo.uiIsPrimary = HM_GROUP_RELATION_MASTER;
+                    }
+                    if (HM_CONSISGROUP_DATA_FROM_REMOTE_TO_LOCAL == stGroupInfo.uiSyncDirection){
+                        stGroupInfo.uiIsPrimary = HM_GROUP_RELATION_SLAVE;
+                    }
+                    stGroupInfo.uiSecResAccess = RESOURCE_ACCESS_NOACCESS;
+                }
+
+                rlstGroupInfo.push_back(stGroupInfo);
+            }
 
-            rlstGroupInfo.push_back(stGroupInfo);
+            if (RECOMMEND_RANGE_COUNT == i){
+                rangeIndex += RECOMMEND_RANGE_COUNT;
+            }
+            else{
+                break;
+            }
         }
+
+        if (flag)
+            return RETURN_OK;
+        else
+            continue;
     }
+
     return RETURN_ERR;
 }
 
@@ -5962,6 +6514,89 @@ int CRESTCmd::CMD_showhostlink(IN string initatorWwn,IN unsigned int nFlag,OUT l
     return RETURN_ERR;
 }
 
+/*------------------------------------------------------------
+Function Name: CMD_showhostlink_all()
+Description  : Query the host links of all initiators of one type.
+Data Accessed: None.
+Data Updated : None.
+Input        : nFlag, 0 for iSCSI, otherwise FC.
+Output       : rlstHostLinkInfo
+Return       : Success or Failure.
+Call         :
+Called by    :
+Called by    :
+Modification :
+Others       :
+-------------------------------------------------------------*/
+int CRESTCmd::CMD_showhostlink_all(IN unsigned int nFlag,OUT list<HOST_LINK_INFO> &rlstHostLinkInfo)
+{
+    int iRet = RETURN_OK;
+    CRestPackage restPkg;
+    ostringstream oss;
+    ostringstream tmposs;
+
+    TLV_LOGIN_INFO_STRU rstLogInInfo = GetLoginInfo();
+    oss.str("");
+
+    oss <<RESTURL_HOST_LINK <<"?" <<COMMON_TAG_TYPE <<"=" <<(int)OBJ_HOST_LINK
+        <<"&" <<HOSTLINK_INITIATOR_TYPE <<"=" <<((nFlag == 0) ? (int)OBJ_ISCSI_INITIATOR : (int)OBJ_FC_INITIATOR);
+
+    for (list<string>::const_iterator iter = rstLogInInfo.lstArrayIP.begin(); 
+        iter != rstLogInInfo.lstArrayIP.end(); ++iter){
+        int rangeIndex = 0;
+        string strDeviceIP = *iter;
+        bool flag = true;
+        CRESTConn *restConn = getConn(strDeviceIP, rstLogInInfo.strArrayUser, rstLogInInfo.strArrayPwd);
+
+        rlstHostLinkInfo.clear();
+
+        while(true){
+            tmposs.str("");
+            tmposs << oss.str() << "&range=[" << rangeIndex << "-" << (rangeIndex + RECOMMEND_RANGE_COUNT) << "]";
+
+            iRet = restConn->doRequest(tmposs.str(), REST_REQUEST_MODE_GET, "", restPkg);
+            if (iRet != RETURN_OK){
+                COMMLOG(OS_LOG_ERROR, "ip [%s] url [%s] the iRet is (%d).", iter->c_str(), tmposs.str().c_str(), iRet);
+                flag = false;
+                break;
+            }
+
+            if (restPkg.errorCode() != RETURN_OK){
+                iRet = restPkg.errorCode();
+                COMMLOG(OS_LOG_ERROR, "ip [%s] url [%s] the iRet is (%d), description %s.", 
+                    iter->c_str(), tmposs.str().c_str(), iRet, restPkg.description().c_str());
+                return restPkg.errorCode();
+            }
+
+            size_t i = 0;
+            for (; i < restPkg.count(); ++i){
+                HOST_LINK_INFO stHostLink;
+
+                stHostLink.initiator_id = restPkg[i][HOSTLINK_INITIATOR_ID].asString();
+                stHostLink.initiator_port_wwn = restPkg[i][HOSTLINK_INITIATOR_PORT_WWN].asString();
+                stHostLink.target_id = restPkg[i][HOSTLINK_TARGET_ID].asString();
+                stHostLink.target_port_wwn = restPkg[i][HOSTLINK_TARGET_PORT_WWN].asString();
+
+                rlstHostLinkInfo.push_back(stHostLink);
+            }
+
+            if (RECOMMEND_RANGE_COUNT == i){
+                rangeIndex += RECOMMEND_RANGE_COUNT;
+            }
+            else{
+                break;
+            }
+        }
+
+        if (flag)
+            return RETURN_OK;
+        else
+            continue;
+    }
+
+    return RETURN_ERR;
+}
+
 /*------------------------------------------------------------
 Function Name: CMD_showLunGroupByMap()
 Description  : Query the corresponding LUN group through the mapping view. The mapping view and LUN group and host group are one-to-one.
@@ -7935,8 +8570,8 @@ Function Name: CMD_showarrayclonefs()
 Description  : Query whether the array supports the clone file system
 Data Accessed: None.
 Data Updated : None.
-Input        : None.
-Output       : g_bnfs.
+Input        : rbNfs:whether config.txt supports nfs.
+Output       : rbNfs:whether nfs is supported.
 Return       : Success or Failure.
 Call         :
 Called by    :
@@ -7944,7 +8579,7 @@ Called by    :
 Modification :
 Others       :
 -------------------------------------------------------------*/
-int CRESTCmd::CMD_showarrayclonefs()
+int CRESTCmd::CMD_showarrayclonefs(bool &rbNfs)
 {
     int iRet = RETURN_OK;
     CRestPackage restPkg;
@@ -7986,19 +8621,19 @@ int CRESTCmd::CMD_showarrayclonefs()
     }
 
     if (nfsFlag == true){
-        if (g_bnfs == true){
-            g_bnfs = true;
+        if (rbNfs == true){
+            rbNfs = true;
             COMMLOG(OS_LOG_INFO, "Check array is support nfs, "
                 "and config.txt is also support nfs.");
         }
         else{
-            g_bnfs = false;
+            rbNfs = false;
             COMMLOG(OS_LOG_INFO, "Check array is support nfs, "
                 "but config.txt is not support nfs. so not support nfs");
         }
     }
     else{
-        if (g_bnfs == true){
+        if (rbNfs == true){
             COMMLOG(OS_LOG_WARN, "Check array is not support nfs, "
                 "but config.txt is support nfs. so not support nfs.");
         }
@@ -8006,7 +8641,7 @@ int CRESTCmd::CMD_showarrayclonefs()
             COMMLOG(OS_LOG_WARN, "Check array is not support nfs, "
                 "and config.txt is also not support nfs.");
         }
-        g_bnfs = false;
+        rbNfs = false;
     }
 
     return RETURN_OK;
@@ -8155,6 +8790,99 @@ int CRESTCmd::CMD_showInitiatorInfo(const string &initiatorID, const string& typ
     return RETURN_ERR;
 }
 
+/*------------------------------------------------------------
+Function Name: CMD_showInitiatorInfo_all()
+Description  : Show all FC or iSCSI initiators on array with one paged
+               listing. The id of a FC initiator is its WWN without
+               separators, as used by CMD_showInitiatorInfo.
+Data Accessed: None.
+Data Updated : None.
+Input        : type : FC or iSCSI.
+Output       : lstInitiatorInfo.
+Return       : success or fail.
+Call         :
+Called by    :
+Called by    :
+Modification :
+Others       :
+-------------------------------------------------------------*/
+int CRESTCmd::CMD_showInitiatorInfo_all(const string& type, list<INITIATOR_INFO>& lstInitiatorInfo)
+{
+    int iRet = RETURN_OK;
+    CRestPackage restPkg;
+    ostringstream tmposs;
+    string strURL;
+
+    if (type.compare("FC") == 0){
+        strURL = RESTURL_FC_INITIATOR;
+    }
+    else if (type.compare("iSCSI") == 0){
+        strURL = RESTURL_ISCSI_INITIATOR;
+    }
+    else{
+        COMMLOG(OS_LOG_ERROR, "Unknown initiator type:[%s].", type.c_str());
+        return RETURN_ERR;
+    }
+
+    TLV_LOGIN_INFO_STRU rstLogInInfo = GetLoginInfo();
+    for (list<string>::const_iterator iter = rstLogInInfo.lstArrayIP.begin(); 
+        iter != rstLogInInfo.lstArrayIP.end(); ++iter){
+        int rangeIndex = 0;
+        string strDeviceIP = *iter;
+        bool flag = true;
+        CRESTConn *restConn = getConn(strDeviceIP, rstLogInInfo.strArrayUser, rstLogInInfo.strArrayPwd);
+        lstInitiatorInfo.clear();
+
+        while(true){
+            tmposs.str("");
+            tmposs << strURL << "?range=[" << rangeIndex << "-" << (rangeIndex + RECOMMEND_RANGE_COUNT) << "]";
+
+            iRet = restConn->doRequest(tmposs.str(), REST_REQUEST_MODE_GET, "", restPkg);
+            if (iRet != RETURN_OK){
+                COMMLOG(OS_LOG_ERROR, "ip [%s] url [%s] the iRet is (%d).", iter->c_str(), tmposs.str().c_str(), iRet);
+                flag = false;
+                break;
+            }
+
+            if (restPkg.errorCode() != RETURN_OK){
+                iRet = restPkg.errorCode();
+                COMMLOG(OS_LOG_ERROR, "ip [%s] url [%s] the iRet is (%d), description %s.", 
+                    iter->c_str(), tmposs.str().c_str(), iRet, restPkg.description().c_str());
+                return iRet;
+            }
+
+            size_t i = 0;
+            for (; i < restPkg.count(); ++i){
+                INITIATOR_INFO initiatorInfo;
+
+                initiatorInfo.strID = restPkg[i][COMMON_TAG_ID].asString();
+                initiatorInfo.isFree = restPkg[i][INITIATOR_ISFREE].asString().compare("true") == 0 ? true : false;
+                if (restPkg[i].isMember(COMMON_TAG_PARENTID)){
+                    initiatorInfo.strHostID = restPkg[i][COMMON_TAG_PARENTID].asString();
+                }
+                initiatorInfo.uiType = jsonValue2Type<unsigned int>(restPkg[i][COMMON_TAG_TYPE]);
+                initiatorInfo.uiStatus = jsonValue2Type<unsigned int>(restPkg[i][COMMON_TAG_RUNNINGSTATUS]);
+
+                lstInitiatorInfo.push_back(initiatorInfo);
+            }
+
+            if (RECOMMEND_RANGE_COUNT == i){
+                rangeIndex += RECOMMEND_RANGE_COUNT;
+            }
+            else{
+                break;
+            }
+        }
+
+        if (flag)
+            return RETURN_OK;
+        else
+            continue;
+    }
+
+    return RETURN_ERR;
+}
+
 /*------------------------------------------------------------
 Function Name: CMD_addInitiatorToHost()
 Description  : Add Initiator to Host.
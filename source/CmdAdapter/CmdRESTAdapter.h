@@ -400,6 +400,7 @@ public:
     virtual int CMD_showconsistgrinfo(OUT list<GROUP_INFO_STRU> &rlstGroupInfo);
     virtual int CMD_showlunsbyconsisid(const string& consis_id,vector<string>& local_lun_ids);
     virtual int CMD_showconsistgrhminfo(IN OUT GROUP_INFO_STRU &rstGroupInfo);
+    virtual int CMD_showconsistgrhminfo(OUT list<GROUP_INFO_STRU> &rlstGroupInfo);
     virtual int CMD_syncconsistgr(IN string strGroupID);
     virtual int CMD_syncvstorepair(IN const string& strGroupID);
     virtual int CMD_syncconsistgrhm(IN string strGroupID);
@@ -447,7 +448,7 @@ public:
     virtual int CMD_showFShyimginfo(IN OUT HYIMAGE_INFO_STRU &rstHyImageInfo);
     virtual int CMD_showhyimgoffs(IN string &strFSID, OUT list<HYIMAGE_INFO_STRU> &rlstHyImageInfo);
     virtual int CMD_showLIF(OUT list<LIF_INFO_STRU> &rlstLifInfo);
-    virtual int CMD_showarrayclonefs();
+    virtual int CMD_showarrayclonefs(bool &rbNfs);
 
     // remote replication
     virtual int CMD_synchymirror(IN string &strMirrorID, IN string &strSlaveArraySN, IN string &strSlaveLUNID);
@@ -464,6 +465,8 @@ public:
     virtual int CMD_showhymirrorlun(IN OUT HYMIRROR_LF_INFO_STRU &rstHyMirrorLUNInfo);
     virtual int CMD_showhymirrorlun_all(IN string &strMirrorID, OUT list<HYMIRROR_LF_INFO_STRU> &rlstHyMirrorLUNInfo);
     virtual int CMD_showhypermetrolun_all(IN string &hypermetroid, OUT list<HYPERMETRO_LF_INFO_STRU> &rlstHMLUNInfo);
+    virtual int CMD_showhymirrorlun_all(OUT map<string, list<HYMIRROR_LF_INFO_STRU> > &rmapHyMirrorLUNInfo);
+    virtual int CMD_showhypermetrolun_all(OUT map<string, list<HYPERMETRO_LF_INFO_STRU> > &rmapHMLUNInfo);
     virtual int CMD_showhymirrorfs_all(IN string &rstrMirrorID, OUT list<HYMIRROR_LF_INFO_STRU> &rlstHyMirrorFSInfo);
     virtual int CMD_showhymirrorbyfs(IN string &strID, OUT list<HYMIRROR_LF_INFO_STRU> &rlstHyMirrorFSInfo,IN bool bismirrorID = false);
     virtual int CMD_changeSlaveLunRw(string &strHyMirrorID, enum RESOURCE_ACCESS_E accessMode);
@@ -471,13 +474,14 @@ public:
 
     // system
     virtual int CMD_showarrayinfo(list<REMOTE_ARRAY_STRU>& rlstRemoteArrayInfo);
-    virtual int CMD_showarraystretched(list<REMOTE_ARRAY_STRU>& rlstRemoteArrayInfo);
+    virtual int CMD_showarraystretched(list<REMOTE_ARRAY_STRU>& rlstRemoteArrayInfo, bool &rbStretch);
     virtual int CMD_showhost(OUT list<CMDHOSTINFO_STRU> &rlstHostInfo);
     virtual int CMD_showhost(OUT CMDHOSTINFO_STRU &rHostInfo);
     virtual int CMD_showsys(OUT SYSTEM_INFO_STRU &rstSysInfo);
     virtual int CMD_showhostport(IN string strHostID, OUT list<HOST_PORT_INFO_STRU> &rlstHostPortInfo);
     virtual int CMD_showarraymodelinfo(IN OUT HYPER_STORAGE_STRU &rstStorageInfo);    
     virtual int CMD_showhostlink(IN string initatorWwn, IN unsigned int nFlag, OUT list<HOST_LINK_INFO> &rlstHostLinkInfo);
+    virtual int CMD_showhostlink_all(IN unsigned int nFlag, OUT list<HOST_LINK_INFO> &rlstHostLinkInfo);
    
     virtual int InitConnectInfo(const string& strSN);
     virtual int ConfigConnectInfo(const string& strSN, const string& strIP, const string& strUser, const string& strPwd);
@@ -494,6 +498,7 @@ public:
 
     //add to support DAR
     virtual int CMD_showInitiatorInfo(const string &initiatorID, const string& type, INITIATOR_INFO& initiatorInfo);
+    virtual int CMD_showInitiatorInfo_all(const string& type, list<INITIATOR_INFO>& lstInitiatorInfo);
     virtual int CMD_removeHostFromHostGroup(const string& hostID, const string& groupID);
     virtual int CMD_createHost(const string& hostName, CMDHOSTINFO_STRU& hostInfo);
     virtual int CMD_addInitiatorToHost(const string &initiatorID, const string &type, const string &strHostID);
@@ -2677,7 +2677,7 @@ Called by    :
 Modification :
 Others       :FusionStorage8.0 does not provide this interface for the time being. The default is to support hyperMetro
 -------------------------------------------------------------*/
-int CRESTFusionStorage::CMD_showarraystretched(list<REMOTE_ARRAY_STRU>& rlstRemoteArrayStrecthed)
+int CRESTFusionStorage::CMD_showarraystretched(list<REMOTE_ARRAY_STRU>& rlstRemoteArrayStrecthed, bool &rbStretch)
 {
     REMOTE_ARRAY_STRU peer;
     peer.strStretched = "true";
@@ -16,15 +16,84 @@
 #include <sstream>
 #include <algorithm> 
 #include <json/reader.h>
+#include <ace/Thread_Mutex.h>
+#include <ace/Guard_T.h>
 
 #include "RESTConn.h"
 #include "Log.h"
 #include "Commf.h"
 #include "common.h"
 #include "curl/curl.h"
+#include <openssl/crypto.h>
+#include <ace/Thread.h>
 
 #define SSL_ERROR_RETRY_NUM 10
 
+// curl_global_init/curl_global_cleanup are not thread safe, serialize them for concurrent sessions
+static ACE_Thread_Mutex g_curlGlobalMutex;
+
+#if OPENSSL_VERSION_NUMBER < 0x10100000L
+// OpenSSL before 1.1.0 is only thread safe once the application installs the locking callbacks
+static ACE_Thread_Mutex *g_sslLocks = NULL;
+
+static void sslLockingCallback(int mode, int type, const char *file, int line)
+{
+    (void)file;
+    (void)line;
+
+    if (mode & CRYPTO_LOCK){
+        (void)g_sslLocks[type].acquire();
+    }
+    else{
+        (void)g_sslLocks[type].release();
+    }
+}
+
+static void sslThreadId(CRYPTO_THREADID *id)
+{
+    CRYPTO_THREADID_set_numeric(id, (unsigned long)ACE_Thread::self());
+}
+
+// called under g_curlGlobalMutex, the callbacks stay installed for the life of the process
+static void sslLocksInit()
+{
+    // TLV connections through ACE_SSL may have installed their own already
+    if (NULL != g_sslLocks || NULL != CRYPTO_get_locking_callback()){
+        return;
+    }
+
+    g_sslLocks = new ACE_Thread_Mutex[CRYPTO_num_locks()];
+    (void)CRYPTO_THREADID_set_callback(sslThreadId);
+    CRYPTO_set_locking_callback(sslLockingCallback);
+}
+#else
+static void sslLocksInit()
+{
+}
+#endif
+
+static CURLcode curlGlobalInit()
+{
+    ACE_Guard<ACE_Thread_Mutex> oGuard(g_curlGlobalMutex);
+    sslLocksInit();
+    return curl_global_init(CURL_GLOBAL_DEFAULT);
+}
+
+static void curlGlobalCleanup()
+{
+    ACE_Guard<ACE_Thread_Mutex> oGuard(g_curlGlobalMutex);
+    curl_global_cleanup();
+}
+
+static ACE_Thread_Mutex g_requestCountMutex;
+static unsigned long g_ulRequestCount = 0;
+
+unsigned long CRESTConn::getRequestCount()
+{
+    ACE_Guard<ACE_Thread_Mutex> oGuard(g_requestCountMutex);
+    return g_ulRequestCount;
+}
+
 /* callback function
    This callback function is called by libcurl as soon as there is data received that needs to be saved. 
    ptr points to the delivered data, and the size of that data is size multiplied with nmemb.
@@ -563,8 +632,12 @@ int CRESTConn::doRequestInner(string strUrl, REST_REQUEST_MODE requstMode, strin
     //COMMLOG(OS_LOG_DEBUG, "doRequest url [%s] ip=%s", strUrl.c_str(), m_strDeviceIPPort.c_str());
     CURL *hCurl;
     CURLcode Lcode;
+    {
+        ACE_Guard<ACE_Thread_Mutex> oGuard(g_requestCountMutex);
+        g_ulRequestCount++;
+    }
     // init curl context
-    Lcode = curl_global_init(CURL_GLOBAL_DEFAULT);
+    Lcode = curlGlobalInit();
     if(CURLE_OK != Lcode){
         COMMLOG(OS_LOG_ERROR,"init curl error [%d]",Lcode);
     }
@@ -592,6 +665,8 @@ int CRESTConn::doRequestInner(string strUrl, REST_REQUEST_MODE requstMode, strin
     else{
         COMMLOG(OS_LOG_DEBUG, "doRequest url [%s],request mode[%d] ", streamTmp.str().c_str(),requstMode);
     }
+    // no SIGALRM based timeouts, several sessions may run on worker threads
+    curl_easy_setopt(hCurl, CURLOPT_NOSIGNAL, 1L);
     curl_easy_setopt(hCurl, CURLOPT_SSLVERSION, CURL_SSLVERSION_TLSv1_2);
     curl_easy_setopt(hCurl, CURLOPT_SSL_VERIFYPEER, 0L);
     curl_easy_setopt(hCurl, CURLOPT_SSL_VERIFYHOST, 0L);
@@ -671,7 +746,7 @@ int CRESTConn::doRequestInner(string strUrl, REST_REQUEST_MODE requstMode, strin
 
         curl_slist_free_all(headers);
         curl_easy_cleanup(hCurl);
-        curl_global_cleanup();
+        curlGlobalCleanup();
         m_strResponse.clear();
         bHaveRecvData = false;
         return res;
@@ -689,7 +764,7 @@ int CRESTConn::doRequestInner(string strUrl, REST_REQUEST_MODE requstMode, strin
 
     curl_slist_free_all(headers);
     curl_easy_cleanup(hCurl);
-    curl_global_cleanup();
+    curlGlobalCleanup();
     m_strResponse.clear();
     bHaveRecvData = false;
 
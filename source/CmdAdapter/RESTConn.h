@@ -63,6 +63,9 @@ public:
     string getPutBodyData() { return m_strPutBodyData; }
     string getVstoreID() { return vstoreID; }
 
+    // number of requests sent by all connections of this process
+    static unsigned long getRequestCount();
+
 private:
     int doRequestInner(string strUrl, REST_REQUEST_MODE requstMode, string strBodyData, 
         CRestPackage &pkgResponse,  vector<string> &vecHeaders, bool isRecvHeader = false);
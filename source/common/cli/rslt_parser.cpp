@@ -44,9 +44,8 @@ Others       :
 CRsltXmlParser::CRsltXmlParser()
 {
     m_iStatus = 0;
-    m_iSrcPos = -1;
-    m_iDstPos = -1;
-    m_plstDstValue = NULL;
+    m_bIndexed = false;
+    m_bHasRecordName = false;
 }
 
 /*------------------------------------------------------------
@@ -66,9 +65,8 @@ Others       :
 CRsltXmlParser::CRsltXmlParser(const char *pszRstlFilePath)
 {
     m_iStatus = 0;
-    m_iSrcPos = -1;
-    m_iDstPos = -1;
-    m_plstDstValue = NULL;
+    m_bIndexed = false;
+    m_bHasRecordName = false;
 
     m_strRstlFilePath = string(pszRstlFilePath);
 }
@@ -89,7 +87,6 @@ Others       :
 ------------------------------------------------------------*/
 CRsltXmlParser::~CRsltXmlParser()
 {
-    m_plstDstValue = NULL;
 }
 
 /*------------------------------------------------------------
@@ -132,6 +129,7 @@ int CRsltXmlParser::SetRstlFilePath(const char *pszRstlFilePath)
     }
 
     m_strRstlFilePath = string(pszRstlFilePath);
+    m_bIndexed = false;
     return RETURN_OK;
 }
 
@@ -154,7 +152,9 @@ int CRsltXmlParser::GetValues(const string &rstrSrcName,
                                      const string &rstrDstName, 
                                      list<string> *plstDstValue)
                                      {
-    int iNum = 0;
+    map<string, size_t>::iterator itSrc;
+    map<string, size_t>::iterator itDst;
+    vector<vector<string> >::iterator itRecord;
 
     if (NULL == plstDstValue){
         return RETURN_ERR;
@@ -162,30 +162,34 @@ int CRsltXmlParser::GetValues(const string &rstrSrcName,
 
     plstDstValue->clear();
 
-    m_strSrcName   = rstrSrcName;
-    m_strSrcValue  = rstrSrcValue;
-    m_strDstName   = rstrDstName;
-    m_plstDstValue = plstDstValue;
-
     m_iStatus = 0;
-    m_iSrcPos = -1;
-    m_iDstPos = -1;
 
     if (RETURN_ERR == _GetStatus()){
         return RETURN_ERR;
     }
 
-    iNum = m_objXmlReader.get_count("/Result/RecordName");
-    if (0 == iNum){
+    if (!m_bHasRecordName){
         return RETURN_OK;
     }
 
-    if (_ParseRecordName() != RETURN_OK){
-        return RETURN_ERR;
+    CONDITION_TRUE_RTN_FAIL(rstrDstName.empty());
+
+    itDst = m_mapFieldPos.find(rstrDstName);
+    CONDITION_TRUE_RTN_FAIL(m_mapFieldPos.end() == itDst);
+
+    if (!rstrSrcName.empty()){
+        itSrc = m_mapFieldPos.find(rstrSrcName);
+        CONDITION_TRUE_RTN_FAIL(m_mapFieldPos.end() == itSrc);
     }
 
-    if (_ParseRecordValue() != RETURN_OK){
-        return RETURN_ERR;
+    CONDITION_TRUE_RTN_FAIL(m_vecRecords.empty());
+
+    for (itRecord = m_vecRecords.begin(); itRecord != m_vecRecords.end(); ++itRecord){
+        if (!rstrSrcName.empty() && _GetField(*itRecord, itSrc->second) != rstrSrcValue){
+            continue;
+        }
+
+        plstDstValue->push_back(_GetField(*itRecord, itDst->second));
     }
 
     return RETURN_OK;
@@ -240,6 +244,10 @@ Others       :
 ------------------------------------------------------------*/
 int CRsltXmlParser::_InitRstlFile()
 {
+    if (m_bIndexed){
+        return RETURN_OK;
+    }
+
     if (!OS_FileExists((char *)m_strRstlFilePath.c_str())){
         return RETURN_ERR;
     }
@@ -248,6 +256,12 @@ int CRsltXmlParser::_InitRstlFile()
         return RETURN_ERR;
     }
 
+    if (_BuildIndex() != RETURN_OK){
+        return RETURN_ERR;
+    }
+
+    m_bIndexed = true;
+
     return RETURN_OK;
 }
 
@@ -279,7 +293,7 @@ int CRsltXmlParser::_GetStatus()
     }
 
     if (0 != m_iStatus){
-        if (0 ==  m_objXmlReader.get_string("/Result/Desc", acErrorDesc, 0)){
+        if (0 ==  m_objXmlReader.get_cstring("/Result/Desc", acErrorDesc)){
             return RETURN_ERR;
         }
 
@@ -325,7 +339,7 @@ int CRsltXmlParser::GetDescription(string& desc)
         return RETURN_ERR;
     }
 
-    if (!m_objXmlReader.get_string("/Result/Desc", ac_desc, 0)){
+    if (!m_objXmlReader.get_cstring("/Result/Desc", ac_desc)){
         return RETURN_ERR;
     }
 
@@ -335,151 +349,157 @@ int CRsltXmlParser::GetDescription(string& desc)
 };
 
 /*------------------------------------------------------------
-Method       : int CRsltXmlParser::_ParseRecordName()
-Description  : Parse "/Result/RecordName" in tempary XML result file.
+Method       : int CRsltXmlParser::GetRecordCount()
+Description  : Get the number of records in tempary XML result file.
 Data Accessed: None.
 Data Updated : None.
 Input        : None.
 Output       : None.
-Return       : None.
+Return       : 1)the number of records
+               2)RETURN_ERR
 Call         :
 Called by    :
 Create By    :
 Modification :
 Others       :
 ------------------------------------------------------------*/
-int CRsltXmlParser::_ParseRecordName()
+int CRsltXmlParser::GetRecordCount()
 {
-    char acTmpRecordName[MAX_TMP_BUFFER];
-    int iTmpSrcPos = 0;
-    int iTmpDstPos = 0;
-    int iTmpPos = -1;
-    char cSepChr = ',';
-    char acTmpStr[MAX_TMP_BUFFER];
-
-    memset_s(acTmpRecordName, sizeof(acTmpRecordName), 0, sizeof(acTmpRecordName));
-    memset_s(acTmpStr, sizeof(acTmpStr), 0, sizeof(acTmpStr));
-
-    CONDITION_TRUE_RTN_FAIL(!m_objXmlReader.get_string("/Result/RecordName", acTmpRecordName, 0));
-
-    for (int i = 0; i < (int)strlen(acTmpRecordName); i++){
-        if (acTmpRecordName[i] == cSepChr){
-            strncpy_s(acTmpStr, MAX_TMP_BUFFER, (acTmpRecordName + 1) + iTmpPos , (unsigned int)(i - iTmpPos));
-            acTmpStr[(unsigned int)(i - iTmpPos) - 1] = '\0';
-            iTmpPos = i;
-
-            iTmpSrcPos++;
-            iTmpDstPos++;
-        }
-        else if ('\0' == acTmpRecordName[(unsigned int)(i + 1)]){
-            strncpy_s(acTmpStr, MAX_TMP_BUFFER, (acTmpRecordName + 1) + iTmpPos , (unsigned int)((i - iTmpPos) + 1));
-            iTmpSrcPos++;
-            iTmpDstPos++;
-        }
-        else{
-            continue;
-        }
+    if (_InitRstlFile() != RETURN_OK){
+        return RETURN_ERR;
+    }
 
-        if (m_strSrcName.size() != 0){
-            if (!strcmp(acTmpStr, m_strSrcName.c_str())){
-                m_iSrcPos = iTmpSrcPos;
-            }
-        }
+    return (int)m_vecRecords.size();
+}
 
-        if (m_strDstName.size() != 0){
-            if (!strcmp(acTmpStr, m_strDstName.c_str())){
-                m_iDstPos = iTmpDstPos;
-            }
-        }
-        else{
-            return RETURN_ERR;
-        }
+/*------------------------------------------------------------
+Method       : int CRsltXmlParser::GetValue()
+Description  : Get one field of one record from the index, without
+               scanning the other records.
+Data Accessed: None.
+Data Updated : None.
+Input        : uiRecord: record number, from 0
+               rstrName: field name in RecordName
+Output       : rstrValue: field value, empty when the record is short
+Return       : 1)RETURN_OK
+               2)RETURN_ERR
+Call         :
+Called by    :
+Create By    :
+Modification :
+Others       :
+------------------------------------------------------------*/
+int CRsltXmlParser::GetValue(size_t uiRecord, const string &rstrName, string &rstrValue)
+{
+    map<string, size_t>::iterator itField;
+
+    if (_InitRstlFile() != RETURN_OK){
+        return RETURN_ERR;
     }
 
-    CONDITION_TRUE_RTN_FAIL((-1 == m_iSrcPos) && (m_strSrcName.size() != 0));
+    CONDITION_TRUE_RTN_FAIL(uiRecord >= m_vecRecords.size());
+
+    itField = m_mapFieldPos.find(rstrName);
+    CONDITION_TRUE_RTN_FAIL(m_mapFieldPos.end() == itField);
 
-    CONDITION_TRUE_RTN_FAIL(-1 == m_iDstPos);
+    rstrValue = _GetField(m_vecRecords[uiRecord], itField->second);
 
     return RETURN_OK;
 }
 
 /*------------------------------------------------------------
-Method       : int CRsltXmlParser::_ParseRecordValue()
-Description  : Parse "/Result/RecordValue/Value" in tempary XML
-               result file and storage in 'm_plstDstValue'.
+Method       : int CRsltXmlParser::_BuildIndex()
+Description  : Split "/Result/RecordName" and every
+               "/Result/RecordValue/Value" of tempary XML result file
+               once, so a field is found by its position instead of
+               parsing the file again for every request.
 Data Accessed: None.
-Data Updated : None.
+Data Updated : m_mapFieldPos, m_vecRecords.
 Input        : None.
 Output       : None.
-Return       : None.
+Return       : 1)RETURN_OK
+               2)RETURN_ERR
 Call         :
 Called by    :
 Create By    :
 Modification :
 Others       :
 ------------------------------------------------------------*/
-int CRsltXmlParser::_ParseRecordValue()
+int CRsltXmlParser::_BuildIndex()
 {
+    XmlText text;
+    XmlCursor objValue;
+    vector<string> vecNames;
     char acTmpRecordValue[MAX_TMP_BUFFER] = {0};
-    int iNum = 0;
-    char cSepChr = ',';
+    wchar_t wt_buf[MAX_TMP_BUFFER * 2] = {0};
+
+    m_mapFieldPos.clear();
+    m_vecRecords.clear();
 
-    CONDITION_TRUE_RTN_FAIL(0 == (iNum = m_objXmlReader.get_count("/Result/RecordValue/Value")));
+    m_bHasRecordName = (0 != m_objXmlReader.get_count("/Result/RecordName"));
+    if (!m_bHasRecordName){
+        return RETURN_OK;
+    }
 
-    for (int i = 0; i < iNum; i++){
-        string strTmpSrcValue = "";
-        string strTmpDstValue = "";
-        int iTmpSrcPos = 0;
-        int iTmpDstPos = 0;
-        int iTmpPos = -1;
+    CONDITION_TRUE_RTN_FAIL(!m_objXmlReader.get_text("/Result/RecordName", text, MAX_TMP_BUFFER - 1));
 
-        char acTmpStr[MAX_TMP_BUFFER] = {0};
-        wchar_t wt_buf[MAX_TMP_BUFFER * 2] = {0};
+    _SplitRecord(text.c_str(), vecNames);
+    for (size_t i = 0; i < vecNames.size(); i++){
+        m_mapFieldPos[vecNames[i]] = i;
+    }
 
-        CONDITION_TRUE_RTN_FAIL(!m_objXmlReader.get_string("/Result/RecordValue/Value", acTmpRecordValue, i));
+    objValue = m_objXmlReader.get_cursor("/Result/RecordValue/Value");
+    for (; objValue.is_valid(); (void)objValue.next()){
+        CONDITION_TRUE_RTN_FAIL(!objValue.get_text("", text, MAX_TMP_BUFFER - 1));
 
+        memcpy(acTmpRecordValue, text.c_str(), text.size() + 1);
         (void)SafeMultiByteToWideChar(wt_buf, acTmpRecordValue);
         (void)SafeWideCharToMultiByte(acTmpRecordValue, wt_buf);
 
-        for (int j = 0; j < (int)strlen(acTmpRecordValue); j++){
-            if (acTmpRecordValue[j] == cSepChr){
-                strncpy_s(acTmpStr, MAX_TMP_BUFFER, (acTmpRecordValue + 1) + iTmpPos, (unsigned int)(j - iTmpPos));
-                acTmpStr[(unsigned int)(j - iTmpPos) - 1] = '\0';
-                iTmpPos = j;
-
-                iTmpSrcPos++;
-                iTmpDstPos++;
-            }
-            else if ('\0' == acTmpRecordValue[(unsigned int)(j + 1)]){
-                strncpy_s(acTmpStr, MAX_TMP_BUFFER, (acTmpRecordValue + 1) + iTmpPos , (unsigned int)((j - iTmpPos) + 1));
-                iTmpSrcPos++;
-                iTmpDstPos++;
-            }
-            else{
-                continue;
-            }
-
-            if (iTmpSrcPos == m_iSrcPos){
-                strTmpSrcValue = string(acTmpStr);
-            }
-
-            if (iTmpDstPos == m_iDstPos){
-                strTmpDstValue = string(acTmpStr);
-            }
-        }
-        if (m_plstDstValue == NULL){
-            return RETURN_ERR;
-        }
-                
-        if (m_iSrcPos != -1){
-            if (strTmpSrcValue == m_strSrcValue){
-                m_plstDstValue->push_back(strTmpDstValue);
-            }
-        }
-        else{
-            m_plstDstValue->push_back(strTmpDstValue);
-        }
+        m_vecRecords.push_back(vector<string>());
+        _SplitRecord(acTmpRecordValue, m_vecRecords.back());
     }
 
     return RETURN_OK;
 }
+
+/*------------------------------------------------------------
+Method       : void CRsltXmlParser::_SplitRecord()
+Description  : Split a record at ','. A trailing ',' does not start
+               another field.
+Data Accessed: None.
+Data Updated : None.
+Input        : pszRecord: record text
+Output       : rvecFields: fields of the record
+Return       : None.
+Call         :
+Called by    :
+Create By    :
+Modification :
+Others       :
+------------------------------------------------------------*/
+void CRsltXmlParser::_SplitRecord(const char *pszRecord, vector<string> &rvecFields)
+{
+    const char *pszField = pszRecord;
+    const char *pszSep = NULL;
+
+    rvecFields.clear();
+
+    while ('\0' != *pszField){
+        pszSep = strchr(pszField, ',');
+        if (NULL == pszSep){
+            rvecFields.push_back(string(pszField));
+            break;
+        }
+
+        rvecFields.push_back(string(pszField, (size_t)(pszSep - pszField)));
+        pszField = pszSep + 1;
+    }
+}
+
+const string& CRsltXmlParser::_GetField(const vector<string> &rvecFields, size_t uiPos)
+{
+    static const string strEmpty;
+
+    return (uiPos < rvecFields.size()) ? rvecFields[uiPos] : strEmpty;
+}
@@ -55,25 +55,25 @@ public:
                          const string &rstrDstName, list<string> *plstDstValue);
     int GetValues(const string &rstrSrcName, const string &rstrSrcValue, 
         const string &rstrDstName, string& dstValue);
+    int GetRecordCount();
+    int GetValue(size_t uiRecord, const string &rstrName, string &rstrValue);
     void GetImgStatus() {(void)_GetStatus();};
 
     int GetDescription(string& desc);
 
 private:
     int _InitRstlFile();
-    int _ParseRecordName();
-    int _ParseRecordValue();
+    int _BuildIndex();
     int _GetStatus();
-    int _StrToken();
+    static void _SplitRecord(const char *pszRecord, vector<string> &rvecFields);
+    static const string& _GetField(const vector<string> &rvecFields, size_t uiPos);
 
     int m_iStatus;          //Status in the result file
-    int m_iSrcPos;          //Source string location
-    int m_iDstPos;          //Target string position
+    bool m_bIndexed;        //Result file is loaded and indexed
+    bool m_bHasRecordName;  //Result file has a RecordName
     string m_strRstlFilePath;      //Result file path
-    string m_strSrcName;           //Parsing the source name
-    string m_strSrcValue;          //Parsing the source value
-    string m_strDstName;           //Analyze the target name
-    list<string> *m_plstDstValue;  //Store the parsed target value list
+    map<string, size_t> m_mapFieldPos;      //Field name to its position in a record
+    vector<vector<string> > m_vecRecords;   //Fields of every RecordValue/Value
     XmlReader m_objXmlReader;
   
 };
@@ -486,6 +486,20 @@ void OS_Sleep(int iMSec)
 #endif
 }
 
+unsigned long long OS_GetTickCount()
+{
+#ifdef WIN32
+    return (unsigned long long)GetTickCount64();
+#else
+    struct timespec stNow;
+    if (0 != clock_gettime(CLOCK_MONOTONIC, &stNow)){
+        return 0;
+    }
+
+    return (unsigned long long)stNow.tv_sec * 1000 + (unsigned long long)stNow.tv_nsec / 1000000;
+#endif
+}
+
 time_t OS_Now()
 {
     time_t lParTime;
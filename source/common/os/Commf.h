@@ -89,6 +89,9 @@ string OS_Time_tToStr(time_t lTime);
 
 void OS_Sleep(int iMSec);
 
+/*Milliseconds from a monotonic clock, only meaningful as a difference*/
+unsigned long long OS_GetTickCount();
+
 int  SafeWideCharToMultiByte(char* pszDest,wchar_t *pszSrc);
 
 int SafeMultiByteToWideChar(wchar_t* pszDest,char *pszSrc);
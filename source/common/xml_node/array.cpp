@@ -82,17 +82,17 @@ void ArrayInfo::readXml(XmlReader *reader)
 {
     list<string>::iterator it = peer_arrays.begin();
 
-    if(!reader->get_string((const char*) "/Array/@id", id, 0)){
+    if(!reader->get_cstring((const char*) "/Array/@id", id)){
         return;
     }
-    if(!reader->get_string((const char*) "/Array/Name", name, 0)){
+    if(!reader->get_cstring((const char*) "/Array/Name", name)){
         return;
     }
 
     while (it != peer_arrays.end()){
-        char str[LENGTH_COMMON] = {0};
+        string str;
 
-        if(reader->get_string("/Array/PeerArrays/PeerArray/@id", str, 0)){
+        if(reader->get_string("/Array/PeerArrays/PeerArray/@id", str, LENGTH_COMMON - 1)){
             peer_arrays.push_back(str);
         }
         ++it;
@@ -41,7 +41,7 @@ void CgSnapshot::writeXml(XmlWriter *writer)
         (void)writer->set_string("/Snapshot/@id", id.c_str());
     }
 
-    if (!tg_devices_info.lst_target_devices.empty()){
+    if (!tg_devices_info.empty()){
         (void)writer->set_xml("/Snapshot", &tg_devices_info);
     }
 
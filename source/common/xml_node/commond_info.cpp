@@ -12,6 +12,8 @@
 // License for the specific language governing permissions and limitations
 // under the License.
 
+#include <cstring>
+#include <algorithm>
 #include "commond_info.h"
 
 void ErrorInfo::readXml(XmlReader *reader)
@@ -209,3 +211,98 @@ void Description::writeXml(XmlWriter *writer)
 
     return;
 }
+
+#define STRING_POOL_SLOTS   1024
+
+StringPool::StringPool() : pool(1, '\0'), count(0)
+{
+}
+
+/* FNV-1a */
+static size_t string_hash(const char *str, size_t len)
+{
+    size_t hash = 2166136261U;
+
+    for (size_t i = 0; i < len; i++){
+        hash = (hash ^ (unsigned char)str[i]) * 16777619U;
+    }
+
+    return hash;
+}
+
+/*-------------------------------------------------------------------------
+Function Name: find_slot
+Description  : The slot of str, or the free slot it would go to.
+               slots is never more than half full, so probing ends.
+-------------------------------------------------------------------------*/
+size_t StringPool::find_slot(const char *str, size_t len) const
+{
+    size_t mask = slots.size() - 1;
+    size_t slot = string_hash(str, len) & mask;
+
+    while (0 != slots[slot]){
+        const char *kept = &pool[slots[slot]];
+
+        if (0 == strncmp(kept, str, len) && '\0' == kept[len]){
+            break;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    return slot;
+}
+
+void StringPool::grow()
+{
+    vector<unsigned int> old_slots(slots.empty() ? STRING_POOL_SLOTS : slots.size() * 2, 0);
+
+    old_slots.swap(slots);
+    for (size_t i = 0; i < old_slots.size(); i++){
+        if (0 != old_slots[i]){
+            const char *kept = &pool[old_slots[i]];
+
+            slots[find_slot(kept, strlen(kept))] = old_slots[i];
+        }
+    }
+}
+
+/*-------------------------------------------------------------------------
+Function Name: add
+Description  : Keep str once and return its offset, the same offset for
+               every equal string.
+Input        : str
+Return       : the offset for get(), 0 for the empty string.
+-------------------------------------------------------------------------*/
+unsigned int StringPool::add(const string &str)
+{
+    size_t slot = 0;
+    unsigned int id = 0;
+
+    if (str.empty()){
+        return 0;
+    }
+
+    if ((count + 1) * 2 > slots.size()){
+        grow();
+    }
+
+    slot = find_slot(str.c_str(), str.size());
+    if (0 != slots[slot]){
+        return slots[slot];
+    }
+
+    id = (unsigned int)pool.size();
+    pool.insert(pool.end(), str.begin(), str.end());
+    pool.push_back('\0');
+    slots[slot] = id;
+    count++;
+
+    return id;
+}
+
+void StringPool::swap(StringPool &other)
+{
+    pool.swap(other.pool);
+    slots.swap(other.slots);
+    std::swap(count, other.count);
+}
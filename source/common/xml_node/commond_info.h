@@ -15,6 +15,7 @@
 #ifndef _COMMOND_INFO
 #define _COMMOND_INFO
 
+#include <vector>
 #include "../xmlserial/xmlserializable.h"
 #include "../common.h"
 
@@ -158,5 +159,43 @@ public:
     string content;
 };
 
+/*
+ Append a default node to lst and return it, so a response node is filled
+ where it is written from instead of being built aside and copied into the
+ list with all its strings and nested lists.
+*/
+template <class T>
+T& append_node(list<T> &lst)
+{
+    lst.push_back(T());
+
+    return lst.back();
+}
+
+/*
+ Strings of a response kept once each in one buffer, records of many
+ devices refer to them by offset instead of holding a string each. The
+ offset 0 is the empty string. Offsets stay valid while strings are
+ added, pointers from get() only until the next add().
+*/
+class StringPool
+{
+public:
+    StringPool();
+
+    unsigned int add(const string &str);
+    const char *get(unsigned int id) const {return &pool[id];};
+    size_t bytes() const {return pool.size();};
+    void swap(StringPool &other);
+
+private:
+    size_t find_slot(const char *str, size_t len) const;
+    void grow();
+
+    vector<char> pool;
+    vector<unsigned int> slots;     // offsets by hash, 0 is a free slot
+    size_t count;
+};
+
 #endif
 
@@ -32,7 +32,7 @@ void ConGroupInfo::writeXml(XmlWriter *writer)
         (void)writer->set_string("/ConsistencyGroup/@state", status.c_str());
     }
 
-    if (!source_devices_info.lst_source_devices.empty()){
+    if (!source_devices_info.empty()){
         (void)writer->set_xml("/ConsistencyGroup", &source_devices_info);
     }
 
@@ -96,7 +96,7 @@ void HMConGroupInfo::writeXml(XmlWriter *writer)
         }
     }
 
-    if (!source_devices_info.lst_source_devices.empty()){
+    if (!source_devices_info.empty()){
         (void)writer->set_xml("/ConsistencyGroup", &source_devices_info);
     }
 
@@ -20,7 +20,7 @@ void FailoverResults::writeXml(XmlWriter *writer)
         (void)writer->set_xml("/FailoverResults", &tg_groups_info);
     }
 
-    if (!tg_devices_info.lst_target_devices.empty()){
+    if (!tg_devices_info.empty()){
         (void)writer->set_xml("/FailoverResults", &tg_devices_info);
     }
 }
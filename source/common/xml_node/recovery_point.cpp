@@ -26,9 +26,9 @@ RecoveryPointInfo::~RecoveryPointInfo()
 
 void RecoveryPointInfo::readXml(XmlReader *reader)
 {
-    (void)reader->get_string((const char*) "/RecoveryPoint/@id", (char *)rp_id.c_str(), 0);
-    (void)reader->get_string((const char*) "/RecoveryPoint/Name", (char *)rp_name.c_str(), 0);
-    (void)reader->get_string((const char*) "/RecoveryPoint/Time", (char *)rp_time.c_str(), 0);
+    (void)reader->get_string((const char*) "/RecoveryPoint/@id", rp_id, LENGTH_COMMON - 1);
+    (void)reader->get_string((const char*) "/RecoveryPoint/Name", rp_name, LENGTH_COMMON - 1);
+    (void)reader->get_string((const char*) "/RecoveryPoint/Time", rp_time, LENGTH_COMMON - 1);
 
     return;
 }
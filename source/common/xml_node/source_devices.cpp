@@ -12,16 +12,55 @@
 // License for the specific language governing permissions and limitations
 // under the License.
 
+#include <cstring>
 #include "source_devices.h"
 
 void SourceDevicesInfo::writeXml(XmlWriter *writer)
 {
     list<SourceDeviceInfo>::iterator iter = lst_source_devices.begin();
+    SourceDeviceInfo device;
 
     while (iter != lst_source_devices.end()){
         (void)writer->set_xml("/SourceDevices", &(*iter));
         ++iter;
     }
+
+    /* one device object for every record, set_xml copies what it writes */
+    for (size_t i = 0; i < records.size(); i++){
+        const SOURCE_DEVICE_RECORD &rec = records[i];
+
+        device.source_id = strings.get(rec.source_id);
+        device.source_name = strings.get(rec.source_name);
+        device.status = strings.get(rec.status);
+        device.stretched = strings.get(rec.stretched);
+        device.cptype = strings.get(rec.cptype);
+        device.target_info.target_key = strings.get(rec.target_key);
+        device.identity_info.source_wwn = strings.get(rec.source_wwn);
+        device.identity_infofs.source_NfsName = strings.get(rec.source_NfsName);
+        (void)writer->set_xml("/SourceDevices", &device);
+    }
+}
+
+/*-------------------------------------------------------------------------
+Function Name: append_record
+Description  : A new device at the end of records, every string empty.
+Return       : the record, valid until the next append_record.
+-------------------------------------------------------------------------*/
+SOURCE_DEVICE_RECORD &SourceDevicesInfo::append_record()
+{
+    SOURCE_DEVICE_RECORD rec;
+
+    memset(&rec, 0, sizeof(rec));
+    records.push_back(rec);
+
+    return records.back();
+}
+
+void SourceDevicesInfo::swap(SourceDevicesInfo &other)
+{
+    lst_source_devices.swap(other.lst_source_devices);
+    records.swap(other.records);
+    strings.swap(other.strings);
 }
 
 void SourceDevicesInfo::readXml(XmlReader *reader)
@@ -17,6 +17,19 @@
 
 #include "source_device.h"
 
+/* a source device of a discoverDevices response, offsets into the strings of its list */
+typedef struct
+{
+    unsigned int source_id;
+    unsigned int source_name;
+    unsigned int status;
+    unsigned int stretched;
+    unsigned int cptype;
+    unsigned int target_key;
+    unsigned int source_wwn;
+    unsigned int source_NfsName;
+}SOURCE_DEVICE_RECORD;
+
 class SourceDevicesInfo : public XmlSerializable
 {
 public:
@@ -27,8 +40,16 @@ public:
     void writeXml(XmlWriter *writer);
     void readXml(XmlReader *reader);
 
+    SOURCE_DEVICE_RECORD &append_record();
+    bool empty() const {return lst_source_devices.empty() && records.empty();};
+    void swap(SourceDevicesInfo &other);
+
 public:
     list<SourceDeviceInfo> lst_source_devices;
+
+    /* devices kept as records are written after the list, as the same elements */
+    vector<SOURCE_DEVICE_RECORD> records;
+    StringPool strings;
 };
 
 #endif
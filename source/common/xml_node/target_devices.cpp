@@ -12,20 +12,81 @@
 // License for the specific language governing permissions and limitations
 // under the License.
 
+#include <cstring>
 #include "target_devices.h"
 
 void TargetDevicesInfo::writeXml(XmlWriter *writer)
 {
     list<TargetDeviceInfo>::iterator iter = lst_target_devices.begin();
+    TargetDeviceInfo device;
+    SnapShotInfo no_snapshot;
 
     while (iter != lst_target_devices.end()){
         (void)writer->set_xml("/TargetDevices", &(*iter));
         ++iter;
     }
 
+    /* one device object for every record, set_xml copies what it writes */
+    for (size_t i = 0; i < records.size(); i++){
+        const TARGET_DEVICE_RECORD &rec = records[i];
+
+        device.target_key = strings.get(rec.target_key);
+        device.target_id = strings.get(rec.target_id);
+        device.target_name = strings.get(rec.target_name);
+        device.target_state = strings.get(rec.target_state);
+        device.stretched = strings.get(rec.stretched);
+        device.identity_info.source_wwn = strings.get(rec.source_wwn);
+        device.identity_infofs.source_NfsName = strings.get(rec.source_NfsName);
+        device.snapshot_info = (0 <= rec.snapshot) ? snapshots[rec.snapshot] : no_snapshot;
+        (void)writer->set_xml("/TargetDevices", &device);
+    }
+
     return;
 }
 
+/*-------------------------------------------------------------------------
+Function Name: append_record
+Description  : A new device at the end of records, every string empty and
+               no snapshot.
+Return       : the record, valid until the next append_record.
+-------------------------------------------------------------------------*/
+TARGET_DEVICE_RECORD &TargetDevicesInfo::append_record()
+{
+    TARGET_DEVICE_RECORD rec;
+
+    memset(&rec, 0, sizeof(rec));
+    rec.snapshot = -1;
+    records.push_back(rec);
+
+    return records.back();
+}
+
+/*-------------------------------------------------------------------------
+Function Name: add_snapshot
+Description  : Keep the snapshot of a record, only few devices have one.
+Input        : snapshot
+Return       : the index for TARGET_DEVICE_RECORD::snapshot, -1 when
+               snapshot has no id and would not be written.
+-------------------------------------------------------------------------*/
+int TargetDevicesInfo::add_snapshot(const SnapShotInfo &snapshot)
+{
+    if (snapshot.snap_id.empty()){
+        return -1;
+    }
+
+    snapshots.push_back(snapshot);
+
+    return (int)snapshots.size() - 1;
+}
+
+void TargetDevicesInfo::swap(TargetDevicesInfo &other)
+{
+    lst_target_devices.swap(other.lst_target_devices);
+    records.swap(other.records);
+    snapshots.swap(other.snapshots);
+    strings.swap(other.strings);
+}
+
 void TargetDevicesInfo::readXml(XmlReader *reader)
 {
     (void)reader;
@@ -17,6 +17,19 @@
 
 #include "target_device.h"
 
+/* a target device of a discoverDevices response, offsets into the strings of its list */
+typedef struct
+{
+    unsigned int target_key;
+    unsigned int target_id;
+    unsigned int target_name;
+    unsigned int target_state;
+    unsigned int stretched;
+    unsigned int source_wwn;
+    unsigned int source_NfsName;
+    int snapshot;                   // index in snapshots, -1 for none
+}TARGET_DEVICE_RECORD;
+
 class TargetDevicesInfo : public XmlSerializable
 {
 public:
@@ -27,8 +40,18 @@ public:
     void writeXml(XmlWriter *writer);
     void readXml(XmlReader *reader);
 
+    TARGET_DEVICE_RECORD &append_record();
+    int add_snapshot(const SnapShotInfo &snapshot);
+    bool empty() const {return lst_target_devices.empty() && records.empty();};
+    void swap(TargetDevicesInfo &other);
+
 public:
     list<TargetDeviceInfo> lst_target_devices;
+
+    /* devices kept as records are written after the list, as the same elements */
+    vector<TARGET_DEVICE_RECORD> records;
+    vector<SnapShotInfo> snapshots;
+    StringPool strings;
 };
 
 #endif
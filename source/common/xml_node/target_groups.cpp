@@ -60,7 +60,7 @@ void TargetGroupInfo::writeXml(XmlWriter *writer)
         (void)writer->set_string("/TargetGroup/Success/", "");
     }
 
-    if (!target_devices_info.lst_target_devices.empty()){
+    if (!target_devices_info.empty()){
         (void)writer->set_xml("/TargetGroup", &target_devices_info);
     }
 
@@ -15,6 +15,9 @@
 #include "xmlreader.h"
 #include "xmlcommon.h"
 #include "securec.h"
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
 
 #ifdef WIN32
 #pragma warning(disable: 4996)
@@ -107,7 +110,7 @@ bool XmlReader::load_from_filename(const char *filename, TiXmlEncoding encoding)
  Description  :
  Others         :
  -------------------------------------------------------------------------*/
-bool XmlReader::load_from_string(std::string xml, TiXmlEncoding encoding)
+bool XmlReader::load_from_string(const std::string &xml, TiXmlEncoding encoding)
 {
     bool ret = false;
     TiXmlDocument * document = new TiXmlDocument;
@@ -126,8 +129,6 @@ bool XmlReader::load_from_string(std::string xml, TiXmlEncoding encoding)
         return false;
     }
 
-    xml += "\n"; 
-
     const char *temp = xmldocument->Parse(xml.c_str(), 0, encoding);
     CHECK_NULL(temp, false);
 
@@ -138,6 +139,125 @@ bool XmlReader::load_from_string(std::string xml, TiXmlEncoding encoding)
 
 }
 
+/*
+ Builds the reader's document from stream events, except for the
+ subtrees the caller's handler claims, which only the handler sees.
+*/
+class XmlDomBuilder : public XmlStreamHandler
+{
+    public:
+        XmlDomBuilder(TiXmlDocument *document, XmlStreamHandler &handler)
+            : document(document), handler(handler), claimed_depth(0){}
+
+        virtual bool start_element(const std::string &path, const std::string &name, const XmlAttrList &attrs)
+        {
+            TiXmlElement *elem = NULL;
+            XmlAttrList::const_iterator it;
+
+            if (0 < claimed_depth || handler.claim(path)){
+                claimed_depth++;
+                return handler.start_element(path, name, attrs);
+            }
+
+            elem = new TiXmlElement(name.c_str());
+            CHECK_NULL(elem, false);
+
+            for (it = attrs.begin(); it != attrs.end(); ++it){
+                elem->SetAttribute(it->first.c_str(), it->second.c_str());
+            }
+
+            if (stack.empty()){
+                (void)document->LinkEndChild(elem);
+            }
+            else{
+                (void)stack.back()->LinkEndChild(elem);
+            }
+            stack.push_back(elem);
+
+            return true;
+        }
+
+        virtual bool text(const std::string &path, const std::string &value)
+        {
+            TiXmlText *text = NULL;
+
+            if (0 < claimed_depth){
+                return handler.text(path, value);
+            }
+
+            CHECK_FALSE(!stack.empty(), false);
+
+            text = new TiXmlText(value.c_str());
+            CHECK_NULL(text, false);
+            (void)stack.back()->LinkEndChild(text);
+
+            return true;
+        }
+
+        virtual bool end_element(const std::string &path)
+        {
+            if (0 < claimed_depth){
+                claimed_depth--;
+                return handler.end_element(path);
+            }
+
+            CHECK_FALSE(!stack.empty(), false);
+            stack.pop_back();
+
+            return true;
+        }
+
+    private:
+        XmlDomBuilder(const XmlDomBuilder&);
+        XmlDomBuilder& operator=(const XmlDomBuilder&);
+
+        TiXmlDocument *document;
+        XmlStreamHandler &handler;
+        std::vector<TiXmlElement *> stack;
+        int claimed_depth;
+};
+
+/*-------------------------------------------------------------------------
+ Function Name: load_from_stream
+ Description  : Load xml in one streaming pass
+ 1. Parse data with XmlStreamParser, no TinyXML text parse
+ 2. Elements claimed by handler go to the handler only and are not part
+    of the document, everything else is read as after load_from_string
+ Input        : data, len: the document
+                handler: receives the claimed subtrees
+ Return       : false on a malformed document; the handler may then
+                hold a partial result.
+ -------------------------------------------------------------------------*/
+bool XmlReader::load_from_stream(const char *data, size_t len, XmlStreamHandler &handler)
+{
+    bool ret = false;
+
+    CHECK_NULL(data, false);
+
+    TiXmlDocument * document = new TiXmlDocument;
+    CHECK_NULL(document, false);
+
+    if(NULL != xmldocument){
+        delete xmldocument;
+        xmldocument = NULL;
+    }
+    parentelem = NULL;
+
+    ret = set_document(document);
+    CHECK_FALSE(ret, false);
+
+    XmlDomBuilder builder(xmldocument, handler);
+    XmlStreamParser parser(builder);
+
+    ret = parser.parse(data, len);
+    CHECK_FALSE(ret, false);
+
+    parentelem = xmldocument->RootElement();
+    CHECK_NULL(parentelem, false);
+
+    return ret;
+}
+
 /*-------------------------------------------------------------------------
  Function Name: get_count
  Description  : Get the number of elements based on the path name
@@ -440,38 +560,143 @@ bool XmlReader::get_string(const char *path, char *value, int index,int indexsec
     return true;
 }
 
-bool XmlReader::get_int(const char * path, int &value, int index)
+/*-------------------------------------------------------------------------
+ Function Name: find_elem
+ Description  : Walk path from elem without copying it anywhere but a
+                stack buffer per name. An absolute path skips the name
+                of elem itself, attr is set to the name after a
+                trailing '@'.
+ -------------------------------------------------------------------------*/
+static TiXmlElement* find_elem(TiXmlElement *elem, const char *path, int index, const char *&attr)
 {
-    char temp_value[NAMELEN] = {0};
-    bool ret = false;
+    char name[NAMELEN] = {0};
+    const char *end = NULL;
+    size_t len = 0;
+    bool skip = ('/' == *path);
+
+    attr = NULL;
+
+    while (NULL != elem){
+        while ('/' == *path){
+            path++;
+        }
+        if ('\0' == *path){
+            break;
+        }
+
+        end = strchr(path, '/');
+        len = (NULL == end) ? strlen(path) : (size_t)(end - path);
+
+        if ('@' == *path){
+            CHECK_FALSE((NULL == end && len > 1), NULL);
+            attr = path + 1;
+            break;
+        }
+
+        CHECK_MORETHAN(len, sizeof(name) - 1, NULL);
+        memcpy(name, path, len);
+        name[len] = '\0';
+        path += len;
+
+        if (skip){
+            skip = false;
+            continue;
+        }
+
+        elem = elem->FirstChildElement(name);
+    }
+
+    for (; index > 0 && NULL != elem; index--){
+        elem = elem->NextSiblingElement(elem->Value());
+    }
+
+    return elem;
+}
+
+/*-------------------------------------------------------------------------
+ Function Name: get_text
+ Description  : Read the text of the element at path, or its attribute
+                when the path ends in "@name", in place. Fails when the
+                value is missing or longer than max_len characters;
+                get_value_error() then tells which. A missing text reads
+                as empty like get_string.
+ -------------------------------------------------------------------------*/
+bool XmlReader::get_text(const char *path, XmlText &value, size_t max_len, int index)
+{
+    const char *attr = NULL;
+    const char *text = NULL;
+    TiXmlElement *tempelem = NULL;
+    size_t len = 0;
+
+    value = XmlText();
+    value_error.clear();
 
     CHECK_NULL(path, false);
+    CHECK_NULL(parentelem, false);
+    CHECK_MORETHAN(0, index, false);
 
-    ret = get_string(path, temp_value, index);
-    CHECK_FALSE(ret, false);
+    tempelem = find_elem(parentelem, path, index, attr);
+    if (NULL != tempelem){
+        text = (NULL != attr) ? tempelem->Attribute(attr) : tempelem->GetText();
+    }
 
-    if(sscanf_s(temp_value, "%d", &value) == -1){
+    if (NULL == text){
+        if (NULL == tempelem || NULL != attr){
+            value_error = std::string(path) + " is missing";
+            return false;
+        }
+        return true;
+    }
+
+    len = strlen(text);
+    if (len > max_len){
+        value_error = std::string(path) + " is too long";
         return false;
     }
 
-    return ret;
+    value = XmlText(text, len);
+
+    return true;
 }
 
-bool XmlReader::get_double(const char * path, double &value, int index)
+bool XmlReader::get_string(const char *path, std::string &value, size_t max_len, int index)
 {
-    char temp_value[NAMELEN] = {0};
-    bool ret = false;
+    XmlText text;
 
-    CHECK_NULL(path, false);
+    value.clear();
+    CHECK_FALSE(get_text(path, text, max_len, index), false);
 
-    ret = get_string(path, temp_value, index); 
-    CHECK_FALSE(ret, false);
+    value.assign(text.c_str(), text.size());
+
+    return true;
+}
+
+bool XmlReader::get_int(const char * path, int &value, int index)
+{
+    XmlText text;
 
-    if(sscanf_s(temp_value, "%g", &value) == -1){
+    CHECK_FALSE(get_text(path, text, NAMELEN - 1, index), false);
+
+    if (!text.to_int(value)){
+        value_error = std::string(path) + " is not a number";
         return false;
     }
-    //end
-    return ret;
+
+    return true;
+}
+
+bool XmlReader::get_double(const char * path, double &value, int index)
+{
+    XmlText text;
+
+    CHECK_FALSE(get_text(path, text, NAMELEN - 1, index), false);
+
+    if (!text.to_double(value)){
+        value_error = std::string(path) + " is not a number";
+        return false;
+    }
+
+    return true;
 }
 
 bool XmlReader::get_short(const char * path, short &value, int index)
@@ -520,3 +745,235 @@ bool XmlReader::get_xml(const char * path, XmlSerializable * obj, int index)
     return true;
 }
 
+
+/*-------------------------------------------------------------------------
+ Function Name: to_int
+ Description  : Parse the whole value as a decimal int. Fails on an empty
+                value, trailing characters or a value out of range.
+ -------------------------------------------------------------------------*/
+bool XmlText::to_int(int &value) const
+{
+    char *stop = NULL;
+    long number = 0;
+
+    CHECK_FALSE(!empty(), false);
+
+    errno = 0;
+    number = strtol(data, &stop, 10);
+    CHECK_FALSE((data + len == stop && 0 == errno), false);
+    CHECK_FALSE((INT_MIN <= number && INT_MAX >= number), false);
+
+    value = (int)number;
+
+    return true;
+}
+
+bool XmlText::to_double(double &value) const
+{
+    char *stop = NULL;
+    double number = 0;
+
+    CHECK_FALSE(!empty(), false);
+
+    errno = 0;
+    number = strtod(data, &stop);
+    CHECK_FALSE((data + len == stop && 0 == errno), false);
+
+    value = number;
+
+    return true;
+}
+
+XmlPath::XmlPath(const char *path) : absolute(false)
+{
+    parse(path);
+}
+
+XmlPath::XmlPath(const std::string &path) : absolute(false)
+{
+    parse(path.c_str());
+}
+
+void XmlPath::parse(const char *path)
+{
+    std::string name;
+
+    if (NULL == path){
+        return;
+    }
+
+    absolute = ('/' == *path);
+
+    for (; ; path++){
+        if ('/' != *path && '\0' != *path){
+            name += *path;
+            continue;
+        }
+
+        if (!name.empty()){
+            names.push_back(name);
+            name.clear();
+        }
+
+        if ('\0' == *path){
+            break;
+        }
+    }
+
+    if (!names.empty() && '@' == names.back()[0]){
+        attr = names.back().substr(1);
+        names.pop_back();
+    }
+}
+
+bool XmlCursor::next()
+{
+    CHECK_NULL(elem, false);
+
+    elem = elem->NextSiblingElement(elem->Value());
+
+    return NULL != elem;
+}
+
+XmlCursor XmlCursor::get_child(const XmlPath &path) const
+{
+    TiXmlElement *tempelem = elem;
+
+    for (size_t i = 0; i < path.get_deepth() && NULL != tempelem; i++){
+        tempelem = tempelem->FirstChildElement(path.get_name(i).c_str());
+    }
+
+    return XmlCursor(tempelem);
+}
+
+int XmlCursor::get_count(const XmlPath &path) const
+{
+    int count = 0;
+
+    for (XmlCursor cursor = get_child(path); cursor.is_valid(); (void)cursor.next()){
+        count++;
+    }
+
+    return count;
+}
+
+/*-------------------------------------------------------------------------
+ Function Name: get_text
+ Description  : Read the text of the element at path below the cursor,
+                or its attribute when the path ends in "@name", in
+                place. A missing attribute or a value longer than
+                max_len fails, a missing text reads as empty like
+                XmlReader::get_string.
+ -------------------------------------------------------------------------*/
+bool XmlCursor::get_text(const XmlPath &path, XmlText &value, size_t max_len) const
+{
+    XmlCursor cursor = get_child(path);
+    const char *text = NULL;
+    size_t len = 0;
+
+    value = XmlText();
+    CHECK_NULL(cursor.elem, false);
+
+    if (!path.get_attr().empty()){
+        text = cursor.elem->Attribute(path.get_attr().c_str());
+        CHECK_NULL(text, false);
+    }
+    else{
+        text = cursor.elem->GetText();
+        CHECK_NULL(text, true);
+    }
+
+    len = strlen(text);
+    CHECK_MORETHAN(len, max_len, false);
+
+    value = XmlText(text, len);
+
+    return true;
+}
+
+bool XmlCursor::get_string(const XmlPath &path, std::string &value) const
+{
+    XmlText text;
+
+    value.clear();
+    CHECK_FALSE(get_text(path, text, std::string::npos), false);
+
+    value.assign(text.c_str(), text.size());
+
+    return true;
+}
+
+bool XmlCursor::get_int(const XmlPath &path, int &value) const
+{
+    XmlText text;
+
+    CHECK_FALSE(get_text(path, text, NAMELEN - 1), false);
+
+    return text.to_int(value);
+}
+
+static bool walk_elem(TiXmlElement *elem, const std::string &parent_path, XmlStreamHandler &handler)
+{
+    std::string path = parent_path + "/" + elem->Value();
+    XmlAttrList attrs;
+    TiXmlAttribute *attr = NULL;
+    TiXmlElement *child = NULL;
+    const char *text = elem->GetText();
+
+    for (attr = elem->FirstAttribute(); NULL != attr; attr = attr->Next()){
+        attrs.push_back(std::make_pair(std::string(attr->Name()), std::string(attr->Value())));
+    }
+
+    CHECK_FALSE(handler.start_element(path, elem->Value(), attrs), false);
+
+    if (NULL != text){
+        CHECK_FALSE(handler.text(path, text), false);
+    }
+
+    for (child = elem->FirstChildElement(); NULL != child; child = child->NextSiblingElement()){
+        CHECK_FALSE(walk_elem(child, path, handler), false);
+    }
+
+    return handler.end_element(path);
+}
+
+/*-------------------------------------------------------------------------
+ Function Name: walk
+ Description  : Report the claimed children of the cursor element, whose
+                own path is path, to handler. Fails when the handler
+                stops the walk.
+ -------------------------------------------------------------------------*/
+bool XmlCursor::walk(const std::string &path, XmlStreamHandler &handler) const
+{
+    TiXmlElement *child = NULL;
+
+    CHECK_NULL(elem, false);
+
+    for (child = elem->FirstChildElement(); NULL != child; child = child->NextSiblingElement()){
+        if (handler.claim(path + "/" + child->Value())){
+            CHECK_FALSE(walk_elem(child, path, handler), false);
+        }
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------------
+ Function Name: get_cursor
+ Description  : Get a cursor on the first element of path. An absolute
+                path starts at the root element and skips its name,
+                the same way get_string does.
+ -------------------------------------------------------------------------*/
+XmlCursor XmlReader::get_cursor(const XmlPath &path)
+{
+    TiXmlElement *tempelem = parentelem;
+    size_t i = path.is_absolute() ? 1 : 0;
+
+    CHECK_NULL(parentelem, XmlCursor());
+
+    for (; i < path.get_deepth() && NULL != tempelem; i++){
+        tempelem = tempelem->FirstChildElement(path.get_name(i).c_str());
+    }
+
+    return XmlCursor(tempelem);
+}
@@ -16,17 +16,104 @@
 #define XMLREADER_H
 
 #include <string>
+#include <vector>
+#include <cstring>
 #include "xmlserializable.h"
+#include "xmlstream.h"
 #include "tinyxml.h"
 
+/*
+ A slash separated path split once, so loops that read the same path for
+ every sibling do not reparse it. A leading '/' marks a path from the
+ document root (the root name itself is not matched, as in get_string),
+ a trailing "@name" selects an attribute of the last element.
+*/
+class XmlPath
+{
+    public:
+        XmlPath(const char *path);
+        XmlPath(const std::string &path);
+
+        bool is_absolute() const {return absolute;}
+        size_t get_deepth() const {return names.size();}
+        const std::string& get_name(size_t index) const {return names[index];}
+        const std::string& get_attr() const {return attr;}
+
+    private:
+        void parse(const char *path);
+
+        std::vector<std::string> names;
+        std::string attr;
+        bool absolute;
+};
+
+/*
+ A value of a loaded document, read in place instead of copied out. It is
+ NUL terminated and, like a cursor, only valid as long as the XmlReader
+ that produced it.
+*/
+class XmlText
+{
+    public:
+        XmlText() : data(""), len(0) {}
+        XmlText(const char *data, size_t len) : data(data), len(len) {}
+
+        const char* c_str() const {return data;}
+        size_t size() const {return len;}
+        bool empty() const {return 0 == len;}
+
+        bool to_int(int &value) const;
+        bool to_double(double &value) const;
+
+    private:
+        const char *data;
+        size_t len;
+};
+
+/*
+ Points at one element of a loaded document. next() moves to the following
+ sibling of the same name, so walking N siblings costs N steps instead of
+ the N walks from the root that indexed get_string calls make. A cursor is
+ only valid as long as the XmlReader that produced it.
+
+ walk() reports the children of the element that the handler claims, and
+ their subtrees, as the events an XmlStreamParser pass would give, so a
+ handler built for load_from_stream can also read a loaded document. The
+ text of an element is reported before its children.
+*/
+class XmlCursor
+{
+    public:
+        XmlCursor() : elem(NULL) {}
+        explicit XmlCursor(TiXmlElement *elem) : elem(elem) {}
+
+        bool is_valid() const {return NULL != elem;}
+        bool next();
+
+        XmlCursor get_child(const XmlPath &path) const;
+        int  get_count(const XmlPath &path) const;
+        bool get_text(const XmlPath &path, XmlText &value, size_t max_len) const;
+        bool get_string(const XmlPath &path, std::string &value) const;
+        bool get_int(const XmlPath &path, int &value) const;
+        bool walk(const std::string &path, XmlStreamHandler &handler) const;
+
+    private:
+        TiXmlElement *elem;
+};
+
 class XmlReader
 {
     public:
         XmlReader() : attrflag(0){xmldocument = NULL; parentelem = NULL;}
         virtual ~XmlReader();
         bool load_from_filename(const char *filename, TiXmlEncoding encoding );
-        bool load_from_string(std::string xml, TiXmlEncoding encoding );
+        bool load_from_string(const std::string &xml, TiXmlEncoding encoding );
+        bool load_from_stream(const char *data, size_t len, XmlStreamHandler &handler);
         bool get_string(const char *path,  char *value, int index ,int indexsecond = 0 ,int deep = 0);
+        bool get_text(const char *path, XmlText &value, size_t max_len, int index = 0);
+        bool get_string(const char *path, std::string &value, size_t max_len, int index = 0);
+        template <size_t N>
+        bool get_cstring(const char *path, char (&value)[N], int index = 0);
         bool get_int(const char *path, int &value, int index);
         bool get_double(const char *path, double &value, int index);
         bool get_short(const char *path, short &value, int index);
@@ -34,6 +121,8 @@ class XmlReader
         bool get_xml(const char* path, XmlSerializable* obj, int index);
         int  get_count(const char *path);
         int  get_count(const char *path,int index,int deep);
+        XmlCursor get_cursor(const XmlPath &path);
+        const std::string& get_value_error() const {return value_error;}
 
     private:
         XmlReader(const XmlReader&);
@@ -46,8 +135,28 @@ class XmlReader
         TiXmlDocument *xmldocument;
         TiXmlElement  *parentelem;
         int attrflag;
+        std::string value_error;
 };
 
+/*
+ Copy a value into a fixed buffer of the caller. A value that does not fit
+ fails instead of overflowing the buffer.
+*/
+template <size_t N>
+bool XmlReader::get_cstring(const char *path, char (&value)[N], int index)
+{
+    XmlText text;
+
+    if (!get_text(path, text, N - 1, index)){
+        return false;
+    }
+
+    memcpy(value, text.c_str(), text.size());
+    value[text.size()] = '\0';
+
+    return true;
+}
+
 #ifndef NODENUM
 #define NODENUM  10
 #endif
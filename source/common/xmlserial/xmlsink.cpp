@@ -0,0 +1,252 @@
+// Copyright 2019 The OpenSDS Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use this file except in compliance with the License. You may obtain
+// a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "xmlsink.h"
+#include "xmlcommon.h"
+
+XmlFileSink::~XmlFileSink()
+{
+    if (NULL != fp){
+        (void)fclose(fp);
+        fp = NULL;
+    }
+}
+
+bool XmlFileSink::open(const char *filename)
+{
+    CHECK_NULL(filename, false);
+
+    if (NULL != fp){
+        return false;
+    }
+
+    fp = fopen(filename, "w");
+    CHECK_NULL(fp, false);
+
+    failed = false;
+    return true;
+}
+
+bool XmlFileSink::write(const char *data, size_t len)
+{
+    if (NULL == fp || failed){
+        return false;
+    }
+
+    if (len != fwrite(data, 1, len, fp)){
+        failed = true;
+    }
+
+    return !failed;
+}
+
+bool XmlFileSink::close()
+{
+    CHECK_NULL(fp, false);
+
+    if (0 != fclose(fp)){
+        failed = true;
+    }
+    fp = NULL;
+
+    return !failed;
+}
+
+bool XmlStringSink::write(const char *data, size_t len)
+{
+    (void)content.append(data, len);
+
+    return true;
+}
+
+bool XmlTeeSink::write(const char *data, size_t len)
+{
+    bool first_ok = first.write(data, len);
+    bool second_ok = second.write(data, len);
+
+    return first_ok && second_ok;
+}
+
+bool XmlTeeSink::close()
+{
+    bool first_ok = first.close();
+    bool second_ok = second.close();
+
+    return first_ok && second_ok;
+}
+
+XmlSinkPrinter::XmlSinkPrinter(XmlSink &out) : sink(out)
+{
+    failed = false;
+    buffer.reserve(2 * XML_SINK_BLOCK);
+}
+
+void XmlSinkPrinter::put(const char *data, size_t len)
+{
+    (void)buffer.append(data, len);
+
+    if (XML_SINK_BLOCK <= buffer.size()){
+        (void)flush();
+    }
+}
+
+void XmlSinkPrinter::indent(int depth)
+{
+    for (int i = 0; i < depth; i++){
+        put("    ", 4);
+    }
+}
+
+/*-------------------------------------------------------------------------
+Function Name: flush
+Description  : Hand what has been printed so far to the sink.
+Return       : false once the sink failed, later prints are dropped.
+-------------------------------------------------------------------------*/
+bool XmlSinkPrinter::flush()
+{
+    if (!buffer.empty()){
+        if (!failed && !sink.write(buffer.data(), buffer.size())){
+            failed = true;
+        }
+        buffer.clear();
+    }
+
+    return !failed;
+}
+
+void XmlSinkPrinter::print_attributes(const TiXmlElement *elem, TIXML_STRING &out)
+{
+    for (const TiXmlAttribute *attr = elem->FirstAttribute(); NULL != attr; attr = attr->Next()){
+        out += " ";
+        attr->Print(NULL, 0, &out);
+    }
+}
+
+/*-------------------------------------------------------------------------
+Function Name: print_node
+Description  : Print node and everything under it at depth. An element
+               without children is closed in its start tag, one whose
+               only child is a text stays on one line, any other has
+               each child on its own lines one indent deeper.
+Input        : node, depth: indents before the node
+Return       : false once the sink failed or for a node TiXmlPrinter
+               would not print.
+-------------------------------------------------------------------------*/
+bool XmlSinkPrinter::print_node(const TiXmlNode *node, int depth)
+{
+    TIXML_STRING str;
+
+    CHECK_NULL(node, false);
+
+    const TiXmlElement *elem = node->ToElement();
+    const TiXmlText *text = node->ToText();
+
+    if (NULL != elem){
+        const TiXmlNode *child = elem->FirstChild();
+
+        if (NULL == child){
+            indent(depth);
+            put("<");
+            put(elem->ValueTStr());
+            print_attributes(elem, str);
+            put(str);
+            put(" />\n");
+        }
+        else if (NULL != child->ToText() && child == elem->LastChild() && !child->ToText()->CDATA()){
+            indent(depth);
+            put("<");
+            put(elem->ValueTStr());
+            print_attributes(elem, str);
+            put(str);
+            put(">");
+            str = "";
+            TiXmlBase::EncodeString(child->ValueTStr(), &str);
+            put(str);
+            put("</");
+            put(elem->ValueTStr());
+            put(">\n");
+        }
+        else{
+            (void)print_start(elem, depth);
+            for (; NULL != child; child = child->NextSibling()){
+                CHECK_FALSE(print_node(child, depth + 1), false);
+            }
+            (void)print_end(elem, depth);
+        }
+    }
+    else if (NULL != text){
+        indent(depth);
+        if (text->CDATA()){
+            put("<![CDATA[");
+            put(text->ValueTStr());
+            put("]]>\n");
+        }
+        else{
+            TiXmlBase::EncodeString(text->ValueTStr(), &str);
+            put(str);
+            put("\n");
+        }
+    }
+    else if (NULL != node->ToDeclaration()){
+        indent(depth);
+        node->ToDeclaration()->Print(NULL, 0, &str);
+        put(str);
+        put("\n");
+    }
+    else if (NULL != node->ToComment()){
+        indent(depth);
+        put("<!--");
+        put(node->ValueTStr());
+        put("-->\n");
+    }
+    else if (NULL != node->ToUnknown()){
+        indent(depth);
+        put("<");
+        put(node->ValueTStr());
+        put(">\n");
+    }
+    else{
+        return false;
+    }
+
+    return !failed;
+}
+
+bool XmlSinkPrinter::print_start(const TiXmlElement *elem, int depth)
+{
+    TIXML_STRING str;
+
+    CHECK_NULL(elem, false);
+
+    indent(depth);
+    put("<");
+    put(elem->ValueTStr());
+    print_attributes(elem, str);
+    put(str);
+    put(">\n");
+
+    return !failed;
+}
+
+bool XmlSinkPrinter::print_end(const TiXmlElement *elem, int depth)
+{
+    CHECK_NULL(elem, false);
+
+    indent(depth);
+    put("</");
+    put(elem->ValueTStr());
+    put(">\n");
+
+    return !failed;
+}
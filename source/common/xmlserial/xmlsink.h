@@ -0,0 +1,126 @@
+// Copyright 2019 The OpenSDS Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use this file except in compliance with the License. You may obtain
+// a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#ifndef XMLSINK_H
+#define XMLSINK_H
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include "tinyxml.h"
+
+using namespace std;
+
+/* bytes XmlSinkPrinter collects before it hands them to the sink */
+#define XML_SINK_BLOCK  (64 * 1024)
+
+/*
+ Where the text of a document goes while XmlWriter writes it. write() is
+ called with the text in pieces in document order, close() once at the
+ end. Both return false once the text could not be kept.
+*/
+class XmlSink
+{
+    public:
+        XmlSink(){};
+        virtual ~XmlSink(){};
+
+        virtual bool write(const char *data, size_t len) = 0;
+        virtual bool close(){return true;};
+};
+
+/* a file opened in text mode, as TiXmlDocument::SaveFile opens it */
+class XmlFileSink : public XmlSink
+{
+    public:
+        XmlFileSink(){fp = NULL;failed = false;};
+        virtual ~XmlFileSink();
+
+        bool open(const char *filename);
+        virtual bool write(const char *data, size_t len);
+        virtual bool close();
+
+    private:
+        XmlFileSink(const XmlFileSink&);
+        XmlFileSink& operator=(const XmlFileSink&);
+
+        FILE *fp;
+        bool failed;
+};
+
+/* the whole text in a string */
+class XmlStringSink : public XmlSink
+{
+    public:
+        explicit XmlStringSink(string &str) : content(str){};
+
+        virtual bool write(const char *data, size_t len);
+
+    private:
+        XmlStringSink(const XmlStringSink&);
+        XmlStringSink& operator=(const XmlStringSink&);
+
+        string &content;
+};
+
+/* the same text to two sinks, a failed one does not stop the other */
+class XmlTeeSink : public XmlSink
+{
+    public:
+        XmlTeeSink(XmlSink &first_sink, XmlSink &second_sink) : first(first_sink), second(second_sink){};
+
+        virtual bool write(const char *data, size_t len);
+        virtual bool close();
+
+    private:
+        XmlTeeSink(const XmlTeeSink&);
+        XmlTeeSink& operator=(const XmlTeeSink&);
+
+        XmlSink &first;
+        XmlSink &second;
+};
+
+/*
+ Prints nodes to a sink with the indent, line breaks, escapes and quotes
+ of TiXmlPrinter, so a document printed here piece by piece is the same
+ text TiXmlPrinter and SaveFile give for the whole of it.
+*/
+class XmlSinkPrinter
+{
+    public:
+        explicit XmlSinkPrinter(XmlSink &out);
+
+        /* node and everything under it */
+        bool print_node(const TiXmlNode *node, int depth);
+        /* the start and end tag of an element printed with children between */
+        bool print_start(const TiXmlElement *elem, int depth);
+        bool print_end(const TiXmlElement *elem, int depth);
+        bool flush();
+
+        static void print_attributes(const TiXmlElement *elem, TIXML_STRING &out);
+
+    private:
+        XmlSinkPrinter(const XmlSinkPrinter&);
+        XmlSinkPrinter& operator=(const XmlSinkPrinter&);
+
+        void put(const char *data, size_t len);
+        void put(const char *str){put(str, strlen(str));};
+        void put(const TIXML_STRING &str){put(str.c_str(), str.length());};
+        void indent(int depth);
+
+        XmlSink &sink;
+        string buffer;
+        bool failed;
+};
+
+#endif
@@ -0,0 +1,393 @@
+// Copyright 2019 The OpenSDS Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use this file except in compliance with the License. You may obtain
+// a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "xmlstream.h"
+#include "xmlcommon.h"
+#include <cstring>
+#include <cstdlib>
+
+#define XML_ENTITY_MAXLEN   10
+
+static bool is_space(char c)
+{
+    return (' ' == c || '\t' == c || '\r' == c || '\n' == c);
+}
+
+static bool is_name_char(char c)
+{
+    return !is_space(c) && '>' != c && '/' != c && '=' != c && '<' != c && '\0' != c;
+}
+
+static void append_utf8(std::string &value, unsigned long code)
+{
+    if (code < 0x80){
+        value += (char)code;
+    }
+    else if (code < 0x800){
+        value += (char)(0xC0 | (code >> 6));
+        value += (char)(0x80 | (code & 0x3F));
+    }
+    else if (code < 0x10000){
+        value += (char)(0xE0 | (code >> 12));
+        value += (char)(0x80 | ((code >> 6) & 0x3F));
+        value += (char)(0x80 | (code & 0x3F));
+    }
+    else{
+        value += (char)(0xF0 | (code >> 18));
+        value += (char)(0x80 | ((code >> 12) & 0x3F));
+        value += (char)(0x80 | ((code >> 6) & 0x3F));
+        value += (char)(0x80 | (code & 0x3F));
+    }
+}
+
+bool xml_get_attr(const XmlAttrList &attrs, const char *name, std::string &value)
+{
+    XmlAttrList::const_iterator it;
+
+    CHECK_NULL(name, false);
+
+    for (it = attrs.begin(); it != attrs.end(); ++it){
+        if (it->first == name){
+            value = it->second;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*-------------------------------------------------------------------------
+ Function Name: parse
+ Description  : Parse one document and report it to the handler. Fails
+                on a malformed document, on a mismatched end tag, or
+                when the handler stops the parse; get_error_pos() then
+                tells where.
+ -------------------------------------------------------------------------*/
+bool XmlStreamParser::parse(const char *data, size_t len)
+{
+    CHECK_NULL(data, false);
+
+    this->data = data;
+    this->len = len;
+    pos = 0;
+    path.clear();
+    path_lens.clear();
+    pending.clear();
+    space_seen = false;
+    root_done = false;
+
+    while (pos < len){
+        if ('<' != data[pos]){
+            if ('&' == data[pos]){
+                CHECK_FALSE(!path_lens.empty(), false);
+                if (space_seen && !pending.empty()){
+                    pending += ' ';
+                }
+                CHECK_FALSE(read_entity(pending), false);
+                space_seen = false;
+                continue;
+            }
+
+            if (is_space(data[pos])){
+                space_seen = true;
+            }
+            else{
+                if (path_lens.empty()){
+                    return false;
+                }
+                if (space_seen && !pending.empty()){
+                    pending += ' ';
+                }
+                space_seen = false;
+                pending += data[pos];
+            }
+            pos++;
+            continue;
+        }
+
+        if (looking_at("<?")){
+            CHECK_FALSE(skip_to("?>"), false);
+        }
+        else if (looking_at("<!--")){
+            CHECK_FALSE(skip_to("-->"), false);
+        }
+        else if (looking_at("<![CDATA[")){
+            CHECK_FALSE(read_cdata(), false);
+        }
+        else if (looking_at("<!")){
+            CHECK_FALSE(skip_doctype(), false);
+        }
+        else if (looking_at("</")){
+            CHECK_FALSE(read_end(), false);
+        }
+        else{
+            CHECK_FALSE(read_start(), false);
+        }
+    }
+
+    return root_done && path_lens.empty();
+}
+
+bool XmlStreamParser::looking_at(const char *token) const
+{
+    size_t token_len = strlen(token);
+
+    return (pos + token_len <= len) && (0 == memcmp(data + pos, token, token_len));
+}
+
+bool XmlStreamParser::skip_to(const char *end)
+{
+    for (; pos < len; pos++){
+        if (looking_at(end)){
+            pos += strlen(end);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool XmlStreamParser::skip_doctype()
+{
+    int bracket = 0;
+
+    for (; pos < len; pos++){
+        if ('[' == data[pos]){
+            bracket++;
+        }
+        else if (']' == data[pos]){
+            bracket--;
+        }
+        else if ('>' == data[pos] && bracket <= 0){
+            pos++;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void XmlStreamParser::skip_space()
+{
+    while (pos < len && is_space(data[pos])){
+        pos++;
+    }
+}
+
+bool XmlStreamParser::read_name(std::string &name)
+{
+    size_t begin = pos;
+
+    while (pos < len && is_name_char(data[pos])){
+        pos++;
+    }
+
+    if (begin == pos){
+        return false;
+    }
+
+    name.assign(data + begin, pos - begin);
+    return true;
+}
+
+/*-------------------------------------------------------------------------
+ Function Name: read_entity
+ Description  : Decode the entity at pos into value. An unknown entity is
+                kept as a literal '&', as TinyXML does.
+ -------------------------------------------------------------------------*/
+bool XmlStreamParser::read_entity(std::string &value)
+{
+    size_t end = pos + 1;
+    std::string entity;
+    unsigned long code = 0;
+    char *stop = NULL;
+
+    while (end < len && end - pos <= XML_ENTITY_MAXLEN && ';' != data[end]){
+        end++;
+    }
+
+    if (end >= len || ';' != data[end]){
+        value += '&';
+        pos++;
+        return true;
+    }
+
+    entity.assign(data + pos + 1, end - pos - 1);
+
+    if ("lt" == entity){
+        value += '<';
+    }
+    else if ("gt" == entity){
+        value += '>';
+    }
+    else if ("amp" == entity){
+        value += '&';
+    }
+    else if ("quot" == entity){
+        value += '"';
+    }
+    else if ("apos" == entity){
+        value += '\'';
+    }
+    else if (entity.size() > 1 && '#' == entity[0]){
+        if ('x' == entity[1] || 'X' == entity[1]){
+            code = strtoul(entity.c_str() + 2, &stop, 16);
+        }
+        else{
+            code = strtoul(entity.c_str() + 1, &stop, 10);
+        }
+        CHECK_FALSE((NULL != stop && '\0' == *stop && 0 != code), false);
+        append_utf8(value, code);
+    }
+    else{
+        value += '&';
+        pos++;
+        return true;
+    }
+
+    pos = end + 1;
+    return true;
+}
+
+bool XmlStreamParser::read_attrs(XmlAttrList &attrs, bool &empty_elem)
+{
+    std::string name;
+    std::string value;
+    char quote = 0;
+
+    empty_elem = false;
+
+    for (;;){
+        skip_space();
+        CHECK_FALSE((pos < len), false);
+
+        if ('>' == data[pos]){
+            pos++;
+            return true;
+        }
+
+        if (looking_at("/>")){
+            pos += 2;
+            empty_elem = true;
+            return true;
+        }
+
+        CHECK_FALSE(read_name(name), false);
+        skip_space();
+        CHECK_FALSE((pos < len && '=' == data[pos]), false);
+        pos++;
+        skip_space();
+        CHECK_FALSE((pos < len && ('"' == data[pos] || '\'' == data[pos])), false);
+
+        quote = data[pos++];
+        value.clear();
+        while (pos < len && quote != data[pos]){
+            if ('&' == data[pos]){
+                CHECK_FALSE(read_entity(value), false);
+                continue;
+            }
+            value += data[pos++];
+        }
+        CHECK_FALSE((pos < len), false);
+        pos++;
+
+        attrs.push_back(std::make_pair(name, value));
+    }
+}
+
+bool XmlStreamParser::read_cdata()
+{
+    size_t begin = pos + 9;
+
+    pos = begin;
+    CHECK_FALSE(skip_to("]]>"), false);
+    CHECK_FALSE(!path_lens.empty(), false);
+
+    CHECK_FALSE(flush_text(), false);
+
+    return handler.text(path, std::string(data + begin, pos - 3 - begin));
+}
+
+bool XmlStreamParser::read_start()
+{
+    std::string name;
+    XmlAttrList attrs;
+    bool empty_elem = false;
+
+    if (root_done && path_lens.empty()){
+        return false;
+    }
+
+    CHECK_FALSE(flush_text(), false);
+
+    pos++;
+    CHECK_FALSE(read_name(name), false);
+    CHECK_FALSE(read_attrs(attrs, empty_elem), false);
+
+    path_lens.push_back(path.size());
+    path += '/';
+    path += name;
+
+    CHECK_FALSE(handler.start_element(path, name, attrs), false);
+
+    if (empty_elem){
+        CHECK_FALSE(handler.end_element(path), false);
+        path.resize(path_lens.back());
+        path_lens.pop_back();
+        root_done = root_done || path_lens.empty();
+    }
+
+    return true;
+}
+
+bool XmlStreamParser::read_end()
+{
+    std::string name;
+
+    CHECK_FALSE(!path_lens.empty(), false);
+    CHECK_FALSE(flush_text(), false);
+
+    pos += 2;
+    CHECK_FALSE(read_name(name), false);
+    skip_space();
+    CHECK_FALSE((pos < len && '>' == data[pos]), false);
+    pos++;
+
+    if (0 != path.compare(path_lens.back() + 1, std::string::npos, name)){
+        return false;
+    }
+
+    CHECK_FALSE(handler.end_element(path), false);
+
+    path.resize(path_lens.back());
+    path_lens.pop_back();
+    root_done = root_done || path_lens.empty();
+
+    return true;
+}
+
+bool XmlStreamParser::flush_text()
+{
+    bool ret = true;
+
+    space_seen = false;
+    if (pending.empty()){
+        return true;
+    }
+
+    ret = handler.text(path, pending);
+    pending.clear();
+
+    return ret;
+}
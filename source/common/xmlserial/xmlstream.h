@@ -0,0 +1,91 @@
+// Copyright 2019 The OpenSDS Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use this file except in compliance with the License. You may obtain
+// a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#ifndef XMLSTREAM_H
+#define XMLSTREAM_H
+
+#include <string>
+#include <vector>
+#include <utility>
+
+typedef std::vector<std::pair<std::string, std::string> > XmlAttrList;
+
+bool xml_get_attr(const XmlAttrList &attrs, const char *name, std::string &value);
+
+/*
+ Receives the events of one XmlStreamParser pass. path is the slash
+ separated path of the element from the root, e.g.
+ "/Command/FailoverParameters/TargetDevices/TargetDevice". Returning
+ false from any event stops the parse.
+
+ claim() is only asked by XmlReader::load_from_stream: the subtree of a
+ claimed element is handed to the handler alone and left out of the
+ reader's document.
+*/
+class XmlStreamHandler
+{
+    public:
+        XmlStreamHandler(){};
+        virtual ~XmlStreamHandler(){};
+
+        virtual bool claim(const std::string &path) {(void)path; return false;}
+        virtual bool start_element(const std::string &path, const std::string &name, const XmlAttrList &attrs) = 0;
+        virtual bool text(const std::string &path, const std::string &value) = 0;
+        virtual bool end_element(const std::string &path) = 0;
+};
+
+/*
+ Single pass, non validating parser over an in-memory document. It keeps
+ only the current element path and the token being read, so nothing of
+ the document outlives the events. Text is condensed the way TinyXML
+ does by default; comments, processing instructions and the DOCTYPE are
+ skipped.
+*/
+class XmlStreamParser
+{
+    public:
+        explicit XmlStreamParser(XmlStreamHandler &handler) : handler(handler), data(NULL), len(0), pos(0), space_seen(false), root_done(false){}
+        ~XmlStreamParser(){}
+
+        bool parse(const char *data, size_t len);
+        size_t get_error_pos() const {return pos;}
+
+    private:
+        XmlStreamParser(const XmlStreamParser&);
+        XmlStreamParser& operator=(const XmlStreamParser&);
+
+        bool looking_at(const char *token) const;
+        bool skip_to(const char *end);
+        bool skip_doctype();
+        bool read_name(std::string &name);
+        bool read_entity(std::string &value);
+        bool read_attrs(XmlAttrList &attrs, bool &empty_elem);
+        bool read_cdata();
+        bool read_start();
+        bool read_end();
+        bool flush_text();
+        void skip_space();
+
+        XmlStreamHandler &handler;
+        const char *data;
+        size_t len;
+        size_t pos;
+        std::string path;
+        std::vector<size_t> path_lens;
+        std::string pending;
+        bool space_seen;
+        bool root_done;
+};
+
+#endif
@@ -16,11 +16,19 @@
 #include "xmlcommon.h"
 #include "securec.h"
 
+/* user data of the elements set_xml creates, and of the ones streamed and emptied */
+static int g_stream_container = 0;
+static int g_stream_sealed = 0;
+
 XmlWriter::XmlWriter(const string& str)
 {
     flag = false;
     xmlreaderdoc = NULL;
     parentelem = NULL;
+    printer = NULL;
+    stream_sink = NULL;
+    stream_failed = false;
+    doc_done = NULL;
     (void)xml_writer_init(str);
 };
 
@@ -28,6 +36,10 @@ XmlWriter::XmlWriter(const string& str)
 XmlWriter::~XmlWriter()
 {
     try{
+        if (NULL != printer){
+            delete printer;
+            printer = NULL;
+        }
         if (NULL != xmlreaderdoc){
             delete xmlreaderdoc;
             xmlreaderdoc = NULL;
@@ -56,6 +68,7 @@ Others         :
 -------------------------------------------------------------------------*/
 bool XmlWriter::xml_writer_init(const string& str)
 {
+    run_index.clear();
     xmlreaderdoc = new TiXmlDocument;
     CHECK_NULL(xmlreaderdoc, NULL);
 
@@ -77,6 +90,7 @@ bool XmlWriter::xml_writer_init(const string& str)
         return false;
     }
 
+    pRootEle->SetUserData(&g_stream_container);
     if(NULL != xmlreaderdoc->LinkEndChild(pRootEle))
         parentelem = pRootEle;
     pRootEle = NULL;
@@ -116,16 +130,7 @@ TiXmlElement* XmlWriter::get_last_elem_byname(int deepth, char name_array[][NAME
     tempelem = elem;
 
     if (true == flag){
-        for (tempelem = elem; tempelem != NULL; tempelem = tempelem->NextSiblingElement()){
-            if (strncmp(name_array[deepth], tempelem->Value(), NAMELEN)){
-                break;
-            }
-            else{
-                elem = tempelem;
-            }
-        }
-
-        return elem;
+        return get_last_in_run(name_array[deepth]);
     }
     
     int i = 0;
@@ -153,6 +158,42 @@ TiXmlElement* XmlWriter::get_last_elem_byname(int deepth, char name_array[][NAME
     return elem;
 }
 
+/*-------------------------------------------------------------------------
+Function Name: get_last_in_run
+Description  : Get the last element of the first run of same named
+               children of parentelem, internal interface. The result is
+               remembered per parent and name and only walked forward over
+               the elements appended since, so appending N elements under
+               one parent costs O(N) instead of O(N^2).
+Input        : name: element name
+Return       : the element, NULL if parentelem has no child of that name
+-------------------------------------------------------------------------*/
+TiXmlElement* XmlWriter::get_last_in_run(const char *name)
+{
+    TiXmlElement *elem = NULL;
+    TiXmlElement *next = NULL;
+    pair<TiXmlElement *, string> key(parentelem, name);
+    map<pair<TiXmlElement *, string>, TiXmlElement *>::iterator it = run_index.find(key);
+
+    if (run_index.end() == it){
+        elem = parentelem->FirstChildElement(name);
+        CHECK_NULL(elem, NULL);
+
+        it = run_index.insert(make_pair(key, elem)).first;
+    }
+
+    elem = it->second;
+    for (next = elem->NextSiblingElement(); NULL != next; next = next->NextSiblingElement()){
+        if (strncmp(name, next->Value(), NAMELEN)){
+            break;
+        }
+        elem = next;
+    }
+
+    it->second = elem;
+    return elem;
+}
+
 /*-------------------------------------------------------------------------
 Function Name: set_string
 Description  : Set the value of the node element, the type of the value is a string
@@ -476,6 +517,7 @@ bool XmlWriter::set_xml(const char * path, XmlSerializable * obj)
             TiXmlElement *elem = new TiXmlElement(name_array[i]);
             CHECK_NULL(elem, false);
 
+            elem->SetUserData(&g_stream_container);
             if(NULL != tempparentelem1->LinkEndChild(elem))
                 tempparentelem1 = elem;
 
@@ -492,6 +534,10 @@ bool XmlWriter::set_xml(const char * path, XmlSerializable * obj)
     parentelem = tempparentelem2;
     flag = false; 
 
+    if (NULL != printer){
+        stream_run(tempparentelem1);
+    }
+
     return true;
 }
 
@@ -522,4 +568,317 @@ bool XmlWriter::save_to_file(const char * filename)
     CHECK_FALSE(ret, false);
 
     return ret;
-}
\ No newline at end of file
+}
+
+/*-------------------------------------------------------------------------
+Function Name: save_to_file
+Description  : Render the document once, write that text to filename and
+               hand the same text back in content, so a caller that logs
+               the response does not read the file again. TiXmlPrinter
+               uses the same 4 space indent and line breaks as SaveFile,
+               and the file is opened in text mode as SaveFile does.
+Input        : filename
+Output       : content: the text written
+Return       : false if the file could not be written, content is set
+               anyway.
+-------------------------------------------------------------------------*/
+bool XmlWriter::save_to_file(const char *filename, string &content)
+{
+    FILE *fp = NULL;
+    size_t written = 0;
+    TiXmlPrinter printer;
+
+    CHECK_NULL(filename, false);
+    CHECK_NULL(xmlreaderdoc, false);
+
+    CHECK_FALSE(xmlreaderdoc->Accept(&printer), false);
+    content.assign(printer.CStr(), printer.Size());
+
+    fp = fopen(filename, "w");
+    CHECK_NULL(fp, false);
+
+    written = fwrite(content.data(), 1, content.size(), fp);
+    if (0 != fclose(fp) || written != content.size()){
+        return false;
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------------
+Function Name: stream_to
+Description  : Stream the document into sink while it is written instead
+               of keeping all of it until save. Each time set_xml returns
+               from writing an element of a list, the elements before it
+               are printed to sink and emptied, so a response of N
+               devices keeps N empty elements instead of N devices in
+               the tree. Only lists
+               whose parents were all created by set_xml are streamed,
+               the elements the objects write themselves may still get
+               attributes after their children. save_to(sink) prints the
+               rest, the text is the same save_to_file writes.
+Input        : sink: kept until save_to
+Return       : false if the writer already streams.
+-------------------------------------------------------------------------*/
+bool XmlWriter::stream_to(XmlSink &sink)
+{
+    if (NULL != printer){
+        return false;
+    }
+
+    printer = new XmlSinkPrinter(sink);
+    CHECK_NULL(printer, false);
+
+    stream_sink = &sink;
+    stream_failed = false;
+    doc_done = NULL;
+    open_elems.clear();
+
+    return true;
+}
+
+/*-------------------------------------------------------------------------
+Function Name: save_to
+Description  : Print what is not printed yet to sink, all of the document
+               unless stream_to(sink) was called. The sink is flushed but
+               not closed. A streamed writer is empty afterwards.
+Input        : sink
+Return       : false if the sink failed, or if an element was changed
+               after it was streamed, the text is not the document then.
+-------------------------------------------------------------------------*/
+bool XmlWriter::save_to(XmlSink &sink)
+{
+    CHECK_NULL(xmlreaderdoc, false);
+
+    if (NULL == printer){
+        XmlSinkPrinter whole(sink);
+
+        for (TiXmlNode *node = xmlreaderdoc->FirstChild(); NULL != node; node = node->NextSibling()){
+            CHECK_FALSE(whole.print_node(node, 0), false);
+        }
+
+        return whole.flush();
+    }
+
+    if (&sink != stream_sink){
+        return false;
+    }
+
+    if (!is_sealed_intact(xmlreaderdoc)){
+        stream_failed = true;
+    }
+
+    if (!stream_failed && stream_close(0)){
+        (void)stream_children(xmlreaderdoc, doc_done, NULL, 0);
+    }
+
+    if (!printer->flush()){
+        stream_failed = true;
+    }
+
+    delete printer;
+    printer = NULL;
+    stream_sink = NULL;
+    open_elems.clear();
+
+    return !stream_failed;
+}
+
+/*-------------------------------------------------------------------------
+Function Name: stream_run
+Description  : Print the elements before the last child of list_parent,
+               internal interface. Called when set_xml returns, the last
+               child is the one it wrote and may still be written to.
+               The start tags from the root down to list_parent are
+               printed first, elements left open above an earlier list
+               are closed.
+Input        : list_parent: the element set_xml wrote into
+-------------------------------------------------------------------------*/
+void XmlWriter::stream_run(TiXmlElement *list_parent)
+{
+    vector<TiXmlElement *> chain;
+    TiXmlNode *last = NULL;
+    TiXmlNode *prev = NULL;
+    size_t level = 0;
+
+    if (stream_failed || NULL == list_parent){
+        return;
+    }
+
+    // only a run of at least two, a single element is not known to be a list
+    last = list_parent->LastChild();
+    if (NULL == last || NULL == last->ToElement()){
+        return;
+    }
+    prev = last->PreviousSibling();
+    if (NULL == prev || NULL == prev->ToElement() || strcmp(prev->Value(), last->Value())){
+        return;
+    }
+
+    for (TiXmlNode *node = list_parent; NULL != node && xmlreaderdoc != node; node = node->Parent()){
+        TiXmlElement *elem = node->ToElement();
+
+        if (NULL == elem || &g_stream_container != elem->GetUserData()){
+            return;
+        }
+        chain.insert(chain.begin(), elem);
+    }
+
+    while (level < open_elems.size() && level < chain.size() && open_elems[level].elem == chain[level]){
+        level++;
+    }
+
+    // what stays open below level must come before the new chain, else wait
+    if (level < open_elems.size()){
+        TiXmlNode *target = (level < chain.size()) ? chain[level] : last;
+        TiXmlNode *node = open_elems[level].elem->NextSibling();
+
+        while (NULL != node && target != node){
+            node = node->NextSibling();
+        }
+        if (NULL == node || !stream_close(level)){
+            return;
+        }
+    }
+
+    for (; level < chain.size(); level++){
+        TiXmlNode *parent = (0 == level) ? (TiXmlNode *)xmlreaderdoc : (TiXmlNode *)chain[level - 1];
+        TiXmlNode *&done = (0 == level) ? doc_done : open_elems[level - 1].done;
+        XML_OPEN_ELEM open;
+
+        if (!stream_children(parent, done, chain[level], (int)level)){
+            return;
+        }
+        if (!printer->print_start(chain[level], (int)level)){
+            stream_failed = true;
+            return;
+        }
+
+        open.elem = chain[level];
+        open.done = NULL;
+        XmlSinkPrinter::print_attributes(chain[level], open.attributes);
+        open_elems.push_back(open);
+    }
+
+    (void)stream_children(list_parent, open_elems.back().done, last, (int)chain.size());
+}
+
+/*-------------------------------------------------------------------------
+Function Name: stream_children
+Description  : Print the children of parent after done up to stop, and
+               empty the elements among them, internal interface.
+Input        : parent, stop: NULL for all, depth: of the children
+Output       : done: the last child printed
+Return       : false if the sink failed.
+-------------------------------------------------------------------------*/
+bool XmlWriter::stream_children(TiXmlNode *parent, TiXmlNode *&done, const TiXmlNode *stop, int depth)
+{
+    TiXmlNode *child = (NULL == done) ? parent->FirstChild() : done->NextSibling();
+
+    for (; NULL != child && stop != child; child = child->NextSibling()){
+        if (!printer->print_node(child, depth)){
+            stream_failed = true;
+            return false;
+        }
+
+        if (NULL != child->ToElement()){
+            seal(child->ToElement());
+        }
+        done = child;
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------------
+Function Name: stream_close
+Description  : Print the rest and the end tags of the open elements from
+               the deepest up to level, internal interface. An element
+               whose attributes changed since its start tag fails the
+               stream.
+Input        : level: the first open element to close
+Return       : false if the stream failed.
+-------------------------------------------------------------------------*/
+bool XmlWriter::stream_close(size_t level)
+{
+    while (level < open_elems.size()){
+        XML_OPEN_ELEM &open = open_elems.back();
+        TiXmlElement *elem = open.elem;
+        TIXML_STRING attributes;
+        int depth = (int)open_elems.size() - 1;
+
+        CHECK_FALSE(stream_children(elem, open.done, NULL, depth + 1), false);
+
+        XmlSinkPrinter::print_attributes(elem, attributes);
+        if (!(attributes == open.attributes) || !printer->print_end(elem, depth)){
+            stream_failed = true;
+            return false;
+        }
+
+        seal(elem);
+        open_elems.pop_back();
+        if (!open_elems.empty()){
+            open_elems.back().done = elem;
+        }
+        else{
+            doc_done = xmlreaderdoc->RootElement();
+        }
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------------
+Function Name: seal
+Description  : Empty a printed element, internal interface. It stays in
+               the tree so the lookups of set_string and set_xml still
+               find it, anything written to it later is found by save_to.
+Input        : elem
+-------------------------------------------------------------------------*/
+void XmlWriter::seal(TiXmlElement *elem)
+{
+    forget_runs(elem);
+    elem->Clear();
+
+    while (NULL != elem->FirstAttribute()){
+        elem->RemoveAttribute(elem->FirstAttribute()->Name());
+    }
+    elem->SetUserData(&g_stream_sealed);
+}
+
+/* drop the runs remembered under elem and its descendants before they are freed */
+void XmlWriter::forget_runs(TiXmlElement *elem)
+{
+    map<pair<TiXmlElement *, string>, TiXmlElement *>::iterator it = run_index.lower_bound(make_pair(elem, string()));
+
+    while (run_index.end() != it && elem == it->first.first){
+        run_index.erase(it++);
+    }
+
+    for (TiXmlElement *child = elem->FirstChildElement(); NULL != child; child = child->NextSiblingElement()){
+        forget_runs(child);
+    }
+}
+
+/* true if no element printed and emptied under node was written to again */
+bool XmlWriter::is_sealed_intact(const TiXmlNode *node)
+{
+    for (const TiXmlNode *child = node->FirstChild(); NULL != child; child = child->NextSibling()){
+        const TiXmlElement *elem = child->ToElement();
+
+        if (NULL == elem){
+            continue;
+        }
+
+        if (&g_stream_sealed == elem->GetUserData()){
+            if (NULL != elem->FirstChild() || NULL != elem->FirstAttribute()){
+                return false;
+            }
+        }
+        else if (!is_sealed_intact(elem)){
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -16,15 +16,26 @@
 #define XMLWRITER_H
 #include <string>
 #include <iostream>
+#include <map>
+#include <vector>
 #include "tinyxml.h"
 #include "xmlserializable.h"
+#include "xmlsink.h"
 
 using namespace std;
 
+/* an element whose start tag has been streamed and end tag not yet */
+typedef struct
+{
+    TiXmlElement *elem;
+    TiXmlNode *done;            /* last child streamed, NULL for none */
+    TIXML_STRING attributes;    /* as streamed in the start tag */
+} XML_OPEN_ELEM;
+
 class XmlWriter
 {
     public:
-        XmlWriter(){flag = false;xmlreaderdoc = NULL;parentelem = NULL;string str = "Response";(void)xml_writer_init(str);};
+        XmlWriter(){flag = false;xmlreaderdoc = NULL;parentelem = NULL;printer = NULL;stream_sink = NULL;stream_failed = false;doc_done = NULL;string str = "Response";(void)xml_writer_init(str);};
         XmlWriter(const string& str);
 
         virtual ~XmlWriter();
@@ -36,6 +47,9 @@ class XmlWriter
         bool set_string(const char *path, const char *value, int index = 0);
         bool set_xml(const char *path, XmlSerializable *obj);
         bool save_to_file(const char *filename);
+        bool save_to_file(const char *filename, string &content);
+        bool stream_to(XmlSink &sink);
+        bool save_to(XmlSink &sink);
 
     private:
         XmlWriter(const XmlWriter&);
@@ -43,10 +57,28 @@ class XmlWriter
 
         bool xml_writer_init(const string& str);
         TiXmlElement* get_last_elem_byname(int i, char name_array[][NAMELEN], int index, bool end_flag);
+        TiXmlElement* get_last_in_run(const char *name);
+        void stream_run(TiXmlElement *list_parent);
+        bool stream_children(TiXmlNode *parent, TiXmlNode *&done, const TiXmlNode *stop, int depth);
+        bool stream_close(size_t level);
+        void seal(TiXmlElement *elem);
+        void forget_runs(TiXmlElement *elem);
+        bool is_sealed_intact(const TiXmlNode *node);
 
         TiXmlDocument *xmlreaderdoc;
         TiXmlElement *parentelem;
         bool flag; 
+
+        // last element of the first run of each name under a parent, elements
+        // are only ever appended so a run can only grow at its end
+        map<pair<TiXmlElement *, string>, TiXmlElement *> run_index;
+
+        // streaming, printer is NULL unless stream_to() was called
+        XmlSinkPrinter *printer;
+        XmlSink *stream_sink;
+        bool stream_failed;
+        TiXmlNode *doc_done;
+        vector<XML_OPEN_ELEM> open_elems;
 };
 
 #ifndef NODENUM
@@ -14,16 +14,25 @@
 
 #include "ThreeDCLun.h"
 
-int ThreeDCLun::full_ABInfo(CCmdOperate& cmdOperate,const string& lunId)
+int ThreeDCLun::full_ABInfo(const string& lunId,const HyperIndex& hyper_index)
 {
     id = lunId;
     
     //query ab relation info:
     //1 query all copy pair(with consis) todo
-    //2 query all hypers(with consis)
-    list<HYPERMETROPAIR_INFO_STRU> rlstHyperMetroPairInfo;
-    CHECK_UNEQ_LOG(RETURN_OK,cmdOperate.CMD_showHyperMetroPair_all(rlstHyperMetroPairInfo));
-    deal_hypers(cmdOperate,rlstHyperMetroPairInfo);
+    //2 find the hyper of the lun in the listing of all hypers(with consis)
+    map<string, string>::const_iterator it_pair = hyper_index.pair_by_lun.find(lunId);
+    if(it_pair == hyper_index.pair_by_lun.end()){
+        return RETURN_OK;
+    }
+
+    map<string, HYPERMETROPAIR_INFO_STRU>::const_iterator it_info = hyper_index.pairs.find(it_pair->second);
+    map<string, list<HYPERMETRO_LF_INFO_STRU> >::const_iterator it_members = hyper_index.members.find(it_pair->second);
+    if(it_info == hyper_index.pairs.end() || it_members == hyper_index.members.end()){
+        return RETURN_OK;
+    }
+
+    deal_hyper(it_info->second,it_members->second);
     return RETURN_OK;
 }
 
@@ -66,39 +75,83 @@ bool ThreeDCLun::is_nfs_lun(CCmdOperate& cmdOperate, string& fs_id)
     }
 }
 
-void ThreeDCLun::deal_hypers(CCmdOperate& cmdOperate,list<HYPERMETROPAIR_INFO_STRU>& rlstHyperMetroPairInfo)
+void ThreeDCLun::deal_hyper(const HYPERMETROPAIR_INFO_STRU& pair_info,const list<HYPERMETRO_LF_INFO_STRU>& lstHMLUNInfo)
 {
-    for(list<HYPERMETROPAIR_INFO_STRU>::iterator it = rlstHyperMetroPairInfo.begin();it != rlstHyperMetroPairInfo.end();it++){
-        list<HYPERMETRO_LF_INFO_STRU> rlstHMLUNInfo;
-        cmdOperate.CMD_showhypermetrolun_all(it->strID, rlstHMLUNInfo);
-        HYPERMETRO_LF_INFO_STRU& local = rlstHMLUNInfo.front();
-        
-        COMMLOG(OS_LOG_INFO,"expected lun id[%s],query lun_id[%s],expected array_id[%s],query array_id[%s]"
-            ,id.c_str(),local.strID.c_str(),array_id.c_str(),local.strArrayWWN.c_str());
-        if(local.strID == id && array_id == local.strArrayWWN){
-            list<HYPERMETRO_LF_INFO_STRU>::iterator r_it = rlstHMLUNInfo.begin();
-            HYPERMETRO_LF_INFO_STRU& remote = *(++r_it);
-            
-            
-            if(local.strIsinCg == "true"){
-                ab_info.id = it->strGroupID;
-                ab_info.relation = Relation::CONSIS_HYPER;
-                COMMLOG(OS_LOG_INFO,"find 3dc lun[consis hyper,consisId[ %s ]] in DataCenterB",ab_info.id.c_str());
-            }
-            else{
-                ab_info.id = local.strHMpairID;
-                ab_info.relation = Relation::PAIR_HYPER;
-                COMMLOG(OS_LOG_INFO,"find 3dc lun[pair hyper,pairId[ %s ]] in DataCenterB",ab_info.id.c_str());
-            }
-            is3dc = true;
-            ab_info.is_primary = (local.uiRelationType == LUN_RELATION_MASTER);
-            ab_info.access = local.uiLocalAccess;
-            ab_info.status = local.uiPairStatus;
-            COMMLOG(OS_LOG_INFO,"the 3dc lun in DataCenterB read_write status[%d],running status[%d]",ab_info.access,ab_info.status);
-            break;
+    const HYPERMETRO_LF_INFO_STRU& local = lstHMLUNInfo.front();
+    
+    COMMLOG(OS_LOG_INFO,"expected lun id[%s],query lun_id[%s],expected array_id[%s],query array_id[%s]"
+        ,id.c_str(),local.strID.c_str(),array_id.c_str(),local.strArrayWWN.c_str());
+    if(local.strID != id || array_id != local.strArrayWWN){
+        return;
+    }
+
+    if(local.strIsinCg == "true"){
+        ab_info.id = pair_info.strGroupID;
+        ab_info.relation = Relation::CONSIS_HYPER;
+        COMMLOG(OS_LOG_INFO,"find 3dc lun[consis hyper,consisId[ %s ]] in DataCenterB",ab_info.id.c_str());
+    }
+    else{
+        ab_info.id = local.strHMpairID;
+        ab_info.relation = Relation::PAIR_HYPER;
+        COMMLOG(OS_LOG_INFO,"find 3dc lun[pair hyper,pairId[ %s ]] in DataCenterB",ab_info.id.c_str());
+    }
+    is3dc = true;
+    ab_info.is_primary = (local.uiRelationType == LUN_RELATION_MASTER);
+    ab_info.access = local.uiLocalAccess;
+    ab_info.status = local.uiPairStatus;
+    COMMLOG(OS_LOG_INFO,"the 3dc lun in DataCenterB read_write status[%d],running status[%d]",ab_info.access,ab_info.status);
+}
+
+/*
+ The hypermetro pairs and their members are listed once per command and
+ indexed by the local lun, so that classifying the luns of all devices
+ and consistency groups does not query every pair for every lun.
+ A pair missing from the member listing is queried on its own.
+*/
+int ThreeDCLunHelper::load_hyper_index(CCmdOperate& cmdOperate)
+{
+    int ret = RETURN_ERR;
+    list<HYPERMETROPAIR_INFO_STRU> lstHyperMetroPairInfo;
+
+    if(hyper_index.loaded){
+        return RETURN_OK;
+    }
+
+    CHECK_UNEQ_LOG(RETURN_OK,cmdOperate.CMD_showHyperMetroPair_all(lstHyperMetroPairInfo));
+    hyper_index.loaded = true;
+
+    if(lstHyperMetroPairInfo.empty()){
+        return RETURN_OK;
+    }
+
+    ret = cmdOperate.CMD_showhypermetrolun_all(hyper_index.members);
+    if(RETURN_OK != ret){
+        COMMLOG(OS_LOG_WARN,"list hypermetro members fail(%d), query them one by one.",ret);
+        hyper_index.members.clear();
+    }
+
+    for(list<HYPERMETROPAIR_INFO_STRU>::iterator it = lstHyperMetroPairInfo.begin();it != lstHyperMetroPairInfo.end();it++){
+        hyper_index.pairs[it->strID] = *it;
+
+        map<string, list<HYPERMETRO_LF_INFO_STRU> >::iterator it_members = hyper_index.members.find(it->strID);
+        if(it_members == hyper_index.members.end()){
+            list<HYPERMETRO_LF_INFO_STRU> lstHMLUNInfo;
+            (void)cmdOperate.CMD_showhypermetrolun_all(it->strID, lstHMLUNInfo);
+            it_members = hyper_index.members.insert(make_pair(it->strID, lstHMLUNInfo)).first;
+        }
+
+        if(it_members->second.size() < 2){
+            COMMLOG(OS_LOG_WARN,"members of hyper pair[%s] are unknown",it->strID.c_str());
+            continue;
         }
 
+        hyper_index.pair_by_lun[it_members->second.front().strID] = it->strID;
     }
+
+    COMMLOG(OS_LOG_INFO,"index %u hyper pairs of %u luns for 3dc",
+        (unsigned int)hyper_index.pairs.size(),(unsigned int)hyper_index.pair_by_lun.size());
+
+    return RETURN_OK;
 }
 
 
@@ -180,7 +233,7 @@ int ThreeDCLunHelper::find_luns_from_consis(CCmdOperate& cmdOperate)
         for(vector<string>::iterator lun = lun_ids.begin(); lun != lun_ids.end();lun++){
             ThreeDCLun three_dc_lun(m_input_array_id);
             three_dc_lun.assign_BCInfo(bc_info);
-            if(three_dc_lun.full_ABInfo(cmdOperate,*lun) != RETURN_OK){
+            if(load_hyper_index(cmdOperate) != RETURN_OK || three_dc_lun.full_ABInfo(*lun,hyper_index) != RETURN_OK){
                 COMMLOG(OS_LOG_ERROR,"handle ABInfo fail");
                 return RETURN_ERR;
             }
@@ -225,7 +278,7 @@ int ThreeDCLunHelper::find_luns_from_devices(CCmdOperate& cmdOperate)
 
         ThreeDCLun three_dc_lun(m_input_array_id);
         three_dc_lun.assign_BCInfo(bc_info);
-        if(three_dc_lun.full_ABInfo(cmdOperate,lun_id) != RETURN_OK){
+        if(load_hyper_index(cmdOperate) != RETURN_OK || three_dc_lun.full_ABInfo(lun_id,hyper_index) != RETURN_OK){
             COMMLOG(OS_LOG_ERROR,"handle ABInfo fail");
             return RETURN_ERR;
         }
@@ -42,17 +42,26 @@ struct ThreeDCLun
         Relation relation;
         string id; //pair_id or consis_id
     };
+    //hypermetro pairs of the array with their members, listed once for all luns
+    struct HyperIndex
+    {
+        HyperIndex():loaded(false){}
+        map<string, HYPERMETROPAIR_INFO_STRU> pairs; //by pair_id
+        map<string, list<HYPERMETRO_LF_INFO_STRU> > members; //by pair_id
+        map<string, string> pair_by_lun; //local lun_id to pair_id
+        bool loaded;
+    };
 
     ThreeDCLun(const string& array_id):array_id(array_id),is3dc(false){}
 
-    int full_ABInfo(CCmdOperate& cmdOperate,const string& lun_id);
+    int full_ABInfo(const string& lun_id,const HyperIndex& hyper_index);
     void assign_BCInfo(const BCInfo& bcinfo);
     bool is_nfs_lun(CCmdOperate& cmdOperate, string& fs_id);
     bool is3DC();
     ABInfo& getABInfo();
     BCInfo& getBCInfo();
 private:
-    void deal_hypers(CCmdOperate& cmdOperate,list<HYPERMETROPAIR_INFO_STRU>& rlstHyperMetroPairInfo);
+    void deal_hyper(const HYPERMETROPAIR_INFO_STRU& pair_info,const list<HYPERMETRO_LF_INFO_STRU>& lstHMLUNInfo);
 private:
     bool is3dc;
     string id; //lunid
@@ -72,12 +81,14 @@ struct ThreeDCLunHelper
     int find_luns_from_consis(CCmdOperate& cmdOperate);
     int find_luns_from_devices(CCmdOperate& cmdOperate);
     int query_all_luns_by_consis_id(CCmdOperate& cmdOperate,const string& flag,const string& consis_id,vector<string>& lun_ids);
+    int load_hyper_index(CCmdOperate& cmdOperate);
 private:
     const string& m_input_array_id;
     ConGroupsInfo& m_consistency_group_info;
     DevicesInfo& m_devices_info;
 protected:
     vector<ThreeDCLun> three_dc_luns;
+    ThreeDCLun::HyperIndex hyper_index;
 };
 
 
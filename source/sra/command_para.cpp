@@ -0,0 +1,323 @@
+// Copyright 2019 The OpenSDS Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use this file except in compliance with the License. You may obtain
+// a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "command_para.h"
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+
+#define PARA_SUFFIX         "Parameters"
+#define SRA_STDIN_BLOCK     (64 * 1024)
+
+CommandPara g_command_para;
+
+/*
+ Paths are relative to <...Parameters>. An element without its identifying
+ attribute is still added with an empty key, but marks the command as
+ key missing when the key is required.
+*/
+const CommandPara::PARA_BINDING CommandPara::bindings[] = {
+    {"TargetGroups/TargetGroup", "key", true, &CommandPara::_add_target_group},
+    {"TargetGroups/TargetGroup/TargetDevices/TargetDevice", "key", true, &CommandPara::_add_group_device},
+    {"TargetGroups/TargetGroup/TargetDevices/TargetDevice/AccessGroups/AccessGroup", "id", false, &CommandPara::_add_group_access},
+    {"ConsistencyGroups/ConsistencyGroup", "id", true, &CommandPara::_add_cons_group},
+    {"ConsistencyGroups/ConsistencyGroup/Devices/Device", "id", true, &CommandPara::_add_group_device},
+    {"ConsistencyGroups/ConsistencyGroup/Devices/Device/AccessGroups/AccessGroup", "id", false, &CommandPara::_add_group_access},
+    {"TargetDevices/TargetDevice", "key", true, &CommandPara::_add_target_device},
+    {"TargetDevices/TargetDevice/AccessGroups/AccessGroup", "id", false, &CommandPara::_add_target_device_access},
+    {"Devices/Device", "id", true, &CommandPara::_add_device},
+    {"Devices/Device/AccessGroups/AccessGroup", "id", false, &CommandPara::_add_device_access},
+    {"SourceDevices/SourceDevice", "id", true, &CommandPara::_add_source_device},
+    {"AccessGroups/AccessGroup", "id", false, &CommandPara::_set_access_group},
+    {"AccessGroups/AccessGroup/Initiator", "id", false, &CommandPara::_add_dar_host},
+    {NULL, NULL, false, NULL}
+};
+
+/*
+ Read the whole command from fp in blocks, main passes stdin. When fp is a
+ file its size is known and the buffer is reserved once, from a pipe it is
+ read in SRA_STDIN_BLOCK blocks and the buffer grows geometrically.
+*/
+bool read_command(FILE *fp, string &input)
+{
+    long size = 0;
+    size_t len = 0;
+    size_t chunk = 0;
+    size_t count = 0;
+
+    input.clear();
+    if (NULL == fp){
+        return false;
+    }
+
+    if (0 == fseek(fp, 0, SEEK_END)){
+        size = ftell(fp);
+        (void)fseek(fp, 0, SEEK_SET);
+    }
+    input.reserve((size > 0) ? (size_t)size + 1 : SRA_STDIN_BLOCK);
+
+    do{
+        len = input.size();
+        chunk = (input.capacity() > len) ? input.capacity() - len : SRA_STDIN_BLOCK;
+
+        input.resize(len + chunk);
+        count = fread(&input[len], 1, chunk, fp);
+        input.resize(len + count);
+    }while (count == chunk);
+
+    return 0 == ferror(fp);
+}
+
+/*
+ Load a command document into reader, streaming its device lists into
+ g_command_para. This is all the XML work done before dispatch, so it is
+ the one entry to drive with synthetic or malformed commands, see
+ test/xml_fuzz.cpp. streamed is false when the streaming parse failed and
+ the whole command was read into the DOM instead.
+*/
+bool load_command(XmlReader &reader, const string &input, bool &streamed)
+{
+    g_command_para.clear();
+
+    // stream the device lists into g_command_para, the DOM only keeps the rest
+    streamed = reader.load_from_stream(input.c_str(), input.size(), g_command_para);
+    if (streamed){
+        return true;
+    }
+
+    g_command_para.clear();
+
+    return reader.load_from_string(input, TIXML_DEFAULT_ENCODING);
+}
+
+void CommandPara::clear()
+{
+    target_groups.clear();
+    cons_groups.clear();
+    target_devices.clear();
+    devices.clear();
+    source_devices.clear();
+    group_access.clear();
+    dar_hosts.clear();
+    access_group.clear();
+    loaded = false;
+    key_missing = false;
+    para_len = 0;
+    value_error.clear();
+}
+
+void CommandPara::swap(CommandPara &other)
+{
+    target_groups.swap(other.target_groups);
+    cons_groups.swap(other.cons_groups);
+    target_devices.swap(other.target_devices);
+    devices.swap(other.devices);
+    source_devices.swap(other.source_devices);
+    group_access.swap(other.group_access);
+    dar_hosts.swap(other.dar_hosts);
+    access_group.swap(other.access_group);
+    std::swap(loaded, other.loaded);
+    std::swap(key_missing, other.key_missing);
+    std::swap(para_len, other.para_len);
+    value_error.swap(other.value_error);
+}
+
+/*
+ Take the list elements directly below /Command/<...Parameters> that have
+ a binding, the scalars of the command stay in the reader's document.
+*/
+bool CommandPara::claim(const string &path)
+{
+    string::size_type para_begin = path.find('/', 1);
+    string::size_type list_begin = path.rfind('/');
+    string para_name;
+    string list_name;
+
+    if (string::npos == para_begin || path.find('/', para_begin + 1) != list_begin){
+        return false;
+    }
+
+    para_name = path.substr(para_begin + 1, list_begin - para_begin - 1);
+    list_name = path.substr(list_begin + 1) + "/";
+
+    if (para_name.size() <= strlen(PARA_SUFFIX) ||
+        0 != para_name.compare(para_name.size() - strlen(PARA_SUFFIX), string::npos, PARA_SUFFIX)){
+        return false;
+    }
+
+    for (const PARA_BINDING *binding = bindings; NULL != binding->path; binding++){
+        if (0 == strncmp(binding->path, list_name.c_str(), list_name.size())){
+            para_len = list_begin + 1;
+            loaded = true;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool CommandPara::start_element(const string &path, const string &name, const XmlAttrList &attrs)
+{
+    string key;
+    bool found = false;
+
+    (void)name;
+
+    for (const PARA_BINDING *binding = bindings; NULL != binding->path; binding++){
+        if (0 != path.compare(para_len, string::npos, binding->path)){
+            continue;
+        }
+
+        found = xml_get_attr(attrs, binding->key_attr, key);
+        if (!found && binding->key_required){
+            key_missing = true;
+        }
+
+        if (key.size() > LENGTH_COMMON - 1){
+            if (value_error.empty()){
+                value_error = path + "@" + binding->key_attr + " is too long";
+            }
+            break;
+        }
+
+        (this->*binding->add)(key, attrs);
+        break;
+    }
+
+    return true;
+}
+
+bool CommandPara::text(const string &path, const string &value)
+{
+    (void)path;
+    (void)value;
+
+    return true;
+}
+
+bool CommandPara::end_element(const string &path)
+{
+    (void)path;
+
+    return true;
+}
+
+/*
+ Fill the lists from the document of reader, for a command that was not
+ streamed.
+*/
+void CommandPara::read(XmlReader &reader, const char *para_path)
+{
+    XmlCursor para;
+
+    clear();
+    para = reader.get_cursor(para_path);
+    if (!para.is_valid()){
+        return;
+    }
+
+    (void)para.walk(para_path, *this);
+}
+
+void CommandPara::_add_target_group(const string &key, const XmlAttrList &attrs)
+{
+    TargetGroupInfo tg_info;
+
+    tg_info.tg_key = key;
+    (void)xml_get_attr(attrs, "isolationRequired", tg_info.isolationRequired);
+    target_groups.push_back(tg_info);
+}
+
+void CommandPara::_add_cons_group(const string &id, const XmlAttrList &attrs)
+{
+    ConGroupInfo cg_info;
+
+    cg_info.cg_id = id;
+    (void)xml_get_attr(attrs, "syncId", cg_info.device_sync_info.sync_id);
+    cons_groups.push_back(cg_info);
+}
+
+void CommandPara::_add_target_device(const string &key, const XmlAttrList &attrs)
+{
+    TargetDeviceInfo td_info;
+
+    td_info.target_key = key;
+    (void)xml_get_attr(attrs, "isolationRequired", td_info.isolationRequired);
+    (void)xml_get_attr(attrs, "syncId", td_info.devicesync_info.sync_id);
+    target_devices.push_back(td_info);
+}
+
+void CommandPara::_add_device(const string &id, const XmlAttrList &attrs)
+{
+    DeviceInfo dev_info;
+
+    (void)attrs;
+    dev_info.id = id;
+    devices.push_back(dev_info);
+}
+
+void CommandPara::_add_source_device(const string &id, const XmlAttrList &attrs)
+{
+    SourceDeviceInfo sd_info;
+
+    sd_info.source_id = id;
+    (void)xml_get_attr(attrs, "syncId", sd_info.device_sync_info.sync_id);
+    source_devices.push_back(sd_info);
+}
+
+void CommandPara::_add_group_device(const string &key, const XmlAttrList &attrs)
+{
+    (void)attrs;
+    group_access.push_back(make_pair(key, string("")));
+}
+
+void CommandPara::_add_group_access(const string &id, const XmlAttrList &attrs)
+{
+    (void)attrs;
+    if (!group_access.empty()){
+        group_access.back().second += id + DAR_HOST_SEPERATOR;
+    }
+}
+
+void CommandPara::_add_target_device_access(const string &id, const XmlAttrList &attrs)
+{
+    (void)attrs;
+    if (!target_devices.empty()){
+        target_devices.back().cg_accessgroups += id + DAR_HOST_SEPERATOR;
+    }
+}
+
+void CommandPara::_add_device_access(const string &id, const XmlAttrList &attrs)
+{
+    (void)attrs;
+    if (!devices.empty()){
+        devices.back().cg_accessgroups += id + DAR_HOST_SEPERATOR;
+    }
+}
+
+void CommandPara::_set_access_group(const string &id, const XmlAttrList &attrs)
+{
+    (void)attrs;
+    access_group = id;
+}
+
+void CommandPara::_add_dar_host(const string &id, const XmlAttrList &attrs)
+{
+    DAR_HOST_INFO dar_host;
+
+    dar_host.strID = id;
+    (void)xml_get_attr(attrs, "type", dar_host.strType);
+    dar_host.strGroup = access_group;
+    dar_hosts.push_back(dar_host);
+}
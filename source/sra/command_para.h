@@ -0,0 +1,116 @@
+// Copyright 2019 The OpenSDS Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use this file except in compliance with the License. You may obtain
+// a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#ifndef COMMAND_PARA_H
+#define COMMAND_PARA_H
+
+#include <cstdio>
+#include <list>
+#include <string>
+
+#include "common.h"
+#include "CmdAdapter.h"
+#include "../common/xmlserial/xmlreader.h"
+#include "../common/xmlserial/xmlstream.h"
+#include "../common/xml_node/consistency_groups.h"
+#include "../common/xml_node/device.h"
+#include "../common/xml_node/source_devices.h"
+#include "../common/xml_node/target_devices.h"
+#include "../common/xml_node/target_groups.h"
+
+/*
+ The device lists of a command's <...Parameters> element. main streams
+ them straight into g_command_para while the rest of the command goes to
+ the XmlReader document, so the lists are never held as DOM nodes. When
+ the streaming parse fails the command falls back to read(), which walks
+ the DOM through the same events.
+
+ What is read is declared once in the bindings table: each list element
+ with the attribute that identifies it and the member that stores it.
+ Parsing is one pass over the elements whatever the command.
+
+ Nested devices of a TargetGroup or ConsistencyGroup only carry their
+ access groups, kept in group_access in document order as
+ (device key, access groups joined by DAR_HOST_SEPERATOR).
+
+ A key is held to LENGTH_COMMON - 1 characters like the scalar fields of
+ the command. A longer one drops its element and get_value_error() names it.
+*/
+class CommandPara : public XmlStreamHandler
+{
+public:
+    CommandPara() : loaded(false), key_missing(false), para_len(0) {};
+    virtual ~CommandPara() {};
+
+    bool is_loaded() const { return loaded; };
+    bool is_key_missing() const { return key_missing; };
+    const string& get_value_error() const { return value_error; };
+
+    void read(XmlReader &reader, const char *para_path);
+    void swap(CommandPara &other);
+    void clear();
+
+    virtual bool claim(const string &path);
+    virtual bool start_element(const string &path, const string &name, const XmlAttrList &attrs);
+    virtual bool text(const string &path, const string &value);
+    virtual bool end_element(const string &path);
+
+public:
+    list<TargetGroupInfo> target_groups;
+    list<ConGroupInfo> cons_groups;
+    list<TargetDeviceInfo> target_devices;
+    list<DeviceInfo> devices;
+    list<SourceDeviceInfo> source_devices;
+    list<pair<string, string> > group_access;
+    list<DAR_HOST_INFO> dar_hosts;
+
+private:
+    typedef void (CommandPara::*PARA_ADD_FUN)(const string &key, const XmlAttrList &attrs);
+
+    struct PARA_BINDING
+    {
+        const char *path;
+        const char *key_attr;
+        bool key_required;
+        PARA_ADD_FUN add;
+    };
+
+    static const PARA_BINDING bindings[];
+
+    void _add_target_group(const string &key, const XmlAttrList &attrs);
+    void _add_cons_group(const string &id, const XmlAttrList &attrs);
+    void _add_target_device(const string &key, const XmlAttrList &attrs);
+    void _add_device(const string &id, const XmlAttrList &attrs);
+    void _add_source_device(const string &id, const XmlAttrList &attrs);
+    void _add_group_device(const string &key, const XmlAttrList &attrs);
+    void _add_group_access(const string &id, const XmlAttrList &attrs);
+    void _add_target_device_access(const string &id, const XmlAttrList &attrs);
+    void _add_device_access(const string &id, const XmlAttrList &attrs);
+    void _set_access_group(const string &id, const XmlAttrList &attrs);
+    void _add_dar_host(const string &id, const XmlAttrList &attrs);
+
+private:
+    bool loaded;
+    bool key_missing;
+    size_t para_len;
+    string access_group;
+    string value_error;
+};
+
+extern CommandPara g_command_para;
+
+bool read_command(FILE *fp, string &input);
+bool load_command(XmlReader &reader, const string &input, bool &streamed);
+
+#endif
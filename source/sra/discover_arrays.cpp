@@ -63,10 +63,9 @@ int DiscoverArrays::_get_sysinfo(CCmdOperate& cmdOperate)
     COMMLOG(OS_LOG_INFO,"%s", "_get_sysinfo begin");
 
     int ret = RETURN_ERR;
-    string strErrorMsg;
     HYPER_STORAGE_STRU stStorageInfo;
 
-    ret = cmdOperate.CMD_showtlvsysinfo(stStorageInfo, strErrorMsg);
+    ret = _get_sysinfo_out(cmdOperate, stStorageInfo);
     CHECK_UNEQ(RETURN_OK, ret);
 
     SNPRINTF(array_id, sizeof(array_id), sizeof(array_id) - 1, "%s", stStorageInfo.strArraySN.c_str());
@@ -84,26 +83,30 @@ int DiscoverArrays::_get_peer_array(CCmdOperate& cmdOperate)
     list<REMOTE_ARRAY_STRU> lstRemoteArrayInfo;
     list<REMOTE_ARRAY_STRU> lstRemoteStretchedInfo;
     list<REMOTE_ARRAY_STRU>::iterator itRemoteArrayInfo;
-    list<REMOTE_ARRAY_STRU>::iterator itRemoteArrayStretched;
+    string strStretched = HM_SUPPORT_NOT_STRETCHED;
     peer_arrays.clear();
+    peer_stretched.clear();
 
     ret = cmdOperate.CMD_showarrayinfo(lstRemoteArrayInfo);
     CHECK_UNEQ(RETURN_OK, ret);
 
     if(g_bstretch){
-        ret = cmdOperate.CMD_showarraystretched(lstRemoteStretchedInfo);
+        ret = _check_stretched_out(cmdOperate, lstRemoteStretchedInfo);
         if (ret != RETURN_OK){
             COMMLOG(OS_LOG_ERROR, "execute CMD_showarraystretched failed, ret = %d", ret);
         }
+
+        // the license of the local array decides it for every peer
+        if (!lstRemoteStretchedInfo.empty()){
+            strStretched = lstRemoteStretchedInfo.front().strStretched;
+        }
     }
     
     if (g_bstretch){
         
-        for (itRemoteArrayInfo = lstRemoteArrayInfo.begin(), itRemoteArrayStretched = lstRemoteStretchedInfo.begin();
-            itRemoteArrayInfo != lstRemoteArrayInfo.end(); 
-            itRemoteArrayInfo++){
+        for (itRemoteArrayInfo = lstRemoteArrayInfo.begin(); itRemoteArrayInfo != lstRemoteArrayInfo.end(); itRemoteArrayInfo++){
             peer_arrays.push_back(itRemoteArrayInfo->strSN);
-            peer_stretched.push_back(itRemoteArrayStretched->strStretched);
+            peer_stretched.push_back(strStretched);
 
             COMMLOG(OS_LOG_INFO, "Find array [%s]",itRemoteArrayInfo->strSN.c_str());
         }
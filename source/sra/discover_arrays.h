@@ -22,7 +22,12 @@ int discover_arrays(XmlReader &reader);
 class DiscoverArrays : public SraBasic
 {
 public:
-    DiscoverArrays() : SraBasic() {};
+    DiscoverArrays() : SraBasic()
+    {
+        if (g_bstretch){
+            startup_checks = STARTUP_CHECK_STRETCHED;
+        }
+    };
     virtual ~DiscoverArrays() {};
 
 protected:
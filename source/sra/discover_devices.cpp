@@ -34,6 +34,75 @@ std::ostream& operator<<(std::ostream& out,const MirrorDetail& item)
     return out;
 }
 
+/*
+ Detail queries of one pair or consistency group. They run on worker
+ sessions and only read the array ids of the command, the results are
+ merged in listing order once the pool is done.
+*/
+class MirrorDetailTask : public SraTask
+{
+public:
+    MirrorDetailTask(DiscoverDevices *owner, const string& hymirror_id, bool nfs)
+        : owner(owner), hymirror_id(hymirror_id), nfs(nfs) {};
+
+    virtual int run(CCmdOperate& cmdOperate)
+    {
+        return owner->_get_mirror_info(cmdOperate, hymirror_id, detail, nfs);
+    }
+
+public:
+    DiscoverDevices *owner;
+    string hymirror_id;
+    bool nfs;
+    MirrorDetail detail;
+};
+
+class HyperMetroDetailTask : public SraTask
+{
+public:
+    HyperMetroDetailTask(DiscoverDevices *owner, const string& hmpair_id)
+        : owner(owner), hmpair_id(hmpair_id) {};
+
+    virtual int run(CCmdOperate& cmdOperate)
+    {
+        return owner->_get_hypermetro_info(cmdOperate, hmpair_id, detail);
+    }
+
+public:
+    DiscoverDevices *owner;
+    string hmpair_id;
+    HyperMetroDetail detail;
+};
+
+class CgDetailTask : public SraTask
+{
+public:
+    CgDetailTask(DiscoverDevices *owner, const string& cg_id, const string& pair_id, bool hypermetro, bool nfs)
+        : owner(owner), cg_id(cg_id), pair_id(pair_id), hypermetro(hypermetro), nfs(nfs) {};
+
+    virtual int run(CCmdOperate& cmdOperate)
+    {
+        if (hypermetro){
+            return owner->_get_cghmdetail_info(cmdOperate, cg_id, pair_id, cghm_info);
+        }
+
+        if (nfs){
+            return owner->_get_vstorepair_detail_info(cmdOperate, cg_id, pair_id, cg_info);
+        }
+
+        return owner->_get_cgdetail_info(cmdOperate, cg_id, pair_id, cg_info);
+    }
+
+public:
+    DiscoverDevices *owner;
+    string cg_id;
+    string pair_id;
+    bool hypermetro;
+    bool nfs;
+    CgDetail cg_info;
+    CgHMDetail cghm_info;
+};
+
 int discover_devices(XmlReader &reader)
 {
     DiscoverDevices discover_dev;
@@ -54,8 +123,8 @@ int discover_devices(XmlReader &reader)
 
 int DiscoverDevices::_read_command_para(XmlReader &reader)
 {
-    (void)reader.get_string("/Command/DiscoverDevicesParameters/ArrayId", input_array_id, 0);
-    (void)reader.get_string("/Command/DiscoverDevicesParameters/PeerArrayId", peer_array_id, 0);
+    (void)reader.get_cstring("/Command/DiscoverDevicesParameters/ArrayId", input_array_id);
+    (void)reader.get_cstring("/Command/DiscoverDevicesParameters/PeerArrayId", peer_array_id);
 
     return RETURN_OK;
 }
@@ -103,15 +172,12 @@ int DiscoverDevices::_outband_process()
     int iRet = RETURN_ERR;
 
     HYPER_STORAGE_STRU stStorageInfo;
-    list<HYMIRROR_INFO_STRU> lstMirrorInfo;
-    list<HYMIRROR_INFO_STRU>::iterator itMirrorInfo;
-    list<HYPERMETROPAIR_INFO_STRU> lstHyperMetroPairInfo;
-    list<HYPERMETROPAIR_INFO_STRU>::iterator itHyperMetroPairInfo;
     list<LIF_INFO_STRU> lstLifInfo;
     list<LIF_INFO_STRU>::iterator itLifInfo;
     CCmdOperate cmdOperate;
     int countDevice = 0;
-    string lunID;
+    unsigned long long ullStartTime = OS_GetTickCount();
+    unsigned long ulStartRequests = CRESTConn::getRequestCount();
 
     (void)setStorageInfo(stStorageInfo);
 
@@ -125,37 +191,107 @@ int DiscoverDevices::_outband_process()
     iRet = check_array_id_validate_out(cmdOperate, array_id_temp, peer_array_id);
     CHECK_UNEQ(RETURN_OK, iRet);
 
+    // one pool for the command, its worker sessions serve every phase
+    TaskPool pool(stStorageInfo);
+
     COMMLOG(OS_LOG_INFO, "Commence: discover the device on array [%s]", string(array_id).c_str());
     print("Commence: discover the device on array [%s]", string(array_id).c_str());
 
     COMMLOG(OS_LOG_INFO, "Commence: Check whether nfs is supported on the array [%s]", string(array_id).c_str());
     print("Commence: Check whether nfs is supported on the array [%s]", string(array_id).c_str());
-    iRet = cmdOperate.CMD_showarrayclonefs();
+    iRet = _check_clonefs_out(cmdOperate);
     if (iRet != RETURN_OK){
         COMMLOG(OS_LOG_ERROR, "execute CMD_showarrayclonefs failed, ret = %d", iRet);
     }
+
+    iRet = _discover_mirror_out(cmdOperate, pool, countDevice);
+    CHECK_UNEQ(RETURN_OK, iRet);
+
+    if (!g_bFusionStorage || g_testFusionStorageStretch){
+        list<REMOTE_ARRAY_STRU> lstRemoteStretchedInfo;
+
+        iRet = _check_stretched_out(cmdOperate, lstRemoteStretchedInfo);
+        if (iRet != RETURN_OK){
+            COMMLOG(OS_LOG_ERROR, "execute CMD_showarraystretched failed, ret = %d", iRet);
+        }
+
+        if (g_bstretch){
+            iRet = _discover_hypermetro_out(cmdOperate, pool, countDevice);
+            CHECK_UNEQ(RETURN_OK, iRet);
+        }
+    }
+
+     
+    if(!g_bFusionStorage && g_bnfs == true){
+        cmdOperate.CMD_showLIF(lstLifInfo);
+        for (itLifInfo = lstLifInfo.begin(); itLifInfo != lstLifInfo.end(); ++itLifInfo){                                         
+             
+            if(itLifInfo->role == SERVICE_ROLE || itLifInfo->role == MANAGEMENT_AND_SERVICE_ROLE){
+                StoragePortsIPS storageportsips;
+                storageportsips.source_IP = itLifInfo->strLIFIP;
+                storageports_info.lst_storageportsips.push_back(storageportsips);
+            }
+            else{
+                COMMLOG(OS_LOG_INFO, "Filtered logical port [%s], because it cannot be a service port", itLifInfo->strLIFIP.c_str());
+            }
+        }    
+    }
      
+    COMMLOG(OS_LOG_INFO, "Complete: discover [%d] devices on array [%s]", countDevice ,string(array_id).c_str());
+    print("Complete: discover [%d] devices on array [%s]", countDevice ,string(array_id).c_str());
+    COMMLOG(OS_LOG_INFO, "discover devices took %llu ms and %lu array requests.",
+        OS_GetTickCount() - ullStartTime, CRESTConn::getRequestCount() - ulStartRequests);
+    print("discover devices took %llu ms and %lu array requests.",
+        OS_GetTickCount() - ullStartTime, CRESTConn::getRequestCount() - ulStartRequests);
+    return RETURN_OK;
+}
+
+int DiscoverDevices::_discover_mirror_out(CCmdOperate& cmdOperate, TaskPool& pool, int& countDevice)
+{
+    int iRet = RETURN_ERR;
+    size_t index = 0;
+    string lunID;
+    list<HYMIRROR_INFO_STRU> lstMirrorInfo;
+    list<HYMIRROR_INFO_STRU>::iterator itMirrorInfo;
+    map<string, CgDetailTask *> cg_tasks;
 
      
     iRet = cmdOperate.CMD_showhymirrorinfo_all(lstMirrorInfo);
     CHECK_UNEQ(RETURN_OK, iRet);
     COMMLOG(OS_LOG_DEBUG, "Number of availabel remote replication is %d", lstMirrorInfo.size());
 
+    // the detail tasks come first in the pool, the group tasks after them
+    pool.clear();
+
     for (itMirrorInfo = lstMirrorInfo.begin(); itMirrorInfo != lstMirrorInfo.end(); ++itMirrorInfo){
-         
-        if (OBJ_FILESYSTEM == itMirrorInfo->uilocalResType){
-            isNFS = true;
-        }
-        else{
-            isNFS = false;
+        pool.add(new MirrorDetailTask(this, itMirrorInfo->strID, OBJ_FILESYSTEM == itMirrorInfo->uilocalResType));
+    }
+
+    pool.run(cmdOperate);
+
+    // the group details are taken with the first member that is discovered
+    for (itMirrorInfo = lstMirrorInfo.begin(), index = 0; itMirrorInfo != lstMirrorInfo.end(); ++itMirrorInfo, ++index){
+        MirrorDetailTask *task = static_cast<MirrorDetailTask *>(pool.at(index));
+
+        if (RETURN_OK != task->result || !itMirrorInfo->bIsBelongGroup || g_bFusionStorage
+            || cg_tasks.end() != cg_tasks.find(itMirrorInfo->strGroupID)){
+            continue;
         }
-        MirrorDetail mirrorinfo;
-        iRet = _get_mirror_info(cmdOperate, itMirrorInfo->strID, mirrorinfo);
-         
 
-        if(RETURN_OK != iRet){
+        CgDetailTask *cg_task = new CgDetailTask(this, itMirrorInfo->strGroupID, itMirrorInfo->strID, false, task->nfs);
+        cg_tasks[itMirrorInfo->strGroupID] = cg_task;
+        pool.add(cg_task);
+    }
+
+    pool.run(cmdOperate);
+
+    for (itMirrorInfo = lstMirrorInfo.begin(), index = 0; itMirrorInfo != lstMirrorInfo.end(); ++itMirrorInfo, ++index){
+        MirrorDetailTask *task = static_cast<MirrorDetailTask *>(pool.at(index));
+        MirrorDetail &mirrorinfo = task->detail;
+
+        if(RETURN_OK != task->result){
              
-            COMMLOG(OS_LOG_ERROR, "exclude the replicated device [%s] because found error [%d]", string(itMirrorInfo->strID).c_str(), iRet);
+            COMMLOG(OS_LOG_ERROR, "exclude the replicated device [%s] because found error [%d]", string(itMirrorInfo->strID).c_str(), task->result);
             continue;
         }
          
@@ -176,9 +312,17 @@ int DiscoverDevices::_outband_process()
         }
         else{
             if (!g_bFusionStorage){
-                 
-                iRet = _check_cgid_exist(cmdOperate, itMirrorInfo->strGroupID, itMirrorInfo->strID, mirrorinfo);
-                CHECK_UNEQ(RETURN_OK, iRet);
+                CgDetailTask *cg_task = cg_tasks[itMirrorInfo->strGroupID];
+                if (RETURN_OK != cg_task->result){
+                    COMMLOG(OS_LOG_ERROR, "query the consistency group [%s] failed [%d]", 
+                        string(itMirrorInfo->strGroupID).c_str(), cg_task->result);
+                    // keep the group in the response and report the error on it
+                    cg_task->cg_info.cgid = itMirrorInfo->strGroupID;
+                    cg_task->cg_info.arrayid = array_id;
+                    cg_task->cg_info.query_ret = cg_task->result;
+                }
+
+                _check_cgid_exist(itMirrorInfo->strGroupID, mirrorinfo, cg_task->cg_info);
                  
                 COMMLOG(OS_LOG_INFO, "discover the consistency group  device [%s] ", lunID.c_str());
                 print("discover the consistency group  device [%s] ", lunID.c_str());
@@ -187,89 +331,99 @@ int DiscoverDevices::_outband_process()
         countDevice++;
     }
 
-    if (g_bFusionStorage && !g_testFusionStorageStretch){
-        return RETURN_OK;
-    }
+    return RETURN_OK;
+}
 
-    list<REMOTE_ARRAY_STRU> lstRemoteStretchedInfo;
+int DiscoverDevices::_discover_hypermetro_out(CCmdOperate& cmdOperate, TaskPool& pool, int& countDevice)
+{
+    int iRet = RETURN_ERR;
+    size_t index = 0;
+    string lunID;
+    list<HYPERMETROPAIR_INFO_STRU> lstHyperMetroPairInfo;
+    list<HYPERMETROPAIR_INFO_STRU>::iterator itHyperMetroPairInfo;
+    map<string, CgDetailTask *> cg_tasks;
 
-    iRet = cmdOperate.CMD_showarraystretched(lstRemoteStretchedInfo);
-    if (iRet != RETURN_OK){
-        COMMLOG(OS_LOG_ERROR, "execute CMD_showarraystretched failed, ret = %d", iRet);
+     
+    iRet = cmdOperate.CMD_showHyperMetroPair_all(lstHyperMetroPairInfo);
+    CHECK_UNEQ(RETURN_OK, iRet);
+
+    // the detail tasks come first in the pool, the group tasks after them
+    pool.clear();
+
+    for (itHyperMetroPairInfo = lstHyperMetroPairInfo.begin(); 
+        itHyperMetroPairInfo != lstHyperMetroPairInfo.end(); ++itHyperMetroPairInfo){
+        pool.add(new HyperMetroDetailTask(this, itHyperMetroPairInfo->strID));
     }
 
-    if (g_bstretch){
-         
-        iRet = cmdOperate.CMD_showHyperMetroPair_all(lstHyperMetroPairInfo);
-        CHECK_UNEQ(RETURN_OK, iRet);
-        for (itHyperMetroPairInfo = lstHyperMetroPairInfo.begin(); 
-            itHyperMetroPairInfo != lstHyperMetroPairInfo.end(); ++itHyperMetroPairInfo){
-            HyperMetroDetail hypermetroinfo;
-            iRet = _get_hypermetro_info(cmdOperate, itHyperMetroPairInfo->strID, hypermetroinfo);
+    pool.run(cmdOperate);
 
-            if(RETURN_OK != iRet){
-                 
-                COMMLOG(OS_LOG_ERROR, "exclude the hypermetro device [%s] because found error [%d]", 
-                    string(itHyperMetroPairInfo->strID).c_str(), iRet);
-                continue;
-            }
-             
-            if(!hypermetroinfo.masterlun.empty()){
-                lunID = hypermetroinfo.masterlun;
-            }
-            else{
-                lunID = hypermetroinfo.slavelun;
-            }
-             
-            if (!itHyperMetroPairInfo->bIsBelongGroup){
-                 
-                lst_hypermetro_info.push_back(hypermetroinfo);
-                 
-                COMMLOG(OS_LOG_INFO, "discover the the remote hypermetro device [%s]",lunID.c_str());
-                print("discover the the remote hypermetro device [%s]",lunID.c_str());
-            }
-            else{           
-                if (!g_bFusionStorage){
-                     
-                    iRet = _check_cghmid_exist(cmdOperate, itHyperMetroPairInfo->strGroupID, 
-                        itHyperMetroPairInfo->strID, hypermetroinfo);
-                    CHECK_UNEQ(RETURN_OK, iRet);
-                     
-                    COMMLOG(OS_LOG_INFO, "discover the consistency group  device [%s] ", lunID.c_str());
-                    print("discover the consistency group  device [%s] ", lunID.c_str());
-                }
-            }
-            countDevice++;
+    for (itHyperMetroPairInfo = lstHyperMetroPairInfo.begin(), index = 0; 
+        itHyperMetroPairInfo != lstHyperMetroPairInfo.end(); ++itHyperMetroPairInfo, ++index){
+        HyperMetroDetailTask *task = static_cast<HyperMetroDetailTask *>(pool.at(index));
+
+        if (RETURN_OK != task->result || !itHyperMetroPairInfo->bIsBelongGroup || g_bFusionStorage
+            || cg_tasks.end() != cg_tasks.find(itHyperMetroPairInfo->strGroupID)){
+            continue;
         }
+
+        CgDetailTask *cg_task = new CgDetailTask(this, itHyperMetroPairInfo->strGroupID, itHyperMetroPairInfo->strID, true, false);
+        cg_tasks[itHyperMetroPairInfo->strGroupID] = cg_task;
+        pool.add(cg_task);
     }
 
+    pool.run(cmdOperate);
 
-    if (g_bFusionStorage){
-        return RETURN_OK;
-    }
+    for (itHyperMetroPairInfo = lstHyperMetroPairInfo.begin(), index = 0; 
+        itHyperMetroPairInfo != lstHyperMetroPairInfo.end(); ++itHyperMetroPairInfo, ++index){
+        HyperMetroDetailTask *task = static_cast<HyperMetroDetailTask *>(pool.at(index));
+        HyperMetroDetail &hypermetroinfo = task->detail;
 
-     
-    if(g_bnfs == true){
-        cmdOperate.CMD_showLIF(lstLifInfo);
-        for (itLifInfo = lstLifInfo.begin(); itLifInfo != lstLifInfo.end(); ++itLifInfo){                                         
+        if(RETURN_OK != task->result){
              
-            if(itLifInfo->role == SERVICE_ROLE || itLifInfo->role == MANAGEMENT_AND_SERVICE_ROLE){
-                StoragePortsIPS storageportsips;
-                storageportsips.source_IP = itLifInfo->strLIFIP;
-                storageports_info.lst_storageportsips.push_back(storageportsips);
-            }
-            else{
-                COMMLOG(OS_LOG_INFO, "Filtered logical port [%s], because it cannot be a service port", itLifInfo->strLIFIP.c_str());
+            COMMLOG(OS_LOG_ERROR, "exclude the hypermetro device [%s] because found error [%d]", 
+                string(itHyperMetroPairInfo->strID).c_str(), task->result);
+            continue;
+        }
+         
+        if(!hypermetroinfo.masterlun.empty()){
+            lunID = hypermetroinfo.masterlun;
+        }
+        else{
+            lunID = hypermetroinfo.slavelun;
+        }
+         
+        if (!itHyperMetroPairInfo->bIsBelongGroup){
+             
+            lst_hypermetro_info.push_back(hypermetroinfo);
+             
+            COMMLOG(OS_LOG_INFO, "discover the the remote hypermetro device [%s]",lunID.c_str());
+            print("discover the the remote hypermetro device [%s]",lunID.c_str());
+        }
+        else{           
+            if (!g_bFusionStorage){
+                CgDetailTask *cg_task = cg_tasks[itHyperMetroPairInfo->strGroupID];
+                if (RETURN_OK != cg_task->result){
+                    COMMLOG(OS_LOG_ERROR, "query the consistency group [%s] failed [%d]", 
+                        string(itHyperMetroPairInfo->strGroupID).c_str(), cg_task->result);
+                    // keep the group in the response and report the error on it
+                    cg_task->cghm_info.cgid = itHyperMetroPairInfo->strGroupID;
+                    cg_task->cghm_info.arrayid = array_id;
+                    cg_task->cghm_info.query_ret = cg_task->result;
+                }
+
+                _check_cghmid_exist(itHyperMetroPairInfo->strGroupID, hypermetroinfo, cg_task->cghm_info);
+                 
+                COMMLOG(OS_LOG_INFO, "discover the consistency group  device [%s] ", lunID.c_str());
+                print("discover the consistency group  device [%s] ", lunID.c_str());
             }
-        }    
+        }
+        countDevice++;
     }
-     
-    COMMLOG(OS_LOG_INFO, "Complete: discover [%d] devices on array [%s]", countDevice ,string(array_id).c_str());
-    print("Complete: discover [%d] devices on array [%s]", countDevice ,string(array_id).c_str());
+
     return RETURN_OK;
 }
 
-int DiscoverDevices::_get_mirror_info(CCmdOperate& cmdOperate, string& hymirror_id, MirrorDetail& mirrorDetail)
+int DiscoverDevices::_get_mirror_info(CCmdOperate& cmdOperate, string& hymirror_id, MirrorDetail& mirrorDetail, bool nfs)
 {
     int iRet = RETURN_ERR;
     list<string> lst_local_ids;
@@ -277,7 +431,7 @@ int DiscoverDevices::_get_mirror_info(CCmdOperate& cmdOperate, string& hymirror_
     list<HYMIRROR_LF_INFO_STRU>::iterator itMirrorLUNInfo;
 
      
-    if (isNFS){
+    if (nfs){
         iRet = cmdOperate.CMD_showhymirrorfs_all(hymirror_id, lstMirrorLUNInfo);
     } 
     else{
@@ -286,7 +440,7 @@ int DiscoverDevices::_get_mirror_info(CCmdOperate& cmdOperate, string& hymirror_
     CHECK_UNEQ(RETURN_OK,iRet);
 
      
-    iRet = _get_mirror_detail_info(cmdOperate, lstMirrorLUNInfo, mirrorDetail);
+    iRet = _get_mirror_detail_info(cmdOperate, lstMirrorLUNInfo, mirrorDetail, nfs);
     CHECK_UNEQ(RETURN_OK,iRet);
 
      
@@ -307,7 +461,7 @@ int DiscoverDevices::_get_mirror_info(CCmdOperate& cmdOperate, string& hymirror_
     }
      
     if ( (MIRROR_RELATION_SLAVE == mirrorDetail.relation) && !lst_local_ids.empty()){
-        if (RETURN_OK != _get_snapshot_info(cmdOperate, lst_local_ids.front(), mirrorDetail.snapshot_info)){
+        if (RETURN_OK != _get_snapshot_info(cmdOperate, lst_local_ids.front(), mirrorDetail.snapshot_info, nfs)){
             mirrorDetail.snapshot_info.snap_id = "";
         }
     }
@@ -346,7 +500,7 @@ int DiscoverDevices::_get_hypermetro_info(CCmdOperate& cmdOperate, string& hyper
     }
      
     if ( (HM_RELATION_SLAVE == hypermetrodetail.relation) && !lst_local_ids.empty()){
-        if (RETURN_OK != _get_snapshot_info(cmdOperate, lst_local_ids.front(), hypermetrodetail.snapshot_info)){
+        if (RETURN_OK != _get_snapshot_info(cmdOperate, lst_local_ids.front(), hypermetrodetail.snapshot_info, false)){
             hypermetrodetail.snapshot_info.snap_id = "";
         }
     }
@@ -354,12 +508,10 @@ int DiscoverDevices::_get_hypermetro_info(CCmdOperate& cmdOperate, string& hyper
     return RETURN_OK; 
 }
 
-int DiscoverDevices::_check_cgid_exist(CCmdOperate& cmdOperate, const string &cg_id,
-                                       string &hymirror_id,const MirrorDetail &mirrorinfo)
+void DiscoverDevices::_check_cgid_exist(const string &cg_id, const MirrorDetail &mirrorinfo, const CgDetail &fetched_cg)
 {
     list<CgDetail>::iterator itcgdetail;
     int flag = 0;
-    int iRet = RETURN_ERR;
     CgDetail cg_info;
     int mirrorslavelunid = 0;
     int cgslavelunid = 0;
@@ -392,15 +544,7 @@ int DiscoverDevices::_check_cgid_exist(CCmdOperate& cmdOperate, const string &cg
 
      
     if (0 == flag){
-        if (isNFS){
-             
-            iRet = _get_vstorepair_detail_info(cmdOperate, cg_id, hymirror_id, cg_info);
-        }
-        else{
-            iRet = _get_cgdetail_info(cmdOperate, cg_id, hymirror_id, cg_info);
-        }
-        CHECK_UNEQ(RETURN_OK,iRet);
-
+        cg_info = fetched_cg;
         cg_info.masterlun = mirrorinfo.masterlun;
         cg_info.slavelun = mirrorinfo.slavelun;
         cg_info.lst_mirror_info.push_back(mirrorinfo);
@@ -408,15 +552,13 @@ int DiscoverDevices::_check_cgid_exist(CCmdOperate& cmdOperate, const string &cg
         lst_cg_info.push_back(cg_info);
     }
 
-    return RETURN_OK;
+    return;
 }
 
-int DiscoverDevices::_check_cghmid_exist(CCmdOperate& cmdOperate, const string &cghm_id,
-    string &hypermetroid,const HyperMetroDetail &hypermetroinfo)
+void DiscoverDevices::_check_cghmid_exist(const string &cghm_id, const HyperMetroDetail &hypermetroinfo, const CgHMDetail &fetched_cghm)
 {
     list<CgHMDetail>::iterator itcghmdetail;
     int flag = 0;
-    int iRet = RETURN_ERR;
     CgHMDetail cghm_info;
     int hmslavelunid = 0;
     int cghmslavelunid = 0;
@@ -449,9 +591,7 @@ int DiscoverDevices::_check_cghmid_exist(CCmdOperate& cmdOperate, const string &
 
      
     if (0 == flag){
-        iRet = _get_cghmdetail_info(cmdOperate, cghm_id, hypermetroid, cghm_info);
-        CHECK_UNEQ(RETURN_OK,iRet);
-
+        cghm_info = fetched_cghm;
         cghm_info.strstretched = hypermetroinfo.strstretched;
         cghm_info.strCptype = hypermetroinfo.strCptype;
         cghm_info.hmdomaingid = hypermetroinfo.hmdomaingid;
@@ -463,7 +603,7 @@ int DiscoverDevices::_check_cghmid_exist(CCmdOperate& cmdOperate, const string &
         lst_hmcg_info.push_back(cghm_info);
     }
 
-    return RETURN_OK;
+    return;
 }
 
 int DiscoverDevices::_get_cgdetail_info(CCmdOperate& cmdOperate,
@@ -628,7 +768,7 @@ int DiscoverDevices::_get_cghmdetail_info(CCmdOperate& cmdOperate,
 }
 
 int DiscoverDevices::_get_mirror_detail_info(CCmdOperate& cmdOperate,
-                                             list<HYMIRROR_LF_INFO_STRU>& lstMirrorLUNInfo, MirrorDetail& mirrorDetail)
+                                             list<HYMIRROR_LF_INFO_STRU>& lstMirrorLUNInfo, MirrorDetail& mirrorDetail, bool nfs)
 {
     int iRet = RETURN_ERR;
     
@@ -660,7 +800,7 @@ int DiscoverDevices::_get_mirror_detail_info(CCmdOperate& cmdOperate,
     
     if (string(array_id) == mirrorDetail.arrayid){
          
-        if (isNFS){
+        if (nfs){
             stFSInfo.strID = mirrorDetail.masterlun;
             iRet = cmdOperate.CMD_showfs(stFSInfo);
             CHECK_UNEQ(RETURN_OK, iRet);
@@ -676,7 +816,7 @@ int DiscoverDevices::_get_mirror_detail_info(CCmdOperate& cmdOperate,
     }
     else{
          
-        if (isNFS){
+        if (nfs){
             stFSInfo.strID = mirrorDetail.slavelun;
             iRet = cmdOperate.CMD_showfs(stFSInfo);
             CHECK_UNEQ(RETURN_OK, iRet);
@@ -752,7 +892,7 @@ int DiscoverDevices::_get_hm_detail_info(CCmdOperate& cmdOperate,
     return RETURN_OK;
 }
 
-int DiscoverDevices::_get_snapshot_info(CCmdOperate& cmdOperate, string& strID, SnapShotInfo& snapShotInfo)
+int DiscoverDevices::_get_snapshot_info(CCmdOperate& cmdOperate, string& strID, SnapShotInfo& snapShotInfo, bool nfs)
 {
     int iRet = RETURN_ERR;
     string wwn;
@@ -767,7 +907,7 @@ int DiscoverDevices::_get_snapshot_info(CCmdOperate& cmdOperate, string& strID,
     list<NFS_INFO_STRU>::iterator itNfsInfo;
     string vstore_id = STR_NOT_EXIST;
      
-    if (isNFS){
+    if (nfs){
         iRet = cmdOperate.CMD_showhyimgoffs(strID, lstHyperImgInfo);
     } 
     else{
@@ -792,9 +932,9 @@ int DiscoverDevices::_get_snapshot_info(CCmdOperate& cmdOperate, string& strID,
     }
 
      
-    iRet = _get_active_time(cmdOperate, lst_snapshot_ids.front(), snapshot_name, snapShotInfo.recoverypoint_info.rp_time);
+    iRet = _get_active_time(cmdOperate, lst_snapshot_ids.front(), snapshot_name, snapShotInfo.recoverypoint_info.rp_time, nfs);
     CHECK_UNEQ(RETURN_OK,iRet);
-    if (isNFS){
+    if (nfs){
         iRet = cmdOperate.CMD_shownfs(vstore_id, lstNfsInfo);
         COMMLOG(OS_LOG_INFO, "CMD_shownfs(%d)", iRet);
                 CHECK_UNEQ(RETURN_OK,iRet);
@@ -837,7 +977,7 @@ int DiscoverDevices::_get_snapshot_info(CCmdOperate& cmdOperate, string& strID,
     }
     else{
         snapShotInfo.snap_id = lst_snapshot_ids.front();
-        if (isNFS){
+        if (nfs){
             snapShotInfo.snap_fspath = sharpath;
         }
         else{
@@ -850,14 +990,14 @@ int DiscoverDevices::_get_snapshot_info(CCmdOperate& cmdOperate, string& strID,
     return RETURN_OK;
 }
 
-int DiscoverDevices::_get_active_time(CCmdOperate& cmdOperate, const string& snapShot_id, const string& snapName, string& time_stamp)
+int DiscoverDevices::_get_active_time(CCmdOperate& cmdOperate, const string& snapShot_id, const string& snapName, string& time_stamp, bool nfs)
 {
     int iRet = RETURN_ERR;
     
     HYIMAGE_INFO_STRU stHyImgInfo;
     stHyImgInfo.strID = snapShot_id;
     stHyImgInfo.strName = snapName;
-    if (isNFS){
+    if (nfs){
         iRet = cmdOperate.CMD_showFShyimginfo(stHyImgInfo);
     } 
     else{
@@ -889,9 +1029,9 @@ void DiscoverDevices::_write_response(XmlWriter &writer)
         _write_hypermetro_response(lst_hypermetro_info, source_devices_info, target_devices_info);  
     }
     
-    rep_devices.sources_info = source_devices_info;
-    rep_devices.targets_info = target_devices_info;
-    rep_devices.storageports_info = storageports_info;
+    rep_devices.sources_info.swap(source_devices_info);
+    rep_devices.targets_info.swap(target_devices_info);
+    rep_devices.storageports_info.lst_storageportsips.swap(storageports_info.lst_storageportsips);
     for (it_cg =  lst_cg_info.begin(); it_cg != lst_cg_info.end(); it_cg++){
         _write_consist(*it_cg);
     }
@@ -934,7 +1074,7 @@ void DiscoverDevices:: _get_tg_snapshot_info(CgDetail &it_cg)
 
     for(itmirrordetail = it_cg.lst_mirror_info.begin();itmirrordetail != it_cg.lst_mirror_info.end(); ++itmirrordetail){
         if (!(itmirrordetail->snapshot_info.snap_id.empty())){
-            TargetDeviceInfo tgdev;
+            TargetDeviceInfo &tgdev = append_node(it_cg.snapshot_info.tg_devices_info.lst_target_devices);
 
             tgdev.target_key = string(array_id) + "_" + itmirrordetail->slavelun;
             tgdev.snapshot_info.snap_id = itmirrordetail->snapshot_info.snap_id;
@@ -942,8 +1082,6 @@ void DiscoverDevices:: _get_tg_snapshot_info(CgDetail &it_cg)
              
             min_time(itmirrordetail->snapshot_info.recoverypoint_info.rp_time, it_cg.snapshot_info.recover_info.rp_time);
 
-            it_cg.snapshot_info.tg_devices_info.lst_target_devices.push_back(tgdev);
-
             itmirrordetail->snapshot_info.snap_id.clear();
             itmirrordetail->snapshot_info.snap_wwn.clear();
         }  
@@ -959,7 +1097,7 @@ void DiscoverDevices:: _get_tghm_snapshot_info(CgHMDetail &it_cghm)
     for(ithypermetrodetail = it_cghm.lst_hypermetro_info.begin();
         ithypermetrodetail != it_cghm.lst_hypermetro_info.end(); ++ithypermetrodetail){
         if (!(ithypermetrodetail->snapshot_info.snap_id.empty())){
-            TargetDeviceInfo tgdev;
+            TargetDeviceInfo &tgdev = append_node(it_cghm.snapshot_info.tg_devices_info.lst_target_devices);
 
             tgdev.target_key = string(array_id) + "_" + ithypermetrodetail->slavelun;
             tgdev.snapshot_info.snap_id = ithypermetrodetail->snapshot_info.snap_id;
@@ -967,8 +1105,6 @@ void DiscoverDevices:: _get_tghm_snapshot_info(CgHMDetail &it_cghm)
              
             min_time(ithypermetrodetail->snapshot_info.recoverypoint_info.rp_time, it_cghm.snapshot_info.recover_info.rp_time);
 
-            it_cghm.snapshot_info.tg_devices_info.lst_target_devices.push_back(tgdev);
-
             ithypermetrodetail->snapshot_info.snap_id.clear();
             ithypermetrodetail->snapshot_info.snap_wwn.clear();
         }  
@@ -985,70 +1121,50 @@ void DiscoverDevices::_write_detail(const MirrorDetail &it_mirror, SourceDevices
     if (it_mirror.arrayid == array_id)  {
          
         if (HM_SPLITED == it_mirror.pairstatus && (int)RESOURCE_ACCESS_READ_WRITE == it_mirror.uiResAcess){
-            SourceDeviceInfo sd;
-            sd.source_id = source_dev_id;
-            sd.source_name = it_mirror.masterlunname;
-            sd.status = "read-only";
+            SOURCE_DEVICE_RECORD &sd = source_devs.append_record();
+            sd.source_id = source_devs.strings.add(source_dev_id);
+            sd.source_name = source_devs.strings.add(it_mirror.masterlunname);
+            sd.status = source_devs.strings.add("read-only");
 
-            TargetDeviceInfo td;
-            td.target_key = target_dev_id;
-            sd.target_info = td;
-
-            source_devs.lst_source_devices.push_back(sd);
+            sd.target_key = source_devs.strings.add(target_dev_id);
         }
         else   {
-            SourceDeviceInfo sd;
-            sd.source_id = source_dev_id;
-            sd.source_name = it_mirror.masterlunname;
-            sd.status = "read-write";
+            SOURCE_DEVICE_RECORD &sd = source_devs.append_record();
+            sd.source_id = source_devs.strings.add(source_dev_id);
+            sd.source_name = source_devs.strings.add(it_mirror.masterlunname);
+            sd.status = source_devs.strings.add("read-write");
             if (it_mirror.localResType == OBJ_FILESYSTEM){
-                IdentityInfoFS ideninfofs;
-                ideninfofs.source_NfsName = it_mirror.masterlumwwn;
-                sd.identity_infofs = ideninfofs;
+                sd.source_NfsName = source_devs.strings.add(it_mirror.masterlumwwn);
             } 
             else{
-                IdentityInfo ideninfo;
-                ideninfo.source_wwn = it_mirror.masterlumwwn;
-                sd.identity_info = ideninfo;
+                sd.source_wwn = source_devs.strings.add(it_mirror.masterlumwwn);
             }
 
-            TargetDeviceInfo td;
-            td.target_key = target_dev_id;
-            sd.target_info = td;
-
-            source_devs.lst_source_devices.push_back(sd);
+            sd.target_key = source_devs.strings.add(target_dev_id);
         }
     }
     else         {
          
         if ((HM_SPLITED == it_mirror.pairstatus || HM_INTERRUPT == it_mirror.pairstatus) && (int)RESOURCE_ACCESS_READ_WRITE == it_mirror.uiResAcess){
-            TargetDeviceInfo td;
-            td.target_key = target_dev_id;
-            td.target_id = target_dev_id;
-            td.target_name = it_mirror.slavelunname;
-            td.target_state = "read-write";
+            TARGET_DEVICE_RECORD &td = target_devs.append_record();
+            td.target_key = target_devs.strings.add(target_dev_id);
+            td.target_id = target_devs.strings.add(target_dev_id);
+            td.target_name = target_devs.strings.add(it_mirror.slavelunname);
+            td.target_state = target_devs.strings.add("read-write");
             if (it_mirror.localResType == OBJ_FILESYSTEM){
-                IdentityInfoFS ideninfofs;
-                ideninfofs.source_NfsName = it_mirror.slavelunwwn; 
-                td.identity_infofs = ideninfofs;
+                td.source_NfsName = target_devs.strings.add(it_mirror.slavelunwwn);
             }
             else{
-                IdentityInfo ideninfo;
-                ideninfo.source_wwn = it_mirror.slavelunwwn;
-                td.identity_info = ideninfo;
+                td.source_wwn = target_devs.strings.add(it_mirror.slavelunwwn);
             }
-
-            target_devs.lst_target_devices.push_back(td);
         }
         else  {
-            TargetDeviceInfo td;
-            td.target_key = target_dev_id;
-            td.target_name = it_mirror.slavelunname;
-            td.target_state = "read-only";
+            TARGET_DEVICE_RECORD &td = target_devs.append_record();
+            td.target_key = target_devs.strings.add(target_dev_id);
+            td.target_name = target_devs.strings.add(it_mirror.slavelunname);
+            td.target_state = target_devs.strings.add("read-only");
 
-            td.snapshot_info = it_mirror.snapshot_info;
-
-            target_devs.lst_target_devices.push_back(td);
+            td.snapshot = target_devs.add_snapshot(it_mirror.snapshot_info);
         }
     }
 }
@@ -1061,146 +1177,118 @@ void DiscoverDevices::_write_detailhm(const HyperMetroDetail &it_hm, SourceDevic
     if (it_hm.arrayid == array_id)  {
          
         if (HM_SLAVE_PAIR_STATUS_STR_PAUSE == it_hm.pairstatus && (int)RESOURCE_ACCESS_READ_WRITE == it_hm.uiResAcess){
-            SourceDeviceInfo sd;
-            sd.source_id = source_dev_id;
-            sd.source_name = it_hm.masterlunname;
-            sd.status = "read-only";
+            SOURCE_DEVICE_RECORD &sd = source_devs.append_record();
+            sd.source_id = source_devs.strings.add(source_dev_id);
+            sd.source_name = source_devs.strings.add(it_hm.masterlunname);
+            sd.status = source_devs.strings.add("read-only");
             if (it_hm.strIsinCg.compare("true") == 0){
-                sd.stretched = "";
-                sd.cptype = "";
+                sd.stretched = 0;
+                sd.cptype = 0;
             }
             else{
-                sd.stretched = it_hm.strstretched;
-                sd.cptype = it_hm.strCptype;
+                sd.stretched = source_devs.strings.add(it_hm.strstretched);
+                sd.cptype = source_devs.strings.add(it_hm.strCptype);
             }
 
-            TargetDeviceInfo td;
-            td.target_key = target_dev_id;
-            sd.target_info = td;
-
-            source_devs.lst_source_devices.push_back(sd);
+            sd.target_key = source_devs.strings.add(target_dev_id);
         }
         else   {
-            SourceDeviceInfo sd;
-            sd.source_id = source_dev_id;
-            sd.source_name = it_hm.masterlunname;
-            sd.status = "read-write";
+            SOURCE_DEVICE_RECORD &sd = source_devs.append_record();
+            sd.source_id = source_devs.strings.add(source_dev_id);
+            sd.source_name = source_devs.strings.add(it_hm.masterlunname);
+            sd.status = source_devs.strings.add("read-write");
             if (it_hm.strIsinCg.compare("true") == 0){
-                sd.stretched = "";
-                sd.cptype = "";
+                sd.stretched = 0;
+                sd.cptype = 0;
             }
             else{
-                sd.cptype = it_hm.strCptype;
-                sd.stretched = it_hm.strstretched;
+                sd.cptype = source_devs.strings.add(it_hm.strCptype);
+                sd.stretched = source_devs.strings.add(it_hm.strstretched);
             }
 
-            IdentityInfo ideninfo;
-            ideninfo.source_wwn = it_hm.masterlumwwn;
-            sd.identity_info = ideninfo;
+            sd.source_wwn = source_devs.strings.add(it_hm.masterlumwwn);
 
-            TargetDeviceInfo td;
-            td.target_key = target_dev_id;
-            sd.target_info = td;
-
-            source_devs.lst_source_devices.push_back(sd);
+            sd.target_key = source_devs.strings.add(target_dev_id);
         }
     }
     else         {
          
         if (HM_SLAVE_PAIR_STATUS_STR_PAUSE == it_hm.pairstatus){
             if ("true" == it_hm.strCptype){
-                TargetDeviceInfo td;
-                td.target_key = target_dev_id;
-                td.target_id = target_dev_id;
-                td.target_name = it_hm.slavelunname;
+                TARGET_DEVICE_RECORD &td = target_devs.append_record();
+                td.target_key = target_devs.strings.add(target_dev_id);
+                td.target_id = target_devs.strings.add(target_dev_id);
+                td.target_name = target_devs.strings.add(it_hm.slavelunname);
                 if ((int)RESOURCE_ACCESS_READ_WRITE == it_hm.uiResAcess){
-                    td.target_state = "read-write";
+                    td.target_state = target_devs.strings.add("read-write");
                 }
                 else{
-                    td.target_state = "read-only";
+                    td.target_state = target_devs.strings.add("read-only");
                 }
 
                 if (it_hm.strIsinCg.compare("true") == 0){
-                    td.stretched = "";
+                    td.stretched = 0;
                 }
                 else{
-                    td.stretched = it_hm.strstretched;
+                    td.stretched = target_devs.strings.add(it_hm.strstretched);
                 }
-                td.cptype = "";
-
-                target_devs.lst_target_devices.push_back(td);
             }
             else{
-                SourceDeviceInfo sd;
-                sd.source_id = target_dev_id;
-                sd.source_name = it_hm.slavelunname;
+                SOURCE_DEVICE_RECORD &sd = source_devs.append_record();
+                sd.source_id = source_devs.strings.add(target_dev_id);
+                sd.source_name = source_devs.strings.add(it_hm.slavelunname);
                 if ((int)RESOURCE_ACCESS_READ_WRITE == it_hm.uiResAcess){
-                    sd.status = "read-write";
+                    sd.status = source_devs.strings.add("read-write");
                 }
                 else{
-                    sd.status = "read-only";
+                    sd.status = source_devs.strings.add("read-only");
                 }
                 if (it_hm.strIsinCg.compare("true") == 0){
-                    sd.stretched = "";
-                    sd.cptype = "";
+                    sd.stretched = 0;
+                    sd.cptype = 0;
                 }
                 else{
-                    sd.stretched = it_hm.strstretched;
-                    sd.cptype = it_hm.strCptype;
+                    sd.stretched = source_devs.strings.add(it_hm.strstretched);
+                    sd.cptype = source_devs.strings.add(it_hm.strCptype);
                 }
 
-                TargetDeviceInfo td;
-                td.target_key = source_dev_id;
-                sd.target_info = td;
-
-                source_devs.lst_source_devices.push_back(sd);
+                sd.target_key = source_devs.strings.add(source_dev_id);
             }
         }
         else  {
             if ("true" == it_hm.strCptype){
-                TargetDeviceInfo td;
-                td.target_key = target_dev_id;
-                td.target_name = it_hm.slavelunname;
-                td.target_state = "read-write";
+                TARGET_DEVICE_RECORD &td = target_devs.append_record();
+                td.target_key = target_devs.strings.add(target_dev_id);
+                td.target_name = target_devs.strings.add(it_hm.slavelunname);
+                td.target_state = target_devs.strings.add("read-write");
                 if (it_hm.strIsinCg.compare("true") == 0){
-                    td.stretched = "";
+                    td.stretched = 0;
                 }
                 else{
-                    td.stretched = it_hm.strstretched;
+                    td.stretched = target_devs.strings.add(it_hm.strstretched);
                 }
-                td.cptype = "";
 
-                IdentityInfo ideninfo;
-                ideninfo.source_wwn = it_hm.slavelunwwn;
-                td.identity_info = ideninfo;
+                td.source_wwn = target_devs.strings.add(it_hm.slavelunwwn);
 
-                td.snapshot_info = it_hm.snapshot_info;
-
-                target_devs.lst_target_devices.push_back(td);
+                td.snapshot = target_devs.add_snapshot(it_hm.snapshot_info);
             }
             else{
-                SourceDeviceInfo sd;
-                sd.source_id = target_dev_id;
-                sd.source_name = it_hm.slavelunname;
-                sd.status = "read-write";
+                SOURCE_DEVICE_RECORD &sd = source_devs.append_record();
+                sd.source_id = source_devs.strings.add(target_dev_id);
+                sd.source_name = source_devs.strings.add(it_hm.slavelunname);
+                sd.status = source_devs.strings.add("read-write");
                 if (it_hm.strIsinCg.compare("true") == 0){
-                    sd.stretched = "";
-                    sd.cptype = "";
+                    sd.stretched = 0;
+                    sd.cptype = 0;
                 }
                 else{
-                    sd.cptype = it_hm.strCptype;
-                    sd.stretched = it_hm.strstretched;
+                    sd.cptype = source_devs.strings.add(it_hm.strCptype);
+                    sd.stretched = source_devs.strings.add(it_hm.strstretched);
                 }
 
-                IdentityInfo ideninfo;
-                ideninfo.source_wwn = it_hm.slavelunwwn;
-                sd.identity_info = ideninfo;
-
-                TargetDeviceInfo td;
-                td.target_key = source_dev_id;
-                sd.target_info = td;
+                sd.source_wwn = source_devs.strings.add(it_hm.slavelunwwn);
 
-                source_devs.lst_source_devices.push_back(sd);
+                sd.target_key = source_devs.strings.add(source_dev_id);
             }
         }
     }
@@ -1213,15 +1301,17 @@ void DiscoverDevices::_write_consist(CgDetail &it_cg)
 
      
     if (it_cg.arrayid == array_id){
-        ConGroupInfo cg;
+        ConGroupInfo &cg = append_node(rep_devices.cgs_info.lst_groups_info);
         TargetDevicesInfo targetdev;
 
         cg.cg_id = source_cg_id;
         cg.cg_name = it_cg.cgname;
 
-        TargetGroupInfo tg;
-        tg.tg_key = target_cg_id;
-        cg.target_group = tg;
+        cg.target_group.tg_key = target_cg_id;
+
+        if (RETURN_OK != it_cg.query_ret){
+            cg.error_info.code = OS_IToString(it_cg.query_ret);
+        }
 
         if (HM_SPLITED == it_cg.pairstatus && (int)RESOURCE_ACCESS_READ_WRITE == it_cg.uiResAcess){
             cg.status = "read-only";
@@ -1231,10 +1321,9 @@ void DiscoverDevices::_write_consist(CgDetail &it_cg)
         }
 
         _write_mirror_response(it_cg.lst_mirror_info, cg.source_devices_info, targetdev);
-        rep_devices.cgs_info.lst_groups_info.push_back(cg);
     }
     else{
-        TargetGroupInfo tg;
+        TargetGroupInfo &tg = append_node(rep_devices.tgs_info.lst_groups_info);
         SourceDevicesInfo sourcedev;
 
         tg.tg_key = target_cg_id;
@@ -1258,7 +1347,6 @@ void DiscoverDevices::_write_consist(CgDetail &it_cg)
             }
         }
         _write_mirror_response(it_cg.lst_mirror_info, sourcedev, tg.target_devices_info);
-        rep_devices.tgs_info.lst_groups_info.push_back(tg);
     }
 
     return;
@@ -1271,7 +1359,7 @@ void DiscoverDevices::_write_consisthm(CgHMDetail &it_cghm)
 
      
     if (it_cghm.arrayid == array_id){
-        HMConGroupInfo cghm;
+        HMConGroupInfo &cghm = append_node(rep_devices.hmcgs_info.lst_hmgroups_info);
         TargetDevicesInfo targetdev;
 
         cghm.cghm_id = source_cg_id;
@@ -1279,9 +1367,11 @@ void DiscoverDevices::_write_consisthm(CgHMDetail &it_cghm)
         cghm.stretched = it_cghm.strstretched;
         cghm.cptype = it_cghm.strCptype;
 
-        TargetGroupInfo tg;
-        tg.tg_key = target_cg_id;
-        cghm.target_group = tg;
+        cghm.target_group.tg_key = target_cg_id;
+
+        if (RETURN_OK != it_cghm.query_ret){
+            cghm.error_info.code = OS_IToString(it_cghm.query_ret);
+        }
 
         if (HM_SLAVE_PAIR_STATUS_STR_PAUSE == it_cghm.pairstatus && (int)RESOURCE_ACCESS_READ_WRITE == it_cghm.uiResAcess){
             cghm.status = "read-only";
@@ -1291,11 +1381,10 @@ void DiscoverDevices::_write_consisthm(CgHMDetail &it_cghm)
         }
 
         _write_hypermetro_response(it_cghm.lst_hypermetro_info, cghm.source_devices_info, targetdev);
-        rep_devices.hmcgs_info.lst_hmgroups_info.push_back(cghm);
     }
     else{
         if ("true" == it_cghm.strCptype){
-            TargetGroupInfo tg;
+            TargetGroupInfo &tg = append_node(rep_devices.tgs_info.lst_groups_info);
             SourceDevicesInfo sourcedev;
 
             tg.tg_key = target_cg_id;
@@ -1326,10 +1415,9 @@ void DiscoverDevices::_write_consisthm(CgHMDetail &it_cghm)
                 }
             }
             _write_hypermetro_response(it_cghm.lst_hypermetro_info, sourcedev, tg.target_devices_info);
-            rep_devices.tgs_info.lst_groups_info.push_back(tg);
         }
         else{
-            HMConGroupInfo cghm;
+            HMConGroupInfo &cghm = append_node(rep_devices.hmcgs_info.lst_hmgroups_info);
             TargetDevicesInfo targetdev;
 
             cghm.cghm_id = target_cg_id;
@@ -1337,9 +1425,7 @@ void DiscoverDevices::_write_consisthm(CgHMDetail &it_cghm)
             cghm.stretched = it_cghm.strstretched;
             cghm.cptype = it_cghm.strCptype;
 
-            TargetGroupInfo tg;
-            tg.tg_key = source_cg_id;
-            cghm.target_group = tg;
+            cghm.target_group.tg_key = source_cg_id;
 
             if (HM_SLAVE_PAIR_STATUS_STR_PAUSE == it_cghm.pairstatus && (int)RESOURCE_ACCESS_READ_WRITE == it_cghm.uiResAcess){
                 cghm.status = "read-only";
@@ -1349,7 +1435,6 @@ void DiscoverDevices::_write_consisthm(CgHMDetail &it_cghm)
             }
 
             _write_hypermetro_response(it_cghm.lst_hypermetro_info, cghm.source_devices_info, targetdev);
-            rep_devices.hmcgs_info.lst_hmgroups_info.push_back(cghm);
         }
     }
 
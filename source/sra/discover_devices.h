@@ -16,10 +16,15 @@
 #define DISCOVER_DEVICES_H
 
 #include "sra_basic.h"
+#include "task_pool.h"
 #include "../common/xml_node/replicated_devices.h"
 
 int discover_devices(XmlReader &reader);
 
+class MirrorDetailTask;
+class HyperMetroDetailTask;
+class CgDetailTask;
+
 class MirrorDetail : public SraBasic
 {
 public:
@@ -90,6 +95,7 @@ public:
     CgDetail()
     {
         uiResAcess = 0;
+        query_ret = RETURN_OK;
     }
 
 public:
@@ -103,6 +109,7 @@ public:
     string pairstatus;
     string role;
     unsigned int uiResAcess;
+    int query_ret;
     list<MirrorDetail> lst_mirror_info;
     CgSnapshot snapshot_info;
 };
@@ -115,6 +122,7 @@ public:
     CgHMDetail()
     {
         uiResAcess = 0;
+        query_ret = RETURN_OK;
     }
 
 public:
@@ -132,18 +140,28 @@ public:
     string strstretched;
     string strCptype;
     unsigned int uiResAcess;
+    int query_ret;
     list<HyperMetroDetail> lst_hypermetro_info;
     CgSnapshot snapshot_info;
 };
 
 class DiscoverDevices : public SraBasic
 {
+    friend class MirrorDetailTask;
+    friend class HyperMetroDetailTask;
+    friend class CgDetailTask;
+
 public:
     DiscoverDevices() : SraBasic()
     {
         memset_s(array_id, sizeof(array_id), 0, sizeof(array_id));
         memset_s(peer_array_id, sizeof(peer_array_id), 0, sizeof(peer_array_id));
         memset_s(input_array_id, sizeof(input_array_id), 0, sizeof(input_array_id));
+
+        startup_checks = STARTUP_CHECK_CLONEFS;
+        if (!g_bFusionStorage || g_testFusionStorageStretch){
+            startup_checks |= STARTUP_CHECK_STRETCHED;
+        }
     };
     virtual ~DiscoverDevices() {};
 
@@ -164,19 +182,22 @@ private:
     void _write_consist(CgDetail &it_cg);
     void _write_consisthm(CgHMDetail &ig_cghm);
 
-    int _get_mirror_info(CCmdOperate& cmdOperate, string& hymirror_id, MirrorDetail& mirrorDetail);
+    int _discover_mirror_out(CCmdOperate& cmdOperate, TaskPool& pool, int& countDevice);
+    int _discover_hypermetro_out(CCmdOperate& cmdOperate, TaskPool& pool, int& countDevice);
+
+    int _get_mirror_info(CCmdOperate& cmdOperate, string& hymirror_id, MirrorDetail& mirrorDetail, bool nfs);
     int _get_hypermetro_info(CCmdOperate& cmdOperate, string& hypermetro_id, HyperMetroDetail &hypermetrodetail);
-    int _check_cgid_exist(CCmdOperate& cmdOperate,const string &cg_id, string &hymirror_id, const MirrorDetail &mirrorinfo);
-    int _check_cghmid_exist(CCmdOperate& cmdOperate, const string &cghm_id,string &hypermetro_id,const HyperMetroDetail &hypermetroinfo);
+    void _check_cgid_exist(const string &cg_id, const MirrorDetail &mirrorinfo, const CgDetail &fetched_cg);
+    void _check_cghmid_exist(const string &cghm_id, const HyperMetroDetail &hypermetroinfo, const CgHMDetail &fetched_cghm);
     int _get_cgdetail_info(CCmdOperate& cmdOperate, const string& cg_id, const string& hymirror_id, CgDetail& cg_info);
 
     int _get_vstorepair_detail_info(CCmdOperate& cmdOperate, const string& cg_id, const string& hymirror_id, CgDetail& cg_info);
     int _get_cghmdetail_info(CCmdOperate& cmdOperate, const string& cg_id, const string& hypermetroid, CgHMDetail& cghm_info);
-    int _get_mirror_detail_info(CCmdOperate& cmdOperate, list<HYMIRROR_LF_INFO_STRU>& lstMirrorLUNInfo, MirrorDetail& mirrorDetail);
+    int _get_mirror_detail_info(CCmdOperate& cmdOperate, list<HYMIRROR_LF_INFO_STRU>& lstMirrorLUNInfo, MirrorDetail& mirrorDetail, bool nfs);
     int _get_hm_detail_info(CCmdOperate& cmdOperate, list<HYPERMETRO_LF_INFO_STRU>& lstHMLUNInfo, HyperMetroDetail& hypermetroDetail);
     int _get_hm_detail_info(CCmdOperate& cmdOperate, list<HYMIRROR_LF_INFO_STRU>& lstMirrorLUNInfo, MirrorDetail& mirrorDetail);
-    int _get_snapshot_info(CCmdOperate& cmdOperate, string& lun_id, SnapShotInfo& snapShotInfo);
-    int _get_active_time(CCmdOperate& cmdOperate, const string& snapShot_id, const string& snapName,string& time_stamp);
+    int _get_snapshot_info(CCmdOperate& cmdOperate, string& lun_id, SnapShotInfo& snapShotInfo, bool nfs);
+    int _get_active_time(CCmdOperate& cmdOperate, const string& snapShot_id, const string& snapName,string& time_stamp, bool nfs);
 
 private:
     char peer_array_id[LENGTH_COMMON];
@@ -44,101 +44,39 @@ int failover(XmlReader &reader)
 
 int FailOver::_read_command_para(XmlReader &reader)
 {
-    int i = 0,j = 0;
-    int tg_count = 0;
-    int device_count = 0;
-    int accessgroup_count = 0;
-    int accessgroups_count = 0;
-    int accessinitiator_count = 0;
+    CommandPara para;
+    list<TargetGroupInfo>::iterator itGroup;
+    list<TargetDeviceInfo>::iterator itDevice;
+    list<pair<string, string> >::iterator itAccess;
 
-    (void)reader.get_string("/Command/FailoverParameters/ArrayId", array_id, 0);
-    (void)reader.get_string("/Command/FailoverParameters/ArrayId", input_array_id, 0);
+    (void)reader.get_cstring("/Command/FailoverParameters/ArrayId", array_id);
+    (void)reader.get_cstring("/Command/FailoverParameters/ArrayId", input_array_id);
 
     m_array_id = input_array_id;
 
-    tg_count = reader.get_count("/Command/FailoverParameters/TargetGroups/TargetGroup");
-
-    for (i = 0; i < tg_count; i++){
-        char tg_key[LENGTH_COMMON] = {0};
-        char tg_isolationRequired[LENGTH_COMMON] = {0};
-
-        TargetGroupInfo tg_info;
-
-        (void)reader.get_string("/Command/FailoverParameters/TargetGroups/TargetGroup/@key", tg_key, i);
-        (void)reader.get_string("/Command/FailoverParameters/TargetGroups/TargetGroup/@isolationRequired", tg_isolationRequired, i);
-
-        tg_info.tg_key = tg_key;
-        tg_info.isolationRequired = tg_isolationRequired;
+    CHECK_FALSE(_get_command_para(reader, "/Command/FailoverParameters", para), RETURN_ERR);
 
+    for (itGroup = para.target_groups.begin(); itGroup != para.target_groups.end(); ++itGroup){
         ConGroupInfo cg_info;
-        cg_info.cg_id = tg_key;
+        cg_info.cg_id = itGroup->tg_key;
         consistency_group_info.lst_groups_info.push_back(cg_info);
-
-        tg_groups.lst_groups_info.push_back(tg_info);
-        
-        device_count = reader.get_count("/Command/FailoverParameters/TargetGroups/TargetGroup/TargetDevices/TargetDevice", i, 2);
-        
-        for(j = 0; j < device_count; j++){
-            char target_key[LENGTH_COMMON] = {0};
-            (void)reader.get_string("/Command/FailoverParameters/TargetGroups/TargetGroup/TargetDevices/TargetDevice/@key", target_key, j);
-            
-            accessgroups_count = reader.get_count("/Command/FailoverParameters/TargetGroups/TargetGroup/TargetDevices/TargetDevice/AccessGroups/AccessGroup",j,2);
-            
-            string cg_accessgroups = "";
-            for (int k = 0; k < accessgroups_count; k++){
-                char group_id[LENGTH_COMMON] = {0};
-                (void)reader.get_string("/Command/FailoverParameters/TargetGroups/TargetGroup/TargetDevices/TargetDevice/AccessGroups/AccessGroup/@id", group_id, k,j,2);
-                
-                cg_accessgroups = cg_accessgroups + group_id + DAR_HOST_SEPERATOR;
-            }
-            COMMLOG(OS_LOG_INFO, "AccessGroups of TargetDevice[%s] is [%s].", target_key, cg_accessgroups.c_str());
-            accessGroupDict[target_key] = cg_accessgroups;
-        }
     }
+    tg_groups.lst_groups_info.swap(para.target_groups);
 
-    device_count = reader.get_count("/Command/FailoverParameters/TargetDevices/TargetDevice");
-
-    for (i = 0; i < device_count; i++){
-        char target_key[LENGTH_COMMON] = {0};
-        char target_isolationRequired[LENGTH_COMMON] = {0};
-
-        TargetDeviceInfo tg_device_info;
-
-        (void)reader.get_string("/Command/FailoverParameters/TargetDevices/TargetDevice/@key", target_key, i);
-        (void)reader.get_string("/Command/FailoverParameters/TargetDevices/TargetDevice/@isolationRequired", target_isolationRequired, i);
-        accessgroups_count = reader.get_count("/Command/FailoverParameters/TargetDevices/TargetDevice/AccessGroups/AccessGroup",i,2);
-        for (j = 0; j < accessgroups_count; j++){
-            char group_id[LENGTH_COMMON] = {0};
-            (void)reader.get_string("/Command/FailoverParameters/TargetDevices/TargetDevice/AccessGroups/AccessGroup/@id", group_id, j,i,2);
-            tg_device_info.cg_accessgroups = tg_device_info.cg_accessgroups + group_id + ":";
-        }
-        tg_device_info.target_key = target_key;
-        tg_device_info.isolationRequired = target_isolationRequired;
-        tg_devices.lst_target_devices.push_back(tg_device_info);
+    for (itAccess = para.group_access.begin(); itAccess != para.group_access.end(); ++itAccess){
+        COMMLOG(OS_LOG_INFO, "AccessGroups of TargetDevice[%s] is [%s].", itAccess->first.c_str(), itAccess->second.c_str());
+        accessGroupDict[itAccess->first] = itAccess->second;
+    }
 
+    for (itDevice = para.target_devices.begin(); itDevice != para.target_devices.end(); ++itDevice){
         DeviceInfo dev_info;
-        dev_info.id = target_key;
-        
+        dev_info.id = itDevice->target_key;
+
         devices_info.lst_device_info.push_back(dev_info);
     }
-       
-    accessgroup_count = reader.get_count("/Command/FailoverParameters/AccessGroups/AccessGroup");
-    for(j = 0 ;j < accessgroup_count; j++){
-        char group_id[LENGTH_COMMON] = {0};
-        (void)reader.get_string("/Command/FailoverParameters/AccessGroups/AccessGroup/@id", group_id, j);
-        accessinitiator_count = reader.get_count("/Command/FailoverParameters/AccessGroups/AccessGroup/Initiator",j,1);
-        for (i = 0; i < accessinitiator_count; i++){
-            char initiator_id[LENGTH_COMMON] = {0};
-            char initiator_type[LENGTH_COMMON] = {0};
-            DAR_HOST_INFO tg_dar_host_info;
-            (void)reader.get_string("/Command/FailoverParameters/AccessGroups/AccessGroup/Initiator/@id", initiator_id, i,j,1);
-            (void)reader.get_string("/Command/FailoverParameters/AccessGroups/AccessGroup/Initiator/@type", initiator_type, i,j,1);
-            tg_dar_host_info.strID = initiator_id;
-            tg_dar_host_info.strType = initiator_type;
-            tg_dar_host_info.strGroup = group_id;
-            lstDARHosts.push_back(tg_dar_host_info);
-        }
-    }
+    tg_devices.lst_target_devices.swap(para.target_devices);
+
+    lstDARHosts.swap(para.dar_hosts);
 
     return RETURN_OK;
 }
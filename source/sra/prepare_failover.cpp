@@ -14,6 +14,196 @@
 
 #include "prepare_failover.h"
 
+/*
+ Promotion of one hypermetro pair or consistency group. run() checks the
+ role on a worker session and swaps while the local side is still the
+ slave, apply() records the outcome and prints the progress on the
+ calling thread, in request order.
+*/
+class PromoteTask : public SraTask
+{
+public:
+    PromoteTask() : err_code(RETURN_OK), swapped(false) {};
+
+    virtual void apply() = 0;
+
+protected:
+    int err_code;
+    bool swapped;
+};
+
+class HyperMetroPromoteTask : public PromoteTask
+{
+public:
+    HyperMetroPromoteTask(PrepareFailove *owner, SourceDeviceInfo *device, const string& hmpair_id, const string& key,
+        const list<HYPERMETRO_LF_INFO_STRU> *listed_info)
+        : owner(owner), device(device), source_id(device->source_id), hmpair_id(hmpair_id), key(key), listed(NULL != listed_info)
+    {
+        if (listed){
+            lstHMPairLFInfo = *listed_info;
+        }
+    };
+
+    virtual int run(CCmdOperate& cmdOperate)
+    {
+        int ret = RETURN_ERR;
+        string master_id;
+        string slave_id;
+        list<HYPERMETRO_LF_INFO_STRU>::iterator itHMPairLFInfo;
+
+        if (!listed){
+            ret = cmdOperate.CMD_showhypermetrolun_all(hmpair_id, lstHMPairLFInfo);
+            if (RETURN_OK != ret){
+                err_code = ret;
+                return ret;
+            }
+        }
+
+        for (itHMPairLFInfo = lstHMPairLFInfo.begin(); 
+            itHMPairLFInfo != lstHMPairLFInfo.end(); itHMPairLFInfo++){
+            if (MIRROR_LUN_RELATION_MASTER == itHMPairLFInfo->uiRelationType){
+                master_id = itHMPairLFInfo->strArrayWWN + "_" + itHMPairLFInfo->strID + "_" + HYPERMETRO_LUN_TAG + "_" + hmpair_id; 
+            }
+            if (MIRROR_LUN_RELATION_SLAVE == itHMPairLFInfo->uiRelationType){
+                slave_id = itHMPairLFInfo->strArrayWWN + "_" + itHMPairLFInfo->strID + "_" + HYPERMETRO_LUN_TAG + "_" + hmpair_id; 
+                slave_key = itHMPairLFInfo->strArrayWWN + "." + itHMPairLFInfo->strID + "_" + HYPERMETRO_LUN_TAG + "_" + hmpair_id; 
+            }
+        }
+
+        if (0 == master_id.length()){
+            err_code = ERROR_INVALIDATE_DEVICE_ID;
+            return err_code;
+        }
+
+        if (slave_id == source_id){
+            return RETURN_OK;
+        }
+
+        COMMLOG(OS_LOG_INFO, "Hypermetro dvice [%s] of Remote device [%s] is being promoted",
+            key.c_str(),slave_key.c_str());
+
+        swapped = true;
+        ret = cmdOperate.CMD_swaphypermetro(hmpair_id);
+        if (RETURN_OK != ret){
+            err_code = ret;
+            COMMLOG(OS_LOG_ERROR, "CMD_swaphypermetro failed (%d).", ret);
+            return ret;
+        }
+
+        return RETURN_OK;
+    }
+
+    virtual void apply()
+    {
+        if (swapped){
+            print("Hypermetro device [%s] of Remote device [%s] is being promoted",
+                key.c_str(),slave_key.c_str());
+        }
+
+        if (RETURN_OK != err_code){
+            device->error_info.code = OS_IToString(err_code);
+            return;
+        }
+
+        device->is_success = true;
+    }
+
+private:
+    PrepareFailove *owner;
+    SourceDeviceInfo *device;
+    string source_id;
+    string hmpair_id;
+    string key;
+    string slave_key;
+    bool listed;
+    list<HYPERMETRO_LF_INFO_STRU> lstHMPairLFInfo;
+};
+
+class ConsistHMPromoteTask : public PromoteTask
+{
+public:
+    ConsistHMPromoteTask(PrepareFailove *owner, ConGroupInfo *group, const string& cg_id, const GROUP_INFO_STRU *listed_info)
+        : owner(owner), group(group), cg_id(cg_id), listed(NULL != listed_info), res_access(0)
+    {
+        if (listed){
+            stGroupInfo = *listed_info;
+        }
+    };
+
+    virtual int run(CCmdOperate& cmdOperate)
+    {
+        int ret = RETURN_ERR;
+
+        if (listed){
+            owner->_convert_pair_status(stGroupInfo.uiState, status);
+            owner->_convert_relation_type(stGroupInfo.uiIsPrimary, role);
+            res_access = stGroupInfo.uiSecResAccess;
+        }
+        else{
+            ret = owner->_get_cghm_status_out(cmdOperate, cg_id, status, role, res_access);
+            if (RETURN_OK != ret){
+                COMMLOG(OS_LOG_ERROR, "_get_cg_status_out faild(%d).", ret);
+                err_code = ret;
+                return ret;
+            }
+        }
+
+        COMMLOG(OS_LOG_INFO,"Hypermetro Group with groupID [%s] status [%s] role [%s]",
+            cg_id.c_str(),
+            status.c_str(),
+            role.c_str());
+
+        if (HM_RELATION_SLAVE == role){
+            return RETURN_OK;
+        }
+
+        COMMLOG(OS_LOG_INFO,"Hypermetro consisgroup id [%s] is being swap promoted from Recovery Point [%s]",
+            cg_id.c_str(),owner->recovery_point.c_str());
+
+        swapped = true;
+        ret = cmdOperate.CMD_swapconsistgrhm(cg_id);
+        if (RETURN_OK != ret){
+            COMMLOG(OS_LOG_ERROR, "swap hypermetro consistgr ret(%d).", ret);
+            err_code = ret;
+            return ret;
+        }
+
+        return RETURN_OK;
+    }
+
+    virtual void apply()
+    {
+        if (!status.empty() || !role.empty()){
+            print("Hypermetro Group with groupID [%s] status [%s] role [%s]",
+                cg_id.c_str(),
+                status.c_str(),
+                role.c_str());
+        }
+
+        if (swapped){
+            print("Hypermetro consisgroup id [%s] is being swap promoted from Recovery Point [%s]",
+                cg_id.c_str(),owner->recovery_point.c_str());
+        }
+
+        if (RETURN_OK != err_code){
+            group->error_info.code = OS_IToString(err_code);
+            return;
+        }
+
+        group->is_success = true;
+    }
+
+private:
+    PrepareFailove *owner;
+    ConGroupInfo *group;
+    string cg_id;
+    bool listed;
+    GROUP_INFO_STRU stGroupInfo;
+    string status;
+    string role;
+    unsigned int res_access;
+};
+
 PrepareFailove::PrepareFailove() : SraBasic()
 {
     memset_s(array_id, sizeof(array_id), 0, sizeof(array_id));
@@ -43,38 +233,15 @@ int prepare_failover(XmlReader &reader)
 
 int PrepareFailove::_read_command_para(XmlReader &reader)
 {
-    int i = 0;
-    int cg_count = 0;
-    int device_count = 0;
-
-    (void)reader.get_string("/Command/PrepareFailoverParameters/ArrayId", array_id, 0);
-    (void)reader.get_string("/Command/PrepareFailoverParameters/ArrayId", input_array_id, 0);
+    CommandPara para;
 
-    cg_count = reader.get_count("/Command/PrepareFailoverParameters/ConsistencyGroups/ConsistencyGroup");
-    for (i = 0; i < cg_count; i++){
-        char cg_id[LENGTH_COMMON];
-        ConGroupInfo gp_info;
+    (void)reader.get_cstring("/Command/PrepareFailoverParameters/ArrayId", array_id);
+    (void)reader.get_cstring("/Command/PrepareFailoverParameters/ArrayId", input_array_id);
 
-        memset_s(cg_id, sizeof(cg_id), 0, sizeof(cg_id));
-        (void)reader.get_string("/Command/PrepareFailoverParameters/ConsistencyGroups/ConsistencyGroup/@id", cg_id, i);
-
-        
-        gp_info.cg_id = cg_id;
-        group_info.lst_groups_info.push_back(gp_info);
-    }
+    CHECK_FALSE(_get_command_para(reader, "/Command/PrepareFailoverParameters", para), RETURN_ERR);
 
-    device_count = reader.get_count("/Command/PrepareFailoverParameters/SourceDevices/SourceDevice");
-    for (i = 0; i < device_count; i++){
-        char dev_id[LENGTH_COMMON];
-        SourceDeviceInfo device_info;
-
-        memset_s(dev_id, sizeof(dev_id), 0, sizeof(dev_id));
-        (void)reader.get_string("/Command/PrepareFailoverParameters/SourceDevices/SourceDevice/@id", dev_id, i);
-
-        
-        device_info.source_id = dev_id;
-        devices_info.lst_source_devices.push_back(device_info);
-    }
+    group_info.lst_groups_info.swap(para.cons_groups);
+    devices_info.lst_source_devices.swap(para.source_devices);
 
     return RETURN_OK;
 }
@@ -84,6 +251,9 @@ int PrepareFailove::_outband_process()
     int iRet = RETURN_ERR;
     HYPER_STORAGE_STRU stStorageInfo;
     CCmdOperate cmdOperate;
+    unsigned long long ullCheckTime = 0;
+    unsigned long long ullListTime = 0;
+    unsigned long long ullPromoteTime = 0;
 
     (void)setStorageInfo(stStorageInfo);
 
@@ -99,33 +269,94 @@ int PrepareFailove::_outband_process()
     iRet = check_array_id_validate_out(cmdOperate, array_id_temp);
     CHECK_UNEQ(RETURN_OK, iRet);
 
+    TaskPool promote_pool(stStorageInfo);
+    unsigned long long ullStartTime = OS_GetTickCount();
+
+    // every pair and group of this request is promoted from the same recovery point
+    recovery_point = OS_Time_tToStr(OS_Now());
+
     
     (void)_outband_swap_hypermirror(cmdOperate);
 
-    if (g_bFusionStorage && !g_testFusionStorageStretch){
-        return RETURN_OK;
+    if (!g_bFusionStorage || g_testFusionStorageStretch){
+        _load_pair_listing_out(cmdOperate);
+        ullListTime = OS_GetTickCount() - ullStartTime;
+
+        if (g_bstretch){
+            
+            (void)_outband_swap_hypermetro(cmdOperate, promote_pool);
+        }
+
+        if (!g_bFusionStorage){
+            
+            iRet = _outband_swap_consist(cmdOperate);
+            if (RETURN_OK == iRet && g_bstretch){
+                
+                iRet = _outband_swap_consisthm(cmdOperate, promote_pool);
+            }
+        }
     }
+    ullCheckTime = OS_GetTickCount() - ullStartTime - ullListTime;
 
-    if (g_bstretch){
-        
-        (void)_outband_swap_hypermetro(cmdOperate);
+    _run_promote_out(cmdOperate, promote_pool);
+    ullPromoteTime = OS_GetTickCount() - ullStartTime - ullListTime - ullCheckTime;
+
+    COMMLOG(OS_LOG_INFO, "prepare failover listed pairs in %llu ms, checked in %llu ms, promoted %u pairs and groups in %llu ms.",
+        ullListTime, ullCheckTime, (unsigned int)promote_pool.size(), ullPromoteTime);
+
+    return iRet;
+}
+
+/*
+ List the hypermetro pairs and hypermetro consistency groups of the array
+ once instead of querying them for each device. Whatever is missing from
+ a listing, or every object when a listing fails, is queried on its own.
+*/
+void PrepareFailove::_load_pair_listing_out(CCmdOperate& cmdOperate)
+{
+    int ret = RETURN_ERR;
+    list<GROUP_INFO_STRU> lstGroupInfo;
+    list<GROUP_INFO_STRU>::iterator itGroupInfo;
+
+    hmpair_lun_info.clear();
+    consistgrhm_info.clear();
+
+    if (!g_bstretch){
+        return;
     }
 
-    if(g_bFusionStorage){
-        return RETURN_OK;
+    if (!devices_info.lst_source_devices.empty()){
+        ret = cmdOperate.CMD_showhypermetrolun_all(hmpair_lun_info);
+        if (RETURN_OK != ret){
+            COMMLOG(OS_LOG_WARN, "list hypermetro pairs fail(%d), query them one by one.", ret);
+            hmpair_lun_info.clear();
+        }
     }
 
-    
-    iRet = _outband_swap_consist(cmdOperate);
-    CHECK_UNEQ(RETURN_OK, iRet);
+    if (group_info.lst_groups_info.empty() || g_bFusionStorage){
+        return;
+    }
 
-    if (g_bstretch){
-        
-        iRet = _outband_swap_consisthm(cmdOperate);
-        CHECK_UNEQ(RETURN_OK, iRet);
+    ret = cmdOperate.CMD_showconsistgrhminfo(lstGroupInfo);
+    if (RETURN_OK != ret){
+        COMMLOG(OS_LOG_WARN, "list hypermetro consist groups fail(%d), query them one by one.", ret);
+        return;
     }
 
-    return RETURN_OK;
+    for (itGroupInfo = lstGroupInfo.begin(); itGroupInfo != lstGroupInfo.end(); ++itGroupInfo){
+        consistgrhm_info[itGroupInfo->strID] = *itGroupInfo;
+    }
+
+    return;
+}
+
+void PrepareFailove::_run_promote_out(CCmdOperate& cmdOperate, TaskPool& pool)
+{
+    pool.run(cmdOperate);
+
+    for (size_t i = 0; i < pool.size(); i++){
+        static_cast<PromoteTask *>(pool.at(i))->apply();
+    }
 }
 
 int PrepareFailove::_operate_snapshot(const string& lun_id)
@@ -271,19 +502,15 @@ int PrepareFailove::_outband_swap_consist(CCmdOperate &cmdOperate)
     return RETURN_OK;
 }
 
-int PrepareFailove::_outband_swap_consisthm(CCmdOperate &cmdOperate)
+int PrepareFailove::_outband_swap_consisthm(CCmdOperate &cmdOperate, TaskPool& pool)
 {
     int iRet = RETURN_ERR;
-    string cmd;
-    string status;
-    string role;
     string cgid;
     string lunid;
     string arrayid;
     string lun_flag;
-    list<string> lst_token;
-    unsigned int uiResAccess = 0;
     list<ConGroupInfo>::iterator iter;
+    map<string, GROUP_INFO_STRU>::iterator itListed;
 
     
     for (iter = group_info.lst_groups_info.begin(); iter != group_info.lst_groups_info.end(); ++iter){
@@ -310,44 +537,9 @@ int PrepareFailove::_outband_swap_consisthm(CCmdOperate &cmdOperate)
             continue;
         }
 
-        
-        iRet = _get_cghm_status_out(cmdOperate, cgid, status, role, uiResAccess);
-        if (RETURN_OK != iRet){
-            iter->error_info.code = OS_IToString(iRet);
-            COMMLOG(OS_LOG_ERROR, "_get_cg_status_out faild(%d).", iRet);
-            continue;
-        }
-        
-        COMMLOG(OS_LOG_INFO,"Hypermetro Group with groupID [%s] status [%s] role [%s]",
-            cgid.c_str(),
-            status.c_str(),
-            role.c_str());
-        print("Hypermetro Group with groupID [%s] status [%s] role [%s]",
-            cgid.c_str(),
-            status.c_str(),
-            role.c_str());
-
-        if (HM_RELATION_SLAVE == role){
-            iter->is_success = true;
-            continue;
-        }
-
-        string TimeNowe = OS_Time_tToStr(OS_Now());
-        COMMLOG(OS_LOG_INFO,"Hypermetro consisgroup id [%s] is being swap promoted from Recovery Point [%s]",
-            cgid.c_str(),TimeNowe.c_str());
-        print("Hypermetro consisgroup id [%s] is being swap promoted from Recovery Point [%s]",
-            cgid.c_str(),TimeNowe.c_str());
-
-        
-        iRet = cmdOperate.CMD_swapconsistgrhm(cgid);
-        if (RETURN_OK != iRet){
-            COMMLOG(OS_LOG_ERROR, "swap hypermetro consistgr ret(%d).", iRet);
-            iter->error_info.code = OS_IToString(iRet);
-            continue;
-        }
-
-        iter->is_success = true;
-
+        itListed = consistgrhm_info.find(cgid);
+        pool.add(new ConsistHMPromoteTask(this, &(*iter), cgid,
+            (consistgrhm_info.end() == itListed) ? NULL : &itListed->second));
     }
     return RETURN_OK;
 }
@@ -386,24 +578,17 @@ int PrepareFailove::_outband_swap_hypermirror(CCmdOperate &cmdOperate)
     return RETURN_OK;
 }
 
-int PrepareFailove::_outband_swap_hypermetro(CCmdOperate &cmdOperate)
+int PrepareFailove::_outband_swap_hypermetro(CCmdOperate &cmdOperate, TaskPool& pool)
 {
     int iRet = RETURN_ERR;
-    string cmd;
     string strid;
     string hmpair_id;
-    string master_id;
-    string slave_key;
-    string Slave_id;
     string key;
-    string statu;
     string arrayid;
     string lun_flag;
 
-    list<string> lst_tmp;
     list<SourceDeviceInfo>::iterator iter;
-    list<HYPERMETRO_LF_INFO_STRU> lstHMPairLFInfo;
-    list<HYPERMETRO_LF_INFO_STRU>::iterator itHMPairLFInfo;
+    map<string, list<HYPERMETRO_LF_INFO_STRU> >::iterator itListed;
 
 
     for (iter = devices_info.lst_source_devices.begin(); iter != devices_info.lst_source_devices.end(); ++iter){
@@ -426,67 +611,22 @@ int PrepareFailove::_outband_swap_hypermetro(CCmdOperate &cmdOperate)
         key = arrayid + "." + strid;
 
         
-        string strTime;
-        strTime = OS_Time_tToStr(OS_Now());
         COMMLOG(OS_LOG_INFO,"Hypermetro of [%s] with id [%s] is being promoted from Recovery Point[%s]",
             strid.c_str(),
             key.c_str(),
-            strTime.c_str());
+            recovery_point.c_str());
         print("Hypermetro of [%s] with id [%s] is being promoted from Recovery Point[%s]",
             strid.c_str(),
             key.c_str(),
-            strTime.c_str());
+            recovery_point.c_str());
 
         
         COMMLOG(OS_LOG_INFO,"The Hypermetro id of lun [%s] is [%s]",strid.c_str(),hmpair_id.c_str());
         print("The Hypermetro id of lun [%s] is [%s]",strid.c_str(),hmpair_id.c_str());
-        
-        iRet = cmdOperate.CMD_showhypermetrolun_all(hmpair_id, lstHMPairLFInfo);
-        if (RETURN_OK != iRet){
-            iter->error_info.code = OS_IToString(iRet);
-            continue;
-        }
-
-        
-        for (itHMPairLFInfo = lstHMPairLFInfo.begin(); 
-            itHMPairLFInfo != lstHMPairLFInfo.end(); itHMPairLFInfo++){
-            if (MIRROR_LUN_RELATION_MASTER == itHMPairLFInfo->uiRelationType){
-                master_id = itHMPairLFInfo->strArrayWWN + "_" + itHMPairLFInfo->strID + "_" + HYPERMETRO_LUN_TAG + "_" + hmpair_id; 
-            }
-            if (MIRROR_LUN_RELATION_SLAVE == itHMPairLFInfo->uiRelationType){
-                Slave_id = itHMPairLFInfo->strArrayWWN + "_" + itHMPairLFInfo->strID + "_" + HYPERMETRO_LUN_TAG + "_" + hmpair_id; 
-                slave_key = itHMPairLFInfo->strArrayWWN + "." + itHMPairLFInfo->strID + "_" + HYPERMETRO_LUN_TAG + "_" + hmpair_id; 
-                _convert_hmpair_status(itHMPairLFInfo->uiPairStatus, statu);
-
-            }
-        }
-
-        if ((0 == master_id.length())){
-            iter->error_info.code = OS_IToString(ERROR_INVALIDATE_DEVICE_ID);
-            continue;
-        }
-
-        
-        if (Slave_id == iter->source_id){
-            iter->is_success = true;
-            continue;
-        }
-
-        
-        COMMLOG(OS_LOG_INFO, "Hypermetro dvice [%s] of Remote device [%s] is being promoted",
-            key.c_str(),slave_key.c_str());
-        print("Hypermetro device [%s] of Remote device [%s] is being promoted",
-            key.c_str(),slave_key.c_str());
-        
-        iRet = cmdOperate.CMD_swaphypermetro(hmpair_id);
-        if (RETURN_OK != iRet){
-            iter->error_info.code = OS_IToString(iRet);
-            COMMLOG(OS_LOG_ERROR, "CMD_swaphypermetro failed (%d).", iRet);
-            continue;
-        }
-
-        iter->is_success = true;
 
+        itListed = hmpair_lun_info.find(hmpair_id);
+        pool.add(new HyperMetroPromoteTask(this, &(*iter), hmpair_id, key,
+            (hmpair_lun_info.end() == itListed) ? NULL : &itListed->second));
     }
 
     return RETURN_OK;
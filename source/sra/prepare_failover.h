@@ -16,13 +16,20 @@
 #define PREPARE_FAILOVER_H
 
 #include "sra_basic.h"
+#include "task_pool.h"
 #include "../common/xml_node/consistency_groups.h"
 #include "../common/xml_node/device.h"
 
 int prepare_failover(XmlReader &reader);
 
+class HyperMetroPromoteTask;
+class ConsistHMPromoteTask;
+
 class PrepareFailove : public SraBasic
 {
+    friend class HyperMetroPromoteTask;
+    friend class ConsistHMPromoteTask;
+
 public:
     PrepareFailove();
     virtual ~PrepareFailove();
@@ -42,11 +49,14 @@ private:
     void _operate_lun_snapshot(const string& cg_id, list<CommonLunInfo>& lst_lun_info);
 
     int _outband_swap_consist(CCmdOperate& cmdOperate);
-    int _outband_swap_consisthm(CCmdOperate& cmdOperate);
+    int _outband_swap_consisthm(CCmdOperate& cmdOperate, TaskPool& pool);
     int _outband_swap_hypermirror(CCmdOperate& cmdOperate);
-    int _outband_swap_hypermetro(CCmdOperate& cmdOperate);
+    int _outband_swap_hypermetro(CCmdOperate& cmdOperate, TaskPool& pool);
     int _get_cghm_status_out(CCmdOperate& cmdOperate, string& cgid, string& status, string& role, unsigned int &uiResAccess);
 
+    void _load_pair_listing_out(CCmdOperate& cmdOperate);
+    void _run_promote_out(CCmdOperate& cmdOperate, TaskPool& pool);
+
 
 private:
     char array_id[LENGTH_COMMON];
@@ -60,6 +70,10 @@ private:
 
     map<string, string> map_cgs_errors;
     map<string, string> map_source_errors;
+
+    map<string, list<HYPERMETRO_LF_INFO_STRU> > hmpair_lun_info;
+    map<string, GROUP_INFO_STRU> consistgrhm_info;
+    string recovery_point;
 };
 
 
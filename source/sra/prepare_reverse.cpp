@@ -14,6 +14,71 @@
 
 #include "prepare_reverse.h"
 
+/*
+ Sets the sparse replication pairs and consistency groups that share the
+ LUNs of one device or group to read-only. The pairs and groups to change
+ are found from the listing on the calling thread, run() only issues the
+ changes on a worker session and apply() records the result.
+*/
+class SplitTask : public SraTask
+{
+public:
+    SplitTask(ErrorInfo *error_info, bool *is_success, const string& item_id, bool group,
+        const vector<string>& sparse_ids, const vector<string>& sparse_cg_ids)
+        : error_info(error_info), is_success(is_success), item_id(item_id), group(group),
+        sparse_ids(sparse_ids), sparse_cg_ids(sparse_cg_ids), err_code(RETURN_OK) {};
+
+    virtual int run(CCmdOperate& cmdOperate)
+    {
+        int ret = RETURN_ERR;
+
+        for (size_t i = 0; i < sparse_ids.size(); i++){
+            ret = cmdOperate.CMD_changeSlaveLunRw(sparse_ids[i], RESOURCE_ACCESS_READ_ONLY);
+            if (ret != RETURN_OK){
+                COMMLOG(OS_LOG_ERROR, "exec CMD_changeSlaveLunRw for SparseHymirror[%s] failed, error code id [%d]", sparse_ids[i].c_str(), ret);
+                err_code = RETURN_ERR;
+                return err_code;
+            }
+        }
+
+        for (size_t i = 0; i < sparse_cg_ids.size(); i++){
+            ret = cmdOperate.CMD_changeCGSlaveLunRw(sparse_cg_ids[i], RESOURCE_ACCESS_READ_ONLY);
+            if (ret != RETURN_OK){
+                COMMLOG(OS_LOG_ERROR, "get the consisGrp Read-Write  by consist id[%s] failed, error code id [%d]", sparse_cg_ids[i].c_str(), ret);
+                err_code = RETURN_ERR;
+                return err_code;
+            }
+        }
+
+        return RETURN_OK;
+    }
+
+    void apply()
+    {
+        if (RETURN_OK == err_code){
+            return;
+        }
+
+        error_info->code = OS_IToString(err_code);
+        *is_success = false;
+        if (group){
+            COMMLOG(OS_LOG_ERROR, "execSparseConsisgr by cgid [%s]  failed, the error code is [%d]", item_id.c_str(), err_code);
+        }
+        else{
+            COMMLOG(OS_LOG_ERROR, "exec execSparseHymirror for lun_id[%s] failed, error code id [%d]", item_id.c_str(), err_code);
+        }
+    }
+
+private:
+    ErrorInfo *error_info;
+    bool *is_success;
+    string item_id;
+    bool group;
+    vector<string> sparse_ids;
+    vector<string> sparse_cg_ids;
+    int err_code;
+};
+
 int prepare_reverse(XmlReader &reader)
 {
     PrepareReverse pre_reverse;
@@ -34,48 +99,32 @@ int prepare_reverse(XmlReader &reader)
 
 int PrepareReverse::_read_command_para(XmlReader &reader)
 {
-    char peer_array[LENGTH_COMMON] = {0};
-    char curr_array_id[LENGTH_COMMON] = {0};
+    CommandPara para;
+    list<ConGroupInfo>::iterator itGroup;
+    list<DeviceInfo>::iterator itDevice;
 
-    CHECK_FALSE(reader.get_string("/Command/PrepareReverseReplicationParameters/ArrayId", array_id, 0), RETURN_ERR);
-    CHECK_FALSE(reader.get_string("/Command/PrepareReverseReplicationParameters/ArrayId", curr_array_id, 0), RETURN_ERR);
-    CHECK_FALSE(reader.get_string("/Command/PrepareReverseReplicationParameters/PeerArrayId", peer_array, 0), RETURN_ERR);
+    CHECK_FALSE(reader.get_cstring("/Command/PrepareReverseReplicationParameters/ArrayId", array_id), RETURN_ERR);
+    CHECK_FALSE(reader.get_string("/Command/PrepareReverseReplicationParameters/ArrayId", input_array_id, LENGTH_COMMON - 1), RETURN_ERR);
+    CHECK_FALSE(reader.get_string("/Command/PrepareReverseReplicationParameters/PeerArrayId", peer_array_id, LENGTH_COMMON - 1), RETURN_ERR);
 
-    peer_array_id = peer_array;
-    input_array_id = string(curr_array_id);
-    
-    int cg_count = reader.get_count("/Command/PrepareReverseReplicationParameters/ConsistencyGroups/ConsistencyGroup");
-    for (int i = 0; i < cg_count; i++){
-        char cg_id[LENGTH_COMMON] = {0};
-        ConGroupInfo cg_info;
+    CHECK_FALSE(_get_command_para(reader, "/Command/PrepareReverseReplicationParameters", para), RETURN_ERR);
 
-        reader.get_string("/Command/PrepareReverseReplicationParameters/ConsistencyGroups/ConsistencyGroup/@id", cg_id, i);
-        
-        
-        cg_info.cg_id = cg_id;
-        cg_info.is_success = true;
-        consistency_group_info.lst_groups_info.push_back(cg_info);
+    for (itGroup = para.cons_groups.begin(); itGroup != para.cons_groups.end(); ++itGroup){
+        itGroup->is_success = true;
     }
+    consistency_group_info.lst_groups_info.swap(para.cons_groups);
 
-    int device_count = reader.get_count("/Command/PrepareReverseReplicationParameters/Devices/Device");
-    for (int i = 0; i < device_count; i++){
-        char dev_id[LENGTH_COMMON] = {0};
-        DeviceInfo dev_info;
-
-        reader.get_string("/Command/PrepareReverseReplicationParameters/Devices/Device/@id", dev_id, i);
-        
-        
-        dev_info.id = dev_id;
-        
-        dev_info.is_success = true;
-        devices_info.lst_device_info.push_back(dev_info);
+    for (itDevice = para.devices.begin(); itDevice != para.devices.end(); ++itDevice){
+        itDevice->is_success = true;
     }
+    devices_info.lst_device_info.swap(para.devices);
 
     return RETURN_OK;
 }
 
 PrepareReverse::PrepareReverse():
-    ThreeDCLunHelper(this->input_array_id,this->consistency_group_info,this->devices_info)
+    ThreeDCLunHelper(this->input_array_id,this->consistency_group_info,this->devices_info),
+    pair_listed(false)
 {
 }
 
@@ -111,14 +160,172 @@ int PrepareReverse::_outband_process()
         CHECK_UNEQ(RETURN_OK, iRet);
     }
 
+    TaskPool split_pool(stStorageInfo);
+    unsigned long long ullStartTime = OS_GetTickCount();
+
+    _load_pair_listing_out(cmdOperate);
+
     
-    dealHyperMirror(cmdOperate);
-    dealConsistHyperMirror(cmdOperate);
+    dealHyperMirror(cmdOperate, split_pool);
+    dealConsistHyperMirror(cmdOperate, split_pool);
+
+    _run_split_out(cmdOperate, split_pool);
+
+    COMMLOG(OS_LOG_INFO, "split sparse pairs of %u devices and groups in %llu ms.",
+        (unsigned int)split_pool.size(), OS_GetTickCount() - ullStartTime);
 
     return RETURN_OK;
 }
 
-void PrepareReverse::dealHyperMirror(CCmdOperate& cmdOperate)
+/*
+ List the replication pairs, and the consistency groups when groups are
+ requested, once, and index the pairs by local LUN and by group. When a
+ listing fails the sparse pairs are looked up one by one as before.
+*/
+void PrepareReverse::_load_pair_listing_out(CCmdOperate& cmdOperate)
+{
+    int ret = RETURN_ERR;
+    list<GROUP_INFO_STRU> lstGroupInfo;
+    list<GROUP_INFO_STRU>::iterator itGroupInfo;
+    map<string, list<HYMIRROR_LF_INFO_STRU> >::iterator itHyMirror;
+
+    pair_listed = false;
+    hymirror_lun_info.clear();
+    hymirror_by_lun.clear();
+    hymirror_by_group.clear();
+    consistgr_info.clear();
+
+    if (g_bFusionStorage){
+        return;
+    }
+
+    if (devices_info.lst_device_info.empty() && consistency_group_info.lst_groups_info.empty()){
+        return;
+    }
+
+    ret = cmdOperate.CMD_showhymirrorlun_all(hymirror_lun_info);
+    if (RETURN_OK != ret){
+        COMMLOG(OS_LOG_WARN, "list replication pairs fail(%d), query them one by one.", ret);
+        hymirror_lun_info.clear();
+        return;
+    }
+
+    if (!consistency_group_info.lst_groups_info.empty()){
+        ret = cmdOperate.CMD_showconsistgrinfo(lstGroupInfo);
+        if (RETURN_OK != ret){
+            COMMLOG(OS_LOG_WARN, "list consist groups fail(%d), query them one by one.", ret);
+            hymirror_lun_info.clear();
+            return;
+        }
+
+        for (itGroupInfo = lstGroupInfo.begin(); itGroupInfo != lstGroupInfo.end(); ++itGroupInfo){
+            consistgr_info[itGroupInfo->strID] = *itGroupInfo;
+        }
+    }
+
+    // the local member is listed first
+    for (itHyMirror = hymirror_lun_info.begin(); itHyMirror != hymirror_lun_info.end(); ++itHyMirror){
+        if (itHyMirror->second.empty() || OBJ_LUN != itHyMirror->second.front().uilocalResType){
+            continue;
+        }
+
+        hymirror_by_lun[itHyMirror->second.front().strID].push_back(itHyMirror->first);
+        if (!itHyMirror->second.front().strGroupID.empty()){
+            hymirror_by_group[itHyMirror->second.front().strGroupID].push_back(itHyMirror->first);
+        }
+    }
+
+    pair_listed = true;
+}
+
+bool PrepareReverse::_is_nfs_out(CCmdOperate& cmdOperate, string& lun_id)
+{
+    if (pair_listed && hymirror_by_lun.end() != hymirror_by_lun.find(lun_id)){
+        return false;
+    }
+
+    is_Fs_by_lun(cmdOperate, lun_id);
+
+    return isNFS;
+}
+
+int PrepareReverse::_find_sparse_hymirror(const string& lun_id, const string& hymirror_id, vector<string>& sparse_ids)
+{
+    map<string, vector<string> >::iterator itLun;
+
+    itLun = hymirror_by_lun.find(lun_id);
+    if (hymirror_by_lun.end() == itLun){
+        COMMLOG(OS_LOG_WARN, "get all hymirror id by lun id[%s] failed, allHymirrorId is empty!", lun_id.c_str());
+        return RETURN_ERR;
+    }
+
+    for (size_t i = 0; i < itLun->second.size(); i++){
+        if (hymirror_id == itLun->second[i]){
+            continue;
+        }
+
+        if (RESOURCE_ACCESS_READ_ONLY != hymirror_lun_info[itLun->second[i]].front().uiSecResAccess){
+            sparse_ids.push_back(itLun->second[i]);
+        }
+    }
+
+    return RETURN_OK;
+}
+
+int PrepareReverse::_find_sparse_consisgr(const string& cg_id, vector<string>& sparse_ids, vector<string>& sparse_cg_ids)
+{
+    vector<string> checked_cg_ids;
+    vector<string> &members = hymirror_by_group[cg_id];
+    map<string, GROUP_INFO_STRU>::iterator itGroup;
+
+    for (size_t i = 0; i < members.size(); i++){
+        vector<string> &lun_hymirrors = hymirror_by_lun[hymirror_lun_info[members[i]].front().strID];
+
+        for (size_t j = 0; j < lun_hymirrors.size(); j++){
+            if (members[i] == lun_hymirrors[j]){
+                continue;
+            }
+
+            HYMIRROR_LF_INFO_STRU &rstSparse = hymirror_lun_info[lun_hymirrors[j]].front();
+            if (rstSparse.strGroupID.empty()){
+                COMMLOG(OS_LOG_WARN, "the Sparese Hymirror[%s] is not in consist group", lun_hymirrors[j].c_str());
+                if (RESOURCE_ACCESS_READ_ONLY != rstSparse.uiSecResAccess){
+                    sparse_ids.push_back(lun_hymirrors[j]);
+                }
+                continue;
+            }
+
+            if (checked_cg_ids.end() != find(checked_cg_ids.begin(), checked_cg_ids.end(), rstSparse.strGroupID)){
+                continue;
+            }
+            checked_cg_ids.push_back(rstSparse.strGroupID);
+
+            itGroup = consistgr_info.find(rstSparse.strGroupID);
+            if (consistgr_info.end() == itGroup){
+                COMMLOG(OS_LOG_ERROR, "get the consisGrp info  by consist id[%s] failed.", rstSparse.strGroupID.c_str());
+                return RETURN_ERR;
+            }
+
+            if (RESOURCE_ACCESS_READ_ONLY != itGroup->second.uiSecResAccess){
+                COMMLOG(OS_LOG_INFO, "add the sparse consistgr id [%s]", rstSparse.strGroupID.c_str());
+                sparse_cg_ids.push_back(rstSparse.strGroupID);
+            }
+        }
+    }
+
+    return RETURN_OK;
+}
+
+void PrepareReverse::_run_split_out(CCmdOperate& cmdOperate, TaskPool& pool)
+{
+    pool.run(cmdOperate);
+
+    for (size_t i = 0; i < pool.size(); i++){
+        static_cast<SplitTask *>(pool.at(i))->apply();
+    }
+}
+
+void PrepareReverse::dealHyperMirror(CCmdOperate& cmdOperate, TaskPool& pool)
 {
     int iRet = RETURN_OK;
 
@@ -147,7 +354,7 @@ void PrepareReverse::dealHyperMirror(CCmdOperate& cmdOperate)
             continue;
         }
 
-        is_Fs_by_lun(cmdOperate, lunId);
+        bool nfs = _is_nfs_out(cmdOperate, lunId);
 
         
         string strTime;
@@ -159,8 +366,24 @@ void PrepareReverse::dealHyperMirror(CCmdOperate& cmdOperate)
             sn.c_str(),
             strTime.c_str());
 
+        if (!nfs && !g_bFusionStorage && pair_listed){
+            vector<string> sparse_ids;
+            iRet = _find_sparse_hymirror(lunId, HymirrorId, sparse_ids);
+            if (iRet != RETURN_OK){
+                iter->error_info.code = OS_IToString(iRet);
+                iter->is_success = false;
+                COMMLOG(OS_LOG_ERROR, "exec execSparseHymirror for lun_id[%s] failed, error code id [%d]", lunId.c_str(), iRet);
+                continue;
+            }
+
+            if (!sparse_ids.empty()){
+                pool.add(new SplitTask(&iter->error_info, &iter->is_success, lunId, false, sparse_ids, vector<string>()));
+            }
+            continue;
+        }
+
         
-        if (!isNFS && !g_bFusionStorage){
+        if (!nfs && !g_bFusionStorage){
             iRet = execSparseHymirror(cmdOperate, lunId, HymirrorId, RESOURCE_ACCESS_READ_ONLY);
 
             if (iRet != RETURN_OK){
@@ -173,7 +396,7 @@ void PrepareReverse::dealHyperMirror(CCmdOperate& cmdOperate)
     }
 }
 
-void PrepareReverse::dealConsistHyperMirror(CCmdOperate& cmdOperate)
+void PrepareReverse::dealConsistHyperMirror(CCmdOperate& cmdOperate, TaskPool& pool)
 {
     int iRet = RETURN_OK;
     list<ConGroupInfo>::iterator iter;
@@ -181,7 +404,6 @@ void PrepareReverse::dealConsistHyperMirror(CCmdOperate& cmdOperate)
     
     for (iter = consistency_group_info.lst_groups_info.begin(); iter != consistency_group_info.lst_groups_info.end(); ++iter){
         if (iter->error_info.hasError()){
-            ++iter;
             continue;
         }
         
@@ -216,7 +438,7 @@ void PrepareReverse::dealConsistHyperMirror(CCmdOperate& cmdOperate)
             continue;
         }
 
-        is_Fs_by_lun(cmdOperate, lunId);
+        bool nfs = _is_nfs_out(cmdOperate, lunId);
 
         
         string strTime;
@@ -229,8 +451,25 @@ void PrepareReverse::dealConsistHyperMirror(CCmdOperate& cmdOperate)
             sn.c_str(),
             strTime.c_str());
 
+        if (!nfs && !g_bFusionStorage && pair_listed){
+            vector<string> sparse_ids;
+            vector<string> sparse_cg_ids;
+            iRet = _find_sparse_consisgr(cgId, sparse_ids, sparse_cg_ids);
+            if (iRet != RETURN_OK){
+                iter->error_info.code = OS_IToString(iRet);
+                iter->is_success = false;
+                COMMLOG(OS_LOG_ERROR, "execSparseConsisgr by cgid [%s]  failed, the error code is [%d]", cgId.c_str(), iRet);
+                continue;
+            }
+
+            if (!sparse_ids.empty() || !sparse_cg_ids.empty()){
+                pool.add(new SplitTask(&iter->error_info, &iter->is_success, cgId, true, sparse_ids, sparse_cg_ids));
+            }
+            continue;
+        }
+
         
-        if (!isNFS && !g_bFusionStorage){
+        if (!nfs && !g_bFusionStorage){
             iRet = execSparseConsisgr(cmdOperate, cgId, RESOURCE_ACCESS_READ_ONLY);
             if(iRet != RETURN_OK){
                 iter->error_info.code =  OS_IToString(iRet);
@@ -19,6 +19,7 @@
 #include "../common/xml_node/device.h"
 #include "../common/xml_node/consistency_groups.h"
 #include "ThreeDCLun.h"
+#include "task_pool.h"
 #include <vector>
 int prepare_reverse(XmlReader &reader);
 
@@ -46,8 +47,14 @@ private:
     void set_consis_result(const string& consis_id,int err);
     void set_all_success();
 
-    void dealHyperMirror(CCmdOperate& cmdOperate);
-    void dealConsistHyperMirror(CCmdOperate& cmdOperate);
+    void dealHyperMirror(CCmdOperate& cmdOperate, TaskPool& pool);
+    void dealConsistHyperMirror(CCmdOperate& cmdOperate, TaskPool& pool);
+
+    void _load_pair_listing_out(CCmdOperate& cmdOperate);
+    bool _is_nfs_out(CCmdOperate& cmdOperate, string& lun_id);
+    int _find_sparse_hymirror(const string& lun_id, const string& hymirror_id, vector<string>& sparse_ids);
+    int _find_sparse_consisgr(const string& cg_id, vector<string>& sparse_ids, vector<string>& sparse_cg_ids);
+    void _run_split_out(CCmdOperate& cmdOperate, TaskPool& pool);
 
 
 private:
@@ -56,6 +63,12 @@ private:
 
     ConGroupsInfo consistency_group_info;
     DevicesInfo devices_info;
+
+    bool pair_listed;
+    map<string, list<HYMIRROR_LF_INFO_STRU> > hymirror_lun_info;
+    map<string, vector<string> > hymirror_by_lun;
+    map<string, vector<string> > hymirror_by_group;
+    map<string, GROUP_INFO_STRU> consistgr_info;
 };
 
 #endif
\ No newline at end of file
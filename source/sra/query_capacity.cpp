@@ -25,11 +25,11 @@ int query_capacity(XmlReader &reader)
 
     COMMLOG(OS_LOG_INFO, "%s", "query_capacity begin.");
     print("%s", "query_capacity begin.");
-    if (!reader.get_string(XML_OUTPUTFILE, output_file, 0)){
+    if (!reader.get_cstring(XML_OUTPUTFILE, output_file)){
         return ERROR_INTERNAL_PROCESS_FAIL;
     }
 
-    if (reader.get_string(XML_REQUSET_TITLE, xmlns, 0)){
+    if (reader.get_cstring(XML_REQUSET_TITLE, xmlns)){
         CHECK_FALSE(writer.set_string(XML_RESPONSE_TITLE, (const char*)xmlns), ERROR_INTERNAL_PROCESS_FAIL);
     }
     string strBandInfo;
@@ -29,16 +29,16 @@ int query_strings(XmlReader &reader)
 
     COMMLOG(OS_LOG_INFO, "%s", "query_strings begin.");
     print("%s", "query_strings begin.");
-    if (!reader.get_string(XML_OUTPUTFILE, output_file, 0)){
+    if (!reader.get_cstring(XML_OUTPUTFILE, output_file)){
         return ERROR_INTERNAL_PROCESS_FAIL;
     }
 
-    if (reader.get_string(XML_REQUSET_TITLE, xmlns, 0)){
+    if (reader.get_cstring(XML_REQUSET_TITLE, xmlns)){
         CHECK_FALSE(writer.set_string(XML_RESPONSE_TITLE, (const char*)xmlns), ERROR_INTERNAL_PROCESS_FAIL);
     }
 
     char acLocale[LENGTH_COMMON] = {0};
-    if (!reader.get_string(XML_QUERYSTRINGS_LOCALE, acLocale, 0)){
+    if (!reader.get_cstring(XML_QUERYSTRINGS_LOCALE, acLocale)){
         (void)write_common_error(writer);
     }
 
@@ -31,73 +31,31 @@ int query_syncstatus(XmlReader &reader)
 
 int QuerySyncStatus::_read_command_para(XmlReader &reader)
 {
-    int i;
-    int cg_count = 0;
-    char sy_id[LENGTH_COMMON] = {0};
-    char cg_id[LENGTH_COMMON] = {0};
-    char peer_array[LENGTH_COMMON] = {0};
+    CommandPara para;
+    list<ConGroupInfo>::iterator itGroup;
 
-    (void)reader.get_string("/Command/QuerySyncStatusParameters/ArrayId", array_id, 0);
-    (void)reader.get_string("/Command/QuerySyncStatusParameters/PeerArrayId", peer_array, 0);
-    (void)reader.get_string("/Command/QuerySyncStatusParameters/ArrayId", input_array_id, 0);
+    (void)reader.get_cstring("/Command/QuerySyncStatusParameters/ArrayId", array_id);
+    (void)reader.get_string("/Command/QuerySyncStatusParameters/PeerArrayId", peer_array_id, LENGTH_COMMON - 1);
+    (void)reader.get_cstring("/Command/QuerySyncStatusParameters/ArrayId", input_array_id);
 
-    peer_array_id = peer_array;
+    CHECK_FALSE(_get_command_para(reader, "/Command/QuerySyncStatusParameters", para), RETURN_ERR);
 
-    cg_count = reader.get_count("/Command/QuerySyncStatusParameters/ConsistencyGroups/ConsistencyGroup");
-    for (i = 0; i < cg_count; i++){
-        ConGroupInfo cg_info;
+    for (itGroup = para.cons_groups.begin(); itGroup != para.cons_groups.end(); ++itGroup){
         list<string> lst_token;
-        string cgid;
-        string lun_id;
 
-        memset_s(cg_id, sizeof(cg_id), 0, sizeof(cg_id));
-        memset_s(sy_id, sizeof(sy_id), 0, sizeof(sy_id));
-        (void)reader.get_string("/Command/QuerySyncStatusParameters/ConsistencyGroups/ConsistencyGroup/@id", cg_id, i);
-        (void)reader.get_string("/Command/QuerySyncStatusParameters/ConsistencyGroups/ConsistencyGroup/@syncId", sy_id, i);
-
-        COMMLOG(OS_LOG_INFO, "_read_command_para cg_id %s", cg_id);
-        OS_StrToken(cg_id, "_", &lst_token);
+        COMMLOG(OS_LOG_INFO, "_read_command_para cg_id %s", itGroup->cg_id.c_str());
+        OS_StrToken(itGroup->cg_id, "_", &lst_token);
         if (lst_token.empty()){
-            COMMLOG(OS_LOG_ERROR, "cg_id %s of lst_token is empty", cg_id);
+            COMMLOG(OS_LOG_ERROR, "cg_id %s of lst_token is empty", itGroup->cg_id.c_str());
             continue;
-        }        
-        lun_id = lst_token.back();
-
-        cg_info.cg_id = cg_id;
-        cg_info.device_sync_info.sync_id = sy_id;
-        cg_info.lun_id = lun_id;
-
-        consistency_group_info.lst_groups_info.push_back(cg_info);
-    }
-
-
-    cg_count = reader.get_count("/Command/QuerySyncStatusParameters/SourceDevices/SourceDevice");
-    for (i = 0; i < cg_count; i++){
-        SourceDeviceInfo sd_info;
-
-        memset_s(cg_id, sizeof(cg_id), 0, sizeof(cg_id));
-        memset_s(sy_id, sizeof(sy_id), 0, sizeof(sy_id));
+        }
+        itGroup->lun_id = lst_token.back();
 
-        (void)reader.get_string("/Command/QuerySyncStatusParameters/SourceDevices/SourceDevice/@id", cg_id, i);
-        (void)reader.get_string("/Command/QuerySyncStatusParameters/SourceDevices/SourceDevice/@syncId", sy_id, i);
-        sd_info.source_id = cg_id;
-        sd_info.device_sync_info.sync_id = sy_id;
-        source_device_info.lst_source_devices.push_back(sd_info);
+        consistency_group_info.lst_groups_info.push_back(*itGroup);
     }
 
-    cg_count = reader.get_count("/Command/QuerySyncStatusParameters/TargetDevices/TargetDevice");
-    for (i = 0; i < cg_count; i++){
-        TargetDeviceInfo td_info;
-
-        memset_s(cg_id, sizeof(cg_id), 0, sizeof(cg_id));
-        memset_s(sy_id, sizeof(sy_id), 0, sizeof(sy_id));
-
-        (void)reader.get_string("/Command/QuerySyncStatusParameters/TargetDevices/TargetDevice/@key", cg_id, i);
-        (void)reader.get_string("/Command/QuerySyncStatusParameters/TargetDevices/TargetDevice/@syncId", sy_id, i);
-        td_info.target_key = cg_id;
-        td_info.devicesync_info.sync_id = sy_id;
-        target_device_info.lst_target_devices.push_back(td_info);
-    }
+    source_device_info.lst_source_devices.swap(para.source_devices);
+    target_device_info.lst_target_devices.swap(para.target_devices);
 
     return RETURN_OK;
 }
@@ -155,11 +113,27 @@ int QuerySyncStatus::_outband_process()
     if (RETURN_OK != iRet){
         return iRet;
     }
-    
+
+    _load_pair_listing_out(cmdOperate);
+
+    sync_sampler.load(_get_log_dir());
+    _query_sync_info_out(cmdOperate);
+    sync_sampler.save();
+
+    COMMLOG(OS_LOG_INFO, "recommended next query of sync status in %d seconds.", sync_sampler.poll_interval());
+    print("recommended next query of sync status in %d seconds.", sync_sampler.poll_interval());
+
+    return RETURN_OK;
+}
+
+void QuerySyncStatus::_query_sync_info_out(CCmdOperate& cmdOperate)
+{
+    int iRet = RETURN_ERR;
+
     (void)_query_hymirror_info_out(cmdOperate);
 
     if (g_bFusionStorage && !g_testFusionStorageStretch){
-        return RETURN_OK;
+        return;
     }
 
     if (g_bstretch){
@@ -167,7 +141,7 @@ int QuerySyncStatus::_outband_process()
     }
 
     if (g_bFusionStorage){
-        return RETURN_OK;
+        return;
     }
 
     iRet = _query_consistency_info_out(cmdOperate);
@@ -182,7 +156,7 @@ int QuerySyncStatus::_outband_process()
         }
     }
 
-    return RETURN_OK;
+    return;
 }
 
 void QuerySyncStatus::_write_response(XmlWriter &writer)
@@ -302,8 +276,6 @@ int QuerySyncStatus::_query_consistencyhm_info_out(CCmdOperate& cmdOperate)
     string lun_id;
     string lun_flag;
 
-    list<HYPERMETROPAIR_INFO_STRU> lstHMPairInfo;
-
     consistency_id = consistency_group_info.lst_groups_info.begin();
     while (consistency_id != consistency_group_info.lst_groups_info.end()){
         ret = get_device_info(consistency_id->cg_id, arrayid, lun_id, lun_flag, cg_id);
@@ -336,11 +308,14 @@ int QuerySyncStatus::_query_consistencyhm_info_out(CCmdOperate& cmdOperate)
             continue;
         }
 
-        lstHMPairInfo.clear();
-        ret = cmdOperate.CMD_showHyperMetroPair_all(lstHMPairInfo);
-        CHECK_UNEQ(RETURN_OK, ret);
+        if (!hmpair_listed){
+            lst_hmpair_info.clear();
+            ret = cmdOperate.CMD_showHyperMetroPair_all(lst_hmpair_info);
+            CHECK_UNEQ(RETURN_OK, ret);
+            hmpair_listed = true;
+        }
 
-        ret = _get_consistencyhm_info_out(cmdOperate, cg_id, lstHMPairInfo, *consistency_id);
+        ret = _get_consistencyhm_info_out(cmdOperate, cg_id, lst_hmpair_info, *consistency_id);
         if (RETURN_OK != ret){
             COMMLOG(OS_LOG_WARN, "query sync status of Hypermetro consistency info,"
                         "get percent of consistency fail %s", cg_id.c_str());
@@ -421,8 +396,13 @@ int QuerySyncStatus::_query_hymirror_info_out(CCmdOperate& cmdOperate)
         }
 
         
-        is_Fs_by_lun(cmdOperate, strid);     
-        ret = _get_hymirror_percent_out(cmdOperate, hymirror_id, percent);
+        if (NULL == _find_listed_hymirror(hymirror_lun_info, hymirror_id)){
+            is_Fs_by_lun(cmdOperate, strid);
+        }
+        else{
+            isNFS = false;
+        }
+        ret = _get_hymirror_percent_bulk(cmdOperate, hymirror_id, percent);
         if (RETURN_OK != ret){
             iter_hymirror_id->error_info.code = OS_IToString(ERROR_INVALIDATE_HYMIRROR_STATUS);
             iter_hymirror_id->device_sync_info.sync_id = "";
@@ -438,12 +418,14 @@ int QuerySyncStatus::_query_hymirror_info_out(CCmdOperate& cmdOperate)
 
         if (SYNC_COMPLETE == percent){
             iter_hymirror_id->device_sync_info.sync_status = COMPLETE_STATUS;
+            sync_sampler.complete(syncname);
         }
         else{
             iter_hymirror_id->device_sync_info.sync_progress = percent;
             iter_hymirror_id->device_sync_info.sync_status = INPROGRESS_STATUS;
 
-            iter_hymirror_id->device_sync_info.sync_remainingtimeestimate = REMAIN_SYNC_TIME;
+            iter_hymirror_id->device_sync_info.sync_remainingtimeestimate =
+                sync_sampler.estimate(syncname, percent, REMAIN_SYNC_TIME);
         }
         
         COMMLOG(OS_LOG_INFO,"Replica divece[%s] with syncname[%s] has sync_status[%s] sync_progress[%s/100]",
@@ -509,7 +491,7 @@ int QuerySyncStatus::_query_hypermetro_info_out(CCmdOperate& cmdOperate)
 
         
 
-        ret = _get_hmpair_percent_out(cmdOperate, hypermetroid, percent);
+        ret = _get_hmpair_percent_bulk(cmdOperate, hypermetroid, percent);
 
         if (RETURN_OK != ret){
             iter_hypermetroid->error_info.code = OS_IToString(ERROR_INVALIDATE_HYMIRROR_STATUS);
@@ -527,12 +509,14 @@ int QuerySyncStatus::_query_hypermetro_info_out(CCmdOperate& cmdOperate)
 
         if (SYNC_COMPLETE == percent){
             iter_hypermetroid->device_sync_info.sync_status = COMPLETE_STATUS;
+            sync_sampler.complete(syncname);
         }
         else{
             iter_hypermetroid->device_sync_info.sync_progress = percent;
             iter_hypermetroid->device_sync_info.sync_status = INPROGRESS_STATUS;
 
-            iter_hypermetroid->device_sync_info.sync_remainingtimeestimate = REMAIN_SYNC_TIME;
+            iter_hypermetroid->device_sync_info.sync_remainingtimeestimate =
+                sync_sampler.estimate(syncname, percent, REMAIN_SYNC_TIME);
         }
         
         COMMLOG(OS_LOG_INFO,"Hypermetro divece[%s] with syncname[%s] has sync_status[%s] sync_progress[%s/100]",
@@ -584,7 +568,7 @@ int QuerySyncStatus::_query_hypermetro_info_out(CCmdOperate& cmdOperate)
 
         
 
-        ret = _get_hmpair_percent_out(cmdOperate, hypermetroid, percent);
+        ret = _get_hmpair_percent_bulk(cmdOperate, hypermetroid, percent);
 
         if (RETURN_OK != ret){
             iterhypermetroid->err_info.code = OS_IToString(ERROR_INVALIDATE_HYMIRROR_STATUS);
@@ -602,12 +586,14 @@ int QuerySyncStatus::_query_hypermetro_info_out(CCmdOperate& cmdOperate)
 
         if (SYNC_COMPLETE == percent){
             iterhypermetroid->devicesync_info.sync_status = COMPLETE_STATUS;
+            sync_sampler.complete(syncname);
         }
         else{
             iterhypermetroid->devicesync_info.sync_progress = percent;
             iterhypermetroid->devicesync_info.sync_status = INPROGRESS_STATUS;
 
-            iterhypermetroid->devicesync_info.sync_remainingtimeestimate = REMAIN_SYNC_TIME;
+            iterhypermetroid->devicesync_info.sync_remainingtimeestimate =
+                sync_sampler.estimate(syncname, percent, REMAIN_SYNC_TIME);
         }
         
         COMMLOG(OS_LOG_INFO,"Hypermetro divece[%s] with syncname[%s] has sync_status[%s] sync_progress[%s/100]",
@@ -646,7 +632,7 @@ int QuerySyncStatus::_get_consistency_info_out(CCmdOperate& cmdOperate,
     hy_id = lst_hy_id.begin();
     while (hy_id != lst_hy_id.end()){
         
-        ret = _get_hymirror_percent_out(cmdOperate, *hy_id, query_percent);
+        ret = _get_hymirror_percent_bulk(cmdOperate, *hy_id, query_percent);
         if (RETURN_OK != ret){
             consistency.error_info.code = OS_IToString(ERROR_INVALIDATE_HYMIRROR_STATUS);
             consistency.device_sync_info.sync_id = "";
@@ -671,11 +657,13 @@ int QuerySyncStatus::_get_consistency_info_out(CCmdOperate& cmdOperate,
 
     if (SYNC_COMPLETE_FLAG == con_percent){
         consistency.device_sync_info.sync_status = COMPLETE_STATUS;
+        sync_sampler.complete(consistency.device_sync_info.sync_id);
     }
     else{
         consistency.device_sync_info.sync_progress = OS_IToString(con_percent);
         consistency.device_sync_info.sync_status = INPROGRESS_STATUS;
-        consistency.device_sync_info.sync_remainingtimeestimate = REMAIN_SYNC_TIME;
+        consistency.device_sync_info.sync_remainingtimeestimate = sync_sampler.estimate(
+            consistency.device_sync_info.sync_id, consistency.device_sync_info.sync_progress, REMAIN_SYNC_TIME);
     }
 
     return RETURN_OK;
@@ -697,7 +685,7 @@ int QuerySyncStatus::_get_consistencyhm_info_out(CCmdOperate& cmdOperate, string
         }
         string hmpair_id = itHMPairInfo->strID;
         
-        ret = _get_hmpair_percent_out(cmdOperate, hmpair_id, query_percent);
+        ret = _get_hmpair_percent_bulk(cmdOperate, hmpair_id, query_percent);
         if (RETURN_OK != ret){
             consistency.error_info.code = OS_IToString(ERROR_INVALIDATE_HYMIRROR_STATUS);
             consistency.device_sync_info.sync_id = "";
@@ -720,12 +708,71 @@ int QuerySyncStatus::_get_consistencyhm_info_out(CCmdOperate& cmdOperate, string
 
     if (SYNC_COMPLETE_FLAG == con_percent){
         consistency.device_sync_info.sync_status = COMPLETE_STATUS;
+        sync_sampler.complete(consistency.device_sync_info.sync_id);
     }
     else{
         consistency.device_sync_info.sync_progress = OS_IToString(con_percent);
         consistency.device_sync_info.sync_status = INPROGRESS_STATUS;
-        consistency.device_sync_info.sync_remainingtimeestimate = REMAIN_SYNC_TIME;
+        consistency.device_sync_info.sync_remainingtimeestimate = sync_sampler.estimate(
+            consistency.device_sync_info.sync_id, consistency.device_sync_info.sync_progress, REMAIN_SYNC_TIME);
     }
 
     return RETURN_OK;
 }
+
+void QuerySyncStatus::_load_pair_listing_out(CCmdOperate& cmdOperate)
+{
+    int ret = RETURN_ERR;
+
+    hymirror_lun_info.clear();
+    hmpair_lun_info.clear();
+
+    if (!source_device_info.lst_source_devices.empty() || !consistency_group_info.lst_groups_info.empty()){
+        ret = cmdOperate.CMD_showhymirrorlun_all(hymirror_lun_info);
+        if (RETURN_OK != ret){
+            COMMLOG(OS_LOG_WARN, "list replication pairs fail(%d), query them one by one.", ret);
+            hymirror_lun_info.clear();
+        }
+    }
+
+    if (!g_bstretch){
+        return;
+    }
+
+    if (!source_device_info.lst_source_devices.empty() || !target_device_info.lst_target_devices.empty()
+        || !consistency_group_info.lst_groups_info.empty()){
+        ret = cmdOperate.CMD_showhypermetrolun_all(hmpair_lun_info);
+        if (RETURN_OK != ret){
+            COMMLOG(OS_LOG_WARN, "list hypermetro pairs fail(%d), query them one by one.", ret);
+            hmpair_lun_info.clear();
+        }
+    }
+
+    return;
+}
+
+int QuerySyncStatus::_get_hymirror_percent_bulk(CCmdOperate& cmdOperate, string& hymirror_id, string& query_percent)
+{
+    list<HYMIRROR_LF_INFO_STRU> *lstHyMirrorLFInfo = NULL;
+
+    if (!isNFS){
+        lstHyMirrorLFInfo = _find_listed_hymirror(hymirror_lun_info, hymirror_id);
+    }
+
+    if (NULL == lstHyMirrorLFInfo){
+        return _get_hymirror_percent_out(cmdOperate, hymirror_id, query_percent);
+    }
+
+    return _calc_hymirror_percent(*lstHyMirrorLFInfo, hymirror_id, query_percent);
+}
+
+int QuerySyncStatus::_get_hmpair_percent_bulk(CCmdOperate& cmdOperate, string& hmpair_id, string& query_percent)
+{
+    map<string, list<HYPERMETRO_LF_INFO_STRU> >::iterator it = hmpair_lun_info.find(hmpair_id);
+
+    if (hmpair_lun_info.end() == it){
+        return _get_hmpair_percent_out(cmdOperate, hmpair_id, query_percent);
+    }
+
+    return _calc_hmpair_percent(it->second, hmpair_id, query_percent);
+}
@@ -16,6 +16,7 @@
 #define QUERY_SYNCSTATUS_H
 
 #include "sra_basic.h"
+#include "sync_sampler.h"
 #include "../common/xml_node/source_devices.h"
 #include "../common/xml_node/consistency_groups.h"
 
@@ -29,7 +30,7 @@ int query_syncstatus(XmlReader &reader);
 class QuerySyncStatus : public SraBasic
 {
 public:
-    QuerySyncStatus() : SraBasic() 
+    QuerySyncStatus() : SraBasic(), hmpair_listed(false)
     {
         memset_s(input_array_id, sizeof(input_array_id), 0, sizeof(input_array_id));
     }
@@ -41,6 +42,7 @@ protected:
     virtual int _outband_process();
     virtual int check_array_id_validate_out(CCmdOperate& cmdOperate, string& array_id, const string& peer_array_id = "");
 private:
+    void _query_sync_info_out(CCmdOperate& cmdOperate);
     int _query_consistency_info_out(CCmdOperate& cmdOperate);
     int _query_consistencyhm_info_out(CCmdOperate& cmdOperate);
     int _query_hymirror_info_out(CCmdOperate& cmdOperate);
@@ -48,6 +50,10 @@ private:
     int _get_consistency_info_out(CCmdOperate& cmdOperate, list<HYMIRROR_INFO_STRU>& lstMirrorInfo, ConGroupInfo& consistency);
     int _get_consistencyhm_info_out(CCmdOperate& cmdOperate, string cg_id, list<HYPERMETROPAIR_INFO_STRU> &lstHMPairInfo, ConGroupInfo& consistency);
 
+    void _load_pair_listing_out(CCmdOperate& cmdOperate);
+    int _get_hymirror_percent_bulk(CCmdOperate& cmdOperate, string& hymirror_id, string& query_percent);
+    int _get_hmpair_percent_bulk(CCmdOperate& cmdOperate, string& hmpair_id, string& query_percent);
+
 private:
     string peer_array_id;
     char input_array_id[LENGTH_COMMON];
@@ -55,6 +61,15 @@ private:
     ConGroupsInfo consistency_group_info;
     SourceDevicesInfo source_device_info;
     TargetDevicesInfo target_device_info;
+
+    // pair listings taken once per command, pairs missing here are queried one by one
+    map<string, list<HYMIRROR_LF_INFO_STRU> > hymirror_lun_info;
+    map<string, list<HYPERMETRO_LF_INFO_STRU> > hmpair_lun_info;
+    list<HYPERMETROPAIR_INFO_STRU> lst_hmpair_info;
+    bool hmpair_listed;
+
+    // progress samples kept between invocations for the remaining time estimate
+    SyncSampler sync_sampler;
 };
 
 #endif
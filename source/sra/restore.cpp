@@ -31,40 +31,16 @@ int restore(XmlReader &reader)
 
 int RestoreReplication::_read_command_para(XmlReader &reader)
 {
-    int i = 0;
-    int cg_count = 0;
-    int device_count = 0;
-    char peer_array[LENGTH_COMMON] = {0};
+    CommandPara para;
 
-    (void)reader.get_string("/Command/RestoreReplicationParameters/ArrayId", array_id, 0);
-    (void)reader.get_string("/Command/RestoreReplicationParameters/ArrayId", input_array_id, 0);
-    (void)reader.get_string("/Command/RestoreReplicationParameters/PeerArrayId", peer_array, 0);
+    (void)reader.get_cstring("/Command/RestoreReplicationParameters/ArrayId", array_id);
+    (void)reader.get_cstring("/Command/RestoreReplicationParameters/ArrayId", input_array_id);
+    (void)reader.get_string("/Command/RestoreReplicationParameters/PeerArrayId", peer_array_id, LENGTH_COMMON - 1);
 
-    peer_array_id = peer_array;
+    CHECK_FALSE(_get_command_para(reader, "/Command/RestoreReplicationParameters", para), RETURN_ERR);
 
-    cg_count = reader.get_count("/Command/RestoreReplicationParameters/ConsistencyGroups/ConsistencyGroup");
-    for (i = 0; i < cg_count; i++){
-        char cg_id[LENGTH_COMMON];
-        ConGroupInfo gp_info;
-
-        memset_s(cg_id, sizeof(cg_id), 0, sizeof(cg_id));
-        (void)reader.get_string("/Command/RestoreReplicationParameters/ConsistencyGroups/ConsistencyGroup/@id", cg_id, i);
-        
-        gp_info.cg_id = cg_id;
-        group_info.lst_groups_info.push_back(gp_info);
-    }
-
-    device_count = reader.get_count("/Command/RestoreReplicationParameters/Devices/Device");
-    for (i = 0; i < device_count; i++){
-        char dev_id[LENGTH_COMMON];
-        DeviceInfo device_info;
-
-        memset_s(dev_id, sizeof(dev_id), 0, sizeof(dev_id));
-        (void)reader.get_string("/Command/RestoreReplicationParameters/Devices/Device/@id", dev_id, i);
-        
-        device_info.id = dev_id;
-        devices_info.lst_device_info.push_back(device_info);
-    }
+    group_info.lst_groups_info.swap(para.cons_groups);
+    devices_info.lst_device_info.swap(para.devices);
 
     return RETURN_OK;
 }
@@ -133,6 +109,8 @@ int RestoreReplication::_outband_process()
     iRet = check_array_id_validate_out(cmdOperate, array_id_temp, peer_array_id);
     CHECK_UNEQ(RETURN_OK, iRet);
 
+    _load_pair_listing_out(cmdOperate);
+
     (void)_is_slave_consistency_out(cmdOperate);
     if (g_bstretch){
         (void)_is_slave_consistencyhm_out(cmdOperate);
@@ -146,19 +124,136 @@ int RestoreReplication::_outband_process()
     return RETURN_OK;
 }
 
+/*
+ List the replication pairs, hypermetro pairs and consistency groups of the
+ array once, so that the checks below do not query them one by one. Whatever
+ is missing from a listing, or every object when a listing fails, is still
+ queried on its own.
+*/
+void RestoreReplication::_load_pair_listing_out(CCmdOperate& cmdOperate)
+{
+    int ret = RETURN_ERR;
+    list<GROUP_INFO_STRU> lstGroupInfo;
+    list<GROUP_INFO_STRU>::iterator itGroupInfo;
+    map<string, list<HYMIRROR_LF_INFO_STRU> >::iterator itHyMirror;
+    map<string, list<HYPERMETRO_LF_INFO_STRU> >::iterator itHMPair;
+
+    hymirror_lun_info.clear();
+    hmpair_lun_info.clear();
+    hymirror_by_lun.clear();
+    hmpair_by_lun.clear();
+    consistgr_info.clear();
+    consistgrhm_info.clear();
+
+    if (devices_info.lst_device_info.empty() && group_info.lst_groups_info.empty()){
+        return;
+    }
+
+    ret = cmdOperate.CMD_showhymirrorlun_all(hymirror_lun_info);
+    if (RETURN_OK != ret){
+        COMMLOG(OS_LOG_WARN, "list replication pairs fail(%d), query them one by one.", ret);
+        hymirror_lun_info.clear();
+    }
+
+    // the local member is listed first
+    for (itHyMirror = hymirror_lun_info.begin(); itHyMirror != hymirror_lun_info.end(); ++itHyMirror){
+        if (!itHyMirror->second.empty() && OBJ_LUN == itHyMirror->second.front().uilocalResType){
+            hymirror_by_lun[itHyMirror->second.front().strID] = itHyMirror->first;
+        }
+    }
+
+    if (g_bstretch){
+        ret = cmdOperate.CMD_showhypermetrolun_all(hmpair_lun_info);
+        if (RETURN_OK != ret){
+            COMMLOG(OS_LOG_WARN, "list hypermetro pairs fail(%d), query them one by one.", ret);
+            hmpair_lun_info.clear();
+        }
+
+        for (itHMPair = hmpair_lun_info.begin(); itHMPair != hmpair_lun_info.end(); ++itHMPair){
+            if (!itHMPair->second.empty()){
+                hmpair_by_lun[itHMPair->second.front().strID] = itHMPair->first;
+            }
+        }
+    }
+
+    if (group_info.lst_groups_info.empty()){
+        return;
+    }
+
+    ret = cmdOperate.CMD_showconsistgrinfo(lstGroupInfo);
+    if (RETURN_OK != ret){
+        COMMLOG(OS_LOG_WARN, "list consist groups fail(%d), query them one by one.", ret);
+    }
+    else{
+        for (itGroupInfo = lstGroupInfo.begin(); itGroupInfo != lstGroupInfo.end(); ++itGroupInfo){
+            consistgr_info[itGroupInfo->strID] = *itGroupInfo;
+        }
+    }
+
+    if (!g_bstretch){
+        return;
+    }
+
+    lstGroupInfo.clear();
+    ret = cmdOperate.CMD_showconsistgrhminfo(lstGroupInfo);
+    if (RETURN_OK != ret){
+        COMMLOG(OS_LOG_WARN, "list hypermetro consist groups fail(%d), query them one by one.", ret);
+    }
+    else{
+        for (itGroupInfo = lstGroupInfo.begin(); itGroupInfo != lstGroupInfo.end(); ++itGroupInfo){
+            consistgrhm_info[itGroupInfo->strID] = *itGroupInfo;
+        }
+    }
+
+    return;
+}
+
+string RestoreReplication::_find_listed_group_slave(const string& lun_id, bool hypermetro)
+{
+    map<string, string>::iterator itPairID;
+    string slave;
+
+    if (hypermetro){
+        itPairID = hmpair_by_lun.find(lun_id);
+        if (hmpair_by_lun.end() == itPairID){
+            return slave;
+        }
+
+        list<HYPERMETRO_LF_INFO_STRU>& lstHMPairLFInfo = hmpair_lun_info[itPairID->second];
+        for (list<HYPERMETRO_LF_INFO_STRU>::iterator it = lstHMPairLFInfo.begin(); it != lstHMPairLFInfo.end(); ++it){
+            if (HM_LUN_RELATION_MASTER == it->uiRelationType){
+                slave = "G_" + it->strID;
+            }
+        }
+
+        return slave;
+    }
+
+    itPairID = hymirror_by_lun.find(lun_id);
+    if (hymirror_by_lun.end() == itPairID){
+        return slave;
+    }
+
+    list<HYMIRROR_LF_INFO_STRU>& lstHyMirrorLFInfo = hymirror_lun_info[itPairID->second];
+    for (list<HYMIRROR_LF_INFO_STRU>::iterator it = lstHyMirrorLFInfo.begin(); it != lstHyMirrorLFInfo.end(); ++it){
+        if (MIRROR_LUN_RELATION_MASTER == it->uiRelationType){
+            slave = "G_" + it->strID;
+        }
+    }
+
+    return slave;
+}
+
 int RestoreReplication::_is_slave_consistency_out(CCmdOperate& cmdOperate)
 {
     int ret = RETURN_ERR;
     string consisgr_status;
-    list<string> lst_token;
     string lun_id;
     string cg_id;
     string cg_name;
     string arrayid;
     string lun_flag;
-
-    list<HYMIRROR_LF_INFO_STRU> lstHyMirrorLFInfo;
-    list<HYMIRROR_LF_INFO_STRU>::iterator itHyMirrorLFInfo;
+    map<string, GROUP_INFO_STRU>::iterator itListedGroup;
 
     list<ConGroupInfo>::iterator iter_group = group_info.lst_groups_info.begin();
 
@@ -190,12 +285,19 @@ int RestoreReplication::_is_slave_consistency_out(CCmdOperate& cmdOperate)
         }
         print("Commence: Replica of ConsistencyGroup [%s] on array [%s] for restore replication request",
             iter_group->cg_id.c_str(), array_id);
-        stGroupInfo.strID = cg_id;
-        ret = cmdOperate.CMD_showconsistgrinfo(stGroupInfo);
-        if (RETURN_OK != ret){
-            iter_group->error_info.code = OS_IToString(ret);
-            ++iter_group;
-            continue;
+
+        itListedGroup = consistgr_info.find(cg_id);
+        if (consistgr_info.end() != itListedGroup){
+            stGroupInfo = itListedGroup->second;
+        }
+        else{
+            stGroupInfo.strID = cg_id;
+            ret = cmdOperate.CMD_showconsistgrinfo(stGroupInfo);
+            if (RETURN_OK != ret){
+                iter_group->error_info.code = OS_IToString(ret);
+                ++iter_group;
+                continue;
+            }
         }
 
         cg_name = stGroupInfo.strName;
@@ -221,20 +323,7 @@ int RestoreReplication::_is_slave_consistency_out(CCmdOperate& cmdOperate)
             print("The ConsistencyGroup [%s] with GroupId [%s] is being restored",
                 iter_group->cg_id.c_str(),cg_id.c_str());
 
-            if(!isNFS){
-                ret = cmdOperate.CMD_showhymirrorlun_all(strHyID, lstHyMirrorLFInfo);
-                if(ret != 0){
-                    COMMLOG(OS_LOG_ERROR,"show hymirror lun err ret(%d)",ret);
-                }
-            }
-            string slave;
-            string perrArry;
-            for (itHyMirrorLFInfo = lstHyMirrorLFInfo.begin(); itHyMirrorLFInfo != lstHyMirrorLFInfo.end(); itHyMirrorLFInfo++){
-                if (MIRROR_LUN_RELATION_MASTER == itHyMirrorLFInfo->uiRelationType && !isNFS){
-                    slave = "G_" + itHyMirrorLFInfo->strID;
-                    perrArry = itHyMirrorLFInfo->strArrayWWN;
-                }
-            }
+            string slave = _find_listed_group_slave(lun_id, false);
             print("After restore,the TargetGroup [%s] on array [%s] has attributes: [r/o]",
                 slave.c_str(),
                 peer_array_id.c_str());
@@ -258,21 +347,16 @@ int RestoreReplication::_is_slave_consistencyhm_out(CCmdOperate& cmdOperate)
 {
     int ret = RETURN_ERR;
     string consisgr_status;
-    list<string> lst_token;
     string lun_id;
     string cg_id;
     string cg_name;
     string arrayid;
     string lun_flag;
-
-    list<HYPERMETRO_LF_INFO_STRU> lstHMPairLFInfo;
-    list<HYPERMETRO_LF_INFO_STRU>::iterator itHMPairLFInfo;
+    map<string, GROUP_INFO_STRU>::iterator itListedGroup;
 
     list<ConGroupInfo>::iterator iter_group = group_info.lst_groups_info.begin();
 
     while (iter_group != group_info.lst_groups_info.end()){
-        HYPERMETRODOMAIN_LF_INFO_STRU stHMDomainInfo;
-
         ret = get_device_info(iter_group->cg_id, arrayid, lun_id, lun_flag, cg_id);
         if (RETURN_OK != ret){
             iter_group->error_info.code = OS_IToString(ret);
@@ -300,12 +384,18 @@ int RestoreReplication::_is_slave_consistencyhm_out(CCmdOperate& cmdOperate)
             iter_group->cg_id.c_str(), array_id);
         
         GROUP_INFO_STRU stGroupInfo;
-        stGroupInfo.strID = cg_id;
-        ret = cmdOperate.CMD_showconsistgrhminfo(stGroupInfo);
-        if (RETURN_OK != ret){
-            iter_group->error_info.code = OS_IToString(ret);
-            ++iter_group;
-            continue;
+        itListedGroup = consistgrhm_info.find(cg_id);
+        if (consistgrhm_info.end() != itListedGroup){
+            stGroupInfo = itListedGroup->second;
+        }
+        else{
+            stGroupInfo.strID = cg_id;
+            ret = cmdOperate.CMD_showconsistgrhminfo(stGroupInfo);
+            if (RETURN_OK != ret){
+                iter_group->error_info.code = OS_IToString(ret);
+                ++iter_group;
+                continue;
+            }
         }
 
         cg_name = stGroupInfo.strName;
@@ -324,19 +414,7 @@ int RestoreReplication::_is_slave_consistencyhm_out(CCmdOperate& cmdOperate)
             print("The ConsistencyGroup [%s] with GroupId [%s] is being restored",
                 iter_group->cg_id.c_str(),cg_id.c_str());
 
-            ret = cmdOperate.CMD_showhypermetrolun_all(strHyID, lstHMPairLFInfo);
-            if(ret != 0){
-                COMMLOG(OS_LOG_ERROR,"show hymirror lun err ret(%d)",ret);
-            }
-
-            string slave;
-            string perrArry;
-            for (itHMPairLFInfo = lstHMPairLFInfo.begin(); itHMPairLFInfo != lstHMPairLFInfo.end(); itHMPairLFInfo++){
-                if (HM_LUN_RELATION_MASTER == itHMPairLFInfo->uiRelationType && !isNFS){
-                    slave = "G_" + itHMPairLFInfo->strID;
-                    perrArry = itHMPairLFInfo->strArrayWWN;
-                }
-            }
+            string slave = _find_listed_group_slave(lun_id, true);
             print("After restore,the TargetGroup [%s] on array [%s] has attributes: [r/o]",
                 slave.c_str(),
                 peer_array_id.c_str());
@@ -360,22 +438,21 @@ int RestoreReplication::_is_slave_consistencyhm_out(CCmdOperate& cmdOperate)
 int RestoreReplication::_is_slave_device_out(CCmdOperate& cmdOperate)
 {
     int ret = RETURN_ERR;
-    list<string> lst_slave_array_sn;
-    list<string> lst_slave_id;
-    list<string> lst_pair_status;
-    list<string> lst_token;
     string strid;
     string hyper_id;
     string key;
     string arrayid;
     string lun_flag;
 
-    list<HYMIRROR_LF_INFO_STRU> lstHyMirrorLFInfo;
+    list<HYMIRROR_LF_INFO_STRU> *plstListedLFInfo = NULL;
     list<HYMIRROR_LF_INFO_STRU>::iterator itHyMirrorLFInfo;
     list<DeviceInfo>::iterator iter_hymirror_id = devices_info.lst_device_info.begin();
 
     while (iter_hymirror_id != devices_info.lst_device_info.end()){
-        lstHyMirrorLFInfo.clear();
+        list<HYMIRROR_LF_INFO_STRU> lstHyMirrorLFInfo;
+        list<string> lst_slave_array_sn;
+        list<string> lst_slave_id;
+        list<string> lst_pair_status;
 
         ret = get_device_info(iter_hymirror_id->id, arrayid, strid, lun_flag, hyper_id);
         if (RETURN_OK != ret){
@@ -398,12 +475,21 @@ int RestoreReplication::_is_slave_device_out(CCmdOperate& cmdOperate)
             ++iter_hymirror_id;
             continue;
         }
-        is_Fs_by_lun(cmdOperate, strid);
-        if (isNFS){
-            ret = cmdOperate.CMD_showhymirrorbyfs(strid, lstHyMirrorLFInfo);//mark
-        } 
+
+        plstListedLFInfo = _find_listed_hymirror(hymirror_lun_info, hyper_id);
+        if (NULL != plstListedLFInfo){
+            isNFS = false;
+            lstHyMirrorLFInfo = *plstListedLFInfo;
+            ret = RETURN_OK;
+        }
         else{
-            ret = cmdOperate.CMD_showhymirrorlun_all(hyper_id, lstHyMirrorLFInfo);
+            is_Fs_by_lun(cmdOperate, strid);
+            if (isNFS){
+                ret = cmdOperate.CMD_showhymirrorbyfs(strid, lstHyMirrorLFInfo);//mark
+            } 
+            else{
+                ret = cmdOperate.CMD_showhymirrorlun_all(hyper_id, lstHyMirrorLFInfo);
+            }
         }
         if (RETURN_OK != ret){
             iter_hymirror_id->error_info.code = OS_IToString(ERROR_INVALIDATE_DEVICE_ID);
@@ -471,23 +557,22 @@ int RestoreReplication::_is_slave_device_out(CCmdOperate& cmdOperate)
 int RestoreReplication::_is_slavehm_device_out(CCmdOperate& cmdOperate)
 {
     int ret = RETURN_ERR;
-    list<string> lst_slave_array_sn;
-    list<string> lst_slave_id;
-    list<string> lst_pair_status;
-    list<string> lst_token;
     string strid;
     string hypermetro_id;
     string key;
-    string master_id;
     string arrayid;
     string lun_flag;
 
-    list<HYPERMETRO_LF_INFO_STRU> lstHMPairLFInfo;
+    map<string, list<HYPERMETRO_LF_INFO_STRU> >::iterator itListedPair;
     list<HYPERMETRO_LF_INFO_STRU>::iterator itHMPairLFInfo;
     list<DeviceInfo>::iterator iter_hmpair_id = devices_info.lst_device_info.begin();
 
     while (iter_hmpair_id != devices_info.lst_device_info.end()){
-        lstHMPairLFInfo.clear();
+        list<HYPERMETRO_LF_INFO_STRU> lstHMPairLFInfo;
+        list<string> lst_slave_array_sn;
+        list<string> lst_slave_id;
+        list<string> lst_pair_status;
+        string master_id;
 
         ret = get_device_info(iter_hmpair_id->id, arrayid, strid, lun_flag, hypermetro_id);
         if (RETURN_OK != ret){
@@ -511,7 +596,14 @@ int RestoreReplication::_is_slavehm_device_out(CCmdOperate& cmdOperate)
             continue;
         }
 
-        ret = cmdOperate.CMD_showhypermetrolun_all(hypermetro_id, lstHMPairLFInfo);
+        itListedPair = hmpair_lun_info.find(hypermetro_id);
+        if (hmpair_lun_info.end() != itListedPair){
+            lstHMPairLFInfo = itListedPair->second;
+            ret = RETURN_OK;
+        }
+        else{
+            ret = cmdOperate.CMD_showhypermetrolun_all(hypermetro_id, lstHMPairLFInfo);
+        }
         if (RETURN_OK != ret){
             iter_hmpair_id->error_info.code = OS_IToString(ERROR_INVALIDATE_DEVICE_ID);
             COMMLOG(OS_LOG_ERROR, "id of device(%s) is wrong.", iter_hmpair_id->id.c_str());
@@ -575,4 +667,3 @@ int RestoreReplication::_is_slavehm_device_out(CCmdOperate& cmdOperate)
 
     return RETURN_OK;
 }
-
@@ -43,11 +43,21 @@ private:
     int _is_slave_device_out(CCmdOperate& cmdOperate);
     int _is_slavehm_device_out(CCmdOperate& cmdOperate);
 
+    void _load_pair_listing_out(CCmdOperate& cmdOperate);
+    string _find_listed_group_slave(const string& lun_id, bool hypermetro);
+
 private:
     string peer_array_id;
     char input_array_id[LENGTH_COMMON];
     ConGroupsInfo group_info;
     DevicesInfo devices_info;
+
+    map<string, list<HYMIRROR_LF_INFO_STRU> > hymirror_lun_info;
+    map<string, list<HYPERMETRO_LF_INFO_STRU> > hmpair_lun_info;
+    map<string, string> hymirror_by_lun;
+    map<string, string> hmpair_by_lun;
+    map<string, GROUP_INFO_STRU> consistgr_info;
+    map<string, GROUP_INFO_STRU> consistgrhm_info;
 };
 
 #endif
@@ -14,6 +14,455 @@
 
 #include "reverse_replication.h"
 
+/*
+ Reversal of one pair or consistency group. run() does the array work on
+ a worker session and only records the outcome, apply() writes it into
+ the response and prints the progress on the calling thread, in request
+ order. Host mapping is done before queueing so that no two workers
+ create the same host or host group.
+*/
+class SwapTask : public SraTask
+{
+public:
+    SwapTask() : err_code(RETURN_OK), swapped(false), success(false) {};
+
+    virtual void apply() = 0;
+
+protected:
+    int err_code;
+    bool swapped;
+    bool success;
+    string slave_key;
+};
+
+class ConsistSwapTask : public SwapTask
+{
+public:
+    ConsistSwapTask(ReverseReplication *owner, ConGroupInfo *group, const string& lun_id, const string& cg_id,
+        const string& hy_id)
+        : owner(owner), group(group), lun_id(lun_id), cg_id(cg_id), hy_id(hy_id), hypermetro(false) {};
+
+    ConsistSwapTask(ReverseReplication *owner, ConGroupInfo *group, const string& lun_id, const string& cg_id,
+        const string& hy_id, const string& role)
+        : owner(owner), group(group), lun_id(lun_id), cg_id(cg_id), hy_id(hy_id), role(role), hypermetro(true) {};
+
+    virtual int run(CCmdOperate& cmdOperate)
+    {
+        if (hypermetro){
+            return _swap_consisthm(cmdOperate);
+        }
+
+        return _swap_consist(cmdOperate);
+    }
+
+    virtual void apply()
+    {
+        if (!hypermetro && !role.empty()){
+            COMMLOG(OS_LOG_INFO,"the lun [%s] of TargetGroup [%s] with role [%s]",lun_id.c_str(),group->cg_id.c_str(),role.c_str());
+            print("the lun [%s] of TargetGroup [%s] with role [%s]",lun_id.c_str(),group->cg_id.c_str(),role.c_str());
+        }
+
+        if (swapped){
+            if (hypermetro){
+                COMMLOG(OS_LOG_INFO,"the Hypermetro ConsistencyGroup[%s] with TargetGroup [%s] promot begin",
+                    group->cg_id.c_str(),cg_id.c_str());
+                print("the Hypermetro ConsistencyGroup[%s] with GroupID [%s] is being promoted",
+                    group->cg_id.c_str(),cg_id.c_str());
+            }
+            else{
+                COMMLOG(OS_LOG_INFO,"the ConsistencyGroup[%s] with TargetGroup [%s] promot begin",group->cg_id.c_str(),cg_id.c_str());
+                print("the ConsistencyGroup[%s] with GroupID [%s] is being promoted",group->cg_id.c_str(),cg_id.c_str());
+            }
+        }
+
+        if (RETURN_OK != err_code){
+            group->error_info.code = OS_IToString(err_code);
+            return;
+        }
+
+        if (!swapped){
+            if (!hypermetro){
+                group->war_info.code = OS_IToString(500);
+            }
+            group->is_success = true;
+            return;
+        }
+
+        if (hypermetro){
+            COMMLOG(OS_LOG_INFO,"After reverse the hmdomain [%s] has attributes: [r/w]", group->cg_id.c_str());
+            print("After reverse the hypermetro group [%s] on array [%s] has attributes: [r/w]",
+                group->cg_id.c_str(),owner->array_id);
+        }
+        else{
+            COMMLOG(OS_LOG_INFO,"After reverse the ConsistencyGroup [%s] has attributes: [r/w]", group->cg_id.c_str());
+            print("After reverse the ConsistencyGroup [%s] on array [%s] has attributes: [r/w]",
+                group->cg_id.c_str(),owner->array_id);
+        }
+        COMMLOG(OS_LOG_INFO,"After reverse the TargetGroup [%s] has attributes: [r/o]",slave_key.c_str());
+        print("After reverse the TargetGroup [%s] on array [%s] has attributes: [r/o]",
+            slave_key.c_str(),owner->peer_array_id.c_str());
+
+        if (hypermetro){
+            COMMLOG(OS_LOG_INFO, "Complete: Promotion is now complete for group lun[%s] for reverse hypermetro request", lun_id.c_str());
+            print("Complete: Promotion is now complete for hmdomain [%s] for reverse hypermetro request", group->cg_id.c_str());
+        }
+        else{
+            COMMLOG(OS_LOG_INFO, "Complete: Promotion is now complete for group lun[%s] for reverse replication request", lun_id.c_str());
+            print("Complete: Promotion is now complete for ConsistencyGroup [%s] for reverse replication request", group->cg_id.c_str());
+        }
+        group->is_success = true;
+    }
+
+private:
+    int _swap_consist(CCmdOperate& cmdOperate)
+    {
+        int ret = RETURN_ERR;
+        bool nfs = false;
+        string cg_name;
+        FS_INFO_STRU stFSInfo;
+
+        stFSInfo.strID = lun_id;
+        nfs = (RETURN_OK == cmdOperate.CMD_showfs(stFSInfo));
+
+        if (nfs){
+            VSTORE_PAIR_INFO_STRU vstorePairInfo;
+            ret = cmdOperate.CMD_showvstorepair_info(cg_id, vstorePairInfo);
+            cg_name = vstorePairInfo.strID;
+            role = vstorePairInfo.isPrimary ? MIRROR_RELATION_MASTER : MIRROR_RELATION_SLAVE;
+        }
+        else{
+            GROUP_INFO_STRU stGroupInfo;
+            stGroupInfo.strID = cg_id;
+            ret = cmdOperate.CMD_showconsistgrinfo(stGroupInfo);
+
+            cg_name = stGroupInfo.strName;
+            owner->_convert_relation_type(stGroupInfo.uiIsPrimary, role);
+        }
+
+        if (RETURN_OK != ret){
+            role = "";
+            err_code = ret;
+            return ret;
+        }
+
+        if (0 == cg_name.length()){
+            role = "";
+            err_code = ERROR_INVALIDATE_GROUP_ID;
+            return err_code;
+        }
+
+        if (MIRROR_RELATION_MASTER == role){
+            return RETURN_OK;
+        }
+
+        swapped = true;
+        if (nfs){
+            ret = cmdOperate.CMD_swapvstorepair(cg_id);
+            if (RETURN_OK != ret){
+                COMMLOG(OS_LOG_ERROR, "swap vstorepair ret(%d).", ret);
+                err_code = ret;
+                return ret;
+            }
+
+            ret = cmdOperate.CMD_changeVstorePairSlaveLunRw(cg_id, RESOURCE_ACCESS_READ_ONLY);
+            if (ret != RETURN_OK){
+                COMMLOG(OS_LOG_ERROR, "change vstorepair Slave RO ret(%d).", ret);
+                err_code = ret;
+                return ret;
+            }
+        }
+        else{
+            ret = cmdOperate.CMD_swapconsistgr(cg_id);
+            if (RETURN_OK != ret){
+                COMMLOG(OS_LOG_ERROR, "swap consistgr ret(%d).", ret);
+                err_code = ret;
+                return ret;
+            }
+
+            OS_Sleep(500);
+
+            ret = cmdOperate.CMD_changeCGSlaveLunRw(cg_id, RESOURCE_ACCESS_READ_ONLY);
+            if (ret != RETURN_OK){
+                COMMLOG(OS_LOG_ERROR, "change consistgr SlaveLun RO ret(%d).", ret);
+                err_code = ret;
+                return ret;
+            }
+        }
+
+        list<HYMIRROR_LF_INFO_STRU> lstHyMirrorLFInfo;
+        list<HYMIRROR_LF_INFO_STRU>::iterator itHyMirrorLFInfo;
+        if (nfs){
+            ret = cmdOperate.CMD_showhymirrorfs_all(hy_id, lstHyMirrorLFInfo);
+        }
+        else{
+            ret = cmdOperate.CMD_showhymirrorlun_all(hy_id, lstHyMirrorLFInfo);
+        }
+
+        if (ret != RETURN_OK){
+            COMMLOG(OS_LOG_ERROR,"show hymirror fs/lun err ret(%d)",ret);
+        }
+
+        for (itHyMirrorLFInfo = lstHyMirrorLFInfo.begin(); 
+            itHyMirrorLFInfo != lstHyMirrorLFInfo.end(); itHyMirrorLFInfo++){
+            if (MIRROR_LUN_RELATION_MASTER == itHyMirrorLFInfo->uiRelationType && !nfs){
+                slave_key = "G_" + itHyMirrorLFInfo->strID;
+            }
+        }
+
+        success = true;
+        return RETURN_OK;
+    }
+
+    int _swap_consisthm(CCmdOperate& cmdOperate)
+    {
+        int ret = RETURN_ERR;
+
+        if (MIRROR_RELATION_MASTER == role){
+            return RETURN_OK;
+        }
+
+        swapped = true;
+        ret = cmdOperate.CMD_swapconsistgrhm(cg_id);
+        if (RETURN_OK != ret){
+            COMMLOG(OS_LOG_ERROR, "swap consistgr ret(%d).", ret);
+            err_code = ret;
+            return ret;
+        }
+
+        list<HYPERMETRO_LF_INFO_STRU> lstHMPairLFInfo;
+        list<HYPERMETRO_LF_INFO_STRU>::iterator itHMPairLFInfo;
+
+        ret = cmdOperate.CMD_showhypermetrolun_all(hy_id, lstHMPairLFInfo);
+        if(ret != 0){
+            COMMLOG(OS_LOG_ERROR,"show hypermetro lun err ret(%d)",ret);
+        }
+
+        for (itHMPairLFInfo = lstHMPairLFInfo.begin(); 
+            itHMPairLFInfo != lstHMPairLFInfo.end(); itHMPairLFInfo++){
+            if (MIRROR_LUN_RELATION_MASTER == itHMPairLFInfo->uiRelationType){
+                slave_key = "G_" + itHMPairLFInfo->strID;
+            }
+        }
+
+        success = true;
+        return RETURN_OK;
+    }
+
+private:
+    ReverseReplication *owner;
+    ConGroupInfo *group;
+    string lun_id;
+    string cg_id;
+    string hy_id;
+    string role;
+    bool hypermetro;
+};
+
+class MirrorSwapTask : public SwapTask
+{
+public:
+    MirrorSwapTask(ReverseReplication *owner, DeviceInfo *device, const string& lun_id, const string& hyper_id,
+        const string& key)
+        : owner(owner), device(device), device_id(device->id), lun_id(lun_id), hyper_id(hyper_id), key(key) {};
+
+    virtual int run(CCmdOperate& cmdOperate)
+    {
+        int ret = RETURN_ERR;
+        bool nfs = false;
+        string slave_id;
+        string master_id;
+        string statu;
+        string peer_array_id;
+        FS_INFO_STRU stFSInfo;
+        list<HYMIRROR_LF_INFO_STRU> lstHyMirrorLFInfo;
+        list<HYMIRROR_LF_INFO_STRU>::iterator itHyMirrorLFInfo;
+
+        stFSInfo.strID = lun_id;
+        nfs = (RETURN_OK == cmdOperate.CMD_showfs(stFSInfo));
+
+        if (nfs){
+            ret = cmdOperate.CMD_showhymirrorbyfs(lun_id, lstHyMirrorLFInfo);
+        } 
+        else{
+            ret = cmdOperate.CMD_showhymirrorlun_all(hyper_id, lstHyMirrorLFInfo);
+        }
+        if (RETURN_OK != ret){
+            err_code = ret;
+            return ret;
+        }
+
+        for (itHyMirrorLFInfo = lstHyMirrorLFInfo.begin(); 
+            itHyMirrorLFInfo != lstHyMirrorLFInfo.end(); itHyMirrorLFInfo++){
+            if (MIRROR_LUN_RELATION_MASTER == itHyMirrorLFInfo->uiRelationType){
+                master_id = itHyMirrorLFInfo->strArrayWWN + "_" + itHyMirrorLFInfo->strID + "_" + MIRROR_LUN_TAG + "_" + hyper_id; 
+                slave_key = itHyMirrorLFInfo->strArrayWWN + "." + itHyMirrorLFInfo->strID + "_" + MIRROR_LUN_TAG + "_" + hyper_id; 
+            }
+            if (MIRROR_LUN_RELATION_MASTER == itHyMirrorLFInfo->uiRelationType && nfs){
+                hyper_id = itHyMirrorLFInfo->strMirrorID;
+            }
+            if (MIRROR_LUN_RELATION_SLAVE == itHyMirrorLFInfo->uiRelationType){
+                slave_id = itHyMirrorLFInfo->strID;
+                owner->_convert_pair_status(itHyMirrorLFInfo->uiPairStatus, statu);
+            }
+        }
+
+        if (0 == master_id.length()){
+            err_code = ERROR_INVALIDATE_DEVICE_ID;
+            return err_code;
+        }
+
+        if (master_id == device_id || statu == MIRROR_SLAVE_PAIR_STATUS_STR_NORMAL){
+            success = true;
+            return RETURN_OK;
+        }
+
+        COMMLOG(OS_LOG_INFO, "Replica dvice [%s] of Remote device [%s] is being promoted",
+            key.c_str(),slave_key.c_str());
+
+        swapped = true;
+        ret = cmdOperate.CMD_swaphymirror(hyper_id, peer_array_id, slave_id);
+        if (RETURN_OK != ret){
+            err_code = ret;
+            COMMLOG(OS_LOG_ERROR, "CMD_swaphymirror failed (%d).", ret);
+            return ret;
+        }
+
+        if (nfs){
+            ret = cmdOperate.CMD_changeSlaveFsRw(hyper_id,RESOURCE_ACCESS_READ_ONLY);
+        }
+        else{
+            ret = cmdOperate.CMD_changeSlaveLunRw(hyper_id, RESOURCE_ACCESS_READ_ONLY);
+        }
+        if (RETURN_OK != ret){
+            COMMLOG(OS_LOG_ERROR, "CMD_changeSlaveRw failed (%d).", ret);
+            return ret;
+        }
+
+        success = true;
+        return RETURN_OK;
+    }
+
+    virtual void apply()
+    {
+        if (swapped){
+            print("Replica device [%s] of Remote device [%s] is being promoted",
+                key.c_str(),slave_key.c_str());
+        }
+
+        if (RETURN_OK != err_code){
+            device->error_info.code = OS_IToString(err_code);
+            return;
+        }
+
+        if (!success){
+            device->is_success = false;
+            return;
+        }
+
+        if (swapped){
+            COMMLOG(OS_LOG_INFO, "After reverse the promoted source  [%s] has attributes:[r/w]", key.c_str());
+            print("After reverse the promoted source  [%s] has attributes:[r/w]", key.c_str());
+            COMMLOG(OS_LOG_INFO, "After reverse the demoted target [%s] has attributes:[r/o]",slave_key.c_str());
+            print("After reverse the demoted target [%s] has attributes:[r/o]",slave_key.c_str());
+
+            COMMLOG(OS_LOG_INFO, "Complete: Replica is now complete for devices [%s] for reverse replication request.", key.c_str());
+            print( "Complete: Replica is now complete for devices [%s] for reverse replication request.", key.c_str());
+        }
+        device->is_success = true;
+    }
+
+private:
+    ReverseReplication *owner;
+    DeviceInfo *device;
+    string device_id;
+    string lun_id;
+    string hyper_id;
+    string key;
+};
+
+class HyperMetroSwapTask : public SwapTask
+{
+public:
+    HyperMetroSwapTask(DeviceInfo *device, const string& hyper_id, const string& key)
+        : device(device), device_id(device->id), hyper_id(hyper_id), key(key) {};
+
+    virtual int run(CCmdOperate& cmdOperate)
+    {
+        int ret = RETURN_ERR;
+        string master_id;
+        list<HYPERMETRO_LF_INFO_STRU> lstHMPairLFInfo;
+        list<HYPERMETRO_LF_INFO_STRU>::iterator itHMPairLFInfo;
+
+        ret = cmdOperate.CMD_showhypermetrolun_all(hyper_id, lstHMPairLFInfo);
+        if (RETURN_OK != ret){
+            err_code = ret;
+            return ret;
+        }
+
+        for (itHMPairLFInfo = lstHMPairLFInfo.begin(); 
+            itHMPairLFInfo != lstHMPairLFInfo.end(); itHMPairLFInfo++){
+            if (MIRROR_LUN_RELATION_MASTER == itHMPairLFInfo->uiRelationType){
+                master_id = itHMPairLFInfo->strArrayWWN + "_" + itHMPairLFInfo->strID + "_" + HYPERMETRO_LUN_TAG + "_" + hyper_id; 
+                slave_key = itHMPairLFInfo->strArrayWWN + "." + itHMPairLFInfo->strID + "_" + HYPERMETRO_LUN_TAG + "_" + hyper_id; 
+            }
+        }
+
+        if (0 == master_id.length()){
+            err_code = ERROR_INVALIDATE_DEVICE_ID;
+            return err_code;
+        }
+
+        if (master_id == device_id){
+            success = true;
+            return RETURN_OK;
+        }
+
+        COMMLOG(OS_LOG_INFO, "Hypermetro dvice [%s] of Remote device [%s] is being promoted",
+            key.c_str(),slave_key.c_str());
+
+        swapped = true;
+        ret = cmdOperate.CMD_swaphypermetro(hyper_id);
+        if (RETURN_OK != ret){
+            err_code = ret;
+            COMMLOG(OS_LOG_ERROR, "CMD_swaphypermetro failed (%d).", ret);
+            return ret;
+        }
+
+        success = true;
+        return RETURN_OK;
+    }
+
+    virtual void apply()
+    {
+        if (swapped){
+            print("Hypermetro device [%s] of Remote device [%s] is being promoted",
+                key.c_str(),slave_key.c_str());
+        }
+
+        if (RETURN_OK != err_code){
+            device->error_info.code = OS_IToString(err_code);
+            return;
+        }
+
+        if (swapped){
+            COMMLOG(OS_LOG_INFO, "After reverse the promoted source  [%s] has attributes:[r/w]", key.c_str());
+            print("After reverse the promoted source  [%s] has attributes:[r/w]", key.c_str());
+            COMMLOG(OS_LOG_INFO, "After reverse the demoted target [%s] has attributes:[r/o]",slave_key.c_str());
+            print("After reverse the demoted target [%s] has attributes:[r/o]",slave_key.c_str());
+
+            COMMLOG(OS_LOG_INFO, "Complete: Hypermetro is now complete for devices [%s] for reverse hypermetro request.", key.c_str());
+            print( "Complete: Hypermetro is now complete for devices [%s] for reverse hypermetro request.", key.c_str());
+        }
+        device->is_success = true;
+    }
+
+private:
+    DeviceInfo *device;
+    string device_id;
+    string hyper_id;
+    string key;
+};
+
 int reverse_replications(XmlReader &reader)
 {
     ReverseReplication rev_replication;
@@ -33,91 +482,25 @@ int reverse_replications(XmlReader &reader)
 
 int ReverseReplication::_read_command_para(XmlReader &reader)
 {
-    int i, j, k;
-    int cg_count = 0;
-    int device_count = 0;
-    int accessgroup_count = 0;
-    int accessinitiator_count = 0;
-    char peer_array[LENGTH_COMMON] = {0};
-
-    CHECK_FALSE(reader.get_string("/Command/ReverseReplicationParameters/ArrayId", array_id, 0), RETURN_ERR);
-    CHECK_FALSE(reader.get_string("/Command/ReverseReplicationParameters/ArrayId", input_array_id, 0), RETURN_ERR);
-    CHECK_FALSE(reader.get_string("/Command/ReverseReplicationParameters/PeerArrayId", peer_array, 0), RETURN_ERR);
-
-    peer_array_id = peer_array;
-    m_array_id = input_array_id;
-    cg_count = reader.get_count("/Command/ReverseReplicationParameters/ConsistencyGroups/ConsistencyGroup");
-    for (i = 0; i < cg_count; i++){
-        char cg_id[LENGTH_COMMON];
-        ConGroupInfo cg_info;
+    CommandPara para;
+    list<pair<string, string> >::iterator itAccess;
 
-        memset_s(cg_id, sizeof(cg_id), 0, sizeof(cg_id));
-        (void)reader.get_string("/Command/ReverseReplicationParameters/ConsistencyGroups/ConsistencyGroup/@id", cg_id, i);
-        
-        
-        cg_info.cg_id = cg_id;
-        consistency_group_info.lst_groups_info.push_back(cg_info);
-
-        
-        device_count = reader.get_count("/Command/ReverseReplicationParameters/ConsistencyGroups/ConsistencyGroup/Devices/Device", i, 2);
-        for(j = 0; j < device_count; j++){
-            char device_id[LENGTH_COMMON] = {0};
-            (void)reader.get_string("/Command/ReverseReplicationParameters/ConsistencyGroups/ConsistencyGroup/Devices/Device/@id", device_id, j);
-            
-            accessgroup_count = reader.get_count("/Command/ReverseReplicationParameters/ConsistencyGroups/ConsistencyGroup/Devices/Device/AccessGroups/AccessGroup", j, 2);
-            
-            string cg_accessgroups = "";
-            for (k = 0; k < accessgroup_count; k++){
-                char group_id[LENGTH_COMMON] = {0};
-                (void)reader.get_string("/Command/ReverseReplicationParameters/ConsistencyGroups/ConsistencyGroup/Devices/Device/AccessGroups/AccessGroup/@id", group_id, k, j, 2);
-                
-                cg_accessgroups = cg_accessgroups + group_id + DAR_HOST_SEPERATOR;
-            }
-            COMMLOG(OS_LOG_INFO, "AccessGroups of Device[%s] is [%s].", device_id, cg_accessgroups.c_str());
-            accessGroupDict[device_id] = cg_accessgroups;
-        }
-    }
+    CHECK_FALSE(reader.get_cstring("/Command/ReverseReplicationParameters/ArrayId", array_id), RETURN_ERR);
+    CHECK_FALSE(reader.get_cstring("/Command/ReverseReplicationParameters/ArrayId", input_array_id), RETURN_ERR);
+    CHECK_FALSE(reader.get_string("/Command/ReverseReplicationParameters/PeerArrayId", peer_array_id, LENGTH_COMMON - 1), RETURN_ERR);
+    m_array_id = input_array_id;
 
-    device_count = reader.get_count("/Command/ReverseReplicationParameters/Devices/Device");
-    for (i = 0; i < device_count; i++){
-        char dev_id[LENGTH_COMMON];
-        DeviceInfo dev_info;
+    CHECK_FALSE(_get_command_para(reader, "/Command/ReverseReplicationParameters", para), RETURN_ERR);
 
-        memset_s(dev_id, sizeof(dev_id), 0, sizeof(dev_id));
-        (void)reader.get_string("/Command/ReverseReplicationParameters/Devices/Device/@id", dev_id, i);
-        
-        
-        dev_info.id = dev_id;
-        
+    consistency_group_info.lst_groups_info.swap(para.cons_groups);
 
-        
-        accessgroup_count = reader.get_count("/Command/ReverseReplicationParameters/Devices/Device/AccessGroups/AccessGroup", i, 2);
-        for (j = 0; j < accessgroup_count; j++){
-            char group_id[LENGTH_COMMON] = {0};
-            (void)reader.get_string("/Command/ReverseReplicationParameters/Devices/Device/AccessGroups/AccessGroup/@id", group_id, j, i, 2);
-            dev_info.cg_accessgroups = dev_info.cg_accessgroups + group_id + ":";
-        }
-        devices_info.lst_device_info.push_back(dev_info);
+    for (itAccess = para.group_access.begin(); itAccess != para.group_access.end(); ++itAccess){
+        COMMLOG(OS_LOG_INFO, "AccessGroups of Device[%s] is [%s].", itAccess->first.c_str(), itAccess->second.c_str());
+        accessGroupDict[itAccess->first] = itAccess->second;
     }
 
-    
-    accessgroup_count = reader.get_count("/Command/ReverseReplicationParameters/AccessGroups/AccessGroup");
-    for(j = 0; j < accessgroup_count; j++){
-        char group_id[LENGTH_COMMON] = {0};
-        (void)reader.get_string("/Command/ReverseReplicationParameters/AccessGroups/AccessGroup/@id", group_id, j);
-        accessinitiator_count = reader.get_count("/Command/ReverseReplicationParameters/AccessGroups/AccessGroup/Initiator", j, 1);
-        for (i = 0; i < accessinitiator_count; i++){
-            char initiator_id[LENGTH_COMMON] = {0};
-            char initiator_type[LENGTH_COMMON] = {0};
-            DAR_HOST_INFO tg_dar_host_info;
-            (void)reader.get_string("/Command/ReverseReplicationParameters/AccessGroups/AccessGroup/Initiator/@id", initiator_id, i, j, 1);
-            (void)reader.get_string("/Command/ReverseReplicationParameters/AccessGroups/AccessGroup/Initiator/@type", initiator_type, i, j, 1);
-            tg_dar_host_info.strID = initiator_id;
-            tg_dar_host_info.strType = initiator_type;
-            tg_dar_host_info.strGroup = group_id;
-            lstDARHosts.push_back(tg_dar_host_info);
-        }
-    }
+    devices_info.lst_device_info.swap(para.devices);
+    lstDARHosts.swap(para.dar_hosts);
 
     return RETURN_OK;
 }
@@ -187,26 +570,28 @@ int ReverseReplication::_outband_process()
         return iRet;
     }
 
+    TaskPool swap_pool(stStorageInfo);
 
     
-    _outband_swap_hypermirror(cmdOperate);
+    _outband_swap_hypermirror(cmdOperate, swap_pool);
 
-    if (g_bFusionStorage && !g_testFusionStorageStretch){
-        return RETURN_OK;
-    }
+    if (!g_bFusionStorage || g_testFusionStorageStretch){
+        if (g_bstretch){
+            _outband_swap_hypermetropair(cmdOperate, swap_pool);
+        }
 
-    if (g_bstretch){
-        _outband_swap_hypermetropair(cmdOperate);
+        if (!g_bFusionStorage){
+            _outband_swap_consist(cmdOperate, swap_pool);
+            if (g_bstretch){
+                _outband_swap_consisthm(cmdOperate, swap_pool);
+            }
+        }
     }
 
-    if(g_bFusionStorage){
-        return RETURN_OK;
-    }
+    _run_swap_out(cmdOperate, swap_pool);
 
-    
-    _outband_swap_consist(cmdOperate);
-    if (g_bstretch){
-        _outband_swap_consisthm(cmdOperate);
+    if (g_bFusionStorage){
+        return RETURN_OK;
     }
 
     
@@ -217,6 +602,15 @@ int ReverseReplication::_outband_process()
     return RETURN_OK;
 }
 
+void ReverseReplication::_run_swap_out(CCmdOperate& cmdOperate, TaskPool& pool)
+{
+    pool.run(cmdOperate);
+
+    for (size_t i = 0; i < pool.size(); i++){
+        static_cast<SwapTask *>(pool.at(i))->apply();
+    }
+}
+
 
 void ReverseReplication::deal_3dc_lun(CCmdOperate& cmdOperate)
 {
@@ -264,25 +658,18 @@ void ReverseReplication::deal_3dc_lun(CCmdOperate& cmdOperate)
     }
 }
 
-void ReverseReplication::_outband_swap_consist(CCmdOperate& cmdOperate)
+void ReverseReplication::_outband_swap_consist(CCmdOperate& cmdOperate, TaskPool& pool)
 {
     int ret = RETURN_ERR;
-    list<string> lst_token;
     string lun_id;
     string cg_id;
-    string cg_name;
-    string role;
     string arrayid;
     string lun_flag;
     list<ConGroupInfo>::iterator iter;
 
     
-    iter = consistency_group_info.lst_groups_info.begin();
-    while (iter != consistency_group_info.lst_groups_info.end()){
-        GROUP_INFO_STRU stGroupInfo;
-
+    for (iter = consistency_group_info.lst_groups_info.begin(); iter != consistency_group_info.lst_groups_info.end(); ++iter){
         if (iter->error_info.hasError()){
-            ++iter;
             continue;
         }
 
@@ -290,12 +677,10 @@ void ReverseReplication::_outband_swap_consist(CCmdOperate& cmdOperate)
         if (RETURN_OK != ret){
             iter->error_info.code = OS_IToString(ret);
             COMMLOG(OS_LOG_ERROR, "id of device(%s) is wrong.", iter->cg_id.c_str());
-            ++iter;
             continue;
         }
 
         if (lun_flag.compare(MIRROR_LUN_CONSISTENT_TAG)){
-            ++iter;
             continue;
         }
 
@@ -306,151 +691,37 @@ void ReverseReplication::_outband_swap_consist(CCmdOperate& cmdOperate)
             iter->cg_id.c_str(), array_id);
 
         if (cg_id.empty()){
-            ++iter;
             continue;
         }
         
         if ("--" == cg_id){
             iter->error_info.code = OS_IToString(ERROR_INVALIDATE_GROUP_ID);
-            ++iter;
             continue;
         }
 
-        is_Fs_by_lun(cmdOperate, lun_id);
-        if(isNFS){
-            VSTORE_PAIR_INFO_STRU vstorePairInfo;
-            ret = cmdOperate.CMD_showvstorepair_info(cg_id, vstorePairInfo);
-            cg_name = vstorePairInfo.strID;
-            role = vstorePairInfo.isPrimary ? MIRROR_RELATION_MASTER : MIRROR_RELATION_SLAVE;
-        }
-        else{
-            
-            stGroupInfo.strID = cg_id;
-            ret = cmdOperate.CMD_showconsistgrinfo(stGroupInfo);
-            
-            cg_name = stGroupInfo.strName;
-            _convert_relation_type(stGroupInfo.uiIsPrimary, role);
-        }
-
-        if (RETURN_OK != ret){
-            iter->error_info.code = OS_IToString(ret);           
-            ++iter;
-            continue;
-        }        
-        
-        if ( 0 == cg_name.length()){
-            iter->error_info.code = OS_IToString(ERROR_INVALIDATE_GROUP_ID);
-            ++iter;
-            continue;
-        }
-        
-        COMMLOG(OS_LOG_INFO,"the lun [%s] of TargetGroup [%s] with role [%s]",lun_id.c_str(),iter->cg_id.c_str(),role.c_str());
-        print("the lun [%s] of TargetGroup [%s] with role [%s]",lun_id.c_str(),iter->cg_id.c_str(),role.c_str());
-        
-        if (MIRROR_RELATION_MASTER == role){
-            iter->war_info.code = OS_IToString(500);
-            iter->is_success = true;
-            ++iter;
-            continue;
-        }
-        
-        COMMLOG(OS_LOG_INFO,"the ConsistencyGroup[%s] with TargetGroup [%s] promot begin",iter->cg_id.c_str(),cg_id.c_str());
-        print("the ConsistencyGroup[%s] with GroupID [%s] is being promoted",iter->cg_id.c_str(),cg_id.c_str());
-        
-        if(isNFS){
-            ret = cmdOperate.CMD_swapvstorepair(cg_id);
-            if (RETURN_OK != ret){
-                COMMLOG(OS_LOG_ERROR, "swap vstorepair ret(%d).", ret);
-                iter->error_info.code = OS_IToString(ret);
-                ++iter;
-                continue;
-            }
-
-            ret = cmdOperate.CMD_changeVstorePairSlaveLunRw(cg_id, RESOURCE_ACCESS_READ_ONLY);
-            if (ret != RETURN_OK){
-                COMMLOG(OS_LOG_ERROR, "change vstorepair Slave RO ret(%d).", ret);
-                iter->error_info.code = OS_IToString(ret);
-                ++iter;
-                continue;
-            }
-        }
-        else{
-            
-            ret = cmdOperate.CMD_swapconsistgr(cg_id);
-            if (RETURN_OK != ret){
-                COMMLOG(OS_LOG_ERROR, "swap consistgr ret(%d).", ret);
-                iter->error_info.code = OS_IToString(ret);
-                ++iter;
-                continue;
-            }
-
-            OS_Sleep(500);
-
-            
-            ret = cmdOperate.CMD_changeCGSlaveLunRw(cg_id, RESOURCE_ACCESS_READ_ONLY);
-            if (ret != RETURN_OK){
-                COMMLOG(OS_LOG_ERROR, "change consistgr SlaveLun RO ret(%d).", ret);
-                iter->error_info.code = OS_IToString(ret);
-                ++iter;
-                continue;
-            }
-        }
-        
-        list<HYMIRROR_LF_INFO_STRU> lstHyMirrorLFInfo;
-        list<HYMIRROR_LF_INFO_STRU>::iterator itHyMirrorLFInfo;
-        string slave_key;
-        string perrArry;
-        if(isNFS){
-            ret = cmdOperate.CMD_showhymirrorfs_all(strHyID, lstHyMirrorLFInfo);
-        }
-        else{
-            ret = cmdOperate.CMD_showhymirrorlun_all(strHyID, lstHyMirrorLFInfo);
-        }
-        
-        if(ret != RETURN_OK){
-            COMMLOG(OS_LOG_ERROR,"show hymirror fs/lun err ret(%d)",ret);
-        }
-
-        for (itHyMirrorLFInfo = lstHyMirrorLFInfo.begin(); 
-            itHyMirrorLFInfo != lstHyMirrorLFInfo.end(); itHyMirrorLFInfo++){
-            if (MIRROR_LUN_RELATION_MASTER == itHyMirrorLFInfo->uiRelationType && !isNFS){
-                slave_key = "G_" + itHyMirrorLFInfo->strID;
-                perrArry = itHyMirrorLFInfo->strArrayWWN;
-            }
-        }
-        COMMLOG(OS_LOG_INFO,"After reverse the ConsistencyGroup [%s] has attributes: [r/w]", iter->cg_id.c_str());
-        print("After reverse the ConsistencyGroup [%s] on array [%s] has attributes: [r/w]",
-            iter->cg_id.c_str(),array_id);
-        COMMLOG(OS_LOG_INFO,"After reverse the TargetGroup [%s] has attributes: [r/o]",slave_key.c_str());
-        print("After reverse the TargetGroup [%s] on array [%s] has attributes: [r/o]",
-            slave_key.c_str(),peer_array_id.c_str());
-        
-        COMMLOG(OS_LOG_INFO, "Complete: Promotion is now complete for group lun[%s] for reverse replication request", lun_id.c_str());
-        print("Complete: Promotion is now complete for ConsistencyGroup [%s] for reverse replication request", iter->cg_id.c_str());
-        iter->is_success = true;
-        ++iter;
+        pool.add(new ConsistSwapTask(this, &(*iter), lun_id, cg_id, strHyID));
     }
 
     return;
 }
 
-void ReverseReplication::_outband_swap_consisthm(CCmdOperate& cmdOperate)
+void ReverseReplication::_outband_swap_consisthm(CCmdOperate& cmdOperate, TaskPool& pool)
 {
     int ret = RETURN_ERR;
-    list<string> lst_token;
     string lun_id;
     string cg_id;
     string cg_name;
     string role;
     string arrayid;
     string lun_flag;
+    bool listed = false;
     list<ConGroupInfo>::iterator iter;
+    list<HYPERMETROPAIR_INFO_STRU> lstHMPairInfo;
+    list<HYPERMETROPAIR_INFO_STRU>::iterator itHMPairInfo;
 
     
-    iter = consistency_group_info.lst_groups_info.begin();
-    while (iter != consistency_group_info.lst_groups_info.end()){
+    for (iter = consistency_group_info.lst_groups_info.begin(); iter != consistency_group_info.lst_groups_info.end(); ++iter){
         if (iter->error_info.hasError()){
-            ++iter;
             continue;
         }
 
@@ -458,12 +729,10 @@ void ReverseReplication::_outband_swap_consisthm(CCmdOperate& cmdOperate)
         if (RETURN_OK != ret){
             iter->error_info.code = OS_IToString(ret);
             COMMLOG(OS_LOG_ERROR, "id of device(%s) is wrong.", iter->cg_id.c_str());
-            ++iter;
             continue;
         }
 
         if (lun_flag.compare(HYPERMETRO_LUN_CONSISTENT_TAG)){
-            ++iter;
             continue;
         }
 
@@ -474,14 +743,12 @@ void ReverseReplication::_outband_swap_consisthm(CCmdOperate& cmdOperate)
             iter->cg_id.c_str(), array_id);
 
         if (cg_id.empty()){
-            ++iter;
             continue;
         }
 
         
         if ("--" == cg_id){
             iter->error_info.code = OS_IToString(ERROR_INVALIDATE_GROUP_ID);
-            ++iter;
             continue;
         }
 
@@ -491,19 +758,21 @@ void ReverseReplication::_outband_swap_consisthm(CCmdOperate& cmdOperate)
         ret = cmdOperate.CMD_showconsistgrhminfo(stGroupInfo);
         if (RETURN_OK != ret){
             iter->error_info.code = OS_IToString(ret);           
-            ++iter;
             continue;
         }
 
         
-        list<HYPERMETROPAIR_INFO_STRU> lstHMPairInfo;
-        list<HYPERMETROPAIR_INFO_STRU>::iterator itHMPairInfo;
-        ret = cmdOperate.CMD_showHyperMetroPair_all(lstHMPairInfo);
-        if (RETURN_OK != ret){
-            iter->error_info.code = OS_IToString(ret);
-            COMMLOG(OS_LOG_ERROR, "CMD_showHyperMetroPair_all failed.");
-            continue;
+        if (!listed){
+            ret = cmdOperate.CMD_showHyperMetroPair_all(lstHMPairInfo);
+            if (RETURN_OK != ret){
+                iter->error_info.code = OS_IToString(ret);
+                COMMLOG(OS_LOG_ERROR, "CMD_showHyperMetroPair_all failed.");
+                continue;
+            }
+            listed = true;
         }
+
+        // hosts are mapped here rather than on the workers, they may share hosts and host groups
         for (itHMPairInfo = lstHMPairInfo.begin(); itHMPairInfo != lstHMPairInfo.end(); itHMPairInfo++){
             if (cg_id != itHMPairInfo->strGroupID){
                 continue;
@@ -537,7 +806,6 @@ void ReverseReplication::_outband_swap_consisthm(CCmdOperate& cmdOperate)
         _convert_relation_type(stGroupInfo.uiIsPrimary, role);
         if ( 0 == cg_name.length()){
             iter->error_info.code = OS_IToString(ERROR_INVALIDATE_GROUP_ID);
-            ++iter;
             continue;
         }
         
@@ -546,90 +814,28 @@ void ReverseReplication::_outband_swap_consisthm(CCmdOperate& cmdOperate)
         
         if (MIRROR_RELATION_MASTER == role){
             iter->is_success = true;
-            ++iter;
             continue;
         }
 
-        
-        COMMLOG(OS_LOG_INFO,"the Hypermetro ConsistencyGroup[%s] with TargetGroup [%s] promot begin",
-            iter->cg_id.c_str(),cg_id.c_str());
-        print("the Hypermetro ConsistencyGroup[%s] with GroupID [%s] is being promoted",
-            iter->cg_id.c_str(),cg_id.c_str());
-        
-        COMMLOG(OS_LOG_INFO,"the lun [%s] of TargetGroup [%s] with role [%s]",
-            lun_id.c_str(),iter->cg_id.c_str(),role.c_str());
-        print("the lun [%s] of TargetGroup [%s] with role [%s]",
-            lun_id.c_str(),iter->cg_id.c_str(),role.c_str());
-
-        ret = cmdOperate.CMD_swapconsistgrhm(cg_id);
-        if (RETURN_OK != ret){
-            COMMLOG(OS_LOG_ERROR, "swap consistgr ret(%d).", ret);
-            iter->error_info.code = OS_IToString(ret);
-            ++iter;
-            continue;
-        }
-
-        
-        list<HYPERMETRO_LF_INFO_STRU> lstHMPairLFInfo;
-        list<HYPERMETRO_LF_INFO_STRU>::iterator itHMPairLFInfo;
-        string slave_key;
-        string perrArry;
-
-        ret = cmdOperate.CMD_showhypermetrolun_all(strHyID, lstHMPairLFInfo);
-        if(ret != 0){
-            COMMLOG(OS_LOG_ERROR,"show hypermetro lun err ret(%d)",ret);
-        }
-
-        for (itHMPairLFInfo = lstHMPairLFInfo.begin(); 
-            itHMPairLFInfo != lstHMPairLFInfo.end(); itHMPairLFInfo++){
-            if (MIRROR_LUN_RELATION_MASTER == itHMPairLFInfo->uiRelationType && !isNFS){
-                slave_key = "G_" + itHMPairLFInfo->strID;
-                perrArry = itHMPairLFInfo->strArrayWWN;
-            }
-        }
-        COMMLOG(OS_LOG_INFO,"After reverse the hmdomain [%s] has attributes: [r/w]", iter->cg_id.c_str());
-        print("After reverse the hypermetro group [%s] on array [%s] has attributes: [r/w]",
-            iter->cg_id.c_str(),array_id);
-        COMMLOG(OS_LOG_INFO,"After reverse the TargetGroup [%s] has attributes: [r/o]",slave_key.c_str());
-        print("After reverse the TargetGroup [%s] on array [%s] has attributes: [r/o]",
-            slave_key.c_str(),peer_array_id.c_str());
-        
-        COMMLOG(OS_LOG_INFO, "Complete: Promotion is now complete for group lun[%s] for reverse hypermetro request", lun_id.c_str());
-        print("Complete: Promotion is now complete for hmdomain [%s] for reverse hypermetro request", iter->cg_id.c_str());
-        iter->is_success = true;
-        ++iter;
+        pool.add(new ConsistSwapTask(this, &(*iter), lun_id, cg_id, strHyID, role));
     }
 
     return;
 }
 
-void ReverseReplication::_outband_swap_hypermirror(CCmdOperate& cmdOperate)
+void ReverseReplication::_outband_swap_hypermirror(CCmdOperate& cmdOperate, TaskPool& pool)
 {
     int ret = RETURN_ERR;
     string strid;
     string hyper_id;
-    string Slave_id;
-    string Peer_array_id;
-    string master_id;
-    string all_LF = "";
     string key;
-    string slave_key;
-    string statu;
     string arrayid;
     string lun_flag;
-    list<string> lst_token;
-    list<HYMIRROR_LF_INFO_STRU> lstHyMirrorLFInfo;
-    list<HYMIRROR_LF_INFO_STRU>::iterator itHyMirrorLFInfo;
 
     list<DeviceInfo>::iterator iter;
 
-    iter = devices_info.lst_device_info.begin();
-    while (iter != devices_info.lst_device_info.end()){
-        
-        lstHyMirrorLFInfo.clear();
-
+    for (iter = devices_info.lst_device_info.begin(); iter != devices_info.lst_device_info.end(); ++iter){
         if (iter->error_info.hasError()){
-            ++iter;
             continue;
         }
 
@@ -637,12 +843,10 @@ void ReverseReplication::_outband_swap_hypermirror(CCmdOperate& cmdOperate)
         if (RETURN_OK != ret){
             iter->error_info.code = OS_IToString(ret);
             COMMLOG(OS_LOG_ERROR, "id of device(%s) is wrong.", iter->id.c_str());
-            ++iter;
             continue;
         }
 
         if (lun_flag.compare(MIRROR_LUN_TAG)){
-            ++iter;
             continue;
         }
         key = arrayid + "." + strid;
@@ -654,130 +858,31 @@ void ReverseReplication::_outband_swap_hypermirror(CCmdOperate& cmdOperate)
             key.c_str(), array_id);
 
         if (hyper_id.empty()){
-            ++iter;
             continue;
         }
-        is_Fs_by_lun(cmdOperate, strid);
         
         COMMLOG(OS_LOG_INFO,"The Remote Replica id of lun [%s] is [%s]",strid.c_str(),hyper_id.c_str());
         print("The Remote Replica id of lun [%s] is [%s]",strid.c_str(),hyper_id.c_str());
-        
-        if (isNFS){
-            ret = cmdOperate.CMD_showhymirrorbyfs(strid, lstHyMirrorLFInfo);
-        } 
-        else{
-            ret = cmdOperate.CMD_showhymirrorlun_all(hyper_id, lstHyMirrorLFInfo);
-        }
-        if (RETURN_OK != ret){
-            iter->error_info.code = OS_IToString(ret);
-            ++iter;
-            continue;
-        }
 
-        
-        for (itHyMirrorLFInfo = lstHyMirrorLFInfo.begin(); 
-            itHyMirrorLFInfo != lstHyMirrorLFInfo.end(); itHyMirrorLFInfo++){
-            if (MIRROR_LUN_RELATION_MASTER == itHyMirrorLFInfo->uiRelationType){
-                master_id = itHyMirrorLFInfo->strArrayWWN + "_" + itHyMirrorLFInfo->strID + "_" + MIRROR_LUN_TAG + "_" + hyper_id; 
-                slave_key = itHyMirrorLFInfo->strArrayWWN + "." + itHyMirrorLFInfo->strID + "_" + MIRROR_LUN_TAG + "_" + hyper_id; 
-            }
-            if (MIRROR_LUN_RELATION_MASTER == itHyMirrorLFInfo->uiRelationType && isNFS){
-                hyper_id = itHyMirrorLFInfo->strMirrorID;
-            }
-            if (MIRROR_LUN_RELATION_SLAVE == itHyMirrorLFInfo->uiRelationType){
-                Slave_id = itHyMirrorLFInfo->strID;
-                _convert_pair_status(itHyMirrorLFInfo->uiPairStatus, statu);
-
-            }
-        }
-
-        if ((0 == master_id.length())){
-            iter->error_info.code = OS_IToString(ERROR_INVALIDATE_DEVICE_ID);
-            ++iter;
-            continue;
-        }
-
-        
-        
-        if (master_id == iter->id || statu == MIRROR_SLAVE_PAIR_STATUS_STR_NORMAL){
-            
-            iter->is_success = true;
-            ++iter;
-            continue;
-        }
-        
-        
-        COMMLOG(OS_LOG_INFO, "Replica dvice [%s] of Remote device [%s] is being promoted",
-            key.c_str(),slave_key.c_str());
-        print("Replica device [%s] of Remote device [%s] is being promoted",
-            key.c_str(),slave_key.c_str());
-        
-        ret = cmdOperate.CMD_swaphymirror(hyper_id, Peer_array_id, Slave_id);
-        if (RETURN_OK != ret){
-            iter->error_info.code = OS_IToString(ret);
-            ++iter;
-            COMMLOG(OS_LOG_ERROR, "CMD_swaphymirror failed (%d).", ret);
-            continue;
-        }
-
-        
-        if (isNFS){
-            ret = cmdOperate.CMD_changeSlaveFsRw(hyper_id,RESOURCE_ACCESS_READ_ONLY);
-        }
-        else{
-            ret = cmdOperate.CMD_changeSlaveLunRw(hyper_id, RESOURCE_ACCESS_READ_ONLY);
-        }
-        if (RETURN_OK != ret){
-            COMMLOG(OS_LOG_ERROR, "CMD_changeSlaveRw failed (%d).", ret);
-            iter->is_success = false;
-            ++iter;
-            continue;
-        }
-    
-
-        
-        COMMLOG(OS_LOG_INFO, "After reverse the promoted source  [%s] has attributes:[r/w]", key.c_str());
-        print("After reverse the promoted source  [%s] has attributes:[r/w]", key.c_str());
-        COMMLOG(OS_LOG_INFO, "After reverse the demoted target [%s] has attributes:[r/o]",slave_key.c_str());
-        print("After reverse the demoted target [%s] has attributes:[r/o]",slave_key.c_str());
-
-        
-        COMMLOG(OS_LOG_INFO, "Complete: Replica is now complete for devices [%s] for reverse replication request.", key.c_str());
-        print( "Complete: Replica is now complete for devices [%s] for reverse replication request.", key.c_str());
-        iter->is_success = true;
-        ++iter;
+        pool.add(new MirrorSwapTask(this, &(*iter), strid, hyper_id, key));
     }
 
     return;
 }
 
-void ReverseReplication::_outband_swap_hypermetropair(CCmdOperate& cmdOperate)
+void ReverseReplication::_outband_swap_hypermetropair(CCmdOperate& cmdOperate, TaskPool& pool)
 {
     int ret = RETURN_ERR;
     string strid;
     string hyper_id;
-    string Slave_id;
-    string Peer_array_id;
-    string master_id;
-    string all_LF = "";
     string key;
-    string slave_key;
-    string statu;
     string arrayid;
     string lun_flag;
-    list<string> lst_token;
-    list<HYPERMETRO_LF_INFO_STRU> lstHMPairLFInfo;
-    list<HYPERMETRO_LF_INFO_STRU>::iterator itHMPairLFInfo;
 
     list<DeviceInfo>::iterator iter;
 
-    iter = devices_info.lst_device_info.begin();
-    while (iter != devices_info.lst_device_info.end()){
-        
-        lstHMPairLFInfo.clear();
-
+    for (iter = devices_info.lst_device_info.begin(); iter != devices_info.lst_device_info.end(); ++iter){
         if (iter->error_info.hasError()){
-            ++iter;
             continue;
         }
 
@@ -785,12 +890,10 @@ void ReverseReplication::_outband_swap_hypermetropair(CCmdOperate& cmdOperate)
         if (RETURN_OK != ret){
             iter->error_info.code = OS_IToString(ret);
             COMMLOG(OS_LOG_ERROR, "id of device(%s) is wrong.", iter->id.c_str());
-            ++iter;
             continue;
         }
 
         if (lun_flag.compare(HYPERMETRO_LUN_TAG)){
-            ++iter;
             continue;
         }
         key = arrayid + "." + strid;
@@ -802,11 +905,10 @@ void ReverseReplication::_outband_swap_hypermetropair(CCmdOperate& cmdOperate)
             key.c_str(), array_id);
 
         if (hyper_id.empty()){
-            ++iter;
             continue;
         }
 
-        
+        // hosts are mapped here rather than on the workers, they may share hosts and host groups
         list<CMDHOSTINFO_STRU> rlstHostInfo;
         TargetDeviceInfo tmp_tg;
         tmp_tg.target_id = iter->id;
@@ -825,69 +927,9 @@ void ReverseReplication::_outband_swap_hypermetropair(CCmdOperate& cmdOperate)
         
         COMMLOG(OS_LOG_INFO,"The Hypermetro id of lun [%s] is [%s]",strid.c_str(),hyper_id.c_str());
         print("The Hypermetro id of lun [%s] is [%s]",strid.c_str(),hyper_id.c_str());
-        
-        ret = cmdOperate.CMD_showhypermetrolun_all(hyper_id, lstHMPairLFInfo);
-        if (RETURN_OK != ret){
-            iter->error_info.code = OS_IToString(ret);
-            ++iter;
-            continue;
-        }
-
-        
-        for (itHMPairLFInfo = lstHMPairLFInfo.begin(); 
-            itHMPairLFInfo != lstHMPairLFInfo.end(); itHMPairLFInfo++){
-            if (MIRROR_LUN_RELATION_MASTER == itHMPairLFInfo->uiRelationType){
-                master_id = itHMPairLFInfo->strArrayWWN + "_" + itHMPairLFInfo->strID + "_" + HYPERMETRO_LUN_TAG + "_" + hyper_id; 
-                slave_key = itHMPairLFInfo->strArrayWWN + "." + itHMPairLFInfo->strID + "_" + HYPERMETRO_LUN_TAG + "_" + hyper_id; 
-            }
-            if (MIRROR_LUN_RELATION_SLAVE == itHMPairLFInfo->uiRelationType){
-                Slave_id = itHMPairLFInfo->strID;
-                _convert_hmpair_status(itHMPairLFInfo->uiPairStatus, statu);
-
-            }
-        }
-
-        if ((0 == master_id.length())){
-            iter->error_info.code = OS_IToString(ERROR_INVALIDATE_DEVICE_ID);
-            ++iter;
-            continue;
-        }
-
-        
-        
-        if (master_id == iter->id){
-            iter->is_success = true;
-            ++iter;
-            continue;
-        }
-
-        
-        COMMLOG(OS_LOG_INFO, "Hypermetro dvice [%s] of Remote device [%s] is being promoted",
-            key.c_str(),slave_key.c_str());
-        print("Hypermetro device [%s] of Remote device [%s] is being promoted",
-            key.c_str(),slave_key.c_str());
-        
-        ret = cmdOperate.CMD_swaphypermetro(hyper_id);
-        if (RETURN_OK != ret){
-            iter->error_info.code = OS_IToString(ret);
-            ++iter;
-            COMMLOG(OS_LOG_ERROR, "CMD_swaphypermetro failed (%d).", ret);
-            continue;
-        }
 
-        
-        COMMLOG(OS_LOG_INFO, "After reverse the promoted source  [%s] has attributes:[r/w]", key.c_str());
-        print("After reverse the promoted source  [%s] has attributes:[r/w]", key.c_str());
-        COMMLOG(OS_LOG_INFO, "After reverse the demoted target [%s] has attributes:[r/o]",slave_key.c_str());
-        print("After reverse the demoted target [%s] has attributes:[r/o]",slave_key.c_str());
-
-        
-        COMMLOG(OS_LOG_INFO, "Complete: Hypermetro is now complete for devices [%s] for reverse hypermetro request.", key.c_str());
-        print( "Complete: Hypermetro is now complete for devices [%s] for reverse hypermetro request.", key.c_str());
-        iter->is_success = true;
-        ++iter;
+        pool.add(new HyperMetroSwapTask(&(*iter), hyper_id, key));
     }
 
     return;
 }
-
@@ -16,15 +16,22 @@
 #define REVERSE_REPLICATION_H
 
 #include "sra_basic.h"
+#include "task_pool.h"
 #include "../common/xml_node/device.h"
 #include "../common/xml_node/consistency_groups.h"
 #include "ThreeDCLun.h"
 
 int reverse_replications(XmlReader &reader);
 
+class ConsistSwapTask;
+class MirrorSwapTask;
+
 class ReverseReplication: public SraBasic
                         ,ThreeDCLunHelper
 {
+    friend class ConsistSwapTask;
+    friend class MirrorSwapTask;
+
 public:
     ReverseReplication() : SraBasic()
                          , ThreeDCLunHelper(this->m_array_id,this->consistency_group_info,this->devices_info)
@@ -40,10 +47,11 @@ protected:
     virtual int check_array_id_validate_out(CCmdOperate& cmdOperate, string& array_id, const string& peer_array_id = "");
 
 private:
-    void _outband_swap_consist(CCmdOperate& cmdOperate);
-    void _outband_swap_consisthm(CCmdOperate& cmdOperate);
-    void _outband_swap_hypermirror(CCmdOperate& cmdOperate);
-    void _outband_swap_hypermetropair(CCmdOperate& cmdOperate);
+    void _outband_swap_consist(CCmdOperate& cmdOperate, TaskPool& pool);
+    void _outband_swap_consisthm(CCmdOperate& cmdOperate, TaskPool& pool);
+    void _outband_swap_hypermirror(CCmdOperate& cmdOperate, TaskPool& pool);
+    void _outband_swap_hypermetropair(CCmdOperate& cmdOperate, TaskPool& pool);
+    void _run_swap_out(CCmdOperate& cmdOperate, TaskPool& pool);
 
     void deal_3dc_lun(CCmdOperate& cmdOperate);
 
@@ -29,6 +29,8 @@
 #include "reverse_replication.h"
 #include "restore.h"
 #include "prepare_reverse.h"
+#include "task_pool.h"
+#include "command_para.h"
 
 #ifdef WIN32
 #include <Windows.h>
@@ -716,7 +718,7 @@ int dispatch(XmlReader &reader)
 
     char commander[LENGTH_COMMON] = {0};
 
-    if (!reader.get_string("/Command/Name", commander, 0)){
+    if (!reader.get_cstring("/Command/Name", commander)){
         COMMLOG(OS_LOG_ERROR, "%s", "read /Command/Name failed.");
         return ERROR_INTERNAL_PROCESS_FAIL;
     }
@@ -751,8 +753,8 @@ int send_error_info(XmlReader &reader, int error_code)
 
     XmlWriter writer;
 
-    CHECK_FALSE(reader.get_string(XML_REQUSET_TITLE, xmlns, 0), RETURN_ERR);
-    CHECK_FALSE(reader.get_string(XML_OUTPUTFILE, output_file, 0), RETURN_ERR);
+    CHECK_FALSE(reader.get_cstring(XML_REQUSET_TITLE, xmlns), RETURN_ERR);
+    CHECK_FALSE(reader.get_cstring(XML_OUTPUTFILE, output_file), RETURN_ERR);
 
     CHECK_FALSE(writer.set_int(XML_RESPONSE_ERROR, error_code), RETURN_ERR);
     CHECK_FALSE(writer.set_string(XML_RESPONSE_TITLE, xmlns), RETURN_ERR);
@@ -764,13 +766,11 @@ int send_error_info(XmlReader &reader, int error_code)
     return RETURN_OK;
 }
 
-
 int main(int argc, char* argv[])
 {
     int ret = RETURN_ERR;
 
     string input("");
-    string str_line;
 
     XmlReader reader;
 
@@ -802,29 +802,29 @@ int main(int argc, char* argv[])
     
     
 
-    while(getline(cin, str_line)){
-#ifdef WIN32
-        input += str_line + "\r\n";
-#else
-        input += str_line + "\n";
-#endif
+    if (!read_command(stdin, input)){
+        print("%s", "read command from stdin err");
+        return -1;
     }
 
-    
-    
-    if (!reader.load_from_string(input, TIXML_DEFAULT_ENCODING)){
+    bool streamed = false;
+    if (!load_command(reader, input, streamed)){
         print("%s","load_from_string err");
         return -1;
     }
+    if (!streamed){
+        print("%s", "load_from_stream err, read the whole command into the DOM.");
+    }
+    string().swap(input);
 
     
     char Log_dir[1024] = {0};
-    if(!reader.get_string(XML_LOGDIRECTORY, Log_dir, 0)){
+    if(!reader.get_cstring(XML_LOGDIRECTORY, Log_dir)){
         print("%s","get log directory err");
         return -1;
     }
     sra_init_log(Log_dir);
-    if(!reader.get_string(XML_LOGLEVEL, LOG_LEVEL, 0)){
+    if(!reader.get_cstring(XML_LOGLEVEL, LOG_LEVEL)){
         print("%s","get log level err");
         return -1;
     }
@@ -880,6 +880,16 @@ int main(int argc, char* argv[])
                 g_bFusionStorage = false;
             }
         }
+
+        int maxConcurrency = -1;
+        if(oConfig.getIntValue("maxConcurrentRequests", maxConcurrency) != false){
+            if (maxConcurrency > 0 && maxConcurrency <= THREAD_MAX_SIZE){
+                g_iMaxConcurrency = maxConcurrency;
+            }
+            else{
+                COMMLOG(OS_LOG_WARN, "config.txt maxConcurrentRequests %d is out of range, use %d.", maxConcurrency, g_iMaxConcurrency);
+            }
+        }
     }
     
     ret = dispatch(reader);
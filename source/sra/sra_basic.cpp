@@ -18,7 +18,9 @@
 
 char LOG_LEVEL[10] = {0};
 
-SraBasic::SraBasic() : error_code(RETURN_OK)
+SraBasic::SraBasic() : startup_checks(0), error_code(RETURN_OK), session_ret(RETURN_ERR), session_grp(-1), session_pending(false),
+    session_checks(0), session_clonefs_ret(RETURN_OK), session_nfs(false), session_stretched_ret(RETURN_OK), session_stretch(false),
+    host_inventory_loaded(false)
 {
     memset_s(xmlns, sizeof(xmlns), 0, sizeof(xmlns));
     memset_s(output_file, sizeof(output_file), 0, sizeof(output_file));
@@ -37,7 +39,10 @@ SraBasic::SraBasic() : error_code(RETURN_OK)
 
 SraBasic::~SraBasic()
 {
-
+    try{
+        _wait_array_session();
+    }
+    catch(...){}
 }
 
 int SraBasic::_read_common_info(XmlReader &reader)
@@ -51,29 +56,29 @@ int SraBasic::_read_common_info(XmlReader &reader)
     char *tmpstr = NULL;
     long portNum = 0;
 
-    CHECK_FALSE(reader.get_string(XML_REQUSET_TITLE, xmlns, 0), RETURN_ERR);
-    CHECK_FALSE(reader.get_string(XML_OUTPUTFILE, output_file, 0), RETURN_ERR);
-    CHECK_FALSE(reader.get_string(XML_STATUSFILE, status_file, 0), RETURN_ERR);
-    CHECK_FALSE(reader.get_string(XML_LOGDIRECTORY, log_dir, 0), RETURN_ERR);
-    CHECK_FALSE(reader.get_string(XML_LOGLEVEL, log_level, 0), RETURN_ERR);
+    CHECK_FALSE(reader.get_cstring(XML_REQUSET_TITLE, xmlns), RETURN_ERR);
+    CHECK_FALSE(reader.get_cstring(XML_OUTPUTFILE, output_file), RETURN_ERR);
+    CHECK_FALSE(reader.get_cstring(XML_STATUSFILE, status_file), RETURN_ERR);
+    CHECK_FALSE(reader.get_cstring(XML_LOGDIRECTORY, log_dir), RETURN_ERR);
+    CHECK_FALSE(reader.get_cstring(XML_LOGLEVEL, log_level), RETURN_ERR);
 
     
     if (INBAND_TYPE == g_cli_type){
-        CHECK_FALSE(reader.get_string(XML_ARRAYSN, id, 0), RETURN_ERR);
+        CHECK_FALSE(reader.get_cstring(XML_ARRAYSN, id), RETURN_ERR);
     }
     else{
         addressCount = reader.get_count(XML_ARRAYSN);
         lstAddressInfo.clear();
         for (int i = 0; i< addressCount; i++){
-            char tmpIP[LENGTH_COMMON] = {0};
+            string tmpIP;
 
-            (void)reader.get_string(XML_ARRAYIP, tmpIP, i);
-            lstAddressInfo.push_back(string(tmpIP));
+            (void)reader.get_string(XML_ARRAYIP, tmpIP, LENGTH_COMMON - 1, i);
+            lstAddressInfo.push_back(tmpIP);
         }
     }
 
-    CHECK_FALSE(reader.get_string(XML_USERNAME, user_name, 0), RETURN_ERR);
-    CHECK_FALSE(reader.get_string(XML_PASSWD, password, 0), RETURN_ERR);
+    CHECK_FALSE(reader.get_cstring(XML_USERNAME, user_name), RETURN_ERR);
+    CHECK_FALSE(reader.get_cstring(XML_PASSWD, password), RETURN_ERR);
 
     
     if (INBAND_TYPE != g_cli_type){
@@ -147,6 +152,29 @@ int SraBasic::_read_command_para(XmlReader &reader)
     return RETURN_OK;
 }
 
+/*
+ Hand over the device lists main streamed for this command, or read them
+ from the document when the command was loaded without streaming. Fails
+ when a list key is too long, the way a scalar field read fails.
+*/
+bool SraBasic::_get_command_para(XmlReader &reader, const char *para_path, CommandPara &para)
+{
+    if (g_command_para.is_loaded()){
+        para.swap(g_command_para);
+        g_command_para.clear();
+    }
+    else{
+        para.read(reader, para_path);
+    }
+
+    if (!para.get_value_error().empty()){
+        COMMLOG(OS_LOG_ERROR, "%s.", para.get_value_error().c_str());
+        return false;
+    }
+
+    return true;
+}
+
 int SraBasic::_outband_process()
 {
     return RETURN_OK;
@@ -166,6 +194,34 @@ int SraBasic::_write_error_info(XmlWriter &writer)
     return RETURN_OK;
 }
 
+/*
+ The error response written the way SaveFile writes it, for when the
+ streamed response could not be saved. SRM gets an error instead of a
+ document cut short.
+*/
+int SraBasic::_save_error_response()
+{
+    int ret = RETURN_ERR;
+    XmlWriter writer;
+    string content;
+
+    if (RETURN_OK == error_code){
+        error_code = ERROR_INTERNAL_PROCESS_FAIL;
+    }
+
+    CHECK_FALSE(writer.set_string(XML_RESPONSE_TITLE, xmlns), RETURN_ERR);
+    ret = _write_error_info(writer);
+    CHECK_UNEQ(RETURN_OK, ret);
+
+    if (!writer.save_to_file(output_file, content)){
+        COMMLOG(OS_LOG_ERROR, "faild to save file(%s)", output_file);
+        return RETURN_ERR;
+    }
+
+    COMMLOG(OS_LOG_INFO, "%s", content.c_str());
+    return RETURN_OK;
+}
+
 void SraBasic::_write_progress(unsigned int percent)
 {
     XmlWriter writer("ProgressUpdate");
@@ -178,6 +234,34 @@ void SraBasic::_write_progress(unsigned int percent)
 
 }
 
+/*
+ The start of the response for the log, one line as the logger cuts it
+ at MAX_MSG_SIZE, written when the response is done.
+*/
+class ResponseLogSink : public XmlSink
+{
+public:
+    ResponseLogSink(){};
+
+    virtual bool write(const char *data, size_t len)
+    {
+        size_t limit = MAX_MSG_SIZE - 1;
+        size_t room = (text.size() < limit) ? (limit - text.size()) : 0;
+
+        (void)text.append(data, (len < room) ? len : room);
+        return true;
+    }
+
+    virtual bool close()
+    {
+        COMMLOG(OS_LOG_INFO, "%s", text.c_str());
+        return true;
+    }
+
+private:
+    string text;
+};
+
 int SraBasic::entry(XmlReader &reader)
 {
     XmlWriter writer;
@@ -189,7 +273,17 @@ int SraBasic::entry(XmlReader &reader)
     
     int error_read_info(RETURN_OK), error_read_param(RETURN_OK);
     error_read_info = _read_common_info(reader);
+    if (RETURN_OK == error_read_info){
+        _start_array_session();
+    }
+    else if (!reader.get_value_error().empty()){
+        COMMLOG(OS_LOG_ERROR, "%s.", reader.get_value_error().c_str());
+    }
+
     error_read_param = _read_command_para(reader);
+    if (RETURN_OK != error_read_param && !reader.get_value_error().empty()){
+        COMMLOG(OS_LOG_ERROR, "%s.", reader.get_value_error().c_str());
+    }
 
     if (RETURN_OK != error_read_info){
         COMMLOG(OS_LOG_ERROR, "%s", "failed to read commond info");
@@ -205,6 +299,18 @@ int SraBasic::entry(XmlReader &reader)
     if (RETURN_OK == error_code){
         process();
     }
+    _wait_array_session();
+
+    // the response goes to a temporary file and the log while it is written,
+    // the file becomes output_file only once the whole document is in it
+    string tmp_file = string(output_file) + ".tmp";
+    XmlFileSink file_sink;
+    ResponseLogSink log_sink;
+    XmlTeeSink tee(file_sink, log_sink);
+    bool opened = file_sink.open(tmp_file.c_str());
+    XmlSink &sink = opened ? (XmlSink &)tee : (XmlSink &)log_sink;
+
+    (void)writer.stream_to(sink);
 
     if (!writer.set_string(XML_RESPONSE_TITLE, xmlns)){
         error_code = ERROR_INTERNAL_PROCESS_FAIL;
@@ -217,32 +323,20 @@ int SraBasic::entry(XmlReader &reader)
         (void)_write_error_info(writer);
     }
 
-    if (!writer.save_to_file(output_file)){
-        COMMLOG(OS_LOG_ERROR, "faild to save file(%s)", output_file);
-    }
-
-    ifstream infile(output_file);
-	string outputStr;
-	string strInfile;
-	if (infile.is_open())
-	{
-		while (getline(infile, strInfile))
-		{
-			outputStr +=  strInfile;
+    bool saved = writer.save_to(sink);
+    saved = sink.close() && saved && opened;
+    if (saved){
 #ifdef WIN32
-			outputStr += "\r\n";
-#else
-			outputStr += "\n";
+        (void)remove(output_file);
 #endif
-		}
-	}
-	else
-	{
-		COMMLOG(OS_LOG_WARN, "the output_file [%s] open failed ", output_file);
-	}
+        saved = (0 == rename(tmp_file.c_str(), output_file));
+    }
 
-    COMMLOG(OS_LOG_INFO, "%s", outputStr.c_str());
-	infile.close();
+    if (!saved){
+        COMMLOG(OS_LOG_ERROR, "faild to save file(%s)", output_file);
+        (void)remove(tmp_file.c_str());
+        (void)_save_error_response();
+    }
 
     if(RETURN_OK == error_code){
         return RETURN_OK;
@@ -517,13 +611,147 @@ int SraBasic::setStorageInfo(HYPER_STORAGE_STRU& stStorageInfo)
     return RETURN_OK;
 }
 
+const char *SraBasic::_get_log_dir() const
+{
+    return log_dir;
+}
+
+/*
+ Every command logs in and reads the system info of the array before its
+ own work. Both only need the common info, so they run on a second session
+ while the command parameters are read, and the first command session that
+ asks for the system info takes that session over instead of logging in.
+ The clone-FS and stretched checks a command asks for in startup_checks
+ run on that session too.
+*/
+void SraBasic::_start_array_session()
+{
+    if ((OUTBAND_REST_TYPE != g_cli_type) && (OUTBAND_TYPE != g_cli_type) && (VISOUT_TYPE != g_cli_type)){
+        return;
+    }
+
+    session_grp = session_mgr.spawn((ACE_THR_FUNC)SraBasic::_array_session_worker, this);
+    if (-1 == session_grp){
+        COMMLOG(OS_LOG_WARN, "%s", "failed to open the array session early, open it on demand.");
+        return;
+    }
+
+    session_pending = true;
+}
+
+ACE_THR_FUNC_RETURN SraBasic::_array_session_worker(void *arg)
+{
+    SraBasic *basic = (SraBasic *)arg;
+    HYPER_STORAGE_STRU stStorageInfo;
+    string strErrorMsg;
+    unsigned long long begin = OS_GetTickCount();
+
+    (void)basic->setStorageInfo(stStorageInfo);
+
+    basic->session_ret = basic->session_cmd.SetStorageInfo(stStorageInfo);
+    if (RETURN_OK == basic->session_ret){
+        basic->session_ret = basic->session_cmd.CMD_showtlvsysinfo(basic->session_sysinfo, strErrorMsg);
+    }
+
+    if (RETURN_OK == basic->session_ret){
+        basic->_run_startup_checks();
+    }
+
+    COMMLOG(OS_LOG_INFO, "array session opened in %llu ms, ret(%d).", OS_GetTickCount() - begin, basic->session_ret);
+
+    return 0;
+}
+
+/*
+ The command may still read g_bnfs and g_bstretch while the checks run,
+ e.g. while listing the pairs ahead of the stretched check of
+ discoverDevices. So the checks start from the configured flags and leave
+ their outcome in session_nfs and session_stretch, the globals are only
+ read here. _check_*_out applies the outcome when the command reaches the
+ check, as if it ran the check there.
+*/
+void SraBasic::_run_startup_checks()
+{
+    if (startup_checks & STARTUP_CHECK_CLONEFS){
+        session_nfs = g_bnfs;
+        session_clonefs_ret = session_cmd.CMD_showarrayclonefs(session_nfs);
+    }
+
+    if (startup_checks & STARTUP_CHECK_STRETCHED){
+        session_stretch = g_bstretch;
+        session_stretched_ret = session_cmd.CMD_showarraystretched(session_stretched, session_stretch);
+    }
+
+    session_checks = startup_checks;
+}
+
+void SraBasic::_wait_array_session()
+{
+    if (-1 == session_grp){
+        return;
+    }
+
+    (void)session_mgr.wait_grp(session_grp);
+    session_grp = -1;
+}
+
+int SraBasic::_get_sysinfo_out(CCmdOperate& cmdOperate, HYPER_STORAGE_STRU& stStorageInfo)
+{
+    string strErrorMsg;
+
+    if (!session_pending){
+        return cmdOperate.CMD_showtlvsysinfo(stStorageInfo, strErrorMsg);
+    }
+
+    _wait_array_session();
+    session_pending = false;
+
+    // a failed login is not tried again, the array may lock the user
+    if (RETURN_OK != session_ret){
+        return session_ret;
+    }
+
+    cmdOperate.TakeSession(session_cmd);
+    stStorageInfo = session_sysinfo;
+
+    return RETURN_OK;
+}
+
+int SraBasic::_check_clonefs_out(CCmdOperate& cmdOperate)
+{
+    _wait_array_session();
+
+    if (0 == (session_checks & STARTUP_CHECK_CLONEFS)){
+        return cmdOperate.CMD_showarrayclonefs();
+    }
+
+    session_checks &= ~STARTUP_CHECK_CLONEFS;
+    g_bnfs = session_nfs;
+
+    return session_clonefs_ret;
+}
+
+int SraBasic::_check_stretched_out(CCmdOperate& cmdOperate, list<REMOTE_ARRAY_STRU>& lstStretchedInfo)
+{
+    _wait_array_session();
+
+    if (0 == (session_checks & STARTUP_CHECK_STRETCHED)){
+        return cmdOperate.CMD_showarraystretched(lstStretchedInfo);
+    }
+
+    session_checks &= ~STARTUP_CHECK_STRETCHED;
+    g_bstretch = session_stretch;
+    lstStretchedInfo.swap(session_stretched);
+
+    return session_stretched_ret;
+}
+
 int SraBasic::_get_array_info(CCmdOperate& cmdOperate)
 {
     int ret = RETURN_ERR;
-    string strErrorMsg;
     HYPER_STORAGE_STRU stStorageInfo;
 
-    ret = cmdOperate.CMD_showtlvsysinfo(stStorageInfo, strErrorMsg);
+    ret = _get_sysinfo_out(cmdOperate, stStorageInfo);
     CHECK_UNEQ(RETURN_OK, ret);
 
     SNPRINTF(array_id, sizeof(array_id), sizeof(array_id) - 1, "%s", stStorageInfo.strArraySN.c_str());
@@ -535,12 +763,7 @@ int SraBasic::_get_hymirror_percent_out(CCmdOperate& cmdOperate, string& hymirro
 {
     int iRet = RETURN_ERR;
 
-    list<string> lst_percent;
-    list<string> lst_name_normal;
-    list<string> lst_name_synchronizing;
-
     list<HYMIRROR_LF_INFO_STRU> lstHyMirrorLFInfo;
-    list<HYMIRROR_LF_INFO_STRU>::iterator itHyMirrorLFInfo;
 
     
     if (isNFS){
@@ -553,6 +776,17 @@ int SraBasic::_get_hymirror_percent_out(CCmdOperate& cmdOperate, string& hymirro
     }
     CHECK_UNEQ(RETURN_OK,iRet);
 
+    return _calc_hymirror_percent(lstHyMirrorLFInfo, hymirror_id, query_percent);
+}
+
+int SraBasic::_calc_hymirror_percent(list<HYMIRROR_LF_INFO_STRU>& lstHyMirrorLFInfo, string& hymirror_id, string& query_percent)
+{
+    list<string> lst_percent;
+    list<string> lst_name_normal;
+    list<string> lst_name_synchronizing;
+
+    list<HYMIRROR_LF_INFO_STRU>::iterator itHyMirrorLFInfo;
+
     for (itHyMirrorLFInfo = lstHyMirrorLFInfo.begin(); itHyMirrorLFInfo != lstHyMirrorLFInfo.end(); itHyMirrorLFInfo++){
         if (MIRROR_SLAVE_PAIR_STATUS_CHAR_NORMAL == itHyMirrorLFInfo->uiPairStatus){
             lst_name_normal.push_back(itHyMirrorLFInfo->strName);
@@ -591,17 +825,23 @@ int SraBasic::_get_hmpair_percent_out(CCmdOperate& cmdOperate, string& hymirror_
 {
     int iRet = RETURN_ERR;
 
-    list<string> lst_percent;
-    list<string> lst_name_normal;
-    list<string> lst_name_synchronizing;
-
     list<HYPERMETRO_LF_INFO_STRU> lstHMPairLFInfo;
-    list<HYPERMETRO_LF_INFO_STRU>::iterator itHMPairLFInfo;
 
     
     iRet = cmdOperate.CMD_showhypermetrolun_all(hymirror_id, lstHMPairLFInfo);
     CHECK_UNEQ(RETURN_OK,iRet);
 
+    return _calc_hmpair_percent(lstHMPairLFInfo, hymirror_id, query_percent);
+}
+
+int SraBasic::_calc_hmpair_percent(list<HYPERMETRO_LF_INFO_STRU>& lstHMPairLFInfo, string& hymirror_id, string& query_percent)
+{
+    list<string> lst_percent;
+    list<string> lst_name_normal;
+    list<string> lst_name_synchronizing;
+
+    list<HYPERMETRO_LF_INFO_STRU>::iterator itHMPairLFInfo;
+
     for (itHMPairLFInfo = lstHMPairLFInfo.begin(); itHMPairLFInfo != lstHMPairLFInfo.end(); itHMPairLFInfo++){
         if (MIRROR_SLAVE_PAIR_STATUS_CHAR_NORMAL == itHMPairLFInfo->uiPairStatus){
             lst_name_normal.push_back(itHMPairLFInfo->strName);
@@ -636,6 +876,18 @@ int SraBasic::_get_hmpair_percent_out(CCmdOperate& cmdOperate, string& hymirror_
     return RETURN_ERR;
 }
 
+list<HYMIRROR_LF_INFO_STRU> *SraBasic::_find_listed_hymirror(map<string, list<HYMIRROR_LF_INFO_STRU> >& mapHyMirrorLUNInfo, const string& hymirror_id)
+{
+    map<string, list<HYMIRROR_LF_INFO_STRU> >::iterator it = mapHyMirrorLUNInfo.find(hymirror_id);
+
+    // file system pairs keep the per pair query, they are looked up by file system
+    if (mapHyMirrorLUNInfo.end() == it || it->second.empty() || OBJ_LUN != it->second.front().uilocalResType){
+        return NULL;
+    }
+
+    return &it->second;
+}
+
 int SraBasic::check_array_id_validate_out(CCmdOperate& cmdOperate, string& array_id, const string& peer_array_id)
 {
     int ret = RETURN_ERR;
@@ -1285,6 +1537,23 @@ int SraBasic::_do_mapping(CCmdOperate& cmdOperate, TargetDeviceInfo& target_devi
     return RETURN_OK;
 }
 
+static string _host_set_key(const list<CMDHOSTINFO_STRU>& lstHosts)
+{
+    vector<string> host_ids;
+    string key;
+
+    for (list<CMDHOSTINFO_STRU>::const_iterator it = lstHosts.begin(); it != lstHosts.end(); ++it){
+        host_ids.push_back(it->strID);
+    }
+    sort(host_ids.begin(), host_ids.end());
+
+    for (size_t i = 0; i < host_ids.size(); i++){
+        key += (0 == i) ? host_ids[i] : "," + host_ids[i];
+    }
+
+    return key;
+}
+
 int SraBasic::_add_map(CCmdOperate& cmdOperate, TargetDeviceInfo& target_device, list<DAR_HOST_INFO>& lstDARHosts, list<CMDHOSTINFO_STRU>& lstHosts, string& lun_id, int obj_type)
 {
     int iRet = RETURN_ERR;
@@ -1340,12 +1609,37 @@ int SraBasic::_add_map(CCmdOperate& cmdOperate, TargetDeviceInfo& target_device,
     }
 
     if (!g_bFusionStorage){
-        
+        // devices exposed to the same hosts share the groups mapped for the first of them
+        string host_key = _host_set_key(lstHosts);
+        string group_key = OS_IToString(obj_type) + "/" + host_key;
+        map<string, string>::iterator itGroup = lun_group_index.find(group_key);
+        if (lun_group_index.end() != itGroup){
+            iRet = cmdOperate.CMD_addLun2LunGroup(lun_id, itGroup->second, obj_type);
+            if (RETURN_OK == iRet){
+                COMMLOG(OS_LOG_INFO, "Add snapshot/lun[%s] to LunGroup [%s] mapped to the same hosts.", lun_id.c_str(), itGroup->second.c_str());
+                return RETURN_OK;
+            }
+
+            COMMLOG(OS_LOG_WARN, "Add snapshot/lun[%s] to LunGroup [%s] fail(%d), map it on its own.", lun_id.c_str(), itGroup->second.c_str(), iRet);
+            lun_group_index.erase(itGroup);
+
+            // the shared host group is already in the mapping view of that LunGroup, a host group
+            // in a second view could not be deleted at teardown, so the lun gets a host group of its own
+            host_group_index.erase(host_key);
+        }
+
         string hostGroupID;
-        iRet = _create_host_group(cmdOperate, lun_id, hostGroupID, lstHosts);
-        if (RETURN_OK != iRet || hostGroupID.empty()){
-            COMMLOG(OS_LOG_ERROR, "Create Host Group for lun id [%s] error", lun_id.c_str());
-            return iRet;
+        map<string, string>::iterator itHostGroup = host_group_index.find(host_key);
+        if (host_group_index.end() != itHostGroup){
+            hostGroupID = itHostGroup->second;
+        }
+        else{
+            iRet = _create_host_group(cmdOperate, lun_id, hostGroupID, lstHosts);
+            if (RETURN_OK != iRet || hostGroupID.empty()){
+                COMMLOG(OS_LOG_ERROR, "Create Host Group for lun id [%s] error", lun_id.c_str());
+                return iRet;
+            }
+            host_group_index[host_key] = hostGroupID;
         }
 
 
@@ -1367,6 +1661,8 @@ int SraBasic::_add_map(CCmdOperate& cmdOperate, TargetDeviceInfo& target_device,
             COMMLOG(OS_LOG_ERROR, "Failed to create mapping between lungroup[%s] and hostgroup[%s].", lunGroupID.c_str(), hostGroupID.c_str());
             return iRet;
         }
+
+        lun_group_index[group_key] = lunGroupID;
     }
     else{
         for (list<CMDHOSTINFO_STRU>::iterator it = lstHosts.begin(); it != lstHosts.end(); it++){
@@ -1395,6 +1691,8 @@ int SraBasic::_select_valid_initiator(CCmdOperate& cmdOperate, TargetDeviceInfo&
     mapHostInfo.clear();
     mapInitiatorNoHost.clear();
     vector<string> lunAceessGroup = split(target_device.cg_accessgroups, DAR_HOST_SEPERATOR);
+
+    _load_host_inventory_out(cmdOperate);
     
     vector<string>::iterator itrLunAceessGroup = lunAceessGroup.begin();
     for (; itrLunAceessGroup != lunAceessGroup.end(); itrLunAceessGroup++ ){
@@ -1409,7 +1707,7 @@ int SraBasic::_select_valid_initiator(CCmdOperate& cmdOperate, TargetDeviceInfo&
                 if (*itrLunAceessGroup == itDARHostInfo->strGroup){                    
                     
                     INITIATOR_INFO initiator_info;
-                    iRet = cmdOperate.CMD_showInitiatorInfo(itDARHostInfo->strID, itDARHostInfo->strType, initiator_info);
+                    iRet = _get_initiator_info(cmdOperate, *itDARHostInfo, initiator_info);
                     if (iRet != RETURN_OK){
                         COMMLOG(OS_LOG_WARN, "Failed to get host by initiator[%s], please check the connection between array and host", itDARHostInfo->strID.c_str());
                         continue;;
@@ -1444,7 +1742,7 @@ int SraBasic::_select_valid_initiator(CCmdOperate& cmdOperate, TargetDeviceInfo&
                             }
                             else{
                                 hostInfo.strID = initiator_info.strHostID;
-                                iRet = cmdOperate.CMD_showhost(hostInfo);
+                                iRet = _get_host_info(cmdOperate, hostInfo);
                             }
                             
 
@@ -1681,6 +1979,7 @@ int SraBasic::_query_and_create_host(CCmdOperate& cmdOperate, const string& lun_
                             COMMLOG(OS_LOG_ERROR, "Failed to associate initiator[%s] to host[%s]...", vInitiatorNoHost[id].strID.c_str(), hostId.c_str());
                             return iRet;
                         }
+                        _note_initiator_added(vInitiatorNoHost[id], itrMapHostInfo->second.front());
                     }
 
                     continue;
@@ -1691,7 +1990,7 @@ int SraBasic::_query_and_create_host(CCmdOperate& cmdOperate, const string& lun_
             string hostName = VSSRA_HOST_PREFIX + lun_id + "_" + strAccessGroup;
             CMDHOSTINFO_STRU hostInfo;
 
-            iRet = cmdOperate.CMD_showhost(hostName, hostInfo);
+            iRet = _get_host_by_name(cmdOperate, hostName, hostInfo);
             if (iRet != RETURN_OK){
                 COMMLOG(OS_LOG_ERROR, "Failed to get host info [%s]", hostName.c_str());
                 return iRet;
@@ -1709,6 +2008,7 @@ int SraBasic::_query_and_create_host(CCmdOperate& cmdOperate, const string& lun_
                     COMMLOG(OS_LOG_ERROR, "create host [%s] success, but host id is empty.", hostName.c_str());
                     return RETURN_ERR;
                 }
+                _note_host(hostInfo);
             }
 
             
@@ -1723,6 +2023,7 @@ int SraBasic::_query_and_create_host(CCmdOperate& cmdOperate, const string& lun_
                     COMMLOG(OS_LOG_ERROR, "Failed to associate initiator[%s] to host[%s]...", vInitiatorNoHost[id].strID.c_str(),  hostInfo.strID.c_str());
                     return iRet;
                 }
+                _note_initiator_added(vInitiatorNoHost[id], hostInfo);
             }
 
             mapHostInfo[strAccessGroup].push_back(hostInfo);
@@ -1732,6 +2033,184 @@ int SraBasic::_query_and_create_host(CCmdOperate& cmdOperate, const string& lun_
     return RETURN_OK;
 }
 
+static string _initiator_key(const string& type, const string& initiator_id)
+{
+    string key = initiator_id;
+
+    if ("FC" == type){
+        key.erase(remove(key.begin(), key.end(), WWN_FILTER_CON[0]), key.end());
+    }
+
+    return type + "/" + key;
+}
+
+/*
+ The ESX initiators are the same for every device of a recovery plan, so
+ the FC and iSCSI initiators and the hosts of the array are listed once
+ per command. A lookup that misses the listing, such as a host created
+ by this command, is queried on its own and remembered.
+*/
+void SraBasic::_load_host_inventory_out(CCmdOperate& cmdOperate)
+{
+    int ret = RETURN_ERR;
+    list<INITIATOR_INFO> lstInitiatorInfo;
+    list<INITIATOR_INFO>::iterator itInitiatorInfo;
+    list<CMDHOSTINFO_STRU> lstHostInfo;
+    list<CMDHOSTINFO_STRU>::iterator itHostInfo;
+    const char *types[] = {"FC", "iSCSI"};
+
+    if (host_inventory_loaded){
+        return;
+    }
+    host_inventory_loaded = true;
+
+    if (g_bFusionStorage){
+        return;
+    }
+
+    for (size_t i = 0; i < sizeof(types) / sizeof(types[0]); i++){
+        ret = cmdOperate.CMD_showInitiatorInfo_all(types[i], lstInitiatorInfo);
+        if (RETURN_OK != ret){
+            COMMLOG(OS_LOG_WARN, "list %s initiators fail(%d), query them one by one.", types[i], ret);
+            continue;
+        }
+
+        for (itInitiatorInfo = lstInitiatorInfo.begin(); itInitiatorInfo != lstInitiatorInfo.end(); ++itInitiatorInfo){
+            initiator_index[_initiator_key(types[i], itInitiatorInfo->strID)] = *itInitiatorInfo;
+        }
+    }
+
+    ret = cmdOperate.CMD_showhost(lstHostInfo);
+    if (RETURN_OK != ret){
+        COMMLOG(OS_LOG_WARN, "list hosts fail(%d), query them one by one.", ret);
+        return;
+    }
+
+    for (itHostInfo = lstHostInfo.begin(); itHostInfo != lstHostInfo.end(); ++itHostInfo){
+        _note_host(*itHostInfo);
+    }
+
+    COMMLOG(OS_LOG_INFO, "listed %u initiators and %u hosts for mapping.",
+        (unsigned int)initiator_index.size(), (unsigned int)host_index.size());
+}
+
+int SraBasic::_get_initiator_info(CCmdOperate& cmdOperate, const DAR_HOST_INFO& initiator, INITIATOR_INFO& initiator_info)
+{
+    int ret = RETURN_ERR;
+    string key = _initiator_key(initiator.strType, initiator.strID);
+    map<string, INITIATOR_INFO>::iterator itInitiator;
+
+    itInitiator = initiator_index.find(key);
+    if (initiator_index.end() != itInitiator){
+        initiator_info = itInitiator->second;
+        return RETURN_OK;
+    }
+
+    ret = cmdOperate.CMD_showInitiatorInfo(initiator.strID, initiator.strType, initiator_info);
+    if (RETURN_OK != ret){
+        return ret;
+    }
+
+    // an initiator unknown to the array is not remembered
+    if (!initiator_info.strID.empty()){
+        initiator_index[key] = initiator_info;
+    }
+
+    return RETURN_OK;
+}
+
+int SraBasic::_get_host_info(CCmdOperate& cmdOperate, CMDHOSTINFO_STRU& hostInfo)
+{
+    int ret = RETURN_ERR;
+    map<string, CMDHOSTINFO_STRU>::iterator itHost;
+
+    itHost = host_index.find(hostInfo.strID);
+    if (host_index.end() != itHost){
+        hostInfo = itHost->second;
+        return RETURN_OK;
+    }
+
+    ret = cmdOperate.CMD_showhost(hostInfo);
+    if (RETURN_OK != ret){
+        return ret;
+    }
+
+    if (!hostInfo.strName.empty()){
+        _note_host(hostInfo);
+    }
+
+    return RETURN_OK;
+}
+
+int SraBasic::_get_host_by_name(CCmdOperate& cmdOperate, const string& host_name, CMDHOSTINFO_STRU& hostInfo)
+{
+    int ret = RETURN_ERR;
+    map<string, string>::iterator itName;
+
+    itName = host_name_index.find(host_name);
+    if (host_name_index.end() != itName){
+        hostInfo = host_index[itName->second];
+        return RETURN_OK;
+    }
+
+    ret = cmdOperate.CMD_showhost(host_name, hostInfo);
+    if (RETURN_OK != ret){
+        return ret;
+    }
+
+    if (!hostInfo.strID.empty()){
+        _note_host(hostInfo);
+    }
+
+    return RETURN_OK;
+}
+
+void SraBasic::_note_host(const CMDHOSTINFO_STRU& hostInfo)
+{
+    host_index[hostInfo.strID] = hostInfo;
+    if (!hostInfo.strName.empty()){
+        host_name_index[hostInfo.strName] = hostInfo.strID;
+    }
+}
+
+int SraBasic::_get_host_ports(CCmdOperate& cmdOperate, const string& host_id, list<HOST_PORT_INFO_STRU>& lstHostPortInfo)
+{
+    int ret = RETURN_ERR;
+    map<string, list<HOST_PORT_INFO_STRU> >::iterator itHostPort;
+
+    itHostPort = host_port_index.find(host_id);
+    if (host_port_index.end() != itHostPort){
+        lstHostPortInfo = itHostPort->second;
+        return RETURN_OK;
+    }
+
+    ret = cmdOperate.CMD_showhostport(host_id, lstHostPortInfo);
+    if (RETURN_OK != ret){
+        return ret;
+    }
+
+    host_port_index[host_id] = lstHostPortInfo;
+
+    return RETURN_OK;
+}
+
+void SraBasic::_note_initiator_added(const DAR_HOST_INFO& initiator, const CMDHOSTINFO_STRU& hostInfo)
+{
+    map<string, INITIATOR_INFO>::iterator itInitiator;
+
+    // the ports of the host changed, query them again on next use
+    (void)host_port_index.erase(hostInfo.strID);
+
+    itInitiator = initiator_index.find(_initiator_key(initiator.strType, initiator.strID));
+    if (initiator_index.end() == itInitiator){
+        return;
+    }
+
+    itInitiator->second.isFree = false;
+    itInitiator->second.strHostID = hostInfo.strID;
+    itInitiator->second.strHostName = hostInfo.strName;
+}
+
 int SraBasic::_create_lun_group(CCmdOperate& cmdOperate, const string& lun_id, string& lunGroupID, int obj_type)
 {
     int iRet = RETURN_OK;
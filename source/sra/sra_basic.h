@@ -15,9 +15,12 @@
 #ifndef SRA_BASIC_H
 #define SRA_BASIC_H
 
+#include <ace/Thread_Manager.h>
+
 #include "common.h"
 #include "commond_info.h"
 #include "CmdOperate.h"
+#include "command_para.h"
 #include "../common/xml_node/target_devices.h"
 #include "../common/xml_node/target_groups.h"
 
@@ -32,6 +35,10 @@
 #define VSSRA_LUNGROUP_PREFIX               "vssra_lungrp_of_"
 #define VSSRA_MAPPINGVIEW_PREFIX            "vssra_mv_of_"
 
+// array checks a command runs on the startup session, see startup_checks
+#define STARTUP_CHECK_CLONEFS               0x1
+#define STARTUP_CHECK_STRETCHED             0x2
+
 extern char LOG_LEVEL[10];
 
 class CommonLunInfo
@@ -85,6 +92,13 @@ public:
     int _create_lun_group(CCmdOperate& cmdOperate, const string& lun_id, string& lunGroupID, int obj_type);
     int _create_host_group(CCmdOperate& cmdOperate, const string& lun_id, string& hostGroupID, list<CMDHOSTINFO_STRU> &lstHosts);
     int _create_mapping(CCmdOperate& cmdOperate, const string& lun_id, const string& lunGrpID, const string& hostGrpID);
+    void _load_host_inventory_out(CCmdOperate& cmdOperate);
+    int _get_initiator_info(CCmdOperate& cmdOperate, const DAR_HOST_INFO& initiator, INITIATOR_INFO& initiator_info);
+    int _get_host_info(CCmdOperate& cmdOperate, CMDHOSTINFO_STRU& hostInfo);
+    int _get_host_by_name(CCmdOperate& cmdOperate, const string& host_name, CMDHOSTINFO_STRU& hostInfo);
+    int _get_host_ports(CCmdOperate& cmdOperate, const string& host_id, list<HOST_PORT_INFO_STRU>& lstHostPortInfo);
+    void _note_host(const CMDHOSTINFO_STRU& hostInfo);
+    void _note_initiator_added(const DAR_HOST_INFO& initiator, const CMDHOSTINFO_STRU& hostInfo);
     int execSparseHymirror(CCmdOperate &cmdOperate, string& lunId, string& hymirrorId, RESOURCE_ACCESS_E accessState);
     int changeSparseHymirrorAccessState(CCmdOperate &cmdOperate, string& hymirrorId, RESOURCE_ACCESS_E accessState);
     int execSparseConsisgr(CCmdOperate &cmdOperate, string& cgId, RESOURCE_ACCESS_E accessState);
@@ -97,10 +111,18 @@ protected:
     virtual int _read_command_para(XmlReader &reader);
     virtual void _write_response(XmlWriter &writer);
     virtual int _outband_process();
+    bool _get_command_para(XmlReader &reader, const char *para_path, CommandPara &para);
     int _get_array_info(CCmdOperate& cmdOperate);
+    int _get_sysinfo_out(CCmdOperate& cmdOperate, HYPER_STORAGE_STRU& stStorageInfo);
+    int _check_clonefs_out(CCmdOperate& cmdOperate);
+    int _check_stretched_out(CCmdOperate& cmdOperate, list<REMOTE_ARRAY_STRU>& lstStretchedInfo);
     int _get_hymirror_percent_out(CCmdOperate& cmdOperate, string& hymirror_id, string& query_percent);
     int _get_hmpair_percent_out(CCmdOperate& cmdOperate, string& hymirror_id, string& query_percent);
+    int _calc_hymirror_percent(list<HYMIRROR_LF_INFO_STRU>& lstHyMirrorLFInfo, string& hymirror_id, string& query_percent);
+    int _calc_hmpair_percent(list<HYPERMETRO_LF_INFO_STRU>& lstHMPairLFInfo, string& hymirror_id, string& query_percent);
+    list<HYMIRROR_LF_INFO_STRU> *_find_listed_hymirror(map<string, list<HYMIRROR_LF_INFO_STRU> >& mapHyMirrorLUNInfo, const string& hymirror_id);
     int setStorageInfo(HYPER_STORAGE_STRU& stStorageInfo);
+    const char *_get_log_dir() const;
 
     virtual void _write_progress(unsigned int percent);
 
@@ -122,9 +144,17 @@ protected:
 
     string strHyID;
 
+    // STARTUP_CHECK_ flags of the checks to run right after the login
+    unsigned int startup_checks;
+
 private:
     int _read_common_info(XmlReader &reader);
     int _write_error_info(XmlWriter &writer);
+    int _save_error_response();
+    void _start_array_session();
+    void _wait_array_session();
+    static ACE_THR_FUNC_RETURN _array_session_worker(void *arg);
+    void _run_startup_checks();
 
 private:
     char xmlns[LENGTH_XMLNS];
@@ -134,6 +164,34 @@ private:
     char log_level[LENGTH_COMMON]; 
 
     int error_code;
+
+    // login and system query of the array, run while the command parameters are read
+    CCmdOperate session_cmd;
+    HYPER_STORAGE_STRU session_sysinfo;
+    int session_ret;
+    int session_grp;
+    bool session_pending;
+    ACE_Thread_Manager session_mgr;
+
+    // results of the startup checks, with the g_bnfs/g_bstretch they left
+    unsigned int session_checks;
+    int session_clonefs_ret;
+    bool session_nfs;
+    int session_stretched_ret;
+    bool session_stretch;
+    list<REMOTE_ARRAY_STRU> session_stretched;
+
+    // initiators and hosts of the array, listed once per command for mapping
+    bool host_inventory_loaded;
+    map<string, INITIATOR_INFO> initiator_index;
+    map<string, CMDHOSTINFO_STRU> host_index;
+    map<string, string> host_name_index;
+    map<string, list<HOST_PORT_INFO_STRU> > host_port_index;
+
+    // host groups keyed by their sorted host ids, and the mapped lun groups
+    // keyed by object type and host ids, reused by the devices of one command
+    map<string, string> host_group_index;
+    map<string, string> lun_group_index;
 };
 
 string  NowTime();
@@ -14,6 +14,399 @@
 
 #include "sync_once.h"
 
+static void convert_group_status(int consisgr_status, string& status)
+{
+    switch(consisgr_status){
+    case MIRROR_GROUP_STATUS_NORAML:
+        status = MIRROR_GROUP_STATUS_STR_NORAML;
+        break;
+    case MIRROR_GROUP_STATUS_SYNCHRONIZING:
+        status = MIRROR_GROUP_STATUS_STR_SYNCHRONIZING;
+        break;
+    case MIRROR_GROUP_STATUS_INTERRUPTED:
+        status = MIRROR_GROUP_STATUS_STR_INTERRUPTED;
+        break;
+    case MIRROR_GROUP_STATUS_TOBERECOV:
+        status = MIRROR_GROUP_STATUS_STR_TOBERECOV;
+        break;
+    case MIRROR_GROUP_STATUS_SPLITED:
+        status = MIRROR_GROUP_STATUS_STR_SPLITED;
+        break;
+    case MIRROR_GROUP_STATUS_INVALID:
+        status = MIRROR_GROUP_STATUS_STR_INVALID;
+        break;
+    case MIRROR_GROUP_STATUS_FAULT:
+        status = MIRROR_GROUP_STATUS_STR_FAULT;
+        break;
+    case MIRROR_GROUP_STATUS_NOT_EXIST:
+        status = "--";
+        break;
+    default:
+        break;
+    }
+}
+
+static void set_sync_processing(DeviceSyncInfo& sync_info, const string& sync_id, const string& progress)
+{
+    sync_info.sync_id = sync_id;
+    sync_info.sync_status = SYNC_PROCESSING_STATUS;
+    sync_info.sync_progress = progress;
+    sync_info.sync_remainingtimeestimate = SYNC_REMAIN_TIME;
+}
+
+/*
+ Sync of one device or consistency group. run() checks the pair state and
+ starts the sync on a worker session, apply() writes the outcome into the
+ response on the calling thread, in request order. The state comes from the
+ listings taken once per command, the object itself is queried only when it
+ is missing there.
+*/
+class SyncTriggerTask : public SraTask
+{
+public:
+    SyncTriggerTask() : query_ret(RETURN_OK), triggered(false) {};
+
+    virtual int apply() = 0;
+
+protected:
+    int query_ret;
+    bool triggered;
+};
+
+class MirrorSyncTask : public SyncTriggerTask
+{
+public:
+    MirrorSyncTask(SourceDeviceInfo *device, const string& lun_id, const string& key, const string& slave_key,
+        const string& hymirror_id, const string& slave_array_sn, const string& slave_id)
+        : device(device), lun_id(lun_id), key(key), slave_key(slave_key),
+          hymirror_id(hymirror_id), slave_array_sn(slave_array_sn), slave_id(slave_id),
+          listed(false), model(0), state(0) {};
+
+    void set_listed_state(unsigned int pair_model, unsigned int pair_state)
+    {
+        listed = true;
+        model = pair_model;
+        state = pair_state;
+    }
+
+    virtual int run(CCmdOperate& cmdOperate)
+    {
+        HYMIRROR_INFO_STRU hymirrorStu;
+        hymirrorStu.strID = hymirror_id;
+
+        if (!listed){
+            query_ret = cmdOperate.CMD_showhymirrorinfo(hymirrorStu);
+            if (RETURN_OK != query_ret){
+                return query_ret;
+            }
+
+            model = hymirrorStu.uiModel;
+            state = hymirrorStu.uiState;
+        }
+
+        if (MODE_SYNCHRONOUS == model && MIRROR_STATUS_NORMAL == state){
+            return RETURN_OK;
+        }
+
+        COMMLOG(OS_LOG_INFO,"hymirror (%s) is begin sysnc.", lun_id.c_str());
+        triggered = true;
+
+        return cmdOperate.CMD_synchymirror(hymirror_id, slave_array_sn, slave_id);
+    }
+
+    virtual int apply()
+    {
+        if (RETURN_OK != query_ret){
+            COMMLOG(OS_LOG_WARN, "hymirror (%s) is failed", lun_id.c_str());
+            return RETURN_OK;
+        }
+
+        if (RETURN_OK != result){
+            device->error_info.code = OS_IToString(result);
+        }
+        else{
+            set_sync_processing(device->device_sync_info, SYNC_PREFIX + device->source_id, SYNC_PROCESSING_RATE);
+        }
+
+        COMMLOG(OS_LOG_INFO,"Replica of devices[%s] with target devices[%s] sync finish,sysncID[%s] sysnc status[%s]",
+            key.c_str(),
+            slave_key.c_str(),
+            device->device_sync_info.sync_id.c_str(),
+            device->device_sync_info.sync_status.c_str());
+        print("Replica of devices[%s] with target devices[%s] sync finish,sysncID[%s] sysnc status[%s]",
+            key.c_str(),
+            slave_key.c_str(),
+            device->device_sync_info.sync_id.c_str(),
+            device->device_sync_info.sync_status.c_str());
+
+        return RETURN_OK;
+    }
+
+private:
+    SourceDeviceInfo *device;
+    string lun_id;
+    string key;
+    string slave_key;
+    string hymirror_id;
+    string slave_array_sn;
+    string slave_id;
+    bool listed;
+    unsigned int model;
+    unsigned int state;
+};
+
+class HyperMetroSyncTask : public SyncTriggerTask
+{
+public:
+    HyperMetroSyncTask(SourceDeviceInfo *device, const string& lun_id, const string& key, const string& slave_key,
+        const string& hmpair_id)
+        : device(device), lun_id(lun_id), key(key), slave_key(slave_key), hmpair_id(hmpair_id),
+          listed(false), state(0) {};
+
+    void set_listed_state(unsigned int pair_state, int pair_progress)
+    {
+        listed = true;
+        state = pair_state;
+        progress = (0 > pair_progress) ? SYNC_COMPLETE_RATE : OS_IToString(pair_progress);
+    }
+
+    virtual int run(CCmdOperate& cmdOperate)
+    {
+        HYPERMETROPAIR_INFO_STRU hypermetroStu;
+        hypermetroStu.strID = hmpair_id;
+
+        if (!listed){
+            query_ret = cmdOperate.CMD_showhypermetroinfo(hypermetroStu);
+            if (RETURN_OK != query_ret){
+                return query_ret;
+            }
+
+            state = hypermetroStu.uiState;
+            progress = hypermetroStu.iProgress;
+        }
+
+        if (HM_STATUS_NORMAL == state || HM_STATUS_SYNCHRONIZING == state){
+            return RETURN_OK;
+        }
+
+        COMMLOG(OS_LOG_INFO,"hypermetro (%s) is begin sysnc.", lun_id.c_str());
+        triggered = true;
+
+        return cmdOperate.CMD_synchmpair(hmpair_id);
+    }
+
+    virtual int apply()
+    {
+        if (RETURN_OK != query_ret){
+            COMMLOG(OS_LOG_WARN, "HyperMetro (%s) is failed", lun_id.c_str());
+            return RETURN_OK;
+        }
+
+        if (!triggered){
+            set_sync_processing(device->device_sync_info, SYNC_PREFIX + device->source_id, progress);
+        }
+        else if (RETURN_OK != result){
+            device->error_info.code = OS_IToString(result);
+        }
+        else{
+            set_sync_processing(device->device_sync_info, SYNC_PREFIX + device->source_id, SYNC_PROCESSING_RATE);
+        }
+
+        COMMLOG(OS_LOG_INFO,"Hypermetro of devices[%s] with target devices[%s] sync finish,sysncID[%s] sysnc status[%s]",
+            key.c_str(),
+            slave_key.c_str(),
+            device->device_sync_info.sync_id.c_str(),
+            device->device_sync_info.sync_status.c_str());
+        print("Hypermetro of devices[%s] with target devices[%s] sync finish,sysncID[%s] sysnc status[%s]",
+            key.c_str(),
+            slave_key.c_str(),
+            device->device_sync_info.sync_id.c_str(),
+            device->device_sync_info.sync_status.c_str());
+
+        return RETURN_OK;
+    }
+
+private:
+    SourceDeviceInfo *device;
+    string lun_id;
+    string key;
+    string slave_key;
+    string hmpair_id;
+    bool listed;
+    unsigned int state;
+    string progress;
+};
+
+/*
+ A failed state query of a consistency group fails the whole command, as
+ it did before the groups were synced concurrently. When the listed pairs
+ do not tell whether a replication group holds file systems, the worker
+ asks the array for the file system itself.
+*/
+class ConsistGrSyncTask : public SyncTriggerTask
+{
+public:
+    ConsistGrSyncTask(ConGroupInfo *cg, const string& cg_id, const string& lun_id, bool hypermetro)
+        : cg(cg), cg_id(cg_id), lun_id(lun_id), hypermetro(hypermetro), nfs(false), nfs_known(hypermetro),
+          listed(false), consisgr_status(0), model(0) {};
+
+    void set_nfs(bool is_nfs)
+    {
+        nfs = is_nfs;
+        nfs_known = true;
+    }
+
+    void set_listed_state(const GROUP_INFO_STRU& rstGroupInfo)
+    {
+        listed = true;
+        consisgr_status = (int)rstGroupInfo.uiState;
+        model = rstGroupInfo.uiModel;
+    }
+
+    virtual int run(CCmdOperate& cmdOperate)
+    {
+        GROUP_INFO_STRU rstGroupInfo;
+        VSTORE_PAIR_INFO_STRU vstorePairInfo;
+
+        if (!nfs_known){
+            FS_INFO_STRU fs_info;
+            fs_info.strID = lun_id;
+            nfs = (RETURN_OK == cmdOperate.CMD_showfs(fs_info));
+        }
+
+        rstGroupInfo.strID = cg_id;
+        if (hypermetro){
+            if (!listed){
+                query_ret = cmdOperate.CMD_showconsistgrhminfo(rstGroupInfo);
+                consisgr_status = (int)rstGroupInfo.uiState;
+            }
+        }
+        else if (nfs){
+            query_ret = cmdOperate.CMD_showvstorepair_info(cg_id, vstorePairInfo);
+            consisgr_status = (int)vstorePairInfo.uiState;
+            model = MODE_ASYNCHRONOUS;
+        }
+        else if (!listed){
+            query_ret = cmdOperate.CMD_showconsistgrinfo(rstGroupInfo);
+            consisgr_status = (int)rstGroupInfo.uiState;
+            model = rstGroupInfo.uiModel;
+        }
+
+        if (RETURN_OK != query_ret){
+            return query_ret;
+        }
+
+        if (MIRROR_GROUP_STATUS_SYNCHRONIZING == consisgr_status){
+            return RETURN_OK;
+        }
+
+        if (MIRROR_GROUP_STATUS_NORAML == consisgr_status && (hypermetro || MODE_SYNCHRONOUS == model)){
+            return RETURN_OK;
+        }
+
+        COMMLOG(OS_LOG_INFO, "consist group(%s) is begin sync.", cg_id.c_str());
+        triggered = true;
+
+        if (hypermetro){
+            return cmdOperate.CMD_syncconsistgrhm(cg_id);
+        }
+
+        if (nfs){
+            return cmdOperate.CMD_syncvstorepair(cg_id);
+        }
+
+        return cmdOperate.CMD_syncconsistgr(cg_id);
+    }
+
+    virtual int apply()
+    {
+        string status;
+        string sync_id;
+        const char *kind = hypermetro ? "Hypermetro" : "Replica";
+
+        if (RETURN_OK != query_ret){
+            COMMLOG(OS_LOG_ERROR, "query state of consist group(%s) fail(%d).", cg_id.c_str(), query_ret);
+            return query_ret;
+        }
+
+        sync_id = SYNC_PREFIX + lun_id + "_" + (hypermetro ? HYPERMETRO_LUN_CONSISTENT_TAG : MIRROR_LUN_CONSISTENT_TAG) + "_" + cg_id;
+
+        convert_group_status(consisgr_status, status);
+        COMMLOG(OS_LOG_INFO,"%s of ConsistencyGroup[%s] with GroupID[%s] has status[%s]",
+            kind,
+            cg->lun_id.c_str(),
+            cg_id.c_str(),
+            status.c_str());
+        print("%s of ConsistencyGroup[%s] with GroupID[%s] has status[%s]",
+            kind,
+            cg->lun_id.c_str(),
+            cg_id.c_str(),
+            status.c_str());
+
+        if (MIRROR_GROUP_STATUS_SYNCHRONIZING == consisgr_status){
+            WarnInfo warninfo;
+            cg->device_sync_info.sync_id = sync_id;
+            warninfo.code = OS_IToString(WARN_REPLICATION_IS_PROCESSING);
+            cg->warnings.lst_warn.push_back(warninfo);
+            COMMLOG(OS_LOG_WARN, "Consisttentgroup(%s) is Synchronizing", cg_id.c_str());
+            return RETURN_OK;
+        }
+
+        if (!triggered){
+            COMMLOG(OS_LOG_INFO,"%s group(%s) is sync and normal.", kind, cg_id.c_str());
+            print("%s group(%s) is sync and normal.", kind, cg_id.c_str());
+            if (hypermetro){
+                cg->device_sync_info.sync_id = sync_id;
+                cg->device_sync_info.sync_status = COMPLETE_STATUS;
+                cg->device_sync_info.sync_progress = SYNC_COMPLETE_RATE;
+                cg->device_sync_info.sync_remainingtimeestimate = "0";
+            }
+            else{
+                set_sync_processing(cg->device_sync_info, sync_id, SYNC_PROCESSING_RATE);
+            }
+            return RETURN_OK;
+        }
+
+        if (RETURN_OK != result){
+            cg->error_info.code = OS_IToString(result);
+            COMMLOG(OS_LOG_ERROR,"%s of ConsistencyGroup[%s] with GroupID[%s] sync err [%s]",
+                kind,
+                cg->lun_id.c_str(),
+                cg_id.c_str(),
+                cg->error_info.code.c_str());
+            return RETURN_OK;
+        }
+
+        set_sync_processing(cg->device_sync_info, sync_id, SYNC_PROCESSING_RATE);
+
+        COMMLOG(OS_LOG_INFO,"%s of ConsistencyGroup[%s] with GroupID[%s] sync finish,syncID[%s] sync status[%s]",
+            kind,
+            cg->lun_id.c_str(),
+            cg_id.c_str(),
+            cg->device_sync_info.sync_id.c_str(),
+            cg->device_sync_info.sync_status.c_str());
+        print("%s of ConsistencyGroup[%s] with GroupID[%s] sync finish,syncID[%s] sync status[%s]",
+            kind,
+            cg->lun_id.c_str(),
+            cg_id.c_str(),
+            cg->device_sync_info.sync_id.c_str(),
+            cg->device_sync_info.sync_status.c_str());
+
+        return RETURN_OK;
+    }
+
+private:
+    ConGroupInfo *cg;
+    string cg_id;
+    string lun_id;
+    bool hypermetro;
+    bool nfs;
+    bool nfs_known;
+    bool listed;
+    int consisgr_status;
+    unsigned int model;
+};
+
 int sync_once(XmlReader &reader)
 {
     SyncOnce so;
@@ -46,52 +439,37 @@ SyncOnce::~SyncOnce()
 
 int SyncOnce::_read_command_para(XmlReader &reader)
 {
-    CHECK_FALSE(reader.get_string("/Command/SyncOnceParameters/ArrayId", array_id, 0), RETURN_ERR);
-    CHECK_FALSE(reader.get_string("/Command/SyncOnceParameters/ArrayId", input_array_id, 0), RETURN_ERR);
-    CHECK_FALSE(reader.get_string("/Command/SyncOnceParameters/PeerArrayId", peer_array_id, 0), RETURN_ERR);
+    CHECK_FALSE(reader.get_cstring("/Command/SyncOnceParameters/ArrayId", array_id), RETURN_ERR);
+    CHECK_FALSE(reader.get_cstring("/Command/SyncOnceParameters/ArrayId", input_array_id), RETURN_ERR);
+    CHECK_FALSE(reader.get_cstring("/Command/SyncOnceParameters/PeerArrayId", peer_array_id), RETURN_ERR);
 
-    char sync_obj_id[LENGTH_COMMON] = {0};
-    int consistgr_count = 0;
-    int mirror_count = 0;
-    int index = 0;
+    CommandPara para;
+    list<ConGroupInfo>::iterator itGroup;
 
-    consistgr_count = reader.get_count("/Command/SyncOnceParameters/ConsistencyGroups/ConsistencyGroup");
-    for (index = 0; index < consistgr_count; ++index){
-        
+    CHECK_FALSE(_get_command_para(reader, "/Command/SyncOnceParameters", para), RETURN_ERR);
+    if (para.is_key_missing()){
+        COMMLOG(OS_LOG_ERROR, "%s", "a consistency group or source device has no id.");
+        return ERROR_INTERNAL_PROCESS_FAIL;
+    }
+
+    for (itGroup = para.cons_groups.begin(); itGroup != para.cons_groups.end(); ++itGroup){
         list<string> lst_token;
-        string cgid;
-        string lun_id;
-        
-        memset_s(sync_obj_id, sizeof(sync_obj_id), 0, sizeof(sync_obj_id));
-        CHECK_FALSE(reader.get_string("/Command/SyncOnceParameters/ConsistencyGroups/ConsistencyGroup/@id", sync_obj_id, index), ERROR_INTERNAL_PROCESS_FAIL);
 
-        ConGroupInfo cg;
-        
-        COMMLOG(OS_LOG_INFO, "_read_command_para sync_obj_id %s", sync_obj_id);
-        print("_read_command_para sync_obj_id %s", sync_obj_id);
-        OS_StrToken(sync_obj_id, "_", &lst_token);
+        COMMLOG(OS_LOG_INFO, "_read_command_para sync_obj_id %s", itGroup->cg_id.c_str());
+        print("_read_command_para sync_obj_id %s", itGroup->cg_id.c_str());
+        OS_StrToken(itGroup->cg_id, "_", &lst_token);
         if (lst_token.empty()){
-            COMMLOG(OS_LOG_ERROR, "OS_StrToken result of sync_obj_id %s is empty", sync_obj_id);
+            COMMLOG(OS_LOG_ERROR, "OS_StrToken result of sync_obj_id %s is empty", itGroup->cg_id.c_str());
             continue;
         }
 
-        cg.cg_id = sync_obj_id;
-        cg.lun_id = lst_token.back();
-        
-        consisgrs_info.lst_groups_info.push_back(cg);
-    }
-
-    mirror_count = reader.get_count("/Command/SyncOnceParameters/SourceDevices/SourceDevice");
-    for (index = 0; index < mirror_count; ++index){
-        memset_s(sync_obj_id, sizeof(sync_obj_id), 0, sizeof(sync_obj_id));
-        CHECK_FALSE(reader.get_string("/Command/SyncOnceParameters/SourceDevices/SourceDevice/@id", sync_obj_id, index), ERROR_INTERNAL_PROCESS_FAIL);
-
-        SourceDeviceInfo sd;
-        sd.source_id = string(sync_obj_id);
-        devices_info.lst_source_devices.push_back(sd);
+        itGroup->lun_id = lst_token.back();
 
+        consisgrs_info.lst_groups_info.push_back(*itGroup);
     }
 
+    devices_info.lst_source_devices.swap(para.source_devices);
+
     return RETURN_OK;
 }
 
@@ -148,32 +526,134 @@ int SyncOnce::_outband_process()
     ret = check_array_id_validate_out(cmdOperate, array_id_temp, string(peer_array_id));
     CHECK_UNEQ(RETURN_OK, ret);  
 
+    TaskPool pool(stStorageInfo);
+
+    _load_pair_listing_out(cmdOperate);
+    _queue_sync_out(cmdOperate, pool);
+
+    return _run_sync_out(cmdOperate, pool);
+}
+
+void SyncOnce::_load_pair_listing_out(CCmdOperate& cmdOperate)
+{
+    int ret = RETURN_ERR;
+    list<GROUP_INFO_STRU> lstGroupInfo;
+    list<GROUP_INFO_STRU>::iterator itGroupInfo;
+    map<string, list<HYMIRROR_LF_INFO_STRU> >::iterator itHyMirror;
+
+    hymirror_lun_info.clear();
+    hmpair_lun_info.clear();
+    consistgr_info.clear();
+    consistgrhm_info.clear();
+    listed_fs_ids.clear();
+    listed_lun_ids.clear();
+
+    if (devices_info.lst_source_devices.empty() && consisgrs_info.lst_groups_info.empty()){
+        return;
+    }
+
+    ret = cmdOperate.CMD_showhymirrorlun_all(hymirror_lun_info);
+    if (RETURN_OK != ret){
+        COMMLOG(OS_LOG_WARN, "list replication pairs fail(%d), query them one by one.", ret);
+        hymirror_lun_info.clear();
+    }
+
+    for (itHyMirror = hymirror_lun_info.begin(); itHyMirror != hymirror_lun_info.end(); ++itHyMirror){
+        if (itHyMirror->second.empty()){
+            continue;
+        }
+
+        if (OBJ_FILESYSTEM == itHyMirror->second.front().uilocalResType){
+            listed_fs_ids.insert(itHyMirror->second.front().strID);
+        }
+        else if (OBJ_LUN == itHyMirror->second.front().uilocalResType){
+            listed_lun_ids.insert(itHyMirror->second.front().strID);
+        }
+    }
+
+    if (g_bstretch && !devices_info.lst_source_devices.empty()){
+        ret = cmdOperate.CMD_showhypermetrolun_all(hmpair_lun_info);
+        if (RETURN_OK != ret){
+            COMMLOG(OS_LOG_WARN, "list hypermetro pairs fail(%d), query them one by one.", ret);
+            hmpair_lun_info.clear();
+        }
+    }
+
+    if (g_bFusionStorage || consisgrs_info.lst_groups_info.empty()){
+        return;
+    }
+
+    ret = cmdOperate.CMD_showconsistgrinfo(lstGroupInfo);
+    if (RETURN_OK != ret){
+        COMMLOG(OS_LOG_WARN, "list consist groups fail(%d), query them one by one.", ret);
+        lstGroupInfo.clear();
+    }
+
+    for (itGroupInfo = lstGroupInfo.begin(); itGroupInfo != lstGroupInfo.end(); ++itGroupInfo){
+        consistgr_info[itGroupInfo->strID] = *itGroupInfo;
+    }
+
+    if (!g_bstretch){
+        return;
+    }
+
+    lstGroupInfo.clear();
+    ret = cmdOperate.CMD_showconsistgrhminfo(lstGroupInfo);
+    if (RETURN_OK != ret){
+        COMMLOG(OS_LOG_WARN, "list hypermetro consist groups fail(%d), query them one by one.", ret);
+        return;
+    }
+
+    for (itGroupInfo = lstGroupInfo.begin(); itGroupInfo != lstGroupInfo.end(); ++itGroupInfo){
+        consistgrhm_info[itGroupInfo->strID] = *itGroupInfo;
+    }
+
+    return;
+}
+
+void SyncOnce::_queue_sync_out(CCmdOperate& cmdOperate, TaskPool& pool)
+{
     
-    (void)_sync_mirror_out(cmdOperate);
+    (void)_sync_mirror_out(cmdOperate, pool);
 
     if (g_bFusionStorage && !g_testFusionStorageStretch){
-        return RETURN_OK;
+        return;
     }
  
     
     if (g_bstretch){
-        (void)_sync_hypermetro_out(cmdOperate);
+        (void)_sync_hypermetro_out(cmdOperate, pool);
     }
 
     if (g_bFusionStorage){
-        return RETURN_OK;
+        return;
     }
 
     
-    ret = _sync_consistgroup_out(cmdOperate);
-    CHECK_UNEQ(RETURN_OK, ret);
+    (void)_sync_consistgroup_out(cmdOperate, pool);
     
     if (g_bstretch){
-        ret = _sync_consistgrouphm_out(cmdOperate);
-        CHECK_UNEQ(RETURN_OK, ret);
+        (void)_sync_consistgrouphm_out(cmdOperate, pool);
     }
 
-    return RETURN_OK;
+    return;
+}
+
+int SyncOnce::_run_sync_out(CCmdOperate& cmdOperate, TaskPool& pool)
+{
+    int ret = RETURN_OK;
+    int apply_ret = RETURN_OK;
+
+    pool.run(cmdOperate);
+
+    for (size_t i = 0; i < pool.size(); i++){
+        apply_ret = static_cast<SyncTriggerTask *>(pool.at(i))->apply();
+        if (RETURN_OK == ret && RETURN_OK != apply_ret){
+            ret = apply_ret;
+        }
+    }
+
+    return ret;
 }
 
 void SyncOnce::_write_response(XmlWriter &writer)
@@ -184,21 +664,19 @@ void SyncOnce::_write_response(XmlWriter &writer)
     return;
 }
 
-int SyncOnce::_sync_consistgroup_out(CCmdOperate& cmdoperate)
+int SyncOnce::_sync_consistgroup_out(CCmdOperate& cmdoperate, TaskPool& pool)
 {
     int ret = RETURN_ERR;
     list<ConGroupInfo>::iterator it;
-    int consisgr_status;
-    string desc;
-    string cmd;
     string cg_id;
     string arrayid;
     string lun_id;
     string lun_flag;
-    GROUP_INFO_STRU rstGroupInfo;
-    VSTORE_PAIR_INFO_STRU vstorePairInfo;
-    unsigned int model;
+    bool in_fs = false;
+    bool in_lun = false;
+    map<string, GROUP_INFO_STRU>::iterator itGroupInfo;
 
+    (void)cmdoperate;
     it = consisgrs_info.lst_groups_info.begin();
 
     while (it != consisgrs_info.lst_groups_info.end()){
@@ -226,139 +704,37 @@ int SyncOnce::_sync_consistgroup_out(CCmdOperate& cmdoperate)
             continue;
         }
 
-        is_Fs_by_lun(cmdoperate, lun_id);
-        if (isNFS){
-            ret = cmdoperate.CMD_showvstorepair_info(cg_id, vstorePairInfo);
-            CHECK_UNEQ(RETURN_OK, ret);
-            consisgr_status = (int)vstorePairInfo.uiState;
-            model = MODE_ASYNCHRONOUS;
-        }
-        else{
-            
-            rstGroupInfo.strID = cg_id;
-            ret = cmdoperate.CMD_showconsistgrinfo(rstGroupInfo);
-            CHECK_UNEQ(RETURN_OK, ret);
+        ConsistGrSyncTask *task = new ConsistGrSyncTask(&(*it), cg_id, lun_id, false);
 
-            consisgr_status = (int)rstGroupInfo.uiState;
-            model = rstGroupInfo.uiModel;
+        /* a member listed on one kind of pair only tells the kind of the group, otherwise the worker asks */
+        in_fs = (listed_fs_ids.end() != listed_fs_ids.find(lun_id));
+        in_lun = (listed_lun_ids.end() != listed_lun_ids.find(lun_id));
+        if (in_fs != in_lun){
+            task->set_nfs(in_fs);
         }
-        
-        string status;
-        switch(consisgr_status){
-        case MIRROR_GROUP_STATUS_NORAML:
-            status = MIRROR_GROUP_STATUS_STR_NORAML;
-            break;
-        case MIRROR_GROUP_STATUS_SYNCHRONIZING:
-            status = MIRROR_GROUP_STATUS_STR_SYNCHRONIZING;
-            break;
-        case MIRROR_GROUP_STATUS_INTERRUPTED:
-            status = MIRROR_GROUP_STATUS_STR_INTERRUPTED;
-            break;
-        case MIRROR_GROUP_STATUS_TOBERECOV:
-            status = MIRROR_GROUP_STATUS_STR_TOBERECOV;
-            break;
-        case MIRROR_GROUP_STATUS_SPLITED:
-            status = MIRROR_GROUP_STATUS_STR_SPLITED;
-            break;
-        case MIRROR_GROUP_STATUS_INVALID:
-            status = MIRROR_GROUP_STATUS_STR_INVALID;
-            break;
-        case MIRROR_GROUP_STATUS_FAULT:
-            status = MIRROR_GROUP_STATUS_STR_FAULT;
-            break;
-        case MIRROR_GROUP_STATUS_NOT_EXIST:
-            status = "--";
-            break;
-        default:
-            break;
-        }
-        COMMLOG(OS_LOG_INFO,"Replica of ConsistencyGroup[%s] with GroupID[%s] has status[%s]",
-            it->lun_id.c_str(),
-            cg_id.c_str(),
-            status.c_str());
-        print("Replica of ConsistencyGroup[%s] with GroupID[%s] has status[%s]",
-            it->lun_id.c_str(),
-            cg_id.c_str(),
-            status.c_str());
 
-        if (MIRROR_GROUP_STATUS_SYNCHRONIZING == consisgr_status){
-            WarnInfo warninfo;
-            it->device_sync_info.sync_id = SYNC_PREFIX + lun_id + "_" + MIRROR_LUN_CONSISTENT_TAG + "_" + cg_id;
-            warninfo.code = OS_IToString(WARN_REPLICATION_IS_PROCESSING);
-            it->warnings.lst_warn.push_back(warninfo); 
-            COMMLOG(OS_LOG_WARN, "Consisttentgroup(%s) is Synchronizing", cg_id.c_str());
-            ++it;
-            continue;
+        itGroupInfo = consistgr_info.find(cg_id);
+        if (consistgr_info.end() != itGroupInfo){
+            task->set_listed_state(itGroupInfo->second);
         }
 
-        
-        if (MODE_SYNCHRONOUS == model && MIRROR_GROUP_STATUS_NORAML == consisgr_status){
-            COMMLOG(OS_LOG_INFO,"consist group(%s) is sync and normal.", cg_id.c_str());
-            print("consist group(%s) is sync and normal.", cg_id.c_str());
-            it->device_sync_info.sync_id = SYNC_PREFIX + lun_id + "_" + MIRROR_LUN_CONSISTENT_TAG + "_" + cg_id;
-            it->device_sync_info.sync_status = SYNC_PROCESSING_STATUS;
-            it->device_sync_info.sync_progress = SYNC_PROCESSING_RATE;
-            it->device_sync_info.sync_remainingtimeestimate = SYNC_REMAIN_TIME;
-            ++it;
-            continue;
-        }
-        
-        COMMLOG(OS_LOG_INFO,"Replica of ConsistencyGroup[%s] with GroupID[%s] begin sync",
-            it->lun_id.c_str(),
-            cg_id.c_str());
-        print("Replica of ConsistencyGroup[%s] with GroupID[%s] begin sync",
-            it->lun_id.c_str(),
-            cg_id.c_str());
-
-        if(isNFS){
-            ret = cmdoperate.CMD_syncvstorepair(cg_id);
-        }
-        else{
-            ret = cmdoperate.CMD_syncconsistgr(cg_id);
-        }
-        if (RETURN_OK != ret){
-            it->error_info.code = OS_IToString(ret);
-            COMMLOG(OS_LOG_ERROR,"Replica of ConsistencyGroup[%s] with GroupID[%s] sync err [%s]",
-                it->lun_id.c_str(),
-                cg_id.c_str(),
-                it->error_info.code.c_str());
-            ++it;
-            continue;
-        }
-        else{
-            it->device_sync_info.sync_id = SYNC_PREFIX + lun_id + "_" + MIRROR_LUN_CONSISTENT_TAG + "_" + cg_id;
-            it->device_sync_info.sync_status = SYNC_PROCESSING_STATUS;
-            it->device_sync_info.sync_progress = SYNC_PROCESSING_RATE;
-            it->device_sync_info.sync_remainingtimeestimate = SYNC_REMAIN_TIME;
-        }
-        
-        COMMLOG(OS_LOG_INFO,"Replica of ConsistencyGroup[%s] with GroupID[%s] sync finish,syncID[%s] sync status[%s]",
-            it->lun_id.c_str(),
-            cg_id.c_str(),
-            it->device_sync_info.sync_id.c_str(),
-            it->device_sync_info.sync_status.c_str());
-        print("Replica of ConsistencyGroup[%s] with GroupID[%s] sync finish,syncID[%s] sync status[%s]",
-            it->lun_id.c_str(),
-            cg_id.c_str(),
-            it->device_sync_info.sync_id.c_str(),
-            it->device_sync_info.sync_status.c_str());
+        pool.add(task);
         ++it;
     }
     return RETURN_OK;
 }
 
-int SyncOnce::_sync_consistgrouphm_out(CCmdOperate& cmdoperate)
+int SyncOnce::_sync_consistgrouphm_out(CCmdOperate& cmdoperate, TaskPool& pool)
 {
     int ret = RETURN_ERR;
     list<ConGroupInfo>::iterator it;
-    int consisgr_status;
-    string desc;
-    string cmd;
     string cg_id;
     string arrayid;
     string lun_id;
     string lun_flag;
+    map<string, GROUP_INFO_STRU>::iterator itGroupInfo;
 
+    (void)cmdoperate;
     it = consisgrs_info.lst_groups_info.begin();
 
     while (it != consisgrs_info.lst_groups_info.end()){
@@ -386,127 +762,34 @@ int SyncOnce::_sync_consistgrouphm_out(CCmdOperate& cmdoperate)
             continue;
         }
 
-        
-        GROUP_INFO_STRU rstGroupInfo;
-        rstGroupInfo.strID = cg_id;
-        ret = cmdoperate.CMD_showconsistgrhminfo(rstGroupInfo);
-        CHECK_UNEQ(RETURN_OK, ret);
-
-        consisgr_status = (int)rstGroupInfo.uiState;
-        
-        string status;
-        switch(consisgr_status){
-        case MIRROR_GROUP_STATUS_NORAML:
-            status = MIRROR_GROUP_STATUS_STR_NORAML;
-            break;
-        case MIRROR_GROUP_STATUS_SYNCHRONIZING:
-            status = MIRROR_GROUP_STATUS_STR_SYNCHRONIZING;
-            break;
-        case MIRROR_GROUP_STATUS_INTERRUPTED:
-            status = MIRROR_GROUP_STATUS_STR_INTERRUPTED;
-            break;
-        case MIRROR_GROUP_STATUS_TOBERECOV:
-            status = MIRROR_GROUP_STATUS_STR_TOBERECOV;
-            break;
-        case MIRROR_GROUP_STATUS_SPLITED:
-            status = MIRROR_GROUP_STATUS_STR_SPLITED;
-            break;
-        case MIRROR_GROUP_STATUS_INVALID:
-            status = MIRROR_GROUP_STATUS_STR_INVALID;
-            break;
-        case MIRROR_GROUP_STATUS_FAULT:
-            status = MIRROR_GROUP_STATUS_STR_FAULT;
-            break;
-        case MIRROR_GROUP_STATUS_NOT_EXIST:
-            status = "--";
-            break;
-        default:
-            break;
-        }
-        COMMLOG(OS_LOG_INFO,"Hypermetro of ConsistencyGroup[%s] with GroupID[%s] has status[%s]",
-            it->lun_id.c_str(),
-            cg_id.c_str(),
-            status.c_str());
-        print("Hypermetro of ConsistencyGroup[%s] with GroupID[%s] has status[%s]",
-            it->lun_id.c_str(),
-            cg_id.c_str(),
-            status.c_str());
-
-        if (MIRROR_GROUP_STATUS_SYNCHRONIZING == consisgr_status){
-            WarnInfo warninfo;
-            it->device_sync_info.sync_id = SYNC_PREFIX + lun_id + "_" + HYPERMETRO_LUN_CONSISTENT_TAG + "_" + cg_id;
-            warninfo.code = OS_IToString(WARN_REPLICATION_IS_PROCESSING);
-            it->warnings.lst_warn.push_back(warninfo); 
-            COMMLOG(OS_LOG_WARN, "hmdomain(%s) is Synchronizing", cg_id.c_str());
-            ++it;
-            continue;
-        }
-
-        
-        if (MIRROR_GROUP_STATUS_NORAML == consisgr_status){
-            COMMLOG(OS_LOG_INFO,"Hypermetro group(%s) is sync and normal.", cg_id.c_str());
-            print("Hypermetro group(%s) is sync and normal.", cg_id.c_str());
-            it->device_sync_info.sync_id = SYNC_PREFIX + lun_id + "_" + HYPERMETRO_LUN_CONSISTENT_TAG + "_" + cg_id;
-            it->device_sync_info.sync_status = COMPLETE_STATUS;
-            it->device_sync_info.sync_progress = SYNC_COMPLETE_RATE;
-            it->device_sync_info.sync_remainingtimeestimate = "0";
-            ++it;
-            continue;
-        }
-        
-        COMMLOG(OS_LOG_INFO,"Hypermetro of ConsistencyGroup[%s] with GroupID[%s] begin sync",
-            it->lun_id.c_str(),
-            cg_id.c_str());
-        print("Hypermetro of ConsistencyGroup[%s] with GroupID[%s] begin sync",
-            it->lun_id.c_str(),
-            cg_id.c_str());
-        ret = cmdoperate.CMD_syncconsistgrhm(cg_id);
-        if (RETURN_OK != ret){
-            it->error_info.code = OS_IToString(ret);
-            COMMLOG(OS_LOG_ERROR,"Hypermetro of ConsistencyGroup[%s] with GroupID[%s] sync err [%s]",
-                it->lun_id.c_str(),
-                cg_id.c_str(),
-                it->error_info.code.c_str());
-            ++it;
-            continue;
-        }
-        else{
-            it->device_sync_info.sync_id = SYNC_PREFIX + lun_id + "_" + HYPERMETRO_LUN_CONSISTENT_TAG + "_" + cg_id;
-            it->device_sync_info.sync_status = SYNC_PROCESSING_STATUS;
-            it->device_sync_info.sync_progress = SYNC_PROCESSING_RATE;
-            it->device_sync_info.sync_remainingtimeestimate = SYNC_REMAIN_TIME;
+        ConsistGrSyncTask *task = new ConsistGrSyncTask(&(*it), cg_id, lun_id, true);
+        itGroupInfo = consistgrhm_info.find(cg_id);
+        if (consistgrhm_info.end() != itGroupInfo){
+            task->set_listed_state(itGroupInfo->second);
         }
 
-        
-        COMMLOG(OS_LOG_INFO,"Hypermetro of ConsistencyGroup[%s] with GroupID[%s] sync finish,syncID[%s] sync status[%s]",
-            it->lun_id.c_str(),
-            cg_id.c_str(),
-            it->device_sync_info.sync_id.c_str(),
-            it->device_sync_info.sync_status.c_str());
-        print("Hypermetro of ConsistencyGroup[%s] with GroupID[%s] sync finish,syncID[%s] sync status[%s]",
-            it->lun_id.c_str(),
-            cg_id.c_str(),
-            it->device_sync_info.sync_id.c_str(),
-            it->device_sync_info.sync_status.c_str());
+        pool.add(task);
         ++it;
     }
     return RETURN_OK;
 }
 
-int SyncOnce::_sync_mirror_out(CCmdOperate& cmdOperate)
+int SyncOnce::_sync_mirror_out(CCmdOperate& cmdOperate, TaskPool& pool)
 {
     int ret = RETURN_ERR;
     string slave_array_sn;
     string slave_id;
     string pair_status;
     list<SourceDeviceInfo>::iterator it;
-    string desc;
     string strid;
     string hymirror_id;
     string arrayid;
     string lun_flag;
     list<HYMIRROR_LF_INFO_STRU> lstHyMirrorLFInfo;
+    list<HYMIRROR_LF_INFO_STRU> *lstListedInfo = NULL;
     list<HYMIRROR_LF_INFO_STRU>::iterator itHyMirrorLF;
+    unsigned int pair_model = 0;
+    unsigned int pair_state = 0;
     string key;
 
     it = devices_info.lst_source_devices.begin();
@@ -533,12 +816,20 @@ int SyncOnce::_sync_mirror_out(CCmdOperate& cmdOperate)
         }
 
         
-        is_Fs_by_lun(cmdOperate, strid);
-        if (isNFS){
-            ret = cmdOperate.CMD_showhymirrorbyfs(strid,lstHyMirrorLFInfo);
-        } 
+        lstListedInfo = _find_listed_hymirror(hymirror_lun_info, hymirror_id);
+        if (NULL != lstListedInfo){
+            isNFS = false;
+            lstHyMirrorLFInfo = *lstListedInfo;
+            ret = RETURN_OK;
+        }
         else{
-            ret = cmdOperate.CMD_showhymirrorlun_all(hymirror_id,lstHyMirrorLFInfo);
+            is_Fs_by_lun(cmdOperate, strid);
+            if (isNFS){
+                ret = cmdOperate.CMD_showhymirrorbyfs(strid,lstHyMirrorLFInfo);
+            } 
+            else{
+                ret = cmdOperate.CMD_showhymirrorlun_all(hymirror_id,lstHyMirrorLFInfo);
+            }
         }
         if (RETURN_OK != ret){
             it->error_info.code = OS_IToString(ret);
@@ -550,6 +841,8 @@ int SyncOnce::_sync_mirror_out(CCmdOperate& cmdOperate)
             if (MIRROR_LUN_RELATION_SLAVE == itHyMirrorLF->uiRelationType){
                 slave_array_sn = itHyMirrorLF->strArrayWWN;
                 slave_id   = itHyMirrorLF->strID;
+                pair_model = itHyMirrorLF->uiModel;
+                pair_state = itHyMirrorLF->uiPairStatus;
                 _convert_pair_status(itHyMirrorLF->uiPairStatus,pair_status);
             }
             if (MIRROR_LUN_RELATION_MASTER == itHyMirrorLF->uiRelationType && isNFS){
@@ -588,55 +881,19 @@ int SyncOnce::_sync_mirror_out(CCmdOperate& cmdOperate)
             continue;
         }
 
-        HYMIRROR_INFO_STRU hymirrorStu;
-        hymirrorStu.strID = hymirror_id;
-        
-        
         COMMLOG(OS_LOG_INFO,"Replica of devices[%s] with target devices[%s]  being sync",
             key.c_str(),
             slave_key.c_str());
         print("Replica of devices[%s] with target devices[%s]  being sync",
             key.c_str(),
             slave_key.c_str());
-        ret = cmdOperate.CMD_showhymirrorinfo(hymirrorStu);
-        if (RETURN_OK != ret){
-            COMMLOG(OS_LOG_WARN, "hymirror (%s) is failed", strid.c_str());
-            ++it;
-            continue;
-        }
 
-        
-        if (MODE_SYNCHRONOUS == hymirrorStu.uiModel && MIRROR_STATUS_NORMAL == hymirrorStu.uiState){
-            it->device_sync_info.sync_id = SYNC_PREFIX + it->source_id;
-            it->device_sync_info.sync_status = SYNC_PROCESSING_STATUS;
-            it->device_sync_info.sync_progress = SYNC_PROCESSING_RATE;
-            it->device_sync_info.sync_remainingtimeestimate = SYNC_REMAIN_TIME;
+        MirrorSyncTask *task = new MirrorSyncTask(&(*it), strid, key, slave_key, hymirror_id, slave_array_sn, slave_id);
+        if (NULL != lstListedInfo){
+            task->set_listed_state(pair_model, pair_state);
         }
-        else{
-            COMMLOG(OS_LOG_INFO,"hymirror (%s) is begin sysnc.",strid.c_str());
-            print("hymirror (%s) is begin sysnc.",strid.c_str());
-            ret = cmdOperate.CMD_synchymirror(hymirror_id,slave_array_sn,slave_id);
-            if (RETURN_OK != ret){
-                it->error_info.code = OS_IToString(ret);
-            }
-            else{
-                it->device_sync_info.sync_id = SYNC_PREFIX + it->source_id;
-                it->device_sync_info.sync_status = SYNC_PROCESSING_STATUS;
-                it->device_sync_info.sync_progress = SYNC_PROCESSING_RATE;
-                it->device_sync_info.sync_remainingtimeestimate = SYNC_REMAIN_TIME;
-            }
-        }
-        
-        COMMLOG(OS_LOG_INFO,"Replica of devices[%s] with target devices[%s] sync finish,sysncID[%s] sysnc status[%s]",
-            key.c_str(),
-            slave_key.c_str(),
-            it->device_sync_info.sync_id.c_str(),
-            it->device_sync_info.sync_status.c_str());
-        print("Replica of devices[%s] with target devices[%s] sync finish,sysncID[%s] sysnc status[%s]",
-            key.c_str(),
-            slave_key.c_str(),
-            it->device_sync_info.sync_id.c_str(),
-            it->device_sync_info.sync_status.c_str());
+
+        pool.add(task);
         ++it;
     }
 
@@ -644,7 +901,7 @@ int SyncOnce::_sync_mirror_out(CCmdOperate& cmdOperate)
 
 }
 
-int SyncOnce::_sync_hypermetro_out(CCmdOperate& cmdOperate)
+int SyncOnce::_sync_hypermetro_out(CCmdOperate& cmdOperate, TaskPool& pool)
 {
     int ret = RETURN_ERR;
     string slave_array_sn;
@@ -658,6 +915,9 @@ int SyncOnce::_sync_hypermetro_out(CCmdOperate& cmdOperate)
     string lun_flag;
     list<HYPERMETRO_LF_INFO_STRU> lstHMPairLFInfo;
     list<HYPERMETRO_LF_INFO_STRU>::iterator itHMPairLF;
+    map<string, list<HYPERMETRO_LF_INFO_STRU> >::iterator itListedInfo;
+    unsigned int pair_state = 0;
+    int pair_progress = 0;
     string key;
 
     it = devices_info.lst_source_devices.begin();
@@ -683,7 +943,14 @@ int SyncOnce::_sync_hypermetro_out(CCmdOperate& cmdOperate)
             continue;
         }
 
-        ret = cmdOperate.CMD_showhypermetrolun_all(hmpair_id,lstHMPairLFInfo);
+        itListedInfo = hmpair_lun_info.find(hmpair_id);
+        if (hmpair_lun_info.end() != itListedInfo){
+            lstHMPairLFInfo = itListedInfo->second;
+            ret = RETURN_OK;
+        }
+        else{
+            ret = cmdOperate.CMD_showhypermetrolun_all(hmpair_id,lstHMPairLFInfo);
+        }
 
         if (RETURN_OK != ret){
             it->error_info.code = OS_IToString(ret);
@@ -695,6 +962,8 @@ int SyncOnce::_sync_hypermetro_out(CCmdOperate& cmdOperate)
             if (MIRROR_LUN_RELATION_SLAVE == itHMPairLF->uiRelationType){
                 slave_array_sn = itHMPairLF->strArrayWWN;
                 slave_id   = itHMPairLF->strID;
+                pair_state = itHMPairLF->uiPairStatus;
+                pair_progress = itHMPairLF->iProgress;
                 _convert_hmpair_status(itHMPairLF->uiPairStatus,pair_status);
             }
             if (MIRROR_LUN_RELATION_MASTER == itHMPairLF->uiRelationType && isNFS){
@@ -733,55 +1002,19 @@ int SyncOnce::_sync_hypermetro_out(CCmdOperate& cmdOperate)
             continue;
         }
 
-        HYPERMETROPAIR_INFO_STRU hypermetroStu;
-        hypermetroStu.strID = hmpair_id;
-        
-        
         COMMLOG(OS_LOG_INFO,"HyperMetro of devices[%s] with target devices[%s]  being sync",
             key.c_str(),
             slave_key.c_str());
         print("HyperMetro of devices[%s] with target devices[%s]  being sync",
             key.c_str(),
             slave_key.c_str());
-        ret = cmdOperate.CMD_showhypermetroinfo(hypermetroStu);
-        if (RETURN_OK != ret){
-            COMMLOG(OS_LOG_WARN, "HyperMetro (%s) is failed", strid.c_str());
-            ++it;
-            continue;
-        }
 
-        
-        if (HM_STATUS_NORMAL == hypermetroStu.uiState || HM_STATUS_SYNCHRONIZING == hypermetroStu.uiState){
-            it->device_sync_info.sync_id = SYNC_PREFIX + it->source_id;
-            it->device_sync_info.sync_status = SYNC_PROCESSING_STATUS;
-            it->device_sync_info.sync_progress = hypermetroStu.iProgress;
-            it->device_sync_info.sync_remainingtimeestimate = SYNC_REMAIN_TIME;
+        HyperMetroSyncTask *task = new HyperMetroSyncTask(&(*it), strid, key, slave_key, hmpair_id);
+        if (hmpair_lun_info.end() != itListedInfo){
+            task->set_listed_state(pair_state, pair_progress);
         }
-        else{
-            COMMLOG(OS_LOG_INFO,"hypermetro (%s) is begin sysnc.",strid.c_str());
-            print("hypermetro (%s) is begin sysnc.",strid.c_str());
-            ret = cmdOperate.CMD_synchmpair(hmpair_id);
-            if (RETURN_OK != ret){
-                it->error_info.code = OS_IToString(ret);
-            }
-            else{
-                it->device_sync_info.sync_id = SYNC_PREFIX + it->source_id;
-                it->device_sync_info.sync_status = SYNC_PROCESSING_STATUS;
-                it->device_sync_info.sync_progress = SYNC_PROCESSING_RATE;
-                it->device_sync_info.sync_remainingtimeestimate = SYNC_REMAIN_TIME;
-            }
-        }
-        
-        COMMLOG(OS_LOG_INFO,"Hypermetro of devices[%s] with target devices[%s] sync finish,sysncID[%s] sysnc status[%s]",
-            key.c_str(),
-            slave_key.c_str(),
-            it->device_sync_info.sync_id.c_str(),
-            it->device_sync_info.sync_status.c_str());
-        print("Hypermetro of devices[%s] with target devices[%s] sync finish,sysncID[%s] sysnc status[%s]",
-            key.c_str(),
-            slave_key.c_str(),
-            it->device_sync_info.sync_id.c_str(),
-            it->device_sync_info.sync_status.c_str());
+
+        pool.add(task);
         ++it;
     }
 
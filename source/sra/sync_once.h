@@ -16,6 +16,8 @@
 #define SYNC_ONCE
 
 #include "sra_basic.h"
+#include <set>
+#include "task_pool.h"
 #include "../common/xml_node/consistency_groups.h"
 
 #define SYNC_PROCESSING 2
@@ -44,10 +46,14 @@ protected:
     virtual int check_array_id_validate_out(CCmdOperate& cmdOperate, string& array_id, const string& peer_array_id = "");
 
 private:
-    int _sync_mirror_out(CCmdOperate& cmdOperate);
-    int _sync_hypermetro_out(CCmdOperate& cmdOperate);
-    int _sync_consistgroup_out(CCmdOperate& cmdOperate);
-    int _sync_consistgrouphm_out(CCmdOperate& cmdOperate);
+    void _load_pair_listing_out(CCmdOperate& cmdOperate);
+    void _queue_sync_out(CCmdOperate& cmdOperate, TaskPool& pool);
+    int _run_sync_out(CCmdOperate& cmdOperate, TaskPool& pool);
+
+    int _sync_mirror_out(CCmdOperate& cmdOperate, TaskPool& pool);
+    int _sync_hypermetro_out(CCmdOperate& cmdOperate, TaskPool& pool);
+    int _sync_consistgroup_out(CCmdOperate& cmdOperate, TaskPool& pool);
+    int _sync_consistgrouphm_out(CCmdOperate& cmdOperate, TaskPool& pool);
 
     void _write_consistgroup_result(XmlWriter &writer);
     void _write_mirror_result(XmlWriter &writer);
@@ -58,6 +64,16 @@ private:
 
     ConGroupsInfo consisgrs_info;
     SourceDevicesInfo devices_info;
+
+    // state listings taken once per command, objects missing here are queried by the workers
+    map<string, list<HYMIRROR_LF_INFO_STRU> > hymirror_lun_info;
+    map<string, list<HYPERMETRO_LF_INFO_STRU> > hmpair_lun_info;
+    map<string, GROUP_INFO_STRU> consistgr_info;
+    map<string, GROUP_INFO_STRU> consistgrhm_info;
+
+    // local members of the listed replication pairs, by resource type
+    set<string> listed_fs_ids;
+    set<string> listed_lun_ids;
 };
 
 #endif
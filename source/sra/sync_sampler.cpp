@@ -0,0 +1,222 @@
+// Copyright 2019 The OpenSDS Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use this file except in compliance with the License. You may obtain
+// a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "sync_sampler.h"
+#include "sra_basic.h"
+#include <cstdio>
+#include <fstream>
+#include <ace/File_Lock.h>
+#include <ace/OS_NS_unistd.h>
+
+#define SYNC_SAMPLE_LOCK_SUFFIX ".lock"
+
+void SyncSampler::_read(const string& file, map<string, SYNC_SAMPLE_STRU>& samples)
+{
+    string sync_id;
+    long long sample_time = 0;
+    time_t now = OS_Now();
+    SYNC_SAMPLE_STRU sample;
+
+    ifstream infile(file.c_str());
+    if (!infile){
+        return;
+    }
+
+    while (infile >> sync_id >> sample.progress >> sample_time >> sample.rate){
+        sample.sample_time = (time_t)sample_time;
+        if (now - sample.sample_time > SYNC_SAMPLE_EXPIRE || now < sample.sample_time){
+            continue;
+        }
+
+        samples[sync_id] = sample;
+    }
+}
+
+void SyncSampler::load(const string& dir)
+{
+    samples.clear();
+    touched.clear();
+    next_poll = 0;
+
+    if (dir.empty()){
+        file = "";
+        return;
+    }
+
+    file = dir + PATH_SEPARATOR + SYNC_SAMPLE_FILE;
+
+    string lock_file = file + SYNC_SAMPLE_LOCK_SUFFIX;
+    ACE_File_Lock file_lock(lock_file.c_str(), O_RDWR | O_CREAT, ACE_DEFAULT_FILE_PERMS);
+    if (-1 == file_lock.acquire_read()){
+        COMMLOG(OS_LOG_WARN, "failed to lock %s, read sync samples unlocked.", lock_file.c_str());
+    }
+
+    _read(file, samples);
+
+    (void)file_lock.release();
+
+    COMMLOG(OS_LOG_INFO, "load %u sync samples from %s.", (unsigned int)samples.size(), file.c_str());
+}
+
+/*
+ Write back the pairs this invocation sampled or completed. The file is
+ read again under the lock and only those pairs are replaced, so the
+ samples another querySyncStatus saved in the meantime are kept.
+*/
+void SyncSampler::save()
+{
+    string tmp_file;
+    string lock_file;
+    map<string, SYNC_SAMPLE_STRU> merged;
+    map<string, SYNC_SAMPLE_STRU>::iterator it;
+    set<string>::iterator itTouched;
+
+    if (file.empty() || touched.empty()){
+        return;
+    }
+
+    lock_file = file + SYNC_SAMPLE_LOCK_SUFFIX;
+    ACE_File_Lock file_lock(lock_file.c_str(), O_RDWR | O_CREAT, ACE_DEFAULT_FILE_PERMS);
+    if (-1 == file_lock.acquire()){
+        COMMLOG(OS_LOG_WARN, "failed to lock %s, sync samples are not kept.", lock_file.c_str());
+        return;
+    }
+
+    _read(file, merged);
+
+    for (itTouched = touched.begin(); itTouched != touched.end(); ++itTouched){
+        it = samples.find(*itTouched);
+        if (samples.end() == it){
+            (void)merged.erase(*itTouched);
+        }
+        else{
+            merged[*itTouched] = it->second;
+        }
+    }
+
+    tmp_file = file + "." + OS_IToString((int)ACE_OS::getpid()) + ".tmp";
+
+    {
+        ofstream outfile(tmp_file.c_str(), ios::out | ios::trunc);
+        if (!outfile){
+            COMMLOG(OS_LOG_WARN, "failed to open %s, sync samples are not kept.", tmp_file.c_str());
+            (void)file_lock.release();
+            return;
+        }
+
+        for (it = merged.begin(); it != merged.end(); ++it){
+            outfile << it->first << " " << it->second.progress << " "
+                << (long long)it->second.sample_time << " " << it->second.rate << "\n";
+        }
+
+        if (!outfile){
+            COMMLOG(OS_LOG_WARN, "failed to write %s, sync samples are not kept.", tmp_file.c_str());
+            outfile.close();
+            (void)remove(tmp_file.c_str());
+            (void)file_lock.release();
+            return;
+        }
+    }
+
+#ifdef WIN32
+    (void)remove(file.c_str());
+#endif
+    if (0 != rename(tmp_file.c_str(), file.c_str())){
+        COMMLOG(OS_LOG_WARN, "failed to replace %s, sync samples are not kept.", file.c_str());
+        (void)remove(tmp_file.c_str());
+    }
+
+    (void)file_lock.release();
+}
+
+/*
+ Record the progress of one pair and return its remaining time in seconds.
+ The rate is smoothed over the invocations that saw progress move; a pair
+ that restarted or has no usable history yet reports the fallback.
+*/
+string SyncSampler::estimate(const string& sync_id, const string& progress, const string& fallback)
+{
+    int cur_progress = atoi(progress.c_str());
+    int remain = 0;
+    double cur_rate = 0;
+    time_t now = OS_Now();
+    map<string, SYNC_SAMPLE_STRU>::iterator it;
+    SYNC_SAMPLE_STRU sample;
+
+    if (sync_id.empty()){
+        return fallback;
+    }
+
+    sample.progress = cur_progress;
+    sample.sample_time = now;
+    sample.rate = 0;
+
+    it = samples.find(sync_id);
+    if (samples.end() != it){
+        if (cur_progress < it->second.progress){
+            COMMLOG(OS_LOG_INFO, "progress of %s went back from %d to %d, restart sampling.",
+                sync_id.c_str(), it->second.progress, cur_progress);
+        }
+        else if (now <= it->second.sample_time || cur_progress == it->second.progress){
+            sample = it->second;
+        }
+        else{
+            cur_rate = (double)(cur_progress - it->second.progress) / (double)(now - it->second.sample_time);
+            sample.rate = (it->second.rate > 0) ? (it->second.rate + cur_rate) / 2 : cur_rate;
+        }
+    }
+
+    samples[sync_id] = sample;
+    (void)touched.insert(sync_id);
+
+    if (sample.rate <= 0){
+        _note_poll(SYNC_POLL_DEFAULT);
+        return fallback;
+    }
+
+    remain = (int)((SYNC_COMPLETE_FLAG - cur_progress) / sample.rate);
+    if (remain < 1){
+        remain = 1;
+    }
+
+    _note_poll(remain / 4);
+
+    COMMLOG(OS_LOG_INFO, "sync %s at %d%%, rate %.4f%%/s, remaining %ds.", sync_id.c_str(), cur_progress, sample.rate, remain);
+
+    return OS_IToString(remain);
+}
+
+void SyncSampler::_note_poll(int poll)
+{
+    if (poll < SYNC_POLL_MIN){
+        poll = SYNC_POLL_MIN;
+    }
+    if (poll > SYNC_POLL_MAX){
+        poll = SYNC_POLL_MAX;
+    }
+    if (0 == next_poll || poll < next_poll){
+        next_poll = poll;
+    }
+}
+
+void SyncSampler::complete(const string& sync_id)
+{
+    (void)samples.erase(sync_id);
+    (void)touched.insert(sync_id);
+}
+
+int SyncSampler::poll_interval() const
+{
+    return (0 == next_poll) ? SYNC_POLL_DEFAULT : next_poll;
+}
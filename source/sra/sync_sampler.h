@@ -0,0 +1,70 @@
+// Copyright 2019 The OpenSDS Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use this file except in compliance with the License. You may obtain
+// a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#ifndef SYNC_SAMPLER_H
+#define SYNC_SAMPLER_H
+
+#include <map>
+#include <set>
+#include <string>
+
+#include "common.h"
+
+#define SYNC_SAMPLE_FILE        "sync_progress.dat"
+#define SYNC_SAMPLE_EXPIRE      86400
+#define SYNC_POLL_MIN           10
+#define SYNC_POLL_MAX           300
+#define SYNC_POLL_DEFAULT       60
+
+typedef struct tag_SYNC_SAMPLE
+{
+    int progress;
+    time_t sample_time;
+    double rate;        // smoothed progress in percent per second, 0 while unknown
+}SYNC_SAMPLE_STRU;
+
+/*
+ Keeps the last progress sample of each pair between querySyncStatus
+ invocations, keyed by sync_id, and derives the remaining time from the
+ observed sync rate. The state lives in a small text file under the log
+ directory SRM hands to every command. SRM runs querySyncStatus for several
+ groups at once, so save() merges the pairs this invocation touched into
+ the file as it is on disk under a lock file.
+*/
+class SyncSampler
+{
+public:
+    SyncSampler() : next_poll(0) {};
+    ~SyncSampler() {};
+
+    void load(const string& dir);
+    void save();
+
+    string estimate(const string& sync_id, const string& progress, const string& fallback);
+    void complete(const string& sync_id);
+
+    int poll_interval() const;
+
+private:
+    void _note_poll(int poll);
+    static void _read(const string& file, map<string, SYNC_SAMPLE_STRU>& samples);
+
+private:
+    string file;
+    map<string, SYNC_SAMPLE_STRU> samples;
+    set<string> touched;
+    int next_poll;
+};
+
+#endif
@@ -0,0 +1,185 @@
+// Copyright 2019 The OpenSDS Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use this file except in compliance with the License. You may obtain
+// a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "task_pool.h"
+#include <ace/Thread_Manager.h>
+#include <ace/Guard_T.h>
+
+int g_iMaxConcurrency = DEFAULT_MAX_CONCURRENCY;
+
+TaskPool::TaskPool(HYPER_STORAGE_STRU& stStorageInfo, int max_workers)
+    : storage_info(stStorageInfo), max_workers(max_workers), next_task(0), next_session(0)
+{
+    if (this->max_workers <= 0){
+        this->max_workers = g_iMaxConcurrency;
+    }
+
+    if (this->max_workers > THREAD_MAX_SIZE){
+        this->max_workers = THREAD_MAX_SIZE;
+    }
+
+    if (this->max_workers <= 0){
+        this->max_workers = 1;
+    }
+
+    sessions.assign((size_t)(this->max_workers - 1), NULL);
+    session_failed.assign((size_t)(this->max_workers - 1), false);
+}
+
+TaskPool::~TaskPool()
+{
+    try{
+        clear();
+
+        for (size_t i = 0; i < sessions.size(); i++){
+            delete sessions[i];
+            sessions[i] = NULL;
+        }
+    }
+    catch(...){}
+}
+
+void TaskPool::add(SraTask *task)
+{
+    if (NULL != task){
+        tasks.push_back(task);
+    }
+}
+
+void TaskPool::clear()
+{
+    for (size_t i = 0; i < tasks.size(); i++){
+        delete tasks[i];
+        tasks[i] = NULL;
+    }
+
+    tasks.clear();
+    next_task = 0;
+}
+
+SraTask *TaskPool::_next_task()
+{
+    ACE_Guard<ACE_Thread_Mutex> oGuard(task_mutex);
+
+    if (next_task >= tasks.size()){
+        return NULL;
+    }
+
+    return tasks[next_task++];
+}
+
+/* the session of the next free slot, logged in by the first worker on it */
+CCmdOperate *TaskPool::_take_session()
+{
+    size_t slot = 0;
+    CCmdOperate *cmdOperate = NULL;
+    HYPER_STORAGE_STRU stStorageInfo = storage_info;
+    SYSTEM_INFO_STRU stSysInfo;
+
+    {
+        ACE_Guard<ACE_Thread_Mutex> oGuard(task_mutex);
+
+        if (next_session >= sessions.size()){
+            return NULL;
+        }
+
+        slot = next_session++;
+    }
+
+    if (NULL != sessions[slot]){
+        return sessions[slot];
+    }
+
+    if (session_failed[slot]){
+        return NULL;
+    }
+
+    cmdOperate = new CCmdOperate();
+    if (RETURN_OK != cmdOperate->SetStorageInfo(stStorageInfo)){
+        COMMLOG(OS_LOG_ERROR, "%s", "worker failed to set storage info, it takes no tasks.");
+        delete cmdOperate;
+        session_failed[slot] = true;
+        return NULL;
+    }
+
+    /* the session logs in lazily on its first request, so log in here before
+       taking any task: a worker that can not log in must not fail the tasks
+       the calling thread and the other workers are still able to run */
+    if (RETURN_OK != cmdOperate->CMD_showsys(stSysInfo)){
+        COMMLOG(OS_LOG_ERROR, "%s", "worker failed to log in to the array, it takes no tasks.");
+        delete cmdOperate;
+        session_failed[slot] = true;
+        return NULL;
+    }
+
+    sessions[slot] = cmdOperate;
+
+    return cmdOperate;
+}
+
+void TaskPool::_drain(CCmdOperate& cmdOperate)
+{
+    SraTask *task = NULL;
+
+    while (NULL != (task = _next_task())){
+        task->result = task->run(cmdOperate);
+    }
+}
+
+ACE_THR_FUNC_RETURN TaskPool::_worker(void *arg)
+{
+    TaskPool *pool = (TaskPool *)arg;
+    CCmdOperate *cmdOperate = pool->_take_session();
+
+    if (NULL == cmdOperate){
+        return 0;
+    }
+
+    pool->_drain(*cmdOperate);
+
+    return 0;
+}
+
+void TaskPool::run(CCmdOperate& cmdOperate)
+{
+    int extra_workers = 0;
+    int grp_id = -1;
+    size_t pending = tasks.size() - next_task;
+    ACE_Thread_Manager thr_mgr;
+
+    if (0 == pending){
+        return;
+    }
+
+    next_session = 0;
+    extra_workers = max_workers - 1;
+    if ((size_t)extra_workers > pending - 1){
+        extra_workers = (int)(pending - 1);
+    }
+
+    if (extra_workers > 0){
+        grp_id = thr_mgr.spawn_n((size_t)extra_workers, (ACE_THR_FUNC)TaskPool::_worker, this);
+        if (-1 == grp_id){
+            COMMLOG(OS_LOG_WARN, "failed to spawn %d workers, tasks run on the calling thread.", extra_workers);
+        }
+    }
+
+    COMMLOG(OS_LOG_INFO, "run %u tasks on %d sessions.", (unsigned int)pending, (-1 == grp_id) ? 1 : extra_workers + 1);
+
+    _drain(cmdOperate);
+
+    if (-1 != grp_id){
+        (void)thr_mgr.wait_grp(grp_id);
+    }
+}
@@ -0,0 +1,91 @@
+// Copyright 2019 The OpenSDS Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use this file except in compliance with the License. You may obtain
+// a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#ifndef TASK_POOL_H
+#define TASK_POOL_H
+
+#include <vector>
+#include <ace/Thread_Mutex.h>
+
+#include "common.h"
+#include "CmdOperate.h"
+
+#define DEFAULT_MAX_CONCURRENCY     4
+
+extern int g_iMaxConcurrency;
+
+/*
+ One unit of array work. run() is called on a worker thread with a
+ CCmdOperate that owns its own REST session, so a task must only touch
+ its own members and never the state of the command object that queued it.
+*/
+class SraTask
+{
+public:
+    SraTask() : result(RETURN_OK) {};
+    virtual ~SraTask() {};
+
+    virtual int run(CCmdOperate& cmdOperate) = 0;
+
+public:
+    int result;
+};
+
+/*
+ Runs queued tasks on at most max_workers sessions against one array.
+ The calling thread takes part with the session it already holds, the
+ other workers log in on their own and only take tasks once logged in.
+ Worker sessions stay logged in until the pool is destroyed, so a command
+ keeps one pool for all its phases: run() runs the tasks added since the
+ last run, clear() drops the tasks and keeps the sessions.
+ Tasks are owned by the pool.
+*/
+class TaskPool
+{
+public:
+    TaskPool(HYPER_STORAGE_STRU& stStorageInfo, int max_workers = 0);
+    ~TaskPool();
+
+    void add(SraTask *task);
+    void run(CCmdOperate& cmdOperate);
+    void clear();
+
+    size_t size() const { return tasks.size(); };
+    SraTask *at(size_t index) { return tasks[index]; };
+
+private:
+    TaskPool(const TaskPool&);
+    TaskPool& operator=(const TaskPool&);
+
+    static ACE_THR_FUNC_RETURN _worker(void *arg);
+    SraTask *_next_task();
+    CCmdOperate *_take_session();
+    void _drain(CCmdOperate& cmdOperate);
+
+private:
+    HYPER_STORAGE_STRU storage_info;
+    int max_workers;
+
+    vector<SraTask *> tasks;
+    size_t next_task;
+    ACE_Thread_Mutex task_mutex;
+
+    // one slot per extra worker, NULL until a worker logs in on it; a
+    // failed login is not tried again, the array may lock the user
+    vector<CCmdOperate *> sessions;
+    vector<bool> session_failed;
+    size_t next_session;
+};
+
+#endif
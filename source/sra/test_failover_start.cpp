@@ -15,7 +15,7 @@
 #include "test_failover_start.h"
 #include <algorithm>
 
-TestFailoverStart::TestFailoverStart() : SraBasic()
+TestFailoverStart::TestFailoverStart() : SraBasic(), host_link_loaded(false)
 {
     memset_s(array_id, sizeof(array_id), 0, sizeof(array_id));
     memset_s(input_array_id, sizeof(input_array_id), 0, sizeof(input_array_id));
@@ -42,87 +42,27 @@ int test_failover_start(XmlReader &reader)
 
 int TestFailoverStart::_read_command_para(XmlReader &reader)
 {
-    int i = 0, j = 0;
-    int tg_count = 0;
-    int device_count = 0;
-    int accessgroup_count = 0;
-    int accessgroups_count = 0;
-    int accessinitiator_count = 0;
-
-    if (!reader.get_string("/Command/TestFailoverStartParameters/ArrayId", array_id, 0)){
+    CommandPara para;
+    list<pair<string, string> >::iterator itAccess;
+
+    if (!reader.get_cstring("/Command/TestFailoverStartParameters/ArrayId", array_id)){
         return ERROR_INTERNAL_PROCESS_FAIL;
     }
 
-    CHECK_FALSE(reader.get_string("/Command/TestFailoverStartParameters/ArrayId", input_array_id, 0), RETURN_ERR);
-
-    tg_count = reader.get_count("/Command/TestFailoverStartParameters/TargetGroups/TargetGroup");
-
-    for (i = 0; i < tg_count; i++){
-        char tg_id[LENGTH_COMMON] = {0};
-        TargetGroupInfo tg_info;
+    CHECK_FALSE(reader.get_cstring("/Command/TestFailoverStartParameters/ArrayId", input_array_id), RETURN_ERR);
 
-        (void)reader.get_string("/Command/TestFailoverStartParameters/TargetGroups/TargetGroup/@key", tg_id, i);
+    CHECK_FALSE(_get_command_para(reader, "/Command/TestFailoverStartParameters", para), RETURN_ERR);
 
-        tg_info.tg_key = tg_id;
-        tg_groups.lst_groups_info.push_back(tg_info);
+    tg_groups.lst_groups_info.swap(para.target_groups);
 
-        
-        device_count = reader.get_count("/Command/TestFailoverStartParameters/TargetGroups/TargetGroup/TargetDevices/TargetDevice", i, 2);
-        
-        for(j = 0; j < device_count; j++){
-            char target_key[LENGTH_COMMON] = {0};
-            (void)reader.get_string("/Command/TestFailoverStartParameters/TargetGroups/TargetGroup/TargetDevices/TargetDevice/@key", target_key, j);
-            
-            accessgroups_count = reader.get_count("/Command/TestFailoverStartParameters/TargetGroups/TargetGroup/TargetDevices/TargetDevice/AccessGroups/AccessGroup",j,2);
-            
-            string cg_accessgroups = "";
-            for (int k = 0; k < accessgroups_count; k++){
-                char group_id[LENGTH_COMMON] = {0};
-                (void)reader.get_string("/Command/TestFailoverStartParameters/TargetGroups/TargetGroup/TargetDevices/TargetDevice/AccessGroups/AccessGroup/@id", group_id, k,j,2);
-                
-                cg_accessgroups = cg_accessgroups + group_id + DAR_HOST_SEPERATOR;
-            }
-            COMMLOG(OS_LOG_INFO, "AccessGroups of TargetDevice[%s] is [%s].", target_key, cg_accessgroups.c_str());
-            accessGroupDict[target_key] = cg_accessgroups;
-        }
+    for (itAccess = para.group_access.begin(); itAccess != para.group_access.end(); ++itAccess){
+        COMMLOG(OS_LOG_INFO, "AccessGroups of TargetDevice[%s] is [%s].", itAccess->first.c_str(), itAccess->second.c_str());
+        accessGroupDict[itAccess->first] = itAccess->second;
     }
 
-    device_count = reader.get_count("/Command/TestFailoverStartParameters/TargetDevices/TargetDevice");
-
-    for (i = 0; i < device_count; i++){
-        char target_key[LENGTH_COMMON] = {0};
+    tg_devices.lst_target_devices.swap(para.target_devices);
+    lstDARHosts.swap(para.dar_hosts);
 
-        TargetDeviceInfo tg_device_info;
-
-        (void)reader.get_string("/Command/TestFailoverStartParameters/TargetDevices/TargetDevice/@key", target_key, i);
-        accessgroups_count = reader.get_count("/Command/TestFailoverStartParameters/TargetDevices/TargetDevice/AccessGroups/AccessGroup",i,2);
-        for (j = 0; j < accessgroups_count; j++){
-            char group_id[LENGTH_COMMON] = {0};
-            (void)reader.get_string("/Command/TestFailoverStartParameters/TargetDevices/TargetDevice/AccessGroups/AccessGroup/@id", group_id, j,i,2);
-            tg_device_info.cg_accessgroups = tg_device_info.cg_accessgroups + group_id + DAR_HOST_SEPERATOR;
-        }
-        tg_device_info.target_key = target_key;
-        tg_devices.lst_target_devices.push_back(tg_device_info);
-    }
-
-    
-    accessgroup_count = reader.get_count("/Command/TestFailoverStartParameters/AccessGroups/AccessGroup");
-    for(j = 0; j < accessgroup_count; j++){
-        char group_id[LENGTH_COMMON] = {0};
-        (void)reader.get_string("/Command/TestFailoverStartParameters/AccessGroups/AccessGroup/@id", group_id, j);
-        accessinitiator_count = reader.get_count("/Command/TestFailoverStartParameters/AccessGroups/AccessGroup/Initiator",j,1);
-        for (i = 0; i < accessinitiator_count; i++){
-            char initiator_id[LENGTH_COMMON] = {0};
-            char initiator_type[LENGTH_COMMON] = {0};
-            DAR_HOST_INFO tg_dar_host_info;
-            (void)reader.get_string("/Command/TestFailoverStartParameters/AccessGroups/AccessGroup/Initiator/@id", initiator_id, i,j,1);
-            (void)reader.get_string("/Command/TestFailoverStartParameters/AccessGroups/AccessGroup/Initiator/@type", initiator_type, i,j,1);
-            tg_dar_host_info.strID = initiator_id;
-            tg_dar_host_info.strType = initiator_type;
-            tg_dar_host_info.strGroup = group_id;
-            lstDARHosts.push_back(tg_dar_host_info);
-        }
-    }
     return RETURN_OK;
 }
 
@@ -1052,6 +992,8 @@ int TestFailoverStart::_and_map_out(CCmdOperate& cmdOperate,TargetDeviceInfo& ta
     list<HOST_PORT_INFO_STRU> rlstHostPortInfo;
     list<HOST_PORT_INFO_STRU>::iterator itHostPortInfo;
 
+    _load_host_links_out(cmdOperate);
+
     ret = get_device_info(target_device.target_key, arrayid, lun_id, lun_flag, pairid);
     if (RETURN_OK != ret){
         target_device.err_info.code = OS_IToString(ret);
@@ -1096,14 +1038,15 @@ int TestFailoverStart::_and_map_out(CCmdOperate& cmdOperate,TargetDeviceInfo& ta
         string strHostCom("");
         unsigned int fcOriscsi = 0;
         
-        cmdOperate.CMD_showhostport(ithost->strID, rlstHostPortInfo);
+        rlstHostPortInfo.clear();
+        (void)_get_host_ports(cmdOperate, ithost->strID, rlstHostPortInfo);
         for (itHostPortInfo = rlstHostPortInfo.begin();itHostPortInfo != rlstHostPortInfo.end(); itHostPortInfo++){
             if (!itHostPortInfo->strIQN.empty() && itHostPortInfo->strIQN.size() > 1){
                 strIQN += strCom + itHostPortInfo->strIQN;
                 strChapName += strCom + itHostPortInfo->strChapName;
                 strCom = ",";
                 fcOriscsi = itHostPortInfo->uifcOriscsi;
-                cmdOperate.CMD_showhostlink(itHostPortInfo->strIQN, itHostPortInfo->uifcOriscsi, rlstHostLinkInfo);
+                _get_host_links_out(cmdOperate, *itHostPortInfo, rlstHostLinkInfo);
                 for (itHostLinkInfo = rlstHostLinkInfo.begin(); itHostLinkInfo != rlstHostLinkInfo.end(); itHostLinkInfo++){
                     if (!itHostLinkInfo->target_port_wwn.empty() && itHostLinkInfo->target_port_wwn.size() > 1){
                         strPortWwn += strHostCom + itHostLinkInfo->target_port_wwn ;
@@ -1149,6 +1092,55 @@ int TestFailoverStart::_and_map_out(CCmdOperate& cmdOperate,TargetDeviceInfo& ta
     return RETURN_OK;
 }
 
+void TestFailoverStart::_load_host_links_out(CCmdOperate& cmdOperate)
+{
+    int ret = RETURN_ERR;
+    list<HOST_LINK_INFO> lstHostLinkInfo;
+    list<HOST_LINK_INFO>::iterator itHostLinkInfo;
+    unsigned int flags[] = {0, 1};
+
+    if (host_link_loaded){
+        return;
+    }
+    host_link_loaded = true;
+
+    for (size_t i = 0; i < sizeof(flags) / sizeof(flags[0]); i++){
+        ret = cmdOperate.CMD_showhostlink_all(flags[i], lstHostLinkInfo);
+        if (RETURN_OK != ret){
+            COMMLOG(OS_LOG_WARN, "list %s host links fail(%d), query them one by one.", (0 == flags[i]) ? "iSCSI" : "FC", ret);
+            continue;
+        }
+
+        for (itHostLinkInfo = lstHostLinkInfo.begin(); itHostLinkInfo != lstHostLinkInfo.end(); ++itHostLinkInfo){
+            host_link_index[OS_IToString((int)flags[i]) + "/" + itHostLinkInfo->initiator_port_wwn].push_back(*itHostLinkInfo);
+        }
+    }
+
+    COMMLOG(OS_LOG_INFO, "listed host links of %u initiators for mapping.", (unsigned int)host_link_index.size());
+}
+
+void TestFailoverStart::_get_host_links_out(CCmdOperate& cmdOperate, const HOST_PORT_INFO_STRU& host_port, list<HOST_LINK_INFO>& lstHostLinkInfo)
+{
+    unsigned int flag = (0 == host_port.uifcOriscsi) ? 0 : 1;
+    string key = OS_IToString((int)flag) + "/" + host_port.strIQN;
+    map<string, list<HOST_LINK_INFO> >::iterator itHostLink;
+
+    itHostLink = host_link_index.find(key);
+    if (host_link_index.end() != itHostLink){
+        lstHostLinkInfo = itHostLink->second;
+        return;
+    }
+
+    // not in the listing, e.g. the port is offline or listing failed
+    lstHostLinkInfo.clear();
+    if (RETURN_OK != cmdOperate.CMD_showhostlink(host_port.strIQN, host_port.uifcOriscsi, lstHostLinkInfo)){
+        lstHostLinkInfo.clear();
+        return;
+    }
+
+    host_link_index[key] = lstHostLinkInfo;
+}
+
 void TestFailoverStart::_check_status_sync_out(CCmdOperate& cmdOperate)
 {
     int iRet = RETURN_ERR;
@@ -43,6 +43,8 @@ private:
     int _get_snapshot_info_out(CCmdOperate& cmdOperate,TargetDeviceInfo& target_device, int& errorCode);
     int _get_active_time_out(CCmdOperate& cmdOperate,HYIMAGE_INFO_STRU& snapshot, string& time_stamp);
     int _and_map_out(CCmdOperate& cmdOperate,TargetDeviceInfo& target_device);
+    void _load_host_links_out(CCmdOperate& cmdOperate);
+    void _get_host_links_out(CCmdOperate& cmdOperate, const HOST_PORT_INFO_STRU& host_port, list<HOST_LINK_INFO>& lstHostLinkInfo);
     int _map_snapshot(CCmdOperate& cmdOperate, TargetDeviceInfo& target_device);
 
     int _get_consist_devices_out(CCmdOperate& cmdOperate,TargetDevicesInfo& tg_devices);
@@ -69,6 +71,10 @@ private:
 
     list<DAR_HOST_INFO> lstDARHosts;
     map<string, string> accessGroupDict;
+
+    // links of the array keyed by initiator type and port, listed once for all devices
+    bool host_link_loaded;
+    map<string, list<HOST_LINK_INFO> > host_link_index;
 };
 
 #endif
@@ -14,6 +14,72 @@
 
 #include "test_failover_stop.h"
 
+static int del_map_from_dar(CCmdOperate& cmdOperate, const string& mapID, const string& lunGroupID,  const string& hostGroupID, const string& snapID);
+
+/*
+ Removes the mapping of snapshots that share a lun group or a host group.
+ Those maps are removed one after another, as each removal checks what is
+ left in the group. Maps of one snapshot are skipped after its first failure.
+*/
+class UnmapSnapshotTask : public SraTask
+{
+public:
+    virtual int run(CCmdOperate& cmdOperate)
+    {
+        set<size_t> failed_items;
+
+        lst_ret.assign(lst_map.size(), RETURN_OK);
+        for (size_t i = 0; i < lst_map.size(); i++){
+            if (failed_items.end() != failed_items.find(lst_ref[i].first)){
+                continue;
+            }
+
+            lst_ret[i] = del_map_from_dar(cmdOperate, lst_map[i].strMapID, lst_map[i].strLunGroupID, lst_map[i].strHostGroupID, lst_map[i].strDevLUNID);
+            if (RETURN_OK != lst_ret[i]){
+                failed_items.insert(lst_ref[i].first);
+            }
+        }
+
+        return RETURN_OK;
+    }
+
+public:
+    set<string> lun_groups;
+    set<string> host_groups;
+    // (teardown index, map index) of every map, in request order
+    vector<pair<size_t, size_t> > lst_ref;
+    vector<MAP_INFO_STRU> lst_map;
+    vector<int> lst_ret;
+};
+
+class DisableSnapshotTask : public SraTask
+{
+public:
+    DisableSnapshotTask(const string& snap_id) : snap_id(snap_id) {};
+
+    virtual int run(CCmdOperate& cmdOperate)
+    {
+        return cmdOperate.CMD_disablehyimg(snap_id);
+    }
+
+private:
+    string snap_id;
+};
+
+class DeleteSnapshotTask : public SraTask
+{
+public:
+    DeleteSnapshotTask(const string& snap_id) : snap_id(snap_id) {};
+
+    virtual int run(CCmdOperate& cmdOperate)
+    {
+        return cmdOperate.CMD_delhyimg(snap_id);
+    }
+
+private:
+    string snap_id;
+};
+
 int test_failover_stop(XmlReader &reader)
 {
     TestFailoverStop tfs;
@@ -43,36 +109,19 @@ TestFailoverStop::~TestFailoverStop()
 
 int TestFailoverStop::_read_command_para(XmlReader &reader)
 {
-    char obj_id_tmp[LENGTH_COMMON] = {0};
-
-    int consistgr_count = 0;
-    int devices_count = 0;
-    int index;
+    CommandPara para;
 
-    CHECK_FALSE(reader.get_string("/Command/TestFailoverStopParameters/ArrayId", array_id, 0), RETURN_ERR);
-    CHECK_FALSE(reader.get_string("/Command/TestFailoverStopParameters/ArrayId", input_array_id, 0), RETURN_ERR);
+    CHECK_FALSE(reader.get_cstring("/Command/TestFailoverStopParameters/ArrayId", array_id), RETURN_ERR);
+    CHECK_FALSE(reader.get_cstring("/Command/TestFailoverStopParameters/ArrayId", input_array_id), RETURN_ERR);
 
-    consistgr_count = reader.get_count("/Command/TestFailoverStopParameters/TargetGroups/TargetGroup");
-    for (index = 0; index < consistgr_count; index++){
-        TargetGroupInfo tg;
-        memset_s(obj_id_tmp, sizeof(obj_id_tmp), 0, sizeof(obj_id_tmp));
-
-        CHECK_FALSE(reader.get_string("/Command/TestFailoverStopParameters/TargetGroups/TargetGroup/@key", obj_id_tmp, index), ERROR_INTERNAL_PROCESS_FAIL);
-
-        tg.tg_key = string(obj_id_tmp);
-        targetconsisgrs_info.lst_groups_info.push_back(tg);
+    CHECK_FALSE(_get_command_para(reader, "/Command/TestFailoverStopParameters", para), RETURN_ERR);
+    if (para.is_key_missing()){
+        COMMLOG(OS_LOG_ERROR, "%s", "a target group or device has no key.");
+        return ERROR_INTERNAL_PROCESS_FAIL;
     }
 
-    devices_count = reader.get_count("/Command/TestFailoverStopParameters/TargetDevices/TargetDevice");
-    for (index = 0; index < devices_count; index++){
-        memset_s(obj_id_tmp, sizeof(obj_id_tmp), 0, sizeof(obj_id_tmp));
-        CHECK_FALSE(reader.get_string("/Command/TestFailoverStopParameters/TargetDevices/TargetDevice/@key", obj_id_tmp, index), ERROR_INTERNAL_PROCESS_FAIL);
-
-        TargetDeviceInfo td;
-
-        td.target_key = string(obj_id_tmp);
-        tartgetdevs_info.lst_target_devices.push_back(td);
-    }
+    targetconsisgrs_info.lst_groups_info.swap(para.target_groups);
+    tartgetdevs_info.lst_target_devices.swap(para.target_devices);
 
     return RETURN_OK;
 }
@@ -309,6 +358,8 @@ int TestFailoverStop::_outband_process()
         _deal_hypermetro_out(cmdOperate);
     }
 
+    _teardown_snapshots_out(cmdOperate);
+
     return RETURN_OK;
 }
 
@@ -561,16 +612,8 @@ void TestFailoverStop::_deal_hymirror_out(CCmdOperate& cmdOperate)
             key.c_str());
         print("Commence: Temporary Snapshot Copy of [%s] is being destroyed for testFailoverStop request.",
             key.c_str());
-        ret = _stop_test_device_out(cmdOperate, strid, it_td->err_info, it_td->war_info);
+        (void)_stop_test_device_out(cmdOperate, strid, it_td->err_info, it_td->war_info, &it_td->success);
 
-        if (RETURN_OK == ret){
-            it_td->success = true;
-        }
-        
-        COMMLOG(OS_LOG_INFO, "Complete: Temporary Snapshot Copy of [%s] has been removed from service and destroyed for testFailoverStop request.",
-            key.c_str());
-        print("Complete: Temporary Snapshot Copy of [%s] has been removed from service and destroyed for testFailoverStop request.",
-            key.c_str());
         ++it_td;
     }
 
@@ -648,16 +691,8 @@ void TestFailoverStop::_deal_hypermetro_out(CCmdOperate& cmdOperate)
             key.c_str());
         print("Commence: Temporary Snapshot Copy of [%s] is being destroyed for testFailoverStop request.",
             key.c_str());
-        ret = _stop_test_device_out(cmdOperate, strid, it_td->err_info, it_td->war_info);
+        (void)_stop_test_device_out(cmdOperate, strid, it_td->err_info, it_td->war_info, &it_td->success);
 
-        if (RETURN_OK == ret){
-            it_td->success = true;
-        }
-        
-        COMMLOG(OS_LOG_INFO, "Complete: Temporary Snapshot Copy of [%s] has been removed from service and destroyed for testFailoverStop request.",
-            key.c_str());
-        print("Complete: Temporary Snapshot Copy of [%s] has been removed from service and destroyed for testFailoverStop request.",
-            key.c_str());
         ++it_td;
     }
 
@@ -683,25 +718,21 @@ void TestFailoverStop::_del_lun_snapshot_out(CCmdOperate& cmdOperate, list<Commo
             key.c_str());    
         print("Commence: Temporary Snapshot Copy of [%s] is being destroyed for testFailoverStop request",
             key.c_str());
-        ret = _stop_test_device_out(cmdOperate, it_lun_info->lun_id, errorinfo, warninfo);
+        ret = _stop_test_device_out(cmdOperate, it_lun_info->lun_id, errorinfo, warninfo, NULL);
         if (RETURN_OK != ret){
             COMMLOG(OS_LOG_ERROR,"_stop_test_device_out with key [%s]error[%d]",
                 key.c_str(),ret);
             ++it_lun_info;
             continue;
         }
-        
-        COMMLOG(OS_LOG_INFO,"Complete: Temporary Snapshot Copy of [%s] has been removed from service and destroyed for testFailoverStop request",
-            key.c_str());
-        print("Complete: Temporary Snapshot Copy of [%s] has been removed from service and destroyed for testFailoverStop request",
-            key.c_str());
+
         ++it_lun_info;
     }
 
     return;
 }
 
-int TestFailoverStop::_stop_test_device_out(CCmdOperate& cmdOperate, string& strid, ErrorInfo& err_info, WarnInfo& warn_info)
+int TestFailoverStop::_stop_test_device_out(CCmdOperate& cmdOperate, string& strid, ErrorInfo& err_info, WarnInfo& warn_info, bool *success)
 {
     int ret = RETURN_ERR;
 
@@ -709,15 +740,9 @@ int TestFailoverStop::_stop_test_device_out(CCmdOperate& cmdOperate, string& str
     string cmd;
     string snap_name = VSSRA_SNAPSHOT_PREFIX + strid;
     string snap_id;
-    string map_id;
 
-    list<string> lst_map_id;
     list<string> lst_snapshot_id;
-    list<string> lst_hostgroup_id;
-    list<MAP_INFO_STRU> lst_delete_map;
-
-    list<string>::iterator it_map_id;
-    list<string>::iterator it_hostgroup_id;
+    SnapTeardown_Info teardown;
 
     list<HYIMAGE_INFO_STRU> lstHyImgInfo;
     list<HYIMAGE_INFO_STRU>::iterator itHyImgInfo;
@@ -757,6 +782,11 @@ int TestFailoverStop::_stop_test_device_out(CCmdOperate& cmdOperate, string& str
     if (lst_snapshot_id.empty()){
         
         COMMLOG(OS_LOG_WARN, "can not find snapshot by source lun(%s)", strid.c_str());
+        if (NULL != success){
+            *success = true;
+        }
+        COMMLOG(OS_LOG_INFO, "Complete: Temporary Snapshot Copy of [%s.%s] has been removed from service and destroyed for testFailoverStop request.",
+            array_id, strid.c_str());
         return RETURN_OK;
     }
     snap_id = lst_snapshot_id.front();
@@ -799,13 +829,20 @@ int TestFailoverStop::_stop_test_device_out(CCmdOperate& cmdOperate, string& str
                 snap_name.c_str(), err_info.code.c_str());
             return ret;
         }
+
+        if (NULL != success){
+            *success = true;
+        }
+        COMMLOG(OS_LOG_INFO, "Complete: Temporary Snapshot Copy of [%s.%s] has been removed from service and destroyed for testFailoverStop request.",
+            array_id, strid.c_str());
+        print("Complete: Temporary Snapshot Copy of [%s.%s] has been removed from service and destroyed for testFailoverStop request.",
+            array_id, strid.c_str());
     }
     else{
         for (itMapInfo = lstMapInfo.begin(); itMapInfo != lstMapInfo.end(); itMapInfo++){
             
             if (snap_id == itMapInfo->strDevLUNID){
-                lst_map_id.push_back(itMapInfo->strMapID);
-                lst_delete_map.push_back(*itMapInfo);
+                teardown.lst_map.push_back(*itMapInfo);
                 
                 lsthost.clear();
                 cmdOperate.CMD_showhostByhostGroup(itMapInfo->strHostGroupID,lsthost);
@@ -826,71 +863,217 @@ int TestFailoverStop::_stop_test_device_out(CCmdOperate& cmdOperate, string& str
                         snap_name.c_str(),
                         strIQN.c_str());
                 }
-                
-                lst_hostgroup_id.push_back(itMapInfo->strHostGroupID);
             }
         }
 
-        for (itMapInfo = lst_delete_map.begin(); itMapInfo != lst_delete_map.end(); itMapInfo++){
-            ret = _del_map_from_dar(cmdOperate, itMapInfo->strMapID, itMapInfo->strLunGroupID,  itMapInfo->strHostGroupID, itMapInfo->strDevLUNID);
-            if (RETURN_OK != ret){
-                (void)check_success_out("", err_info);
-                return ret;
+        // unmap, disable and delete are done for all snapshots of the command in _teardown_snapshots_out
+        teardown.key = string(array_id) + "." + strid;
+        teardown.lun_id = strid;
+        teardown.snap_name = snap_name;
+        teardown.snap_id = snap_id;
+        teardown.lst_map_ret.assign(teardown.lst_map.size(), RETURN_OK);
+        teardown.err_info = &err_info;
+        teardown.success = success;
+        teardown.unmap_ret = RETURN_OK;
+        teardown.disabled = false;
+        lst_teardown.push_back(teardown);
+    }
+
+    return RETURN_OK;
+}
+
+void TestFailoverStop::_teardown_snapshots_out(CCmdOperate& cmdOperate)
+{
+    HYPER_STORAGE_STRU stStorageInfo;
+    unsigned long long begin_time = 0;
+    size_t index = 0;
+
+    if (lst_teardown.empty()){
+        return;
+    }
+
+    (void)setStorageInfo(stStorageInfo);
+    begin_time = OS_GetTickCount();
+
+    {
+        // one pool for unmap, disable and delete, its worker sessions serve all three
+        TaskPool pool(stStorageInfo);
+
+        _unmap_snapshots_out(cmdOperate, pool);
+        _delete_snapshots_out(cmdOperate, pool);
+    }
+
+    COMMLOG(OS_LOG_INFO, "teardown of %u snapshots takes %llu ms.", (unsigned int)lst_teardown.size(), OS_GetTickCount() - begin_time);
+
+    for (index = 0; index < lst_teardown.size(); index++){
+        SnapTeardown_Info& teardown = lst_teardown[index];
+
+        if (RETURN_OK != teardown.unmap_ret){
+            (void)check_success_out("", *teardown.err_info);
+            COMMLOG(OS_LOG_ERROR,"_stop_test_device_out with key [%s]error[%d]",
+                teardown.key.c_str(), teardown.unmap_ret);
+        }
+        else if (teardown.lst_map.empty()){
+            teardown.err_info->desc = "The snapshot is not mapped to ESX host.";
+            teardown.err_info->hint = "Please check the information from array.";
+            COMMLOG(OS_LOG_WARN, "can not find map id by lun snapshot(%s),maybe the snapshot is not mapped.", teardown.lun_id.c_str());
+        }
+        else if (NULL != teardown.success){
+            *teardown.success = true;
+        }
+
+        COMMLOG(OS_LOG_INFO, "Complete: Temporary Snapshot Copy of [%s] has been removed from service and destroyed for testFailoverStop request.",
+            teardown.key.c_str());
+        print("Complete: Temporary Snapshot Copy of [%s] has been removed from service and destroyed for testFailoverStop request.",
+            teardown.key.c_str());
+    }
+
+    lst_teardown.clear();
+
+    return;
+}
+
+void TestFailoverStop::_unmap_snapshots_out(CCmdOperate& cmdOperate, TaskPool& pool)
+{
+    vector<UnmapSnapshotTask *> lst_group;
+    size_t index = 0;
+    size_t map_index = 0;
+    size_t group_index = 0;
+
+    for (index = 0; index < lst_teardown.size(); index++){
+        for (map_index = 0; map_index < lst_teardown[index].lst_map.size(); map_index++){
+            MAP_INFO_STRU& map_info = lst_teardown[index].lst_map[map_index];
+            UnmapSnapshotTask *group = NULL;
+
+            for (group_index = 0; group_index < lst_group.size();){
+                UnmapSnapshotTask *cur = lst_group[group_index];
+                if ((cur->lun_groups.end() == cur->lun_groups.find(map_info.strLunGroupID))
+                    && (cur->host_groups.end() == cur->host_groups.find(map_info.strHostGroupID))){
+                    group_index++;
+                    continue;
+                }
+
+                if (NULL == group){
+                    group = cur;
+                    group_index++;
+                    continue;
+                }
+
+                // the map joins two groups, merge them
+                group->lun_groups.insert(cur->lun_groups.begin(), cur->lun_groups.end());
+                group->host_groups.insert(cur->host_groups.begin(), cur->host_groups.end());
+                group->lst_ref.insert(group->lst_ref.end(), cur->lst_ref.begin(), cur->lst_ref.end());
+                delete cur;
+                lst_group.erase(lst_group.begin() + group_index);
+            }
+
+            if (NULL == group){
+                group = new UnmapSnapshotTask();
+                lst_group.push_back(group);
             }
+
+            group->lun_groups.insert(map_info.strLunGroupID);
+            group->host_groups.insert(map_info.strHostGroupID);
+            group->lst_ref.push_back(make_pair(index, map_index));
+        }
+    }
+
+    for (group_index = 0; group_index < lst_group.size(); group_index++){
+        UnmapSnapshotTask *group = lst_group[group_index];
+
+        sort(group->lst_ref.begin(), group->lst_ref.end());
+        for (map_index = 0; map_index < group->lst_ref.size(); map_index++){
+            group->lst_map.push_back(lst_teardown[group->lst_ref[map_index].first].lst_map[group->lst_ref[map_index].second]);
         }
 
-        mSnapname = snap_name;
-        _delete_snapshot_out(cmdOperate, snap_id);
+        pool.add(group);
+    }
+
+    pool.run(cmdOperate);
 
-        if (lst_map_id.empty()){
-            err_info.desc = "The snapshot is not mapped to ESX host.";
-            err_info.hint = "Please check the information from array.";
-            COMMLOG(OS_LOG_WARN, "can not find map id by lun snapshot(%s),maybe the snapshot is not mapped.", strid.c_str());
+    for (group_index = 0; group_index < lst_group.size(); group_index++){
+        UnmapSnapshotTask *group = lst_group[group_index];
 
-            return RETURN_ERR;
+        for (map_index = 0; map_index < group->lst_ref.size(); map_index++){
+            lst_teardown[group->lst_ref[map_index].first].lst_map_ret[group->lst_ref[map_index].second] = group->lst_ret[map_index];
         }
     }
 
-    return RETURN_OK;
+    for (index = 0; index < lst_teardown.size(); index++){
+        for (map_index = 0; map_index < lst_teardown[index].lst_map_ret.size(); map_index++){
+            if (RETURN_OK != lst_teardown[index].lst_map_ret[map_index]){
+                lst_teardown[index].unmap_ret = lst_teardown[index].lst_map_ret[map_index];
+                break;
+            }
+        }
+    }
+
+    return;
 }
 
-void TestFailoverStop::_delete_snapshot_out(CCmdOperate& cmdOperate, string& snap_id)
+void TestFailoverStop::_delete_snapshots_out(CCmdOperate& cmdOperate, TaskPool& pool)
 {
-    int ret = RETURN_ERR; 
-    if (isNFS){
-        COMMLOG(OS_LOG_INFO, "Snapshot copy [%s] is being deleted", mSnapname.c_str());
-        print("Snapshot copy [%s] is being deleted", mSnapname.c_str());
-        ret = cmdOperate.CMD_delFShyimg(snap_id);
-        if (RETURN_OK != ret){
-            COMMLOG(OS_LOG_WARN, "can not delete snapshot(%s)", mSnapname.c_str());
-            return;
+    vector<size_t> lst_index;
+    size_t index = 0;
+
+    pool.clear();
+    for (index = 0; index < lst_teardown.size(); index++){
+        if (RETURN_OK != lst_teardown[index].unmap_ret){
+            continue;
         }
 
-        return;
+        COMMLOG(OS_LOG_INFO, "Snapshot copy [%s] is being offlined", lst_teardown[index].snap_name.c_str());
+        print("Snapshot copy [%s] is being offlined", lst_teardown[index].snap_name.c_str());
+        pool.add(new DisableSnapshotTask(lst_teardown[index].snap_id));
+        lst_index.push_back(index);
     }
-    
-    COMMLOG(OS_LOG_INFO, "Snapshot copy [%s] is being offlined", mSnapname.c_str());
-    print("Snapshot copy [%s] is being offlined", mSnapname.c_str());
-    ret = cmdOperate.CMD_disablehyimg(snap_id);
-    if (RETURN_OK != ret){
-        COMMLOG(OS_LOG_WARN, "can not disable snapshot:(%s)", mSnapname.c_str());
+
+    pool.run(cmdOperate);
+
+    for (index = 0; index < lst_index.size(); index++){
+        SnapTeardown_Info& teardown = lst_teardown[lst_index[index]];
+
+        if (RETURN_OK != pool.at(index)->result){
+            COMMLOG(OS_LOG_WARN, "can not disable snapshot:(%s)", teardown.snap_name.c_str());
+            continue;
+        }
+
+        teardown.disabled = true;
+    }
+
+    pool.clear();
+    lst_index.clear();
+    for (index = 0; index < lst_teardown.size(); index++){
+        if (lst_teardown[index].disabled){
+            lst_index.push_back(index);
+        }
+    }
+
+    if (lst_index.empty()){
         return;
     }
 
+    // one wait for all disabled snapshots instead of one per snapshot
     OS_Sleep(5000);
-    COMMLOG(OS_LOG_INFO, "Snapshot copy [%s] is being deleted", mSnapname.c_str());
-    print("Snapshot copy [%s] is being deleted", mSnapname.c_str());
-    ret = cmdOperate.CMD_delhyimg(snap_id);
-    if (RETURN_OK != ret){
 
-        COMMLOG(OS_LOG_WARN, "can not delete snapshot(%s)", mSnapname.c_str());
-        return;
+    for (index = 0; index < lst_index.size(); index++){
+        COMMLOG(OS_LOG_INFO, "Snapshot copy [%s] is being deleted", lst_teardown[lst_index[index]].snap_name.c_str());
+        print("Snapshot copy [%s] is being deleted", lst_teardown[lst_index[index]].snap_name.c_str());
+        pool.add(new DeleteSnapshotTask(lst_teardown[lst_index[index]].snap_id));
+    }
+
+    pool.run(cmdOperate);
+
+    for (index = 0; index < lst_index.size(); index++){
+        if (RETURN_OK != pool.at(index)->result){
+            COMMLOG(OS_LOG_WARN, "can not delete snapshot(%s)", lst_teardown[lst_index[index]].snap_name.c_str());
+        }
     }
 
     return;
 }
 
-int TestFailoverStop::_del_map_from_dar(CCmdOperate& cmdOperate, const string& mapID, const string& lunGroupID,  const string& hostGroupID, const string& snapID)
+static int del_map_from_dar(CCmdOperate& cmdOperate, const string& mapID, const string& lunGroupID,  const string& hostGroupID, const string& snapID)
 {
     int ret = RETURN_ERR;
   
@@ -910,7 +1093,8 @@ int TestFailoverStop::_del_map_from_dar(CCmdOperate& cmdOperate, const string& m
         COMMLOG(OS_LOG_WARN, "the Lun Number is [%u], the snapshot number is [%u] included by lunGroup[%s]  ", lstLunIDs.size(), lstSnapShot.size(), lunGroupID.c_str());
     }
 
-    if (lstLunIDs.size() != 0 && lstSnapShot.size() != 0){
+    // the lun group is shared with other devices, take only this snapshot out of it
+    if (lstLunIDs.size() + lstSnapShot.size() > 1 && lstSnapShot.size() != 0){
         list<HYIMAGE_INFO_STRU>::iterator itrLstSnapShot = lstSnapShot.begin();
         for (; itrLstSnapShot != lstSnapShot.end(); itrLstSnapShot++){
             if (snapID == itrLstSnapShot->strID){
@@ -17,6 +17,21 @@
 
 #include "sra_basic.h"
 #include "../common/xml_node/target_groups.h"
+#include "task_pool.h"
+
+typedef struct tag_snapTeardownInfo
+{
+    string key;
+    string lun_id;
+    string snap_name;
+    string snap_id;
+    vector<MAP_INFO_STRU> lst_map;
+    vector<int> lst_map_ret;
+    ErrorInfo *err_info;
+    bool *success;
+    int unmap_ret;
+    bool disabled;
+}SnapTeardown_Info;
 
 int test_failover_stop(XmlReader &reader);
 
@@ -40,10 +55,11 @@ private:
     void _deal_hymirror_out(CCmdOperate& cmdOperate);
     void _deal_hypermetro_out(CCmdOperate& cmdOperate);
     void _del_lun_snapshot_out(CCmdOperate& cmdOperate, list<CommonLunInfo>& lst_lun_info, ErrorInfo& errorinfo, WarnInfo& warn_info);
-    int _stop_test_device_out(CCmdOperate& cmdOperate, string& lun_id, ErrorInfo& err_info, WarnInfo& warnInfo);
-    void _delete_snapshot_out(CCmdOperate& cmdOperate, string& snap_id);
+    int _stop_test_device_out(CCmdOperate& cmdOperate, string& lun_id, ErrorInfo& err_info, WarnInfo& warnInfo, bool *success);
 
-    int _del_map_from_dar(CCmdOperate& cmdOperate, const string& mapID, const string& lunGroupID,  const string& hostID, const string& snapID);
+    void _teardown_snapshots_out(CCmdOperate& cmdOperate);
+    void _unmap_snapshots_out(CCmdOperate& cmdOperate, TaskPool& pool);
+    void _delete_snapshots_out(CCmdOperate& cmdOperate, TaskPool& pool);
 
 private:
     char input_array_id[LENGTH_COMMON];
@@ -53,7 +69,7 @@ private:
     TargetGroupsInfo targetconsisgrs_info;
     TargetDevicesInfo tartgetdevs_info;
 
-    string mSnapname;
+    vector<SnapTeardown_Info> lst_teardown;
 };
 
 
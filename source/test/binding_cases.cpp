@@ -0,0 +1,202 @@
+// Copyright 2019 The OpenSDS Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use this file except in compliance with the License. You may obtain
+// a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "xml_bench.h"
+#include "xml_corpus.h"
+#include "common.h"
+#include "command_para.h"
+#include "Commf.h"
+
+#define CHECK_DEVICES       20
+
+/* the lists of doc streamed, as main loads them, and read from the DOM */
+static bool parse_lists(const string &doc, const char *para, CommandPara &streamed, CommandPara &dom)
+{
+    XmlReader stream_reader;
+    XmlReader dom_reader;
+    bool is_streamed = false;
+
+    BENCH_EXPECT(load_command(stream_reader, doc, is_streamed));
+    BENCH_EXPECT(is_streamed);
+    streamed.swap(g_command_para);
+    g_command_para.clear();
+
+    BENCH_EXPECT(dom_reader.load_from_string(doc, TIXML_DEFAULT_ENCODING));
+    dom.read(dom_reader, (string(XML_COMMAND) + "/" + para).c_str());
+
+    return true;
+}
+
+static bool lists_round_trip(const CORPUS_COMMAND &cmd, int devices)
+{
+    CommandPara expected;
+    CommandPara streamed;
+    CommandPara dom;
+
+    corpus_lists(cmd, devices, expected);
+    BENCH_EXPECT(parse_lists(corpus_command(cmd, devices), cmd.para, streamed, dom));
+
+    BENCH_EXPECT(bench_same_text(corpus_para_dump(streamed), corpus_para_dump(expected)));
+    BENCH_EXPECT(bench_same_text(corpus_para_dump(dom), corpus_para_dump(expected)));
+    BENCH_EXPECT(streamed.is_loaded() == (0 != cmd.lists));
+
+    return true;
+}
+
+/*
+ The lists the generator wrote come back through the binding table, keys
+ unescaped and nested access groups joined, both streamed and from the
+ DOM. A command reads nothing for the lists it does not carry.
+*/
+static bool binding_lists_round_trip()
+{
+    for (const CORPUS_COMMAND *cmd = g_corpus_commands; NULL != cmd->name; cmd++){
+        printf("  %s\n", cmd->name);
+        BENCH_EXPECT(lists_round_trip(*cmd, CHECK_DEVICES));
+    }
+
+    printf("  every list\n");
+    BENCH_EXPECT(lists_round_trip(g_corpus_every_list, CHECK_DEVICES));
+    BENCH_EXPECT(lists_round_trip(g_corpus_every_list, 1));
+
+    return true;
+}
+XML_CHECK_CASE(binding_lists_round_trip);
+
+static string replace_first(const string &doc, const string &from, const string &to)
+{
+    string result = doc;
+    string::size_type pos = result.find(from);
+
+    if (string::npos != pos){
+        (void)result.replace(pos, from.size(), to);
+    }
+
+    return result;
+}
+
+/*
+ A list element without its required key marks the command, one without
+ an optional id still counts, and elements the table does not know are
+ skipped. Streamed and DOM reads agree on all of them.
+*/
+static bool binding_malformed_lists()
+{
+    string doc = corpus_command(g_corpus_every_list, CHECK_DEVICES);
+    CommandPara expected;
+    const char *edits[][3] = {
+        // from, to, whether the key goes missing
+        {"<TargetDevice key=\"", "<TargetDevice kee=\"", "1"},
+        {"<SourceDevice id=\"", "<SourceDevice name=\"", "1"},
+        {"<ConsistencyGroup id=\"", "<ConsistencyGroup name=\"", "1"},
+        {"<TargetGroup key=\"", "<TargetGroup name=\"", "1"},
+        {"<AccessGroup id=\"", "<AccessGroup name=\"", "0"},
+        {"<Initiator id=\"", "<Initiator name=\"", "0"},
+        {"<TargetDevices>", "<TargetDevices><Unknown key=\"x\"><TargetDevice key=\"y\"/></Unknown>", "0"},
+        {"<SourceDevices>", "<SourceDevices><SourceDevice id=\"s\"><SourceDevice id=\"t\"/></SourceDevice>", "0"},
+        {NULL, NULL, NULL}};
+
+    corpus_lists(g_corpus_every_list, CHECK_DEVICES, expected);
+
+    for (int i = 0; NULL != edits[i][0]; i++){
+        string edited = replace_first(doc, edits[i][0], edits[i][1]);
+        CommandPara streamed;
+        CommandPara dom;
+
+        printf("  %s\n", edits[i][1]);
+        BENCH_EXPECT(edited != doc);
+        BENCH_EXPECT(parse_lists(edited, g_corpus_every_list.para, streamed, dom));
+        BENCH_EXPECT(bench_same_text(corpus_para_dump(streamed), corpus_para_dump(dom)));
+        BENCH_EXPECT(streamed.is_key_missing() == ('1' == edits[i][2][0]));
+        BENCH_EXPECT(expected.target_devices.size() == streamed.target_devices.size());
+        BENCH_EXPECT(expected.dar_hosts.size() == streamed.dar_hosts.size());
+        // the nested SourceDevice of the last edit is not a list element, the outer one is
+        BENCH_EXPECT(expected.source_devices.size() + ((7 == i) ? 1 : 0) == streamed.source_devices.size());
+    }
+
+    return true;
+}
+XML_CHECK_CASE(binding_malformed_lists);
+
+/*
+ A list key is held to the length of a scalar field: at the limit it is
+ kept, one more character drops the element and get_value_error() names
+ it, streamed and from the DOM alike.
+*/
+static bool binding_key_length()
+{
+    string doc = corpus_command(g_corpus_every_list, CHECK_DEVICES);
+    CommandPara expected;
+    const char *keys[] = {"<TargetDevice key=\"", "<SourceDevice id=\"", "<ConsistencyGroup id=\"",
+        "<TargetGroup key=\"", "<AccessGroup id=\"", NULL};
+
+    corpus_lists(g_corpus_every_list, CHECK_DEVICES, expected);
+
+    for (int i = 0; NULL != keys[i]; i++){
+        string at_limit = replace_first(doc, keys[i], keys[i] + string(LENGTH_COMMON - 1, 'k') + "\" x=\"");
+        string too_long = replace_first(doc, keys[i], keys[i] + string(LENGTH_COMMON, 'k') + "\" x=\"");
+        CommandPara streamed;
+        CommandPara dom;
+
+        printf("  %s\n", keys[i]);
+        BENCH_EXPECT(parse_lists(at_limit, g_corpus_every_list.para, streamed, dom));
+        BENCH_EXPECT(streamed.get_value_error().empty());
+        BENCH_EXPECT(dom.get_value_error().empty());
+
+        BENCH_EXPECT(parse_lists(too_long, g_corpus_every_list.para, streamed, dom));
+        BENCH_EXPECT(bench_same_text(corpus_para_dump(streamed), corpus_para_dump(dom)));
+        BENCH_EXPECT(string::npos != streamed.get_value_error().find(" is too long"));
+        BENCH_EXPECT(streamed.get_value_error() == dom.get_value_error());
+        BENCH_EXPECT(!streamed.is_key_missing());
+    }
+
+    // the dropped element is missing from its list
+    string too_long = replace_first(doc, keys[1], keys[1] + string(LENGTH_COMMON, 'k') + "\" x=\"");
+    CommandPara streamed;
+    CommandPara dom;
+
+    BENCH_EXPECT(parse_lists(too_long, g_corpus_every_list.para, streamed, dom));
+    BENCH_EXPECT(expected.source_devices.size() == streamed.source_devices.size() + 1);
+
+    return true;
+}
+XML_CHECK_CASE(binding_key_length);
+
+/*
+ A command with every list at half and at the full scale, 10000 devices
+ by default: one pass over the elements keeps the time per byte the same.
+*/
+static bool binding_parse_bench()
+{
+    int devices = bench_scale(10000);
+    int sizes[] = {devices / 2, devices};
+
+    for (int i = 0; i < 2; i++){
+        string doc = corpus_command(g_corpus_every_list, sizes[i]);
+        CommandPara expected;
+        XmlReader reader;
+        bool streamed = false;
+
+        BenchMeter meter("load_command every list " + OS_IToString(sizes[i]));
+        BENCH_EXPECT(load_command(reader, doc, streamed));
+        meter.done(doc.size(), (size_t)sizes[i]);
+
+        corpus_lists(g_corpus_every_list, sizes[i], expected);
+        BENCH_EXPECT(corpus_para_dump(expected) == corpus_para_dump(g_command_para));
+        g_command_para.clear();
+    }
+
+    return true;
+}
+XML_BENCH_CASE(binding_parse_bench);
@@ -0,0 +1,210 @@
+// Copyright 2019 The OpenSDS Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use this file except in compliance with the License. You may obtain
+// a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include <stdint.h>
+#include <cctype>
+#include "xml_bench.h"
+#include "xml_corpus.h"
+#include "common.h"
+#include "command_para.h"
+
+#define CHECK_DEVICES       20
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+/* bytes a mutation writes into a document, the ones a parser cares about */
+static const char g_mutation_bytes[] = "<>&\"'/=;#\0 ";
+
+static void fuzz_one(const string &doc)
+{
+    (void)LLVMFuzzerTestOneInput((const uint8_t *)doc.data(), doc.size());
+}
+
+static bool load_command_corpus()
+{
+    for (const CORPUS_COMMAND *cmd = g_corpus_commands; NULL != cmd->name; cmd++){
+        XmlReader reader;
+        bool streamed = false;
+        char name[LENGTH_COMMON] = {0};
+
+        BENCH_EXPECT(load_command(reader, corpus_command(*cmd, CHECK_DEVICES), streamed));
+        BENCH_EXPECT(streamed);
+        BENCH_EXPECT(reader.get_cstring(XML_COMMANDNAME, name));
+        BENCH_EXPECT(0 == strcmp(name, cmd->name));
+        BENCH_EXPECT(g_command_para.is_loaded() == (0 != cmd->lists));
+        BENCH_EXPECT(!g_command_para.is_key_missing());
+        if (0 != (cmd->lists & CORPUS_SOURCE_DEVICES)){
+            BENCH_EXPECT(CHECK_DEVICES == g_command_para.source_devices.size());
+        }
+        if (0 != (cmd->lists & CORPUS_TARGET_DEVICES)){
+            BENCH_EXPECT(CHECK_DEVICES == g_command_para.target_devices.size());
+        }
+        g_command_para.clear();
+    }
+
+    for (size_t i = 0; i < bench_files().size(); i++){
+        XmlReader reader;
+        bool streamed = false;
+        string doc;
+
+        BENCH_EXPECT(bench_read_file(bench_files()[i], doc));
+        BENCH_EXPECT(load_command(reader, doc, streamed));
+        BENCH_EXPECT(streamed);
+        g_command_para.clear();
+    }
+
+    return true;
+}
+XML_CHECK_CASE(load_command_corpus);
+
+/*
+ Replay the corpus and broken variants of it through the fuzz entry, so a
+ crash the fuzzer would find on these inputs fails the check as well.
+*/
+static bool fuzz_replay()
+{
+    vector<string> docs;
+
+    for (const CORPUS_COMMAND *cmd = g_corpus_commands; NULL != cmd->name; cmd++){
+        docs.push_back(corpus_command(*cmd, 3));
+    }
+    for (size_t i = 0; i < bench_files().size(); i++){
+        string doc;
+
+        BENCH_EXPECT(bench_read_file(bench_files()[i], doc));
+        docs.push_back(doc);
+    }
+
+    fuzz_one("");
+    for (size_t i = 0; i < docs.size(); i++){
+        const string &doc = docs[i];
+
+        fuzz_one(doc);
+        for (size_t len = 0; len < doc.size(); len += 13){
+            fuzz_one(doc.substr(0, len));
+        }
+        for (size_t pos = 0; pos < doc.size(); pos += 7){
+            string mutated = doc;
+
+            mutated[pos] = g_mutation_bytes[pos % (sizeof(g_mutation_bytes) - 1)];
+            fuzz_one(mutated);
+        }
+    }
+
+    return true;
+}
+XML_CHECK_CASE(fuzz_replay);
+
+/* the parameter element of a command, <Name>Parameters as in FailoverParameters */
+static string para_path(XmlReader &reader)
+{
+    char name[LENGTH_COMMON] = {0};
+
+    if (!reader.get_cstring(XML_COMMANDNAME, name) || '\0' == name[0]){
+        return "";
+    }
+    name[0] = (char)toupper((unsigned char)name[0]);
+
+    return string(XML_COMMAND) + "/" + name + "Parameters";
+}
+
+/*
+ Load doc streamed, as main does, and into the DOM alone, then read the
+ lists with CommandPara::read. Both give the same lists, and the scalars
+ left in the streamed document read the same as in the whole one.
+*/
+static bool stream_matches_dom(const string &doc)
+{
+    XmlReader stream_reader;
+    XmlReader dom_reader;
+    CommandPara streamed;
+    CommandPara dom;
+    bool is_streamed = false;
+    const char *scalars[] = {XML_REQUSET_TITLE, XML_COMMANDNAME, XML_OUTPUTFILE, XML_STATUSFILE,
+        XML_LOGDIRECTORY, XML_LOGLEVEL, XML_USERNAME, XML_PASSWD, NULL};
+
+    BENCH_EXPECT(load_command(stream_reader, doc, is_streamed));
+    BENCH_EXPECT(is_streamed);
+    streamed.swap(g_command_para);
+    g_command_para.clear();
+
+    BENCH_EXPECT(dom_reader.load_from_string(doc, TIXML_DEFAULT_ENCODING));
+    dom.read(dom_reader, para_path(dom_reader).c_str());
+
+    BENCH_EXPECT(bench_same_text(corpus_para_dump(streamed), corpus_para_dump(dom)));
+
+    for (int i = 0; NULL != scalars[i]; i++){
+        string stream_value;
+        string dom_value;
+
+        BENCH_EXPECT(stream_reader.get_string(scalars[i], stream_value, LEGNTH_PATH) ==
+            dom_reader.get_string(scalars[i], dom_value, LEGNTH_PATH));
+        BENCH_EXPECT(bench_same_text(stream_value, dom_value));
+    }
+    BENCH_EXPECT(stream_reader.get_count(XML_ARRAYSN) == dom_reader.get_count(XML_ARRAYSN));
+
+    return true;
+}
+
+/* the streamed lists against the DOM ones, for every command and demo input */
+static bool stream_corpus_matches_dom()
+{
+    for (const CORPUS_COMMAND *cmd = g_corpus_commands; NULL != cmd->name; cmd++){
+        printf("  %s\n", cmd->name);
+        BENCH_EXPECT(stream_matches_dom(corpus_command(*cmd, CHECK_DEVICES)));
+    }
+
+    for (size_t i = 0; i < bench_files().size(); i++){
+        string doc;
+
+        printf("  %s\n", bench_files()[i].c_str());
+        BENCH_EXPECT(bench_read_file(bench_files()[i], doc));
+        BENCH_EXPECT(stream_matches_dom(doc));
+    }
+
+    return true;
+}
+XML_CHECK_CASE(stream_corpus_matches_dom);
+
+static bool load_command_bench()
+{
+    int devices = bench_scale(10000);
+
+    for (const CORPUS_COMMAND *cmd = g_corpus_commands; NULL != cmd->name; cmd++){
+        string doc = corpus_command(*cmd, devices);
+        XmlReader reader;
+        bool streamed = false;
+
+        BenchMeter meter(string("load_command ") + cmd->name);
+        BENCH_EXPECT(load_command(reader, doc, streamed));
+        meter.done(doc.size(), (size_t)devices);
+        g_command_para.clear();
+
+        if (0 == cmd->lists){
+            continue;
+        }
+
+        // what the streaming saves: the whole command in the DOM, then read()
+        XmlReader dom_reader;
+        CommandPara dom;
+
+        BenchMeter dom_meter(string("load_from_string+read ") + cmd->name);
+        BENCH_EXPECT(dom_reader.load_from_string(doc, TIXML_DEFAULT_ENCODING));
+        dom.read(dom_reader, para_path(dom_reader).c_str());
+        dom_meter.done(doc.size(), (size_t)devices);
+    }
+
+    return true;
+}
+XML_BENCH_CASE(load_command_bench);
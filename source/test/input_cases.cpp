@@ -0,0 +1,171 @@
+// Copyright 2019 The OpenSDS Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use this file except in compliance with the License. You may obtain
+// a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include <fstream>
+#include "xml_bench.h"
+#include "xml_corpus.h"
+#include "common.h"
+#include "command_para.h"
+
+#define CHECK_DEVICES       20
+#define COMMAND_FILE        "xml_bench_command.xml"
+#define COMMAND_MB          50
+
+static bool write_command(const string &doc)
+{
+    FILE *fp = fopen(COMMAND_FILE, "wb");
+
+    BENCH_EXPECT(NULL != fp);
+    BENCH_EXPECT(doc.size() == fwrite(doc.data(), 1, doc.size(), fp));
+    BENCH_EXPECT(0 == fclose(fp));
+
+    return true;
+}
+
+/* doc read back by read_command from a file, or from a pipe that cannot seek */
+static bool read_back(const string &doc, bool pipe, string &input)
+{
+    FILE *fp = NULL;
+    bool ok = false;
+
+    BENCH_EXPECT(write_command(doc));
+    fp = pipe ? popen("cat " COMMAND_FILE, "r") : fopen(COMMAND_FILE, "rb");
+    BENCH_EXPECT(NULL != fp);
+
+    ok = read_command(fp, input);
+    if (pipe){
+        BENCH_EXPECT(0 == pclose(fp));
+    }
+    else{
+        BENCH_EXPECT(0 == fclose(fp));
+    }
+    (void)remove(COMMAND_FILE);
+
+    return ok;
+}
+
+/*
+ A command read the way main reads stdin is the document that was written,
+ and loads into the lists it was generated from. Documents larger than one
+ read block check the block loop of a pipe.
+*/
+static bool read_command_round_trip()
+{
+    int sizes[] = {0, 1, CHECK_DEVICES, 200};
+    string input;
+
+    for (int pipe = 0; pipe < 2; pipe++){
+        for (int i = 0; i < (int)(sizeof(sizes) / sizeof(sizes[0])); i++){
+            string doc = corpus_command(g_corpus_every_list, sizes[i]);
+            CommandPara expected;
+            XmlReader reader;
+            bool streamed = false;
+
+            BENCH_EXPECT(read_back(doc, 0 != pipe, input));
+            BENCH_EXPECT(input == doc);
+
+            corpus_lists(g_corpus_every_list, sizes[i], expected);
+            BENCH_EXPECT(load_command(reader, input, streamed));
+            BENCH_EXPECT(streamed);
+            BENCH_EXPECT(bench_same_text(corpus_para_dump(g_command_para), corpus_para_dump(expected)));
+            g_command_para.clear();
+        }
+
+        // nothing to read is not an error of the read, the load refuses it
+        XmlReader reader;
+        bool streamed = false;
+        BENCH_EXPECT(read_back("", 0 != pipe, input));
+        BENCH_EXPECT(input.empty());
+        BENCH_EXPECT(!load_command(reader, input, streamed));
+        g_command_para.clear();
+    }
+    BENCH_EXPECT(!read_command(NULL, input));
+
+    return true;
+}
+XML_CHECK_CASE(read_command_round_trip);
+
+/* the command read as main read it before: line by line, then copied into the parser */
+static bool getline_command(const char *file, string &input)
+{
+    std::ifstream in(file);
+    string line;
+
+    input.clear();
+    BENCH_EXPECT(in.is_open());
+    while (getline(in, line)){
+        input += line;
+        input += "\n";
+    }
+
+    return true;
+}
+
+/*
+ A command of about 50 MB: read_command from a file and from a pipe, then
+ load_command, each with its time and peak memory. The line by line read
+ with a copy into load_from_string is the before.
+*/
+static bool read_command_bench()
+{
+    int devices = 0;
+    string doc;
+    string input;
+
+    // devices to reach COMMAND_MB, from the size of a smaller document
+    devices = bench_scale((int)((size_t)COMMAND_MB * 1024 * 1024 /
+        (corpus_command(g_corpus_every_list, 1000).size() / 1000)));
+    doc = corpus_command(g_corpus_every_list, devices);
+    BENCH_EXPECT(write_command(doc));
+    string().swap(doc);
+
+    for (int pipe = 0; pipe < 2; pipe++){
+        FILE *fp = (0 != pipe) ? popen("cat " COMMAND_FILE, "r") : fopen(COMMAND_FILE, "rb");
+        bool ok = false;
+
+        BENCH_EXPECT(NULL != fp);
+        string().swap(input);
+        BenchMeter read((0 != pipe) ? "read_command from a pipe" : "read_command from a file");
+        ok = read_command(fp, input);
+        read.done(input.size(), (size_t)devices);
+        (void)((0 != pipe) ? pclose(fp) : fclose(fp));
+        BENCH_EXPECT(ok);
+    }
+
+    {
+        XmlReader reader;
+        bool streamed = false;
+
+        BenchMeter load("load_command every list");
+        BENCH_EXPECT(load_command(reader, input, streamed));
+        load.done(input.size(), (size_t)devices);
+        BENCH_EXPECT(streamed);
+        BENCH_EXPECT(devices == (int)g_command_para.target_devices.size());
+        g_command_para.clear();
+    }
+    string().swap(input);
+
+    {
+        XmlReader reader;
+
+        BenchMeter before("getline + load_from_string copy");
+        BENCH_EXPECT(getline_command(COMMAND_FILE, input));
+        BENCH_EXPECT(reader.load_from_string(string(input), TIXML_DEFAULT_ENCODING));
+        before.done(input.size(), (size_t)devices);
+    }
+    (void)remove(COMMAND_FILE);
+
+    return true;
+}
+XML_BENCH_CASE(read_command_bench);
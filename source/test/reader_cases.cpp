@@ -0,0 +1,145 @@
+// Copyright 2019 The OpenSDS Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use this file except in compliance with the License. You may obtain
+// a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "xml_bench.h"
+#include "xml_corpus.h"
+#include "common.h"
+#include "command_para.h"
+
+#define CHECK_DEVICES       40
+#define FAILOVER_PARA       "/Command/FailoverParameters"
+#define TARGET_DEVICE_PATH  FAILOVER_PARA "/TargetDevices/TargetDevice"
+
+typedef list<pair<string, string> > DEVICE_ACCESS;
+
+static const CORPUS_COMMAND& failover_command()
+{
+    const CORPUS_COMMAND *cmd = g_corpus_commands;
+
+    while (0 != strcmp(cmd->name, "failover")){
+        cmd++;
+    }
+
+    return *cmd;
+}
+
+/*
+ The target devices and their access groups read with indexed paths, the
+ way the commands read them before the cursors, each index walking the
+ siblings from the first one again.
+*/
+static void read_indexed(XmlReader &reader, DEVICE_ACCESS &devices)
+{
+    int device_count = reader.get_count(TARGET_DEVICE_PATH);
+
+    for (int i = 0; i < device_count; i++){
+        char target_key[LENGTH_COMMON] = {0};
+        string access;
+
+        (void)reader.get_string(TARGET_DEVICE_PATH "/@key", target_key, i);
+        int group_count = reader.get_count(TARGET_DEVICE_PATH "/AccessGroups/AccessGroup", i, 2);
+        for (int j = 0; j < group_count; j++){
+            char group_id[LENGTH_COMMON] = {0};
+
+            (void)reader.get_string(TARGET_DEVICE_PATH "/AccessGroups/AccessGroup/@id", group_id, j, i, 2);
+            access = access + group_id + DAR_HOST_SEPERATOR;
+        }
+        devices.push_back(make_pair(string(target_key), access));
+    }
+}
+
+/* the same read with cursors, one step per sibling */
+static void read_cursor(XmlReader &reader, DEVICE_ACCESS &devices)
+{
+    XmlPath key_path("@key");
+    XmlPath group_path("AccessGroups/AccessGroup");
+    XmlPath id_path("@id");
+
+    for (XmlCursor device = reader.get_cursor(TARGET_DEVICE_PATH); device.is_valid(); (void)device.next()){
+        string target_key;
+        string group_id;
+        string access;
+
+        (void)device.get_string(key_path, target_key);
+        for (XmlCursor group = device.get_child(group_path); group.is_valid(); (void)group.next()){
+            (void)group.get_string(id_path, group_id);
+            access = access + group_id + DAR_HOST_SEPERATOR;
+        }
+        devices.push_back(make_pair(target_key, access));
+    }
+}
+
+static void read_para(XmlReader &reader, DEVICE_ACCESS &devices)
+{
+    CommandPara para;
+
+    para.read(reader, FAILOVER_PARA);
+    for (list<TargetDeviceInfo>::iterator it = para.target_devices.begin(); it != para.target_devices.end(); ++it){
+        devices.push_back(make_pair(it->target_key, it->cg_accessgroups));
+    }
+}
+
+static bool cursor_read_matches_indexed()
+{
+    XmlReader reader;
+    DEVICE_ACCESS indexed;
+    DEVICE_ACCESS cursor;
+    DEVICE_ACCESS para;
+
+    BENCH_EXPECT(reader.load_from_string(corpus_command(failover_command(), CHECK_DEVICES), TIXML_DEFAULT_ENCODING));
+
+    read_indexed(reader, indexed);
+    read_cursor(reader, cursor);
+    read_para(reader, para);
+
+    BENCH_EXPECT(CHECK_DEVICES == indexed.size());
+    BENCH_EXPECT(indexed == cursor);
+    BENCH_EXPECT(indexed == para);
+
+    return true;
+}
+XML_CHECK_CASE(cursor_read_matches_indexed);
+
+/* a failover command of 5000 target devices, read indexed and with cursors */
+static bool cursor_read_bench()
+{
+    int devices = bench_scale(5000);
+    string doc = corpus_command(failover_command(), devices);
+    XmlReader reader;
+    DEVICE_ACCESS indexed;
+    DEVICE_ACCESS cursor;
+    DEVICE_ACCESS para;
+
+    BenchMeter load("load_from_string failover");
+    BENCH_EXPECT(reader.load_from_string(doc, TIXML_DEFAULT_ENCODING));
+    load.done(doc.size(), (size_t)devices);
+
+    BenchMeter read_i("read target devices indexed");
+    read_indexed(reader, indexed);
+    read_i.done(0, indexed.size());
+
+    BenchMeter read_c("read target devices by cursor");
+    read_cursor(reader, cursor);
+    read_c.done(0, cursor.size());
+
+    BenchMeter read_p("CommandPara::read failover");
+    read_para(reader, para);
+    read_p.done(0, para.size());
+
+    BENCH_EXPECT(indexed == cursor);
+    BENCH_EXPECT(indexed == para);
+
+    return true;
+}
+XML_BENCH_CASE(cursor_read_bench);
@@ -0,0 +1,257 @@
+// Copyright 2019 The OpenSDS Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use this file except in compliance with the License. You may obtain
+// a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "xml_bench.h"
+#include "xml_corpus.h"
+#include "common.h"
+#include "Commf.h"
+
+#define CHECK_DEVICES       50
+#define RECORD_FILE         "xml_bench_record.xml"
+
+/* the n-th device of every kind discoverDevices writes: stretched, NFS, with a snapshot */
+static void fill_objects(int n, SourceDevicesInfo &sources, TargetDevicesInfo &targets)
+{
+    const char *stretched[] = {"", "true", "false"};
+    const char *cptype[] = {"", "false", "true"};
+    SourceDeviceInfo &sd = append_node(sources.lst_source_devices);
+    TargetDeviceInfo &td = append_node(targets.lst_target_devices);
+
+    sd.source_id = "210235G7H00002_" + OS_IToString(n) + "_0_" + OS_IToString(n);
+    sd.source_name = (5 == n % 6) ? "" : corpus_device_name(n);
+    sd.status = (0 == n % 2) ? "read-write" : "read-only";
+    sd.stretched = stretched[n % 3];
+    sd.cptype = cptype[(n / 3) % 3];
+    if (0 == n % 4){
+        sd.identity_infofs.source_NfsName = "/fs_" + OS_IToString(n);
+    }
+    else{
+        sd.identity_info.source_wwn = "6a0b4c1100d3e5f7" + OS_IToString(n);
+    }
+    sd.target_info.target_key = (7 == n % 8) ? "" : "210235G7H00001_" + OS_IToString(n);
+
+    td.target_key = "210235G7H00001_" + OS_IToString(n);
+    td.target_id = (0 == n % 2) ? td.target_key : "";
+    td.target_name = corpus_device_name(n);
+    td.target_state = (0 == n % 2) ? "read-write" : "read-only";
+    td.stretched = stretched[n % 3];
+    if (0 == n % 4){
+        td.identity_infofs.source_NfsName = "/fs_" + OS_IToString(n);
+    }
+    else if (1 != n % 4){
+        td.identity_info.source_wwn = "6a0b4c1100d3e5f8" + OS_IToString(n);
+    }
+    if (1 == n % 5){
+        td.snapshot_info.snap_id = "snap_" + OS_IToString(n);
+        td.snapshot_info.snap_wwn = "6a0b4c1100d3e5f9" + OS_IToString(n);
+        td.snapshot_info.recoverypoint_info.rp_id = "rp_" + OS_IToString(n);
+        td.snapshot_info.recoverypoint_info.rp_name = "rp <" + OS_IToString(n) + ">";
+    }
+}
+
+/* the same device as records, the way discoverDevices keeps it */
+static void fill_records(int n, SourceDevicesInfo &sources, TargetDevicesInfo &targets)
+{
+    SourceDevicesInfo objects;
+    TargetDevicesInfo target_objects;
+
+    fill_objects(n, objects, target_objects);
+
+    const SourceDeviceInfo &from = objects.lst_source_devices.front();
+    SOURCE_DEVICE_RECORD &sd = sources.append_record();
+    sd.source_id = sources.strings.add(from.source_id);
+    sd.source_name = sources.strings.add(from.source_name);
+    sd.status = sources.strings.add(from.status);
+    sd.stretched = sources.strings.add(from.stretched);
+    sd.cptype = sources.strings.add(from.cptype);
+    sd.target_key = sources.strings.add(from.target_info.target_key);
+    sd.source_wwn = sources.strings.add(from.identity_info.source_wwn);
+    sd.source_NfsName = sources.strings.add(from.identity_infofs.source_NfsName);
+
+    const TargetDeviceInfo &target_from = target_objects.lst_target_devices.front();
+    TARGET_DEVICE_RECORD &td = targets.append_record();
+    td.target_key = targets.strings.add(target_from.target_key);
+    td.target_id = targets.strings.add(target_from.target_id);
+    td.target_name = targets.strings.add(target_from.target_name);
+    td.target_state = targets.strings.add(target_from.target_state);
+    td.stretched = targets.strings.add(target_from.stretched);
+    td.source_wwn = targets.strings.add(target_from.identity_info.source_wwn);
+    td.source_NfsName = targets.strings.add(target_from.identity_infofs.source_NfsName);
+    td.snapshot = targets.add_snapshot(target_from.snapshot_info);
+}
+
+static bool write_devices(int devices, bool as_records, string &content)
+{
+    ReplicatedDevices rep_devices;
+    XmlWriter writer;
+
+    for (int n = 0; n < devices; n++){
+        if (as_records){
+            fill_records(n, rep_devices.sources_info, rep_devices.targets_info);
+        }
+        else{
+            fill_objects(n, rep_devices.sources_info, rep_devices.targets_info);
+        }
+    }
+    BENCH_EXPECT(as_records || rep_devices.sources_info.records.empty());
+    BENCH_EXPECT(devices == 0 || !rep_devices.sources_info.empty());
+    BENCH_EXPECT(writer.set_string(XML_RESPONSE_TITLE, CORPUS_XMLNS));
+    BENCH_EXPECT(writer.set_xml("/Response", &rep_devices));
+    BENCH_EXPECT(writer.save_to_file(RECORD_FILE, content));
+
+    return true;
+}
+
+/*
+ Devices kept as records are written as the same text as the device
+ objects they replace: names to escape, empty and missing fields, NFS and
+ WWN identities, snapshots, with and without stretched storage. A list
+ moved with swap() keeps its records and their strings.
+*/
+static bool records_match_objects()
+{
+    int sizes[] = {0, 1, 2, CHECK_DEVICES};
+    bool saved_stretch = g_bstretch;
+
+    for (int stretch = 0; stretch < 2; stretch++){
+        g_bstretch = (0 != stretch);
+        for (int i = 0; i < (int)(sizeof(sizes) / sizeof(sizes[0])); i++){
+            string objects;
+            string records;
+
+            printf("  %d devices%s\n", sizes[i], g_bstretch ? ", stretched" : "");
+            BENCH_EXPECT(write_devices(sizes[i], false, objects));
+            BENCH_EXPECT(write_devices(sizes[i], true, records));
+            BENCH_EXPECT(bench_same_text(records, objects));
+        }
+    }
+    g_bstretch = saved_stretch;
+
+    {
+        ReplicatedDevices objects;
+        ReplicatedDevices records;
+        ReplicatedDevices moved;
+        XmlWriter objects_writer;
+        XmlWriter records_writer;
+        string objects_text;
+        string records_text;
+
+        corpus_response(CHECK_DEVICES, objects);
+        corpus_response_records(CHECK_DEVICES, records);
+        moved.sources_info.swap(records.sources_info);
+        moved.targets_info.swap(records.targets_info);
+        moved.storageports_info.lst_storageportsips.swap(records.storageports_info.lst_storageportsips);
+        BENCH_EXPECT(records.sources_info.empty());
+        BENCH_EXPECT(records.targets_info.empty());
+
+        BENCH_EXPECT(objects_writer.set_xml("/Response", &objects));
+        BENCH_EXPECT(objects_writer.save_to_file(RECORD_FILE, objects_text));
+        BENCH_EXPECT(records_writer.set_xml("/Response", &moved));
+        BENCH_EXPECT(records_writer.save_to_file(RECORD_FILE, records_text));
+        BENCH_EXPECT(bench_same_text(records_text, objects_text));
+    }
+    (void)remove(RECORD_FILE);
+
+    return true;
+}
+XML_CHECK_CASE(records_match_objects);
+
+/*
+ Equal strings get one offset, the empty string offset 0, and every
+ offset still gives its string after the pool grew many times over.
+*/
+static bool string_pool_interns()
+{
+    StringPool pool;
+    vector<unsigned int> ids;
+    size_t bytes = 0;
+
+    BENCH_EXPECT(0 == pool.add(""));
+    BENCH_EXPECT('\0' == pool.get(0)[0]);
+
+    for (int n = 0; n < 5000; n++){
+        ids.push_back(pool.add("device_" + OS_IToString(n)));
+    }
+    bytes = pool.bytes();
+    for (int n = 0; n < 5000; n++){
+        BENCH_EXPECT(ids[n] == pool.add("device_" + OS_IToString(n)));
+        BENCH_EXPECT(string("device_") + OS_IToString(n) == pool.get(ids[n]));
+    }
+    BENCH_EXPECT(bytes == pool.bytes());
+
+    // a prefix of a kept string is a string of its own
+    BENCH_EXPECT(ids[12] != pool.add("device_1"));
+    BENCH_EXPECT(ids[1] == pool.add("device_1"));
+    BENCH_EXPECT(string("read-only") == pool.get(pool.add("read-only")));
+
+    {
+        StringPool other;
+
+        other.swap(pool);
+        BENCH_EXPECT(string("device_42") == other.get(ids[42]));
+        BENCH_EXPECT(ids[42] == other.add("device_42"));
+        BENCH_EXPECT(1 == pool.bytes());
+        BENCH_EXPECT(0 != pool.add("device_42"));
+    }
+
+    return true;
+}
+XML_CHECK_CASE(string_pool_interns);
+
+/*
+ A discoverDevices response of 10000 devices by default, built and
+ written as a list of device objects, and as records with their strings
+ in one pool the way discoverDevices keeps them now.
+*/
+static bool record_response_bench()
+{
+    int devices = bench_scale(10000);
+    string objects_text;
+    string records_text;
+
+    {
+        ReplicatedDevices rep_devices;
+        XmlWriter writer;
+
+        BenchMeter build("build list of objects");
+        corpus_response(devices, rep_devices);
+        build.done(0, (size_t)devices);
+
+        BenchMeter write("set_xml + save_to_file list of objects");
+        BENCH_EXPECT(writer.set_xml("/Response", &rep_devices));
+        BENCH_EXPECT(writer.save_to_file(RECORD_FILE, objects_text));
+        write.done(objects_text.size(), (size_t)devices);
+    }
+
+    {
+        ReplicatedDevices rep_devices;
+        XmlWriter writer;
+
+        BenchMeter build("build records + string pool");
+        corpus_response_records(devices, rep_devices);
+        build.done(rep_devices.sources_info.strings.bytes() + rep_devices.targets_info.strings.bytes(),
+            (size_t)devices);
+
+        BenchMeter write("set_xml + save_to_file records");
+        BENCH_EXPECT(writer.set_xml("/Response", &rep_devices));
+        BENCH_EXPECT(writer.save_to_file(RECORD_FILE, records_text));
+        write.done(records_text.size(), (size_t)devices);
+    }
+    (void)remove(RECORD_FILE);
+
+    BENCH_EXPECT(records_text == objects_text);
+
+    return true;
+}
+XML_BENCH_CASE(record_response_bench);
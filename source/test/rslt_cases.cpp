@@ -0,0 +1,180 @@
+// Copyright 2019 The OpenSDS Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use this file except in compliance with the License. You may obtain
+// a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "xml_bench.h"
+#include "common.h"
+#include "rslt_parser.h"
+#include "Commf.h"
+
+#define CHECK_RECORDS       50
+#define RSLT_FILE           "xml_bench_rslt.xml"
+#define RSLT_FIELDS         "ID,Name,WWN,RunningStatus,Capacity"
+#define RSLT_FIELD_COUNT    5
+
+static string rslt_field(int record, int field)
+{
+    const char *prefix[RSLT_FIELD_COUNT] = {"", "lun_", "6a0b4c1100d3e5f7", "", ""};
+
+    switch (field){
+        case 3:
+            return (0 == record % 3) ? "27" : "28";
+        case 4:
+            return OS_IToString((record % 64 + 1) * 2097152);
+        default:
+            return prefix[field] + OS_IToString(record);
+    }
+}
+
+/* a result file of records, as the array CLI leaves it for CRsltXmlParser */
+static bool write_rslt(int records, int status, const string &extra)
+{
+    string doc;
+    FILE *fp = NULL;
+
+    doc.reserve(128 + (size_t)records * 80);
+    doc += "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<Result>\n";
+    doc += "    <Status>" + OS_IToString(status) + "</Status>\n";
+    doc += "    <Desc>" + string((0 == status) ? "success" : "failed") + "</Desc>\n";
+    doc += "    <RecordName>" RSLT_FIELDS "</RecordName>\n";
+    doc += "    <RecordValue>\n";
+    for (int n = 0; n < records; n++){
+        doc += "        <Value>";
+        for (int f = 0; f < RSLT_FIELD_COUNT; f++){
+            doc += rslt_field(n, f) + ((f + 1 < RSLT_FIELD_COUNT) ? "," : "");
+        }
+        doc += "</Value>\n";
+    }
+    doc += extra;
+    doc += "    </RecordValue>\n</Result>\n";
+
+    fp = fopen(RSLT_FILE, "wb");
+    BENCH_EXPECT(NULL != fp);
+    BENCH_EXPECT(doc.size() == fwrite(doc.data(), 1, doc.size(), fp));
+    BENCH_EXPECT(0 == fclose(fp));
+
+    return true;
+}
+
+/*
+ Every field of every record reads back from the index, lookups by field
+ value find the records a scan would, and short or failed results give
+ what the callers expect.
+*/
+static bool rslt_index_reads_back()
+{
+    const char *names[RSLT_FIELD_COUNT] = {"ID", "Name", "WWN", "RunningStatus", "Capacity"};
+    list<string> values;
+    string value;
+
+    // a trailing ',' adds no field, a short record reads its missing fields empty
+    BENCH_EXPECT(write_rslt(CHECK_RECORDS, 0, "        <Value>900,lun_900,</Value>\n"));
+    CRsltXmlParser parser(RSLT_FILE);
+
+    BENCH_EXPECT(0 == parser.GetStatus());
+    BENCH_EXPECT(CHECK_RECORDS + 1 == parser.GetRecordCount());
+    for (int n = 0; n < CHECK_RECORDS; n++){
+        for (int f = 0; f < RSLT_FIELD_COUNT; f++){
+            BENCH_EXPECT(RETURN_OK == parser.GetValue((size_t)n, names[f], value));
+            BENCH_EXPECT(rslt_field(n, f) == value);
+        }
+    }
+    BENCH_EXPECT(RETURN_OK == parser.GetValue(CHECK_RECORDS, "Name", value) && "lun_900" == value);
+    BENCH_EXPECT(RETURN_OK == parser.GetValue(CHECK_RECORDS, "WWN", value) && value.empty());
+    BENCH_EXPECT(RETURN_ERR == parser.GetValue(CHECK_RECORDS + 1, "Name", value));
+    BENCH_EXPECT(RETURN_ERR == parser.GetValue(0, "Nothing", value));
+
+    BENCH_EXPECT(RETURN_OK == parser.GetValues("ID", "17", "Name", value) && "lun_17" == value);
+    BENCH_EXPECT(RETURN_ERR == parser.GetValues("ID", "4711", "Name", value));
+    BENCH_EXPECT(RETURN_ERR == parser.GetValues("Nothing", "17", "Name", value));
+    BENCH_EXPECT(RETURN_OK == parser.GetValues("RunningStatus", "27", "ID", &values));
+    BENCH_EXPECT((CHECK_RECORDS + 2) / 3 == values.size());
+    for (list<string>::iterator it = values.begin(); it != values.end(); ++it){
+        BENCH_EXPECT(0 == atoi(it->c_str()) % 3);
+    }
+    BENCH_EXPECT(RETURN_OK == parser.GetValues("", "", "ID", &values));
+    BENCH_EXPECT(CHECK_RECORDS + 1 == values.size());
+
+    // a new file at the same path is indexed again once the path is set
+    BENCH_EXPECT(write_rslt(3, 0, ""));
+    BENCH_EXPECT(CHECK_RECORDS + 1 == parser.GetRecordCount());
+    BENCH_EXPECT(RETURN_OK == parser.SetRstlFilePath(RSLT_FILE));
+    BENCH_EXPECT(3 == parser.GetRecordCount());
+
+    BENCH_EXPECT(write_rslt(3, 1077948993, ""));
+    CRsltXmlParser failed(RSLT_FILE);
+    BENCH_EXPECT(1077948993 == failed.GetStatus());
+    BENCH_EXPECT(RETURN_ERR == failed.GetValues("ID", "1", "Name", value));
+    BENCH_EXPECT(RETURN_OK == failed.GetDescription(value) && "failed" == value);
+    (void)remove(RSLT_FILE);
+
+    return true;
+}
+XML_CHECK_CASE(rslt_index_reads_back);
+
+/*
+ A 10000 record result: load and index it, read every field of every
+ record from the index, and read the records with indexed get_string
+ calls as the parser did before the index.
+*/
+static bool rslt_index_bench()
+{
+    int records = bench_scale(10000);
+    const char *names[RSLT_FIELD_COUNT] = {"ID", "Name", "WWN", "RunningStatus", "Capacity"};
+    size_t file_size = 0;
+    size_t fields = 0;
+    string value;
+
+    BENCH_EXPECT(write_rslt(records, 0, ""));
+    BENCH_EXPECT(bench_read_file(RSLT_FILE, value));
+    file_size = value.size();
+
+    {
+        CRsltXmlParser parser(RSLT_FILE);
+
+        BenchMeter load("CRsltXmlParser load and index");
+        BENCH_EXPECT(records == parser.GetRecordCount());
+        load.done(file_size, (size_t)records);
+
+        BenchMeter get("CRsltXmlParser GetValue every field");
+        for (int n = 0; n < records; n++){
+            for (int f = 0; f < RSLT_FIELD_COUNT; f++){
+                BENCH_EXPECT(RETURN_OK == parser.GetValue((size_t)n, names[f], value));
+                fields++;
+            }
+        }
+        get.done(0, fields);
+
+        BenchMeter lookup("CRsltXmlParser GetValues by ID, 100 ids");
+        for (int n = 0; n < 100; n++){
+            BENCH_EXPECT(RETURN_OK == parser.GetValues("ID", OS_IToString(n * (records / 100)), "Name", value));
+        }
+        lookup.done(0, 100);
+    }
+
+    {
+        XmlReader reader;
+        char record[MAX_TMP_BUFFER] = {0};
+
+        BenchMeter indexed("get_string every record indexed");
+        BENCH_EXPECT(reader.load_from_filename(RSLT_FILE, TIXML_DEFAULT_ENCODING));
+        for (int n = 0; n < records; n++){
+            BENCH_EXPECT(reader.get_string("/Result/RecordValue/Value", record, n));
+        }
+        indexed.done(file_size, (size_t)records);
+    }
+    (void)remove(RSLT_FILE);
+
+    return true;
+}
+XML_BENCH_CASE(rslt_index_bench);
@@ -0,0 +1,221 @@
+// Copyright 2019 The OpenSDS Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use this file except in compliance with the License. You may obtain
+// a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include <climits>
+#include "xml_bench.h"
+#include "xml_corpus.h"
+#include "common.h"
+#include "../common/xmlserial/xmlwriter.h"
+#include "../common/xmlserial/xmlreader.h"
+
+#define VALUE_FILE          "xml_bench_values.xml"
+#define VALUE_ROOT          "/Values"
+#define SHORT_BUF           8
+
+typedef struct
+{
+    const char *path;
+    string value;
+} VALUE_ITEM;
+
+/* values as the commands carry them, escaped on write and read back as written */
+static void value_items(vector<VALUE_ITEM> &items)
+{
+    VALUE_ITEM item;
+
+    item.path = VALUE_ROOT "/Name";
+    item.value = corpus_device_name(3);
+    items.push_back(item);
+
+    item.path = VALUE_ROOT "/Name/@key";
+    item.value = "210235G7H00001_3&<\">'";
+    items.push_back(item);
+
+    item.path = VALUE_ROOT "/Utf8";
+    item.value = "\xe6\x95\xb0\xe6\x8d\xae\xe5\xad\x98\xe5\x82\xa8_lun_7";
+    items.push_back(item);
+
+    // longer than every fixed buffer the commands read into
+    item.path = VALUE_ROOT "/Long";
+    item.value.clear();
+    for (int n = 0; item.value.size() < LEGNTH_PATH * 4; n++){
+        item.value += "vm_datastore_lun_" + corpus_device_name(n).substr(0, 20) + ";";
+    }
+    items.push_back(item);
+
+    item.path = VALUE_ROOT "/Short";
+    item.value = string(SHORT_BUF - 1, 'x');
+    items.push_back(item);
+}
+
+static bool write_values(const vector<VALUE_ITEM> &items, string &content)
+{
+    const char *numbers[][2] = {
+        {VALUE_ROOT "/Max", "2147483647"},
+        {VALUE_ROOT "/Min", "-2147483648"},
+        {VALUE_ROOT "/Over", "2147483648"},
+        {VALUE_ROOT "/Under", "-2147483649"},
+        {VALUE_ROOT "/Junk", "12a"},
+        {VALUE_ROOT "/Double", "3.25"},
+        {VALUE_ROOT "/Huge", "1e400"},
+        {VALUE_ROOT "/Empty", ""},
+        {NULL, NULL}};
+    XmlWriter writer("Values");
+
+    for (size_t i = 0; i < items.size(); i++){
+        BENCH_EXPECT(writer.set_string(items[i].path, items[i].value.c_str()));
+    }
+    for (int i = 0; NULL != numbers[i][0]; i++){
+        BENCH_EXPECT(writer.set_string(numbers[i][0], numbers[i][1]));
+    }
+    BENCH_EXPECT(writer.save_to_file(VALUE_FILE, content));
+    (void)remove(VALUE_FILE);
+
+    return true;
+}
+
+/*
+ Every accessor reads a written value back as it was written, in place,
+ as a string, into a fixed buffer, from a cursor and through the old
+ indexed get_string the commands used before.
+*/
+static bool read_values_round_trip()
+{
+    vector<VALUE_ITEM> items;
+    XmlReader reader;
+    XmlCursor root;
+    string content;
+
+    value_items(items);
+    BENCH_EXPECT(write_values(items, content));
+    BENCH_EXPECT(reader.load_from_string(content, TIXML_DEFAULT_ENCODING));
+    root = reader.get_cursor(VALUE_ROOT);
+    BENCH_EXPECT(root.is_valid());
+
+    for (size_t i = 0; i < items.size(); i++){
+        const char *path = items[i].path;
+        const string &value = items[i].value;
+        vector<char> legacy(value.size() + 1, '\0');
+        XmlText text;
+        string str;
+
+        BENCH_EXPECT(reader.get_text(path, text, value.size()));
+        BENCH_EXPECT(string(text.c_str(), text.size()) == value);
+        BENCH_EXPECT(strlen(text.c_str()) == text.size());
+
+        BENCH_EXPECT(reader.get_string(path, str, value.size()));
+        BENCH_EXPECT(str == value);
+
+        BENCH_EXPECT(root.get_string(XmlPath(path + strlen(VALUE_ROOT "/")), str));
+        BENCH_EXPECT(str == value);
+
+        BENCH_EXPECT(reader.get_string(path, &legacy[0], 0));
+        BENCH_EXPECT(string(&legacy[0]) == value);
+    }
+
+    char name[LENGTH_COMMON] = {0};
+    BENCH_EXPECT(reader.get_cstring(VALUE_ROOT "/Name", name));
+    BENCH_EXPECT(items[0].value == name);
+
+    char key[LENGTH_COMMON] = {0};
+    BENCH_EXPECT(reader.get_cstring(VALUE_ROOT "/Name/@key", key));
+    BENCH_EXPECT(items[1].value == key);
+
+    return true;
+}
+XML_CHECK_CASE(read_values_round_trip);
+
+/*
+ A value longer than the limit, a missing one and a number out of range
+ fail with the reason in get_value_error(), and leave the buffer alone.
+ An element without text reads as empty.
+*/
+static bool read_value_limits()
+{
+    vector<VALUE_ITEM> items;
+    XmlReader reader;
+    XmlCursor root;
+    XmlText text;
+    string content;
+    string str;
+    int number = 0;
+    double real = 0;
+
+    value_items(items);
+    BENCH_EXPECT(write_values(items, content));
+    BENCH_EXPECT(reader.load_from_string(content, TIXML_DEFAULT_ENCODING));
+    root = reader.get_cursor(VALUE_ROOT);
+
+    // a value of exactly the buffer size minus the NUL fits, one more does not
+    char fits[SHORT_BUF] = {0};
+    BENCH_EXPECT(reader.get_cstring(VALUE_ROOT "/Short", fits));
+    BENCH_EXPECT(string(SHORT_BUF - 1, 'x') == fits);
+
+    char small[SHORT_BUF - 1] = "keep";
+    BENCH_EXPECT(!reader.get_cstring(VALUE_ROOT "/Short", small));
+    BENCH_EXPECT(string(VALUE_ROOT "/Short is too long") == reader.get_value_error());
+    BENCH_EXPECT(0 == strcmp(small, "keep"));
+
+    char name[LENGTH_COMMON] = "keep";
+    BENCH_EXPECT(!reader.get_cstring(VALUE_ROOT "/Long", name));
+    BENCH_EXPECT(string(VALUE_ROOT "/Long is too long") == reader.get_value_error());
+    BENCH_EXPECT(0 == strcmp(name, "keep"));
+
+    BENCH_EXPECT(!reader.get_text(VALUE_ROOT "/Long", text, items[3].value.size() - 1));
+    BENCH_EXPECT(text.empty());
+    BENCH_EXPECT(!reader.get_string(VALUE_ROOT "/Long", str, items[3].value.size() - 1));
+    BENCH_EXPECT(str.empty());
+    BENCH_EXPECT(!root.get_text(XmlPath("Long"), text, items[3].value.size() - 1));
+    BENCH_EXPECT(root.get_text(XmlPath("Long"), text, items[3].value.size()));
+
+    // missing elements, attributes and siblings
+    BENCH_EXPECT(!reader.get_text(VALUE_ROOT "/Nothing", text, LENGTH_COMMON));
+    BENCH_EXPECT(string(VALUE_ROOT "/Nothing is missing") == reader.get_value_error());
+    BENCH_EXPECT(!reader.get_text(VALUE_ROOT "/Name/@none", text, LENGTH_COMMON));
+    BENCH_EXPECT(string(VALUE_ROOT "/Name/@none is missing") == reader.get_value_error());
+    BENCH_EXPECT(!reader.get_text(VALUE_ROOT "/Name", text, LENGTH_COMMON, 1));
+    BENCH_EXPECT(!reader.get_text(VALUE_ROOT "/Name", text, LENGTH_COMMON, -1));
+    BENCH_EXPECT(!root.get_text(XmlPath("Name/@none"), text, LENGTH_COMMON));
+    BENCH_EXPECT(!root.get_string(XmlPath("Nothing"), str));
+
+    // an element without text
+    BENCH_EXPECT(reader.get_text(VALUE_ROOT "/Empty", text, 0));
+    BENCH_EXPECT(text.empty() && 0 == strcmp(text.c_str(), ""));
+    BENCH_EXPECT(reader.get_value_error().empty());
+    BENCH_EXPECT(root.get_string(XmlPath("Empty"), str) && str.empty());
+
+    // integer limits and malformed numbers
+    BENCH_EXPECT(reader.get_int(VALUE_ROOT "/Max", number, 0) && INT_MAX == number);
+    BENCH_EXPECT(reader.get_int(VALUE_ROOT "/Min", number, 0) && INT_MIN == number);
+    BENCH_EXPECT(root.get_int(XmlPath("Max"), number) && INT_MAX == number);
+    const char *bad[] = {VALUE_ROOT "/Over", VALUE_ROOT "/Under", VALUE_ROOT "/Junk", VALUE_ROOT "/Empty", NULL};
+    for (int i = 0; NULL != bad[i]; i++){
+        number = 7;
+        BENCH_EXPECT(!reader.get_int(bad[i], number, 0));
+        BENCH_EXPECT(string(bad[i]) + " is not a number" == reader.get_value_error());
+        BENCH_EXPECT(7 == number);
+        BENCH_EXPECT(!root.get_int(XmlPath(bad[i] + strlen(VALUE_ROOT "/")), number));
+    }
+    BENCH_EXPECT(!reader.get_int(VALUE_ROOT "/Nothing", number, 0));
+    BENCH_EXPECT(string(VALUE_ROOT "/Nothing is missing") == reader.get_value_error());
+
+    BENCH_EXPECT(XmlText("42", 2).to_int(number) && 42 == number);
+    BENCH_EXPECT(!XmlText("", 0).to_int(number));
+    BENCH_EXPECT(reader.get_double(VALUE_ROOT "/Double", real, 0) && 3.25 == real);
+    BENCH_EXPECT(!reader.get_double(VALUE_ROOT "/Huge", real, 0));
+    BENCH_EXPECT(!reader.get_double(VALUE_ROOT "/Junk", real, 0));
+
+    return true;
+}
+XML_CHECK_CASE(read_value_limits);
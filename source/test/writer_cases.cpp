@@ -0,0 +1,198 @@
+// Copyright 2019 The OpenSDS Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use this file except in compliance with the License. You may obtain
+// a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "xml_bench.h"
+#include "xml_corpus.h"
+#include "common.h"
+#include "../common/xmlserial/xmlwriter.h"
+#include "../common/xmlserial/xmlreader.h"
+#include "Commf.h"
+
+#define CHECK_DEVICES       50
+#define APPEND_DEVICES      2000
+#define RESPONSE_FILE       "xml_bench_response.xml"
+#define SOURCE_DEVICE_PATH  "/Response/ReplicatedDevices/SourceDevices/SourceDevice"
+#define TARGET_DEVICE_PATH  "/Response/ReplicatedDevices/TargetDevices/TargetDevice"
+#define RESULT_DEVICE_PATH  "/Response/TargetDevices/TargetDevice"
+
+static bool write_response(int devices, string &content)
+{
+    ReplicatedDevices rep_devices;
+    XmlWriter writer;
+
+    corpus_response(devices, rep_devices);
+    BENCH_EXPECT(writer.set_string(XML_RESPONSE_TITLE, CORPUS_XMLNS));
+    BENCH_EXPECT(writer.set_xml("/Response", &rep_devices));
+    BENCH_EXPECT(writer.save_to_file(RESPONSE_FILE, content));
+
+    return true;
+}
+
+/* a written response reads back with every device, names unescaped */
+static bool write_response_read_back()
+{
+    XmlReader reader;
+    XmlCursor source;
+    XmlCursor target;
+    XmlPath name_path("Name");
+    string content;
+    string name;
+    string file;
+
+    BENCH_EXPECT(write_response(CHECK_DEVICES, content));
+    BENCH_EXPECT(bench_read_file(RESPONSE_FILE, file));
+    BENCH_EXPECT(file == content);
+    (void)remove(RESPONSE_FILE);
+
+    BENCH_EXPECT(reader.load_from_string(content, TIXML_DEFAULT_ENCODING));
+    BENCH_EXPECT(CHECK_DEVICES == reader.get_count(SOURCE_DEVICE_PATH));
+    BENCH_EXPECT(CHECK_DEVICES == reader.get_count(TARGET_DEVICE_PATH));
+
+    source = reader.get_cursor(SOURCE_DEVICE_PATH);
+    target = reader.get_cursor(TARGET_DEVICE_PATH);
+    for (int n = 0; n < CHECK_DEVICES; n++){
+        BENCH_EXPECT(source.get_string(name_path, name));
+        BENCH_EXPECT(corpus_device_name(n) == name);
+        BENCH_EXPECT(target.get_string(name_path, name));
+        BENCH_EXPECT(corpus_device_name(n) == name);
+        BENCH_EXPECT(source.next() == (n + 1 < CHECK_DEVICES));
+        BENCH_EXPECT(target.next() == (n + 1 < CHECK_DEVICES));
+    }
+
+    return true;
+}
+XML_CHECK_CASE(write_response_read_back);
+
+static bool write_response_bench()
+{
+    int devices = bench_scale(10000);
+    string content;
+
+    {
+        ReplicatedDevices rep_devices;
+        XmlWriter writer;
+
+        BenchMeter build("build discoverDevices response");
+        corpus_response(devices, rep_devices);
+        build.done(0, (size_t)devices);
+
+        BenchMeter set("set_xml discoverDevices response");
+        BENCH_EXPECT(writer.set_xml("/Response", &rep_devices));
+        set.done(0, (size_t)devices);
+
+        BenchMeter save("save_to_file discoverDevices response");
+        BENCH_EXPECT(writer.save_to_file(RESPONSE_FILE, content));
+        save.done(content.size(), (size_t)devices);
+    }
+    (void)remove(RESPONSE_FILE);
+
+    return true;
+}
+XML_BENCH_CASE(write_response_bench);
+
+/* target device results as a failover writes them, one set_xml per device */
+static void fill_targets(int devices, TargetDevicesInfo &targets)
+{
+    char wwn[40] = {0};
+
+    for (int n = 0; n < devices; n++){
+        TargetDeviceInfo &td = append_node(targets.lst_target_devices);
+
+        (void)snprintf(wwn, sizeof(wwn), "6a0b4c1100d3e5f7%016x", (unsigned int)n);
+        td.target_key = "210235G7H00001_" + OS_IToString(n);
+        td.target_id = td.target_key + "_0_" + OS_IToString(n);
+        td.target_name = corpus_device_name(n);
+        td.target_state = "read-write";
+        td.identity_info.source_wwn = wwn;
+        td.success = true;
+    }
+}
+
+/*
+ Appends land on the last device written, so every device keeps its own
+ attributes and children however many come before it.
+*/
+static bool write_devices_in_order()
+{
+    TargetDevicesInfo targets;
+    XmlWriter writer;
+    XmlReader reader;
+    XmlPath key_path("@key");
+    XmlPath id_path("@id");
+    XmlPath state_path("@state");
+    XmlPath name_path("Name");
+    XmlPath wwn_path("Identity/Wwn");
+    XmlPath success_path("Success");
+    XmlCursor device;
+    string content;
+    string value;
+    int n = 0;
+
+    fill_targets(APPEND_DEVICES, targets);
+    BENCH_EXPECT(writer.set_xml("/Response", &targets));
+    BENCH_EXPECT(writer.save_to_file(RESPONSE_FILE, content));
+    (void)remove(RESPONSE_FILE);
+
+    BENCH_EXPECT(reader.load_from_string(content, TIXML_DEFAULT_ENCODING));
+    BENCH_EXPECT(1 == reader.get_count("/Response/TargetDevices"));
+
+    device = reader.get_cursor(RESULT_DEVICE_PATH);
+    for (list<TargetDeviceInfo>::iterator it = targets.lst_target_devices.begin();
+        it != targets.lst_target_devices.end(); ++it, n++){
+        BENCH_EXPECT(device.is_valid());
+        BENCH_EXPECT(device.get_string(key_path, value) && it->target_key == value);
+        BENCH_EXPECT(device.get_string(id_path, value) && it->target_id == value);
+        BENCH_EXPECT(device.get_string(state_path, value) && it->target_state == value);
+        BENCH_EXPECT(device.get_string(name_path, value) && it->target_name == value);
+        BENCH_EXPECT(device.get_string(wwn_path, value) && it->identity_info.source_wwn == value);
+        BENCH_EXPECT(1 == device.get_count(success_path));
+        BENCH_EXPECT(1 == device.get_count(name_path));
+        (void)device.next();
+    }
+    BENCH_EXPECT(!device.is_valid());
+    BENCH_EXPECT(APPEND_DEVICES == n);
+
+    return true;
+}
+XML_CHECK_CASE(write_devices_in_order);
+
+/*
+ 10000 device results by default, and half as many: with constant time
+ appends the time per device stays the same.
+*/
+static bool write_devices_bench()
+{
+    int devices = bench_scale(10000);
+    int sizes[] = {devices / 2, devices};
+
+    for (int i = 0; i < 2; i++){
+        TargetDevicesInfo targets;
+        XmlWriter writer;
+        string content;
+
+        fill_targets(sizes[i], targets);
+
+        BenchMeter set("set_xml " + OS_IToString(sizes[i]) + " target devices");
+        BENCH_EXPECT(writer.set_xml("/Response", &targets));
+        set.done(0, (size_t)sizes[i]);
+
+        BenchMeter save("save_to_file " + OS_IToString(sizes[i]) + " target devices");
+        BENCH_EXPECT(writer.save_to_file(RESPONSE_FILE, content));
+        save.done(content.size(), (size_t)sizes[i]);
+    }
+    (void)remove(RESPONSE_FILE);
+
+    return true;
+}
+XML_BENCH_CASE(write_devices_bench);
@@ -0,0 +1,262 @@
+// Copyright 2019 The OpenSDS Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use this file except in compliance with the License. You may obtain
+// a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "xml_bench.h"
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include "Commf.h"
+
+#define BENCH_ALLOC_HEAD    16
+
+// the xml_node classes read these, sra.cpp that defines them is not linked
+bool g_bnfs = false;
+bool g_bstretch = false;
+bool g_bFusionStorage = false;
+
+BenchCase *BenchCase::first = NULL;
+
+static BENCH_ALLOC g_alloc = {0, 0, 0, 0};
+static int g_scale = 0;
+static vector<string> g_files;
+
+/*
+ Every allocation carries its size in front of it, so delete can take it
+ off the live bytes. The harness is single threaded.
+*/
+static void* bench_alloc(size_t size)
+{
+    char *ptr = (char *)malloc(size + BENCH_ALLOC_HEAD);
+
+    if (NULL == ptr){
+        return NULL;
+    }
+
+    *(size_t *)ptr = size;
+    g_alloc.count++;
+    g_alloc.bytes += size;
+    g_alloc.live += size;
+    if (g_alloc.live > g_alloc.peak){
+        g_alloc.peak = g_alloc.live;
+    }
+
+    return ptr + BENCH_ALLOC_HEAD;
+}
+
+static void bench_free(void *ptr)
+{
+    char *head = (char *)ptr - BENCH_ALLOC_HEAD;
+
+    if (NULL == ptr){
+        return;
+    }
+
+    g_alloc.live -= *(size_t *)head;
+    free(head);
+}
+
+void* operator new(size_t size)
+{
+    void *ptr = bench_alloc(size);
+
+    if (NULL == ptr){
+        throw std::bad_alloc();
+    }
+
+    return ptr;
+}
+
+void* operator new[](size_t size)
+{
+    void *ptr = bench_alloc(size);
+
+    if (NULL == ptr){
+        throw std::bad_alloc();
+    }
+
+    return ptr;
+}
+
+void* operator new(size_t size, const std::nothrow_t&) throw()
+{
+    return bench_alloc(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) throw()
+{
+    return bench_alloc(size);
+}
+
+void operator delete(void *ptr) throw()
+{
+    bench_free(ptr);
+}
+
+void operator delete[](void *ptr) throw()
+{
+    bench_free(ptr);
+}
+
+void operator delete(void *ptr, const std::nothrow_t&) throw()
+{
+    bench_free(ptr);
+}
+
+void operator delete[](void *ptr, const std::nothrow_t&) throw()
+{
+    bench_free(ptr);
+}
+
+BENCH_ALLOC bench_alloc_get()
+{
+    return g_alloc;
+}
+
+void bench_alloc_mark()
+{
+    g_alloc.peak = g_alloc.live;
+}
+
+BenchCase::BenchCase(const char *name, BENCH_FUN fun, bool is_bench)
+    : name(name), fun(fun), is_bench(is_bench), next(NULL)
+{
+    BenchCase **last = &first;
+
+    // keep the order of registration, so the report reads like the sources
+    while (NULL != *last){
+        last = &(*last)->next;
+    }
+    *last = this;
+}
+
+BenchMeter::BenchMeter(const string &label) : label(label)
+{
+    bench_alloc_mark();
+    alloc_start = bench_alloc_get();
+    start = OS_GetTickCount();
+}
+
+void BenchMeter::done(size_t bytes, size_t items)
+{
+    unsigned long long ms = OS_GetTickCount() - start;
+    BENCH_ALLOC alloc = bench_alloc_get();
+    double mb_per_s = (0 == ms) ? 0 : ((double)bytes / (1024 * 1024)) / ((double)ms / 1000);
+
+    printf("  %-46s %8lu items %10.1f MB %8llu ms %8.1f MB/s %10lu allocs %10.1f MB alloc %8.1f MB peak\n",
+        label.c_str(), (unsigned long)items, (double)bytes / (1024 * 1024), ms, mb_per_s,
+        (unsigned long)(alloc.count - alloc_start.count),
+        (double)(alloc.bytes - alloc_start.bytes) / (1024 * 1024),
+        (double)(alloc.peak - alloc_start.live) / (1024 * 1024));
+}
+
+int bench_scale(int def)
+{
+    return (g_scale > 0) ? g_scale : def;
+}
+
+const vector<string>& bench_files()
+{
+    return g_files;
+}
+
+bool bench_read_file(const string &file, string &content)
+{
+    FILE *fp = fopen(file.c_str(), "rb");
+    char buf[64 * 1024];
+    size_t count = 0;
+
+    content.clear();
+    if (NULL == fp){
+        return false;
+    }
+
+    while ((count = fread(buf, 1, sizeof(buf), fp)) > 0){
+        content.append(buf, count);
+    }
+
+    bool ok = (0 == ferror(fp));
+    fclose(fp);
+
+    return ok;
+}
+
+bool bench_same_text(const string &actual, const string &expected)
+{
+    string::size_type pos = 0;
+
+    if (actual == expected){
+        return true;
+    }
+
+    while (pos < actual.size() && pos < expected.size() && actual[pos] == expected[pos]){
+        pos++;
+    }
+    printf("  actual:   ...%s\n", actual.substr(pos, 80).c_str());
+    printf("  expected: ...%s\n", expected.substr(pos, 80).c_str());
+
+    return false;
+}
+
+static void usage()
+{
+    printf("Usage: xml_bench [--bench] [--scale N] [--case NAME] [corpus file ...]\n");
+    printf("  --bench      run the benchmarks as well as the checks\n");
+    printf("  --scale N    devices of the generated documents, instead of the case default\n");
+    printf("  --case NAME  only run the case NAME\n");
+}
+
+int main(int argc, char *argv[])
+{
+    bool bench = false;
+    const char *only = NULL;
+    int failed = 0;
+    int run = 0;
+
+    for (int i = 1; i < argc; i++){
+        if (0 == strcmp(argv[i], "--bench")){
+            bench = true;
+        }
+        else if (0 == strcmp(argv[i], "--scale") && i + 1 < argc){
+            g_scale = atoi(argv[++i]);
+        }
+        else if (0 == strcmp(argv[i], "--case") && i + 1 < argc){
+            only = argv[++i];
+        }
+        else if (0 == strncmp(argv[i], "--", 2)){
+            usage();
+            return 2;
+        }
+        else{
+            g_files.push_back(argv[i]);
+        }
+    }
+
+    for (BenchCase *item = BenchCase::first; NULL != item; item = item->next){
+        if (NULL != only ? 0 != strcmp(only, item->name) : (item->is_bench && !bench)){
+            continue;
+        }
+
+        printf("%s\n", item->name);
+        fflush(stdout);
+        run++;
+        if (!item->fun()){
+            printf("%s FAILED\n", item->name);
+            failed++;
+        }
+    }
+
+    printf("%d of %d cases failed\n", failed, run);
+
+    return (0 == failed) ? 0 : 1;
+}
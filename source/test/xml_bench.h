@@ -0,0 +1,99 @@
+// Copyright 2019 The OpenSDS Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use this file except in compliance with the License. You may obtain
+// a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#ifndef XML_BENCH_H
+#define XML_BENCH_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/*
+ Checks and benchmarks of the XML layer, run without an array. Every case
+ registers itself with XML_CHECK_CASE or XML_BENCH_CASE, checks always run
+ and benchmarks only with --bench. A case returns false when it failed.
+*/
+typedef bool (*BENCH_FUN)();
+
+class BenchCase
+{
+public:
+    BenchCase(const char *name, BENCH_FUN fun, bool is_bench);
+
+    const char *name;
+    BENCH_FUN fun;
+    bool is_bench;
+    BenchCase *next;
+
+    static BenchCase *first;
+};
+
+#define XML_CHECK_CASE(fun) static BenchCase fun##_case(#fun, fun, false)
+#define XML_BENCH_CASE(fun) static BenchCase fun##_case(#fun, fun, true)
+
+#define BENCH_EXPECT(cond) \
+    do{ \
+        if (!(cond)){ \
+            printf("%s:%d: expect %s failed\n", __FILE__, __LINE__, #cond); \
+            return false; \
+        } \
+    }while (0)
+
+/*
+ Allocations through operator new since the start of the process. live
+ and peak are bytes in use, peak is the highest live since the last
+ bench_alloc_mark().
+*/
+typedef struct
+{
+    size_t count;
+    size_t bytes;
+    size_t live;
+    size_t peak;
+} BENCH_ALLOC;
+
+BENCH_ALLOC bench_alloc_get();
+void bench_alloc_mark();
+
+/*
+ Time and allocations of one measured step, printed as a line of the
+ report by done().
+*/
+class BenchMeter
+{
+public:
+    explicit BenchMeter(const string &label);
+
+    void done(size_t bytes, size_t items);
+
+private:
+    string label;
+    unsigned long long start;
+    BENCH_ALLOC alloc_start;
+};
+
+/* the --scale of the command line, or def when none was given */
+int bench_scale(int def);
+
+/* the corpus files given on the command line */
+const vector<string>& bench_files();
+
+bool bench_read_file(const string &file, string &content);
+
+/* true when actual equals expected, else both are printed from the first difference */
+bool bench_same_text(const string &actual, const string &expected);
+
+#endif
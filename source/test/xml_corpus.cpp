@@ -0,0 +1,450 @@
+// Copyright 2019 The OpenSDS Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use this file except in compliance with the License. You may obtain
+// a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "xml_corpus.h"
+#include <cstdio>
+#include "common.h"
+
+#define CORPUS_ARRAY_ID         "210235G7H00002"
+#define CORPUS_PEER_ARRAY_ID    "210235G7H00001"
+#define CORPUS_HOST_GROUPS      4
+
+const CORPUS_COMMAND g_corpus_commands[] = {
+    {"discoverDevices", "DiscoverDevicesParameters", 0},
+    {"failover", "FailoverParameters", CORPUS_TARGET_GROUPS | CORPUS_TARGET_DEVICES | CORPUS_ACCESS_GROUPS},
+    {"prepareFailover", "PrepareFailoverParameters", CORPUS_SOURCE_DEVICES | CORPUS_CONS_GROUPS},
+    {"prepareReverseReplication", "PrepareReverseReplicationParameters", CORPUS_CONS_GROUPS | CORPUS_DEVICES},
+    {"querySyncStatus", "QuerySyncStatusParameters", CORPUS_SOURCE_DEVICES | CORPUS_CONS_GROUPS | CORPUS_TARGET_DEVICES},
+    {"restoreReplication", "RestoreReplicationParameters", CORPUS_CONS_GROUPS | CORPUS_DEVICES},
+    {"reverseReplication", "ReverseReplicationParameters", CORPUS_CONS_GROUPS | CORPUS_DEVICES | CORPUS_ACCESS_GROUPS},
+    {"syncOnce", "SyncOnceParameters", CORPUS_SOURCE_DEVICES | CORPUS_CONS_GROUPS},
+    {"testFailoverStart", "TestFailoverStartParameters", CORPUS_TARGET_GROUPS | CORPUS_TARGET_DEVICES | CORPUS_ACCESS_GROUPS},
+    {"testFailoverStop", "TestFailoverStopParameters", CORPUS_TARGET_GROUPS | CORPUS_TARGET_DEVICES},
+    {NULL, NULL, 0}
+};
+
+const CORPUS_COMMAND g_corpus_every_list = {"failover", "FailoverParameters",
+    CORPUS_TARGET_GROUPS | CORPUS_TARGET_DEVICES | CORPUS_SOURCE_DEVICES |
+    CORPUS_CONS_GROUPS | CORPUS_DEVICES | CORPUS_ACCESS_GROUPS};
+
+static string corpus_int(int value)
+{
+    char buf[16] = {0};
+
+    (void)snprintf(buf, sizeof(buf), "%d", value);
+
+    return buf;
+}
+
+static void corpus_escape(string &doc, const string &value)
+{
+    for (string::size_type i = 0; i < value.size(); i++){
+        switch (value[i]){
+            case '&':
+                doc += "&amp;";
+                break;
+            case '<':
+                doc += "&lt;";
+                break;
+            case '>':
+                doc += "&gt;";
+                break;
+            case '"':
+                doc += "&quot;";
+                break;
+            case '\'':
+                doc += "&apos;";
+                break;
+            default:
+                doc += value[i];
+                break;
+        }
+    }
+}
+
+static void corpus_indent(string &doc, int depth)
+{
+    doc.append(depth * 4, ' ');
+}
+
+static void corpus_open(string &doc, int depth, const char *name, const char *attr, const string &value, bool empty)
+{
+    corpus_indent(doc, depth);
+    doc += "<";
+    doc += name;
+    doc += " ";
+    doc += attr;
+    doc += "=\"";
+    corpus_escape(doc, value);
+    doc += empty ? "\"/>\n" : "\">\n";
+}
+
+static void corpus_close(string &doc, int depth, const char *name)
+{
+    corpus_indent(doc, depth);
+    doc += "</";
+    doc += name;
+    doc += ">\n";
+}
+
+static void corpus_value(string &doc, int depth, const char *name, const string &value)
+{
+    corpus_indent(doc, depth);
+    doc += "<";
+    doc += name;
+    doc += ">";
+    corpus_escape(doc, value);
+    doc += "</";
+    doc += name;
+    doc += ">\n";
+}
+
+/* the key of the n-th device of array, every seventh one needs escaping */
+static string corpus_device_key(const char *array, int n)
+{
+    string key = string(array) + "_" + corpus_int(n) + "_1_" + corpus_int(n);
+
+    return (3 == n % 7) ? key + "&<\"'>" : key;
+}
+
+static string corpus_host_group(int n)
+{
+    return "vssra_hostgrp_" + corpus_int(n % CORPUS_HOST_GROUPS);
+}
+
+/* the access groups of the n-th device as CommandPara joins them */
+static string corpus_access(int n)
+{
+    string access = corpus_host_group(n) + DAR_HOST_SEPERATOR;
+
+    return (0 == n % 5) ? access + corpus_host_group(n + 1) + DAR_HOST_SEPERATOR : access;
+}
+
+static void corpus_access_groups(string &doc, int depth, int n)
+{
+    corpus_indent(doc, depth);
+    doc += "<AccessGroups>\n";
+    corpus_open(doc, depth + 1, "AccessGroup", "id", corpus_host_group(n), true);
+    if (0 == n % 5){
+        corpus_open(doc, depth + 1, "AccessGroup", "id", corpus_host_group(n + 1), true);
+    }
+    corpus_close(doc, depth, "AccessGroups");
+}
+
+static void corpus_target_groups(string &doc, int depth, int devices)
+{
+    int groups = (devices + CORPUS_GROUP_SIZE - 1) / CORPUS_GROUP_SIZE;
+
+    corpus_indent(doc, depth);
+    doc += "<TargetGroups>\n";
+    for (int g = 0; g < groups; g++){
+        corpus_indent(doc, depth + 1);
+        doc += "<TargetGroup key=\"";
+        corpus_escape(doc, "tg_" + corpus_int(g));
+        doc += (0 == g % 2) ? "\" isolationRequired=\"false\">\n" : "\" isolationRequired=\"true\">\n";
+        corpus_indent(doc, depth + 2);
+        doc += "<TargetDevices>\n";
+        for (int n = g * CORPUS_GROUP_SIZE; n < devices && n < (g + 1) * CORPUS_GROUP_SIZE; n++){
+            corpus_open(doc, depth + 3, "TargetDevice", "key", corpus_device_key(CORPUS_ARRAY_ID, n), false);
+            corpus_access_groups(doc, depth + 4, n);
+            corpus_close(doc, depth + 3, "TargetDevice");
+        }
+        corpus_close(doc, depth + 2, "TargetDevices");
+        corpus_close(doc, depth + 1, "TargetGroup");
+    }
+    corpus_close(doc, depth, "TargetGroups");
+}
+
+static void corpus_target_devices(string &doc, int depth, int devices)
+{
+    corpus_indent(doc, depth);
+    doc += "<TargetDevices>\n";
+    for (int n = 0; n < devices; n++){
+        corpus_indent(doc, depth + 1);
+        doc += "<TargetDevice key=\"";
+        corpus_escape(doc, corpus_device_key(CORPUS_ARRAY_ID, n));
+        doc += "\" isolationRequired=\"false\" syncId=\"sync_" + corpus_int(n) + "\">\n";
+        corpus_access_groups(doc, depth + 2, n);
+        corpus_close(doc, depth + 1, "TargetDevice");
+    }
+    corpus_close(doc, depth, "TargetDevices");
+}
+
+static void corpus_source_devices(string &doc, int depth, int devices)
+{
+    corpus_indent(doc, depth);
+    doc += "<SourceDevices>\n";
+    for (int n = 0; n < devices; n++){
+        corpus_indent(doc, depth + 1);
+        doc += "<SourceDevice id=\"";
+        corpus_escape(doc, corpus_device_key(CORPUS_PEER_ARRAY_ID, n));
+        doc += "\" syncId=\"sync_" + corpus_int(n) + "\"/>\n";
+    }
+    corpus_close(doc, depth, "SourceDevices");
+}
+
+static void corpus_devices(string &doc, int depth, int first, int last)
+{
+    corpus_indent(doc, depth);
+    doc += "<Devices>\n";
+    for (int n = first; n < last; n++){
+        corpus_open(doc, depth + 1, "Device", "id", corpus_device_key(CORPUS_PEER_ARRAY_ID, n), false);
+        corpus_access_groups(doc, depth + 2, n);
+        corpus_close(doc, depth + 1, "Device");
+    }
+    corpus_close(doc, depth, "Devices");
+}
+
+static void corpus_cons_groups(string &doc, int depth, int devices)
+{
+    int groups = (devices + CORPUS_GROUP_SIZE - 1) / CORPUS_GROUP_SIZE;
+
+    corpus_indent(doc, depth);
+    doc += "<ConsistencyGroups>\n";
+    for (int g = 0; g < groups; g++){
+        corpus_indent(doc, depth + 1);
+        doc += "<ConsistencyGroup id=\"cg_" + corpus_int(g) + "\" syncId=\"cgsync_" + corpus_int(g) + "\">\n";
+        corpus_devices(doc, depth + 2, g * CORPUS_GROUP_SIZE,
+            ((g + 1) * CORPUS_GROUP_SIZE < devices) ? (g + 1) * CORPUS_GROUP_SIZE : devices);
+        corpus_close(doc, depth + 1, "ConsistencyGroup");
+    }
+    corpus_close(doc, depth, "ConsistencyGroups");
+}
+
+static void corpus_hosts(string &doc, int depth)
+{
+    corpus_indent(doc, depth);
+    doc += "<AccessGroups>\n";
+    for (int g = 0; g < CORPUS_HOST_GROUPS; g++){
+        corpus_open(doc, depth + 1, "AccessGroup", "id", corpus_host_group(g), false);
+        corpus_indent(doc, depth + 2);
+        doc += "<Initiator id=\"iqn.1998-01.com.vmware:esx" + corpus_int(g) + "\" type=\"iSCSI\"/>\n";
+        corpus_indent(doc, depth + 2);
+        doc += "<Initiator id=\"21000024ff3a4b" + corpus_int(10 + g) + "\" type=\"FC\"/>\n";
+        corpus_close(doc, depth + 1, "AccessGroup");
+    }
+    corpus_close(doc, depth, "AccessGroups");
+}
+
+string corpus_command(const CORPUS_COMMAND &cmd, int devices)
+{
+    string doc;
+
+    // about 300 bytes per device and list
+    doc.reserve(1024 + (size_t)devices * 300 * 3);
+
+    doc += "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+    doc += "<Command xmlns=\"" CORPUS_XMLNS "\">\n";
+    corpus_value(doc, 1, "Name", cmd.name);
+
+    corpus_indent(doc, 1);
+    doc += "<";
+    doc += cmd.para;
+    doc += ">\n";
+    corpus_value(doc, 2, "ArrayId", CORPUS_ARRAY_ID);
+    corpus_value(doc, 2, "PeerArrayId", CORPUS_PEER_ARRAY_ID);
+    if (0 != (cmd.lists & CORPUS_TARGET_GROUPS)){
+        corpus_target_groups(doc, 2, devices);
+    }
+    if (0 != (cmd.lists & CORPUS_TARGET_DEVICES)){
+        corpus_target_devices(doc, 2, devices);
+    }
+    if (0 != (cmd.lists & CORPUS_SOURCE_DEVICES)){
+        corpus_source_devices(doc, 2, devices);
+    }
+    if (0 != (cmd.lists & CORPUS_CONS_GROUPS)){
+        corpus_cons_groups(doc, 2, devices);
+    }
+    if (0 != (cmd.lists & CORPUS_DEVICES)){
+        corpus_devices(doc, 2, 0, devices);
+    }
+    if (0 != (cmd.lists & CORPUS_ACCESS_GROUPS)){
+        corpus_hosts(doc, 2);
+    }
+    corpus_close(doc, 1, cmd.para);
+
+    doc += "    <Connections>\n";
+    doc += "        <Connection>\n";
+    doc += "            <Username>admin</Username>\n";
+    doc += "            <Password>p&amp;ssw&lt;rd</Password>\n";
+    doc += "            <Addresses>\n";
+    doc += "                <Address id=\"group1\">" CORPUS_ARRAY_ID "</Address>\n";
+    doc += "                <Address id=\"group2\">192.168.1.101</Address>\n";
+    doc += "            </Addresses>\n";
+    doc += "        </Connection>\n";
+    doc += "    </Connections>\n";
+    corpus_value(doc, 1, "OutputFile", string("outputs/") + cmd.name + "_response.xml");
+    corpus_value(doc, 1, "StatusFile", string("outputs/") + cmd.name + "_status.xml");
+    corpus_value(doc, 1, "LogDirectory", "logs");
+    corpus_value(doc, 1, "LogLevel", "info");
+    doc += "</Command>\n";
+
+    return doc;
+}
+
+static void corpus_group_devices(const char *array, int first, int last, CommandPara &para)
+{
+    for (int n = first; n < last; n++){
+        para.group_access.push_back(make_pair(corpus_device_key(array, n), corpus_access(n)));
+    }
+}
+
+void corpus_lists(const CORPUS_COMMAND &cmd, int devices, CommandPara &para)
+{
+    int groups = (devices + CORPUS_GROUP_SIZE - 1) / CORPUS_GROUP_SIZE;
+
+    para.clear();
+
+    // in document order, group_access takes the target groups' devices first
+    for (int g = 0; 0 != (cmd.lists & CORPUS_TARGET_GROUPS) && g < groups; g++){
+        TargetGroupInfo &tg = append_node(para.target_groups);
+        tg.tg_key = "tg_" + corpus_int(g);
+        tg.isolationRequired = (0 == g % 2) ? "false" : "true";
+        corpus_group_devices(CORPUS_ARRAY_ID, g * CORPUS_GROUP_SIZE,
+            ((g + 1) * CORPUS_GROUP_SIZE < devices) ? (g + 1) * CORPUS_GROUP_SIZE : devices, para);
+    }
+    for (int n = 0; 0 != (cmd.lists & CORPUS_TARGET_DEVICES) && n < devices; n++){
+        TargetDeviceInfo &td = append_node(para.target_devices);
+        td.target_key = corpus_device_key(CORPUS_ARRAY_ID, n);
+        td.isolationRequired = "false";
+        td.devicesync_info.sync_id = "sync_" + corpus_int(n);
+        td.cg_accessgroups = corpus_access(n);
+    }
+    for (int n = 0; 0 != (cmd.lists & CORPUS_SOURCE_DEVICES) && n < devices; n++){
+        SourceDeviceInfo &sd = append_node(para.source_devices);
+        sd.source_id = corpus_device_key(CORPUS_PEER_ARRAY_ID, n);
+        sd.device_sync_info.sync_id = "sync_" + corpus_int(n);
+    }
+    for (int g = 0; 0 != (cmd.lists & CORPUS_CONS_GROUPS) && g < groups; g++){
+        ConGroupInfo &cg = append_node(para.cons_groups);
+        cg.cg_id = "cg_" + corpus_int(g);
+        cg.device_sync_info.sync_id = "cgsync_" + corpus_int(g);
+        corpus_group_devices(CORPUS_PEER_ARRAY_ID, g * CORPUS_GROUP_SIZE,
+            ((g + 1) * CORPUS_GROUP_SIZE < devices) ? (g + 1) * CORPUS_GROUP_SIZE : devices, para);
+    }
+    for (int n = 0; 0 != (cmd.lists & CORPUS_DEVICES) && n < devices; n++){
+        DeviceInfo &dev = append_node(para.devices);
+        dev.id = corpus_device_key(CORPUS_PEER_ARRAY_ID, n);
+        dev.cg_accessgroups = corpus_access(n);
+    }
+    for (int g = 0; 0 != (cmd.lists & CORPUS_ACCESS_GROUPS) && g < CORPUS_HOST_GROUPS; g++){
+        DAR_HOST_INFO iscsi;
+        DAR_HOST_INFO fc;
+
+        iscsi.strID = "iqn.1998-01.com.vmware:esx" + corpus_int(g);
+        iscsi.strType = "iSCSI";
+        iscsi.strGroup = corpus_host_group(g);
+        para.dar_hosts.push_back(iscsi);
+
+        fc.strID = "21000024ff3a4b" + corpus_int(10 + g);
+        fc.strType = "FC";
+        fc.strGroup = corpus_host_group(g);
+        para.dar_hosts.push_back(fc);
+    }
+}
+
+string corpus_para_dump(const CommandPara &para)
+{
+    string dump = para.is_key_missing() ? "key missing\n" : "";
+
+    for (list<TargetGroupInfo>::const_iterator it = para.target_groups.begin(); it != para.target_groups.end(); ++it){
+        dump += "TargetGroup " + it->tg_key + " " + it->isolationRequired + "\n";
+    }
+    for (list<ConGroupInfo>::const_iterator it = para.cons_groups.begin(); it != para.cons_groups.end(); ++it){
+        dump += "ConsistencyGroup " + it->cg_id + " " + it->device_sync_info.sync_id + "\n";
+    }
+    for (list<TargetDeviceInfo>::const_iterator it = para.target_devices.begin(); it != para.target_devices.end(); ++it){
+        dump += "TargetDevice " + it->target_key + " " + it->isolationRequired + " " +
+            it->devicesync_info.sync_id + " " + it->cg_accessgroups + "\n";
+    }
+    for (list<DeviceInfo>::const_iterator it = para.devices.begin(); it != para.devices.end(); ++it){
+        dump += "Device " + it->id + " " + it->cg_accessgroups + "\n";
+    }
+    for (list<SourceDeviceInfo>::const_iterator it = para.source_devices.begin(); it != para.source_devices.end(); ++it){
+        dump += "SourceDevice " + it->source_id + " " + it->device_sync_info.sync_id + "\n";
+    }
+    for (list<pair<string, string> >::const_iterator it = para.group_access.begin(); it != para.group_access.end(); ++it){
+        dump += "GroupAccess " + it->first + " " + it->second + "\n";
+    }
+    for (list<DAR_HOST_INFO>::const_iterator it = para.dar_hosts.begin(); it != para.dar_hosts.end(); ++it){
+        dump += "Initiator " + it->strID + " " + it->strType + " " + it->strGroup + "\n";
+    }
+
+    return dump;
+}
+
+string corpus_device_name(int n)
+{
+    string name = "vm_datastore_lun_" + corpus_int(n);
+
+    return (3 == n % 7) ? name + " <R&D \"test\" 'copy'>" : name;
+}
+
+static string corpus_wwn(int n)
+{
+    char buf[40] = {0};
+
+    (void)snprintf(buf, sizeof(buf), "6a0b4c1100d3e5f7%08x%08x", (unsigned int)n, (unsigned int)(n * 2654435761u));
+
+    return buf;
+}
+
+void corpus_response(int devices, ReplicatedDevices &rep_devices)
+{
+    for (int n = 0; n < devices; n++){
+        SourceDeviceInfo &sd = append_node(rep_devices.sources_info.lst_source_devices);
+        sd.source_id = string(CORPUS_ARRAY_ID) + "_" + corpus_int(n) + "_0_" + corpus_int(n);
+        sd.source_name = corpus_device_name(n);
+        sd.status = (0 == n % 2) ? "read-write" : "read-only";
+        sd.identity_info.source_wwn = corpus_wwn(n);
+        sd.target_info.target_key = string(CORPUS_PEER_ARRAY_ID) + "_" + corpus_int(n) + "_0_" + corpus_int(n);
+
+        TargetDeviceInfo &td = append_node(rep_devices.targets_info.lst_target_devices);
+        td.target_key = corpus_device_key(CORPUS_PEER_ARRAY_ID, n);
+        td.target_name = corpus_device_name(n);
+        td.target_state = "read-only";
+        td.identity_info.source_wwn = corpus_wwn(n + devices);
+    }
+
+    for (int i = 0; i < 2; i++){
+        StoragePortsIPS &port = append_node(rep_devices.storageports_info.lst_storageportsips);
+        port.source_IP = "192.168.10." + corpus_int(10 + i);
+    }
+}
+
+void corpus_response_records(int devices, ReplicatedDevices &rep_devices)
+{
+    SourceDevicesInfo &sources = rep_devices.sources_info;
+    TargetDevicesInfo &targets = rep_devices.targets_info;
+
+    for (int n = 0; n < devices; n++){
+        SOURCE_DEVICE_RECORD &sd = sources.append_record();
+        sd.source_id = sources.strings.add(string(CORPUS_ARRAY_ID) + "_" + corpus_int(n) + "_0_" + corpus_int(n));
+        sd.source_name = sources.strings.add(corpus_device_name(n));
+        sd.status = sources.strings.add((0 == n % 2) ? "read-write" : "read-only");
+        sd.source_wwn = sources.strings.add(corpus_wwn(n));
+        sd.target_key = sources.strings.add(string(CORPUS_PEER_ARRAY_ID) + "_" + corpus_int(n) + "_0_" + corpus_int(n));
+
+        TARGET_DEVICE_RECORD &td = targets.append_record();
+        td.target_key = targets.strings.add(corpus_device_key(CORPUS_PEER_ARRAY_ID, n));
+        td.target_name = targets.strings.add(corpus_device_name(n));
+        td.target_state = targets.strings.add("read-only");
+        td.source_wwn = targets.strings.add(corpus_wwn(n + devices));
+    }
+
+    for (int i = 0; i < 2; i++){
+        StoragePortsIPS &port = append_node(rep_devices.storageports_info.lst_storageportsips);
+        port.source_IP = "192.168.10." + corpus_int(10 + i);
+    }
+}
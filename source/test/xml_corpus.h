@@ -0,0 +1,78 @@
+// Copyright 2019 The OpenSDS Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use this file except in compliance with the License. You may obtain
+// a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#ifndef XML_CORPUS_H
+#define XML_CORPUS_H
+
+#include <string>
+#include <vector>
+#include "../common/xml_node/replicated_devices.h"
+#include "command_para.h"
+
+using namespace std;
+
+#define CORPUS_XMLNS            "http://www.vmware.com/srm/client"
+
+#define CORPUS_TARGET_GROUPS    0x01
+#define CORPUS_TARGET_DEVICES   0x02
+#define CORPUS_SOURCE_DEVICES   0x04
+#define CORPUS_CONS_GROUPS      0x08
+#define CORPUS_ACCESS_GROUPS    0x10
+#define CORPUS_DEVICES          0x20
+
+/* devices of a generated target or consistency group */
+#define CORPUS_GROUP_SIZE       8
+
+/*
+ The commands SRM sends, with the parameter lists each one carries. The
+ table ends with a NULL name.
+*/
+typedef struct
+{
+    const char *name;
+    const char *para;
+    unsigned int lists;
+} CORPUS_COMMAND;
+
+extern const CORPUS_COMMAND g_corpus_commands[];
+
+/* a failover carrying every list, so one document goes through every binding */
+extern const CORPUS_COMMAND g_corpus_every_list;
+
+/*
+ The command document of cmd with devices entries in each of its lists.
+ Some keys and names need escaping, so the documents also check entity
+ handling.
+*/
+string corpus_command(const CORPUS_COMMAND &cmd, int devices);
+
+/*
+ The lists CommandPara reads from corpus_command(cmd, devices), built from
+ the same rules as the document instead of parsed from it.
+*/
+void corpus_lists(const CORPUS_COMMAND &cmd, int devices, CommandPara &para);
+
+/* every list of para as text, so two loads compare and print as one value */
+string corpus_para_dump(const CommandPara &para);
+
+/* the name of the n-th generated device, every seventh one needs escaping */
+string corpus_device_name(int n);
+
+/* a discoverDevices response of devices source and target devices */
+void corpus_response(int devices, ReplicatedDevices &rep_devices);
+
+/* the same response with the devices kept as records, as discoverDevices keeps them */
+void corpus_response_records(int devices, ReplicatedDevices &rep_devices);
+
+#endif
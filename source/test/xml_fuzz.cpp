@@ -0,0 +1,67 @@
+// Copyright 2019 The OpenSDS Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use this file except in compliance with the License. You may obtain
+// a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include <stdint.h>
+#include <cctype>
+#include "common.h"
+#include "command_para.h"
+
+/*
+ libFuzzer entry point. One input is one command document, loaded the way
+ main loads stdin and then read the way SraBasic reads the common info and
+ the parameter lists, so both the streamed lists and the DOM fallback are
+ reached. xml_bench replays its corpus through it too, the entry does not
+ need libFuzzer to run.
+*/
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    XmlReader reader;
+    CommandPara para;
+    bool streamed = false;
+    char name[LENGTH_COMMON] = {0};
+    char xmlns[LENGTH_XMLNS] = {0};
+    char output_file[LEGNTH_PATH] = {0};
+    char array_id[LENGTH_COMMON] = {0};
+    string address;
+    string para_path;
+
+    if (!load_command(reader, string((const char *)data, size), streamed)){
+        g_command_para.clear();
+        return 0;
+    }
+
+    (void)reader.get_cstring(XML_REQUSET_TITLE, xmlns);
+    (void)reader.get_cstring(XML_OUTPUTFILE, output_file);
+    for (int i = 0; i < reader.get_count(XML_ARRAYSN); i++){
+        (void)reader.get_string(XML_ARRAYIP, address, LENGTH_COMMON - 1, i);
+    }
+
+    // <name> is read from <Name>Parameters, as in FailoverParameters
+    if (reader.get_cstring(XML_COMMANDNAME, name) && '\0' != name[0]){
+        name[0] = (char)toupper((unsigned char)name[0]);
+        para_path = string(XML_COMMAND) + "/" + name + "Parameters";
+        (void)reader.get_cstring((para_path + "/ArrayId").c_str(), array_id);
+
+        if (g_command_para.is_loaded()){
+            para.swap(g_command_para);
+        }
+        else{
+            para.read(reader, para_path.c_str());
+        }
+    }
+
+    g_command_para.clear();
+
+    return 0;
+}